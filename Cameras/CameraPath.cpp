@@ -0,0 +1,181 @@
+//--------------------------------------------------------------------------------------
+// File: CameraPath.cpp
+//
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+//-------------------------------------------------------------------------------------
+
+#include "pch.h"
+#include "CameraPath.h"
+
+#include "OrbitCamera.h"
+
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+using namespace DirectX;
+using namespace DX;
+
+namespace
+{
+	// Focus in xyz and radius in w, so that both are interpolated by one spline
+	inline XMVECTOR LoadFocusRadius(const CameraPath::Keyframe& keyframe)
+	{
+		return XMVectorSetW(XMLoadFloat3(&keyframe.focus), keyframe.radius);
+	}
+}
+
+CameraPath::CameraPath(std::vector<Keyframe> keyframes) :
+	m_keyframes(std::move(keyframes))
+{
+	if (m_keyframes.empty())
+	{
+		throw std::invalid_argument("Camera path has no keyframes");
+	}
+
+	for (size_t i = 1; i < m_keyframes.size(); ++i)
+	{
+		if (!(m_keyframes[i].time > m_keyframes[i - 1].time))
+		{
+			throw std::invalid_argument("Camera path keyframe times must be strictly increasing");
+		}
+	}
+}
+
+CameraPath CameraPath::CreateFromFile(const std::filesystem::path& fileName)
+{
+	std::ifstream file(fileName);
+	if (!file)
+	{
+		throw std::runtime_error("Failed to open camera path");
+	}
+
+	return CreateFromStream(file);
+}
+
+CameraPath CameraPath::CreateFromStream(std::istream& stream)
+{
+	std::vector<Keyframe> keyframes;
+
+	std::string line;
+	for (size_t lineNumber = 1; std::getline(stream, line); ++lineNumber)
+	{
+		const auto comment = line.find('#');
+		if (comment != std::string::npos)
+		{
+			line.erase(comment);
+		}
+
+		std::istringstream fields(line);
+
+		Keyframe keyframe;
+		if (!(fields >> keyframe.time))
+		{
+			if (fields.eof())
+			{
+				// Blank line
+				continue;
+			}
+
+			throw std::runtime_error("Invalid camera path keyframe at line " + std::to_string(lineNumber));
+		}
+
+		fields >> keyframe.focus.x >> keyframe.focus.y >> keyframe.focus.z
+			>> keyframe.rotation.x >> keyframe.rotation.y >> keyframe.rotation.z >> keyframe.rotation.w
+			>> keyframe.radius;
+
+		std::string extra;
+		if (!fields || (fields >> extra))
+		{
+			throw std::runtime_error("Invalid camera path keyframe at line " + std::to_string(lineNumber));
+		}
+
+		keyframes.push_back(keyframe);
+	}
+
+	if (stream.bad())
+	{
+		throw std::runtime_error("Failed to read camera path");
+	}
+
+	return CameraPath(std::move(keyframes));
+}
+
+void CameraPath::Evaluate(double time, XMVECTOR& focus, XMVECTOR& rotation, float& radius) const
+{
+	if (m_keyframes.empty())
+	{
+		throw std::logic_error("Camera path has no keyframes");
+	}
+
+	const size_t last = m_keyframes.size() - 1;
+
+	// Segment [i, i + 1] containing time
+	size_t i = 0;
+	float s = 0.f;
+	if (time >= m_keyframes[last].time)
+	{
+		i = last;
+	}
+	else if (time > m_keyframes[0].time)
+	{
+		const auto next = std::upper_bound(m_keyframes.cbegin(), m_keyframes.cend(), time,
+			[](double t, const Keyframe& keyframe) { return t < keyframe.time; });
+		i = static_cast<size_t>(next - m_keyframes.cbegin()) - 1;
+		s = static_cast<float>((time - m_keyframes[i].time) / (m_keyframes[i + 1].time - m_keyframes[i].time));
+	}
+
+	if (i == last)
+	{
+		const Keyframe& keyframe = m_keyframes[last];
+		focus = XMLoadFloat3(&keyframe.focus);
+		rotation = XMQuaternionNormalize(XMLoadFloat4(&keyframe.rotation));
+		radius = keyframe.radius;
+		return;
+	}
+
+	// The end keyframes are repeated to stand in for the missing neighbors
+	const Keyframe& k0 = m_keyframes[(i > 0) ? i - 1 : 0];
+	const Keyframe& k1 = m_keyframes[i];
+	const Keyframe& k2 = m_keyframes[i + 1];
+	const Keyframe& k3 = m_keyframes[std::min(i + 2, last)];
+
+	// Catmull-Rom tangents for non-uniform keyframe spacing, scaled to the [0, 1] parameter of this segment
+	const float h = static_cast<float>(k2.time - k1.time);
+	const float scale1 = h / static_cast<float>(k2.time - k0.time);
+	const float scale2 = h / static_cast<float>(k3.time - k1.time);
+
+	const XMVECTOR p0 = LoadFocusRadius(k0);
+	const XMVECTOR p1 = LoadFocusRadius(k1);
+	const XMVECTOR p2 = LoadFocusRadius(k2);
+	const XMVECTOR p3 = LoadFocusRadius(k3);
+
+	const XMVECTOR t1 = XMVectorScale(XMVectorSubtract(p2, p0), scale1);
+	const XMVECTOR t2 = XMVectorScale(XMVectorSubtract(p3, p1), scale2);
+
+	const XMVECTOR focusRadius = XMVectorHermite(p1, t1, p2, t2, s);
+	focus = XMVectorSetW(focusRadius, 0.f);
+	radius = XMVectorGetW(focusRadius);
+
+	XMVECTOR a, b, c;
+	XMQuaternionSquadSetup(&a, &b, &c,
+		XMQuaternionNormalize(XMLoadFloat4(&k0.rotation)),
+		XMQuaternionNormalize(XMLoadFloat4(&k1.rotation)),
+		XMQuaternionNormalize(XMLoadFloat4(&k2.rotation)),
+		XMQuaternionNormalize(XMLoadFloat4(&k3.rotation)));
+
+	rotation = XMQuaternionNormalize(XMQuaternionSquad(XMQuaternionNormalize(XMLoadFloat4(&k1.rotation)), a, b, c, s));
+}
+
+void CameraPath::Apply(OrbitCamera& camera, double time, float minRadius, float maxRadius) const
+{
+	XMVECTOR focus, rotation;
+	float radius;
+	Evaluate(time, focus, rotation, radius);
+
+	camera.SetFocus(focus);
+	camera.SetRotation(rotation);
+	camera.SetRadius(radius, minRadius, maxRadius);
+}
@@ -0,0 +1,63 @@
+//--------------------------------------------------------------------------------------
+// File: CameraPath.h
+//
+// Keyframed camera flythrough for driving an OrbitCamera
+//
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+//-------------------------------------------------------------------------------------
+
+#pragma once
+
+#include <cfloat>
+#include <filesystem>
+#include <iosfwd>
+#include <vector>
+
+#include <DirectXMath.h>
+
+
+namespace DX
+{
+    class OrbitCamera;
+
+    class CameraPath
+    {
+    public:
+        struct Keyframe
+        {
+            double              time;       // Seconds, strictly increasing
+            DirectX::XMFLOAT3   focus;
+            DirectX::XMFLOAT4   rotation;   // Quaternion
+            float               radius;
+        };
+
+        CameraPath() = default;
+
+        // Throws std::invalid_argument if there are no keyframes or their times are not strictly increasing
+        explicit CameraPath(std::vector<Keyframe> keyframes);
+
+        // Reads one keyframe per line as whitespace-separated numbers:
+        //
+        //   time focusX focusY focusZ rotationX rotationY rotationZ rotationW radius
+        //
+        // Blank lines and anything after '#' are ignored.
+        static CameraPath CreateFromFile(const std::filesystem::path& fileName);
+        static CameraPath CreateFromStream(std::istream& stream);
+
+        // Samples the path at time (seconds), holding the first and last keyframes outside their range.
+        // Focus and radius follow a Catmull-Rom spline, rotation a squad spline through the keyframe quaternions.
+        void Evaluate(double time, DirectX::XMVECTOR& focus, DirectX::XMVECTOR& rotation, float& radius) const;
+
+        // Sets the camera focus, rotation and radius to the path at time
+        void Apply(OrbitCamera& camera, double time, float minRadius = 1.f, float maxRadius = FLT_MAX) const;
+
+        // Returns the time of the last keyframe
+        double GetDuration() const noexcept { return m_keyframes.empty() ? 0. : m_keyframes.back().time; }
+
+        const std::vector<Keyframe>& GetKeyframes() const noexcept { return m_keyframes; }
+
+    private:
+        std::vector<Keyframe> m_keyframes;
+    };
+}
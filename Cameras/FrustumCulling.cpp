@@ -0,0 +1,456 @@
+//--------------------------------------------------------------------------------------
+// File: FrustumCulling.cpp
+//
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+//-------------------------------------------------------------------------------------
+
+#include "pch.h"
+#include "FrustumCulling.h"
+
+#include <bit>
+#include <stdexcept>
+#include <vector>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define FRUSTUM_CULLING_SSE
+#define FRUSTUM_CULLING_AVX
+#elif defined(_M_IX86) || defined(_M_X64) || defined(__SSE2__)
+#include <emmintrin.h>
+#define FRUSTUM_CULLING_SSE
+#endif
+
+using namespace DirectX;
+using namespace DX;
+
+namespace
+{
+	// Gribb & Hartmann: rows of the transposed matrix combine into the clip-space planes -w <= x, y <= w and 0 <= z <= w
+	inline void XM_CALLCONV ExtractPlanes(FXMMATRIX viewProjection, XMVECTOR(&planes)[6])
+	{
+		const XMMATRIX m = XMMatrixTranspose(viewProjection);
+
+		planes[0] = XMVectorAdd(m.r[3], m.r[0]);
+		planes[1] = XMVectorSubtract(m.r[3], m.r[0]);
+		planes[2] = XMVectorAdd(m.r[3], m.r[1]);
+		planes[3] = XMVectorSubtract(m.r[3], m.r[1]);
+		planes[4] = m.r[2];
+		planes[5] = XMVectorSubtract(m.r[3], m.r[2]);
+	}
+
+	inline bool IsSphereVisible(const FrustumPlanes& frustum, const BoundingSphere& sphere)
+	{
+		for (size_t i = 0; i < 6; ++i)
+		{
+			const float distance = frustum.x[i] * sphere.Center.x + frustum.y[i] * sphere.Center.y + frustum.z[i] * sphere.Center.z + frustum.w[i];
+			if (distance + sphere.Radius < 0.f)
+				return false;
+		}
+		return true;
+	}
+
+	inline bool IsBoxVisible(const FrustumPlanes& frustum, const BoundingBox& box)
+	{
+		for (size_t i = 0; i < 6; ++i)
+		{
+			// Distance of the corner furthest along the plane normal
+			const float distance = frustum.x[i] * box.Center.x + frustum.y[i] * box.Center.y + frustum.z[i] * box.Center.z + frustum.w[i]
+				+ fabsf(frustum.x[i]) * box.Extents.x + fabsf(frustum.y[i]) * box.Extents.y + fabsf(frustum.z[i]) * box.Extents.z;
+			if (distance < 0.f)
+				return false;
+		}
+		return true;
+	}
+
+#ifdef FRUSTUM_CULLING_SSE
+	// Loads four spheres { x, y, z, r } and transposes them to one register per component
+	inline void LoadSpheres(const BoundingSphere* spheres, __m128& x, __m128& y, __m128& z, __m128& r)
+	{
+		static_assert(sizeof(BoundingSphere) == 16, "Spheres are loaded as four floats");
+
+		x = _mm_loadu_ps(&spheres[0].Center.x);
+		y = _mm_loadu_ps(&spheres[1].Center.x);
+		z = _mm_loadu_ps(&spheres[2].Center.x);
+		r = _mm_loadu_ps(&spheres[3].Center.x);
+		_MM_TRANSPOSE4_PS(x, y, z, r);
+	}
+
+	// Loads four boxes { cx, cy, cz, ex, ey, ez } as six registers, then shuffles them to one register per component
+	inline void LoadBoxes(const BoundingBox* boxes, __m128& cx, __m128& cy, __m128& cz, __m128& ex, __m128& ey, __m128& ez)
+	{
+		static_assert(sizeof(BoundingBox) == 24, "Boxes are loaded as six floats");
+
+		const float* p = &boxes[0].Center.x;
+		const __m128 a = _mm_loadu_ps(p);      // c0x c0y c0z e0x
+		const __m128 b = _mm_loadu_ps(p + 4);  // e0y e0z c1x c1y
+		const __m128 c = _mm_loadu_ps(p + 8);  // c1z e1x e1y e1z
+		const __m128 d = _mm_loadu_ps(p + 12); // c2x c2y c2z e2x
+		const __m128 e = _mm_loadu_ps(p + 16); // e2y e2z c3x c3y
+		const __m128 f = _mm_loadu_ps(p + 20); // c3z e3x e3y e3z
+
+		cx = a;
+		cy = _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 0, 3, 2)); // c1x c1y c1z e1x
+		cz = d;
+		ex = _mm_shuffle_ps(e, f, _MM_SHUFFLE(1, 0, 3, 2)); // c3x c3y c3z e3x
+		_MM_TRANSPOSE4_PS(cx, cy, cz, ex);
+
+		const __m128 lo = _mm_shuffle_ps(b, c, _MM_SHUFFLE(3, 2, 1, 0)); // e0y e0z e1y e1z
+		const __m128 hi = _mm_shuffle_ps(e, f, _MM_SHUFFLE(3, 2, 1, 0)); // e2y e2z e3y e3z
+		ey = _mm_shuffle_ps(lo, hi, _MM_SHUFFLE(2, 0, 2, 0));
+		ez = _mm_shuffle_ps(lo, hi, _MM_SHUFFLE(3, 1, 3, 1));
+	}
+#endif
+
+#if defined(FRUSTUM_CULLING_AVX)
+	// Eight volumes per iteration, loaded as two groups of four
+	using Vector = __m256;
+
+	inline Vector Splat(float value) { return _mm256_set1_ps(value); }
+	inline Vector Add(Vector a, Vector b) { return _mm256_add_ps(a, b); }
+	inline Vector Multiply(Vector a, Vector b) { return _mm256_mul_ps(a, b); }
+	inline Vector Or(Vector a, Vector b) { return _mm256_or_ps(a, b); }
+	inline Vector Less(Vector a, Vector b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+	inline uint32_t MoveMask(Vector a) { return uint32_t(_mm256_movemask_ps(a)); }
+	inline Vector Load(const float* p) { return _mm256_loadu_ps(p); }
+	inline Vector Abs(Vector a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.f), a); }
+
+	inline Vector MultiplyAdd(Vector a, Vector b, Vector c)
+	{
+#ifdef __FMA__
+		return _mm256_fmadd_ps(a, b, c);
+#else
+		return _mm256_add_ps(_mm256_mul_ps(a, b), c);
+#endif
+	}
+
+	inline Vector Combine(__m128 lo, __m128 hi) { return _mm256_insertf128_ps(_mm256_castps128_ps256(lo), hi, 1); }
+
+	inline void LoadSpheres(const BoundingSphere* spheres, Vector& x, Vector& y, Vector& z, Vector& r)
+	{
+		__m128 x0, y0, z0, r0, x1, y1, z1, r1;
+		LoadSpheres(spheres, x0, y0, z0, r0);
+		LoadSpheres(spheres + 4, x1, y1, z1, r1);
+
+		x = Combine(x0, x1);
+		y = Combine(y0, y1);
+		z = Combine(z0, z1);
+		r = Combine(r0, r1);
+	}
+
+	inline void LoadBoxes(const BoundingBox* boxes, Vector& cx, Vector& cy, Vector& cz, Vector& ex, Vector& ey, Vector& ez)
+	{
+		__m128 cx0, cy0, cz0, ex0, ey0, ez0, cx1, cy1, cz1, ex1, ey1, ez1;
+		LoadBoxes(boxes, cx0, cy0, cz0, ex0, ey0, ez0);
+		LoadBoxes(boxes + 4, cx1, cy1, cz1, ex1, ey1, ez1);
+
+		cx = Combine(cx0, cx1);
+		cy = Combine(cy0, cy1);
+		cz = Combine(cz0, cz1);
+		ex = Combine(ex0, ex1);
+		ey = Combine(ey0, ey1);
+		ez = Combine(ez0, ez1);
+	}
+#elif defined(FRUSTUM_CULLING_SSE)
+	using Vector = __m128;
+
+	inline Vector Splat(float value) { return _mm_set1_ps(value); }
+	inline Vector Add(Vector a, Vector b) { return _mm_add_ps(a, b); }
+	inline Vector Multiply(Vector a, Vector b) { return _mm_mul_ps(a, b); }
+	inline Vector Or(Vector a, Vector b) { return _mm_or_ps(a, b); }
+	inline Vector Less(Vector a, Vector b) { return _mm_cmplt_ps(a, b); }
+	inline uint32_t MoveMask(Vector a) { return uint32_t(_mm_movemask_ps(a)); }
+	inline Vector Load(const float* p) { return _mm_loadu_ps(p); }
+	inline Vector Abs(Vector a) { return _mm_andnot_ps(_mm_set1_ps(-0.f), a); }
+	inline Vector MultiplyAdd(Vector a, Vector b, Vector c) { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+#endif
+
+#ifdef FRUSTUM_CULLING_SSE
+	constexpr size_t c_VectorWidth = sizeof(Vector) / sizeof(float);
+
+	// Plane components replicated across all lanes, with the absolute normals used by the box test
+	struct SplatPlanes
+	{
+		Vector x[6], y[6], z[6], w[6];
+		Vector ax[6], ay[6], az[6];
+
+		explicit SplatPlanes(const FrustumPlanes& frustum)
+		{
+			for (size_t i = 0; i < 6; ++i)
+			{
+				Set(i, frustum.x[i], frustum.y[i], frustum.z[i], frustum.w[i]);
+			}
+		}
+
+		SplatPlanes(const MultiViewFrustum& frustum, size_t view)
+		{
+			for (size_t i = 0; i < 6; ++i)
+			{
+				Set(i, frustum.x[i][view], frustum.y[i][view], frustum.z[i][view], frustum.w[i][view]);
+			}
+		}
+
+		void Set(size_t i, float px, float py, float pz, float pw)
+		{
+			x[i] = Splat(px);
+			y[i] = Splat(py);
+			z[i] = Splat(pz);
+			w[i] = Splat(pw);
+			ax[i] = Splat(fabsf(px));
+			ay[i] = Splat(fabsf(py));
+			az[i] = Splat(fabsf(pz));
+		}
+
+		// One bit per lane, set if the volume is inside or intersecting every plane
+		uint32_t TestSpheres(Vector cx, Vector cy, Vector cz, Vector r) const
+		{
+			const Vector zero = Splat(0.f);
+
+			Vector outside = zero;
+			for (size_t i = 0; i < 6; ++i)
+			{
+				const Vector distance = MultiplyAdd(cx, x[i], MultiplyAdd(cy, y[i], MultiplyAdd(cz, z[i], Add(w[i], r))));
+				outside = Or(outside, Less(distance, zero));
+			}
+			return ~MoveMask(outside) & ((1u << c_VectorWidth) - 1);
+		}
+
+		uint32_t TestBoxes(Vector cx, Vector cy, Vector cz, Vector ex, Vector ey, Vector ez) const
+		{
+			const Vector zero = Splat(0.f);
+
+			Vector outside = zero;
+			for (size_t i = 0; i < 6; ++i)
+			{
+				const Vector radius = MultiplyAdd(ex, ax[i], MultiplyAdd(ey, ay[i], Multiply(ez, az[i])));
+				const Vector distance = MultiplyAdd(cx, x[i], MultiplyAdd(cy, y[i], MultiplyAdd(cz, z[i], Add(w[i], radius))));
+				outside = Or(outside, Less(distance, zero));
+			}
+			return ~MoveMask(outside) & ((1u << c_VectorWidth) - 1);
+		}
+	};
+#endif
+
+	// One bit per view, set if the volume is inside or intersecting every plane of that view
+	inline uint32_t TestViews(const MultiViewFrustum& frustum, const BoundingSphere& sphere)
+	{
+		uint32_t mask = 0;
+		for (size_t v = 0; v < frustum.viewCount; ++v)
+		{
+			bool visible = true;
+			for (size_t i = 0; i < 6 && visible; ++i)
+			{
+				visible = frustum.x[i][v] * sphere.Center.x + frustum.y[i][v] * sphere.Center.y + frustum.z[i][v] * sphere.Center.z + frustum.w[i][v] + sphere.Radius >= 0.f;
+			}
+			mask |= uint32_t(visible) << v;
+		}
+		return mask;
+	}
+
+	inline uint32_t TestViews(const MultiViewFrustum& frustum, const BoundingBox& box)
+	{
+		uint32_t mask = 0;
+		for (size_t v = 0; v < frustum.viewCount; ++v)
+		{
+			bool visible = true;
+			for (size_t i = 0; i < 6 && visible; ++i)
+			{
+				visible = frustum.x[i][v] * box.Center.x + frustum.y[i][v] * box.Center.y + frustum.z[i][v] * box.Center.z + frustum.w[i][v]
+					+ fabsf(frustum.x[i][v]) * box.Extents.x + fabsf(frustum.y[i][v]) * box.Extents.y + fabsf(frustum.z[i][v]) * box.Extents.z >= 0.f;
+			}
+			mask |= uint32_t(visible) << v;
+		}
+		return mask;
+	}
+
+	inline void SetViewBits(uint32_t mask, size_t index, uint32_t* const* visibility)
+	{
+		for (; mask; mask &= mask - 1)
+		{
+			visibility[std::countr_zero(mask)][index >> 5] |= 1u << (index & 31);
+		}
+	}
+}
+
+FrustumPlanes XM_CALLCONV FrustumPlanes::CreateFromMatrix(FXMMATRIX viewProjection)
+{
+	XMVECTOR planes[6];
+	ExtractPlanes(viewProjection, planes);
+
+	FrustumPlanes result;
+	for (size_t i = 0; i < 6; ++i)
+	{
+		XMFLOAT4 plane;
+		XMStoreFloat4(&plane, XMPlaneNormalize(planes[i]));
+
+		result.x[i] = plane.x;
+		result.y[i] = plane.y;
+		result.z[i] = plane.z;
+		result.w[i] = plane.w;
+	}
+	return result;
+}
+
+void DX::CullSpheres(const FrustumPlanes& frustum, const BoundingSphere* spheres, size_t count, uint32_t* visibility)
+{
+	std::fill_n(visibility, (count + 31) / 32, 0u);
+
+	size_t i = 0;
+
+#ifdef FRUSTUM_CULLING_SSE
+	const SplatPlanes planes(frustum);
+
+	// The vector width divides 32, so every group lands within one visibility word
+	for (; i + c_VectorWidth <= count; i += c_VectorWidth)
+	{
+		Vector x, y, z, r;
+		LoadSpheres(spheres + i, x, y, z, r);
+
+		visibility[i >> 5] |= planes.TestSpheres(x, y, z, r) << (i & 31);
+	}
+#endif
+
+	for (; i < count; ++i)
+	{
+		if (IsSphereVisible(frustum, spheres[i]))
+			visibility[i >> 5] |= 1u << (i & 31);
+	}
+}
+
+void DX::CullBoxes(const FrustumPlanes& frustum, const BoundingBox* boxes, size_t count, uint32_t* visibility)
+{
+	std::fill_n(visibility, (count + 31) / 32, 0u);
+
+	size_t i = 0;
+
+#ifdef FRUSTUM_CULLING_SSE
+	const SplatPlanes planes(frustum);
+
+	for (; i + c_VectorWidth <= count; i += c_VectorWidth)
+	{
+		Vector cx, cy, cz, ex, ey, ez;
+		LoadBoxes(boxes + i, cx, cy, cz, ex, ey, ez);
+
+		visibility[i >> 5] |= planes.TestBoxes(cx, cy, cz, ex, ey, ez) << (i & 31);
+	}
+#endif
+
+	for (; i < count; ++i)
+	{
+		if (IsBoxVisible(frustum, boxes[i]))
+			visibility[i >> 5] |= 1u << (i & 31);
+	}
+}
+
+MultiViewFrustum MultiViewFrustum::CreateFromMatrices(const XMMATRIX* viewProjections, size_t viewCount)
+{
+	if (viewCount > c_MaxViews)
+		throw std::out_of_range("Too many views");
+
+	MultiViewFrustum result = {};
+	result.viewCount = viewCount;
+
+	for (size_t first = 0; first < viewCount; first += 4)
+	{
+		XMVECTOR planes[4][6];
+		for (size_t j = 0; j < 4; ++j)
+		{
+			if (first + j < viewCount)
+			{
+				ExtractPlanes(viewProjections[first + j], planes[j]);
+			}
+			else
+			{
+				// Padding views only need to stay well-defined through the normalization below
+				std::fill_n(planes[j], 6, g_XMIdentityR0);
+			}
+		}
+
+		for (size_t i = 0; i < 6; ++i)
+		{
+			const XMMATRIX rows{ planes[0][i], planes[1][i], planes[2][i], planes[3][i] };
+
+			// Plane i of four views as rows, transposed to one register per component and normalized together
+			const XMMATRIX components = XMMatrixTranspose(rows);
+			const XMVECTOR length = XMVectorSqrt(XMVectorMultiplyAdd(components.r[0], components.r[0],
+				XMVectorMultiplyAdd(components.r[1], components.r[1], XMVectorMultiply(components.r[2], components.r[2]))));
+
+			XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(&result.x[i][first]), XMVectorDivide(components.r[0], length));
+			XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(&result.y[i][first]), XMVectorDivide(components.r[1], length));
+			XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(&result.z[i][first]), XMVectorDivide(components.r[2], length));
+			XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(&result.w[i][first]), XMVectorDivide(components.r[3], length));
+		}
+	}
+	return result;
+}
+
+void DX::CullSpheres(const MultiViewFrustum& frustum, const BoundingSphere* spheres, size_t count, uint32_t* const* visibility)
+{
+	for (size_t v = 0; v < frustum.viewCount; ++v)
+	{
+		std::fill_n(visibility[v], (count + 31) / 32, 0u);
+	}
+
+	size_t i = 0;
+
+#ifdef FRUSTUM_CULLING_SSE
+	std::vector<SplatPlanes> planes;
+	planes.reserve(frustum.viewCount);
+	for (size_t v = 0; v < frustum.viewCount; ++v)
+	{
+		planes.emplace_back(frustum, v);
+	}
+
+	// Each group is loaded and transposed once, then tested against every view while it stays in registers
+	for (; i + c_VectorWidth <= count; i += c_VectorWidth)
+	{
+		Vector x, y, z, r;
+		LoadSpheres(spheres + i, x, y, z, r);
+
+		for (size_t v = 0; v < frustum.viewCount; ++v)
+		{
+			visibility[v][i >> 5] |= planes[v].TestSpheres(x, y, z, r) << (i & 31);
+		}
+	}
+#endif
+
+	for (; i < count; ++i)
+	{
+		SetViewBits(TestViews(frustum, spheres[i]), i, visibility);
+	}
+}
+
+void DX::CullBoxes(const MultiViewFrustum& frustum, const BoundingBox* boxes, size_t count, uint32_t* const* visibility)
+{
+	for (size_t v = 0; v < frustum.viewCount; ++v)
+	{
+		std::fill_n(visibility[v], (count + 31) / 32, 0u);
+	}
+
+	size_t i = 0;
+
+#ifdef FRUSTUM_CULLING_SSE
+	std::vector<SplatPlanes> planes;
+	planes.reserve(frustum.viewCount);
+	for (size_t v = 0; v < frustum.viewCount; ++v)
+	{
+		planes.emplace_back(frustum, v);
+	}
+
+	for (; i + c_VectorWidth <= count; i += c_VectorWidth)
+	{
+		Vector cx, cy, cz, ex, ey, ez;
+		LoadBoxes(boxes + i, cx, cy, cz, ex, ey, ez);
+
+		for (size_t v = 0; v < frustum.viewCount; ++v)
+		{
+			visibility[v][i >> 5] |= planes[v].TestBoxes(cx, cy, cz, ex, ey, ez) << (i & 31);
+		}
+	}
+#endif
+
+	for (; i < count; ++i)
+	{
+		SetViewBits(TestViews(frustum, boxes[i]), i, visibility);
+	}
+}
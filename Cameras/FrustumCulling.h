@@ -0,0 +1,63 @@
+//--------------------------------------------------------------------------------------
+// File: FrustumCulling.h
+//
+// Batch frustum tests for bounding volumes
+//
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+//-------------------------------------------------------------------------------------
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <DirectXMath.h>
+
+
+namespace DirectX
+{
+    struct BoundingSphere;
+    struct BoundingBox;
+}
+
+namespace DX
+{
+    // Six inward-facing planes (left, right, bottom, top, near, far) in structure-of-arrays form:
+    // a point p is inside plane i when x[i] * p.x + y[i] * p.y + z[i] * p.z + w[i] >= 0
+    struct FrustumPlanes
+    {
+        float x[6];
+        float y[6];
+        float z[6];
+        float w[6];
+
+        // Extracts normalized planes from a view-projection matrix with depth in [0, 1], left- or right-handed
+        static FrustumPlanes XM_CALLCONV CreateFromMatrix(DirectX::FXMMATRIX viewProjection);
+    };
+
+    // Tests count volumes against the frustum and writes one bit per volume, set if it may be visible,
+    // into visibility[0 .. (count + 31) / 32). Uses AVX when compiled for it, SSE2 otherwise.
+    void CullSpheres(const FrustumPlanes& frustum, const DirectX::BoundingSphere* spheres, size_t count, uint32_t* visibility);
+    void CullBoxes(const FrustumPlanes& frustum, const DirectX::BoundingBox* boxes, size_t count, uint32_t* visibility);
+
+    // Frustum planes of several views, laid out so that one SIMD register holds the same plane component for consecutive views:
+    // view v is inside plane i when x[i][v] * p.x + y[i][v] * p.y + z[i][v] * p.z + w[i][v] >= 0
+    struct MultiViewFrustum
+    {
+        static constexpr size_t c_MaxViews = 8;
+
+        float x[6][c_MaxViews];
+        float y[6][c_MaxViews];
+        float z[6][c_MaxViews];
+        float w[6][c_MaxViews];
+        size_t viewCount;
+
+        // Extracts and normalizes the planes of all views together, four views per SIMD operation
+        static MultiViewFrustum CreateFromMatrices(const DirectX::XMMATRIX* viewProjections, size_t viewCount);
+    };
+
+    // Tests each volume once against every view, writing visibility bits for view v into visibility[v][0 .. (count + 31) / 32)
+    void CullSpheres(const MultiViewFrustum& frustum, const DirectX::BoundingSphere* spheres, size_t count, uint32_t* const* visibility);
+    void CullBoxes(const MultiViewFrustum& frustum, const DirectX::BoundingBox* boxes, size_t count, uint32_t* const* visibility);
+}
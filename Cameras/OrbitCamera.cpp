@@ -273,7 +273,7 @@ public:
 		}
 	}
 
-	void Update(float elapsedTime, Mouse& mouse, Keyboard& kb)
+	void Update(float elapsedTime, const Mouse::State& mstate, const Keyboard::State& kbstate, Mouse* mouse)
 	{
 		using namespace DirectX::SimpleMath;
 
@@ -281,9 +281,6 @@ public:
 
 		Matrix im = XMMatrixInverse(nullptr, GetView());
 
-		auto mstate = mouse.GetState();
-		auto kbstate = kb.GetState();
-
 		if ((mstate.positionMode != Mouse::MODE_RELATIVE) && !m_arcBall.IsDragging())
 		{
 			// Keyboard controls
@@ -439,10 +436,13 @@ public:
 
 		if (!m_arcBall.IsDragging())
 		{
-			if (mstate.rightButton && mstate.positionMode == Mouse::MODE_ABSOLUTE)
-				mouse.SetMode(Mouse::MODE_RELATIVE);
-			else if (!mstate.rightButton && mstate.positionMode == Mouse::MODE_RELATIVE)
-				mouse.SetMode(Mouse::MODE_ABSOLUTE);
+			if (mouse)
+			{
+				if (mstate.rightButton && mstate.positionMode == Mouse::MODE_ABSOLUTE)
+					mouse->SetMode(Mouse::MODE_RELATIVE);
+				else if (!mstate.rightButton && mstate.positionMode == Mouse::MODE_RELATIVE)
+					mouse->SetMode(Mouse::MODE_ABSOLUTE);
+			}
 
 			if (mstate.leftButton)
 			{
@@ -461,7 +461,7 @@ public:
 		m_radius = m_defaultRadius;
 		m_cameraRotation = m_homeRotation;
 		m_sensitivity = m_defaultSensitivity;
-		m_viewDirty = m_projDirty = true;
+		m_viewDirty = m_projDirty = m_frustumDirty = true;
 		m_arcBall.Reset();
 		m_arcBall.OnEnd();
 	}
@@ -469,6 +469,7 @@ public:
 	mutable XMMATRIX        m_view;
 	mutable XMMATRIX        m_projection;
 	mutable XMVECTOR        m_cameraPosition;
+	mutable FrustumPlanes   m_frustum;
 
 	XMVECTOR                m_focus;
 	XMVECTOR                m_homeFocus;
@@ -495,6 +496,7 @@ public:
 	bool                    m_lhcoords;
 	mutable bool            m_viewDirty;
 	mutable bool            m_projDirty;
+	mutable bool            m_frustumDirty;
 
 	int                     m_width;
 	int                     m_height;
@@ -506,20 +508,9 @@ public:
 	XMMATRIX GetView() const
 	{
 		m_viewDirty = false;
+		m_frustumDirty = true;
 
-		XMVECTOR dir = XMVector3Rotate((m_lhcoords) ? g_XMNegIdentityR2 : g_XMIdentityR2, m_cameraRotation);
-		XMVECTOR up = XMVector3Rotate(g_XMIdentityR1, m_cameraRotation);
-
-		m_cameraPosition = XMVectorAdd(m_focus, XMVectorScale(dir, m_radius));
-
-		if (m_lhcoords)
-		{
-			m_view = XMMatrixLookAtLH(m_cameraPosition, m_focus, up);
-		}
-		else
-		{
-			m_view = XMMatrixLookAtRH(m_cameraPosition, m_focus, up);
-		}
+		m_view = OrbitCameraState::ComputeView(m_focus, m_cameraRotation, m_radius, m_lhcoords, &m_cameraPosition);
 
 		return m_view;
 	}
@@ -527,6 +518,7 @@ public:
 	XMMATRIX GetProjection() const
 	{
 		m_projDirty = false;
+		m_frustumDirty = true;
 
 		float aspectRatio = (m_height > 0.f) ? (float(m_width) / float(m_height)) : 1.f;
 
@@ -563,7 +555,12 @@ void OrbitCamera::Update(float elapsedTime, const GamePad::State & pad)
 
 void OrbitCamera::Update(float elapsedTime, Mouse & mouse, Keyboard & kb)
 {
-	pImpl->Update(elapsedTime, mouse, kb);
+	pImpl->Update(elapsedTime, mouse.GetState(), kb.GetState(), &mouse);
+}
+
+void OrbitCamera::Update(float elapsedTime, const Mouse::State & mouseState, const Keyboard::State & kbState, Mouse * mouse)
+{
+	pImpl->Update(elapsedTime, mouseState, kbState, mouse);
 }
 
 void OrbitCamera::Reset()
@@ -687,11 +684,56 @@ XMMATRIX OrbitCamera::GetProjection() const
 	}
 }
 
+const FrustumPlanes& OrbitCamera::GetFrustum() const
+{
+	if (pImpl->m_viewDirty || pImpl->m_projDirty || pImpl->m_frustumDirty)
+	{
+		XMMATRIX viewProjection = XMMatrixMultiply(GetView(), GetProjection());
+		pImpl->m_frustum = FrustumPlanes::CreateFromMatrix(viewProjection);
+		pImpl->m_frustumDirty = false;
+	}
+	return pImpl->m_frustum;
+}
+
+void OrbitCamera::CullSpheres(const DirectX::BoundingSphere* spheres, size_t count, uint32_t* visibility) const
+{
+	DX::CullSpheres(GetFrustum(), spheres, count, visibility);
+}
+
+void OrbitCamera::CullBoxes(const DirectX::BoundingBox* boxes, size_t count, uint32_t* visibility) const
+{
+	DX::CullBoxes(GetFrustum(), boxes, count, visibility);
+}
+
 XMVECTOR OrbitCamera::GetFocus() const
 {
 	return pImpl->m_focus;
 }
 
+XMVECTOR OrbitCamera::GetRotation() const
+{
+	return pImpl->m_cameraRotation;
+}
+
+float OrbitCamera::GetRadius() const
+{
+	return pImpl->m_radius;
+}
+
+OrbitCameraState OrbitCamera::GetState() const
+{
+	OrbitCameraState state;
+	XMStoreFloat3(&state.focus, pImpl->m_focus);
+	XMStoreFloat4(&state.rotation, pImpl->m_cameraRotation);
+	state.radius = pImpl->m_radius;
+	return state;
+}
+
+XMMATRIX OrbitCamera::GetView(const OrbitCameraState& state, XMVECTOR* position) const
+{
+	return state.GetView(pImpl->m_lhcoords, position);
+}
+
 XMVECTOR OrbitCamera::GetPosition() const
 {
 	if (pImpl->m_viewDirty)
@@ -12,13 +12,15 @@
 #include <memory>
 
 #include "GamePad.h"
+#include "Keyboard.h"
+#include "Mouse.h"
+
+#include "FrustumCulling.h"
+#include "OrbitCameraState.h"
 
 
 namespace DirectX
 {
-    class Keyboard;
-    class Mouse;
-
     struct BoundingSphere;
     struct BoundingBox;
 }
@@ -63,6 +65,13 @@ namespace DX
         //
         void Update(float elapsedTime, DirectX::Mouse& mouse, DirectX::Keyboard& kb);
 
+        // Perform per-frame update using previously captured keyboard & mouse states (e.g. replayed input)
+        //
+        // Same controls as above. If mouse is not null, it is switched between absolute and relative mode
+        // for translation as above; otherwise the caller is responsible for the mode of the captured states.
+        //
+        void Update(float elapsedTime, const DirectX::Mouse::State& mouseState, const DirectX::Keyboard::State& kbState, DirectX::Mouse* mouse = nullptr);
+
         // Reset camera to default view
         void Reset();
 
@@ -110,9 +119,26 @@ namespace DX
         DirectX::XMMATRIX GetView() const;
         DirectX::XMMATRIX GetProjection() const;
 
+        // Returns world-space frustum planes, recomputed only after the view or projection changes
+        const FrustumPlanes& GetFrustum() const;
+
+        // Tests world-space bounds against GetFrustum(), writing one visibility bit per volume (see FrustumCulling.h)
+        void CullSpheres(const DirectX::BoundingSphere* spheres, size_t count, uint32_t* visibility) const;
+        void CullBoxes(const DirectX::BoundingBox* boxes, size_t count, uint32_t* visibility) const;
+
+        // Returns view matrix for a captured or interpolated state, with this camera's handedness, and optionally its camera position
+        DirectX::XMMATRIX GetView(const OrbitCameraState& state, DirectX::XMVECTOR* position = nullptr) const;
+
         // Returns the current focus point
         DirectX::XMVECTOR GetFocus() const;
 
+        // Returns the current rotation quaternion and orbit radius
+        DirectX::XMVECTOR GetRotation() const;
+        float GetRadius() const;
+
+        // Returns the current focus, rotation and radius
+        OrbitCameraState GetState() const;
+
         // Returns the current camera position
         DirectX::XMVECTOR GetPosition() const;
 
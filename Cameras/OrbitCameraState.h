@@ -0,0 +1,76 @@
+//--------------------------------------------------------------------------------------
+// File: OrbitCameraState.h
+//
+// The part of an OrbitCamera that determines its view
+//
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+//-------------------------------------------------------------------------------------
+
+#pragma once
+
+#include <DirectXMath.h>
+
+
+namespace DX
+{
+    // Focus, rotation and radius of an orbit camera, e.g. for rendering between fixed-timestep updates or without an OrbitCamera
+    struct OrbitCameraState
+    {
+        DirectX::XMFLOAT3   focus;
+        DirectX::XMFLOAT4   rotation;
+        float               radius;
+
+        // Linear for focus and radius, spherical for rotation; t of 0 or 1 returns from or to unchanged
+        static OrbitCameraState Lerp(const OrbitCameraState& from, const OrbitCameraState& to, float t)
+        {
+            using namespace DirectX;
+
+            // The ends are returned as-is so that an interpolation factor of 0 or 1 reproduces an update exactly
+            if (t <= 0.f)
+            {
+                return from;
+            }
+            if (t >= 1.f)
+            {
+                return to;
+            }
+
+            OrbitCameraState state;
+            XMStoreFloat3(&state.focus, XMVectorLerp(XMLoadFloat3(&from.focus), XMLoadFloat3(&to.focus), t));
+            XMStoreFloat4(&state.rotation, XMQuaternionSlerp(XMLoadFloat4(&from.rotation), XMLoadFloat4(&to.rotation), t));
+            state.radius = from.radius + (to.radius - from.radius) * t;
+            return state;
+        }
+
+        // Looks at focus from radius away along the rotated +z axis (-z with left-handed coordinates), with the rotated +y axis up
+        static DirectX::XMMATRIX XM_CALLCONV ComputeView(DirectX::FXMVECTOR focus, DirectX::FXMVECTOR rotation, float radius,
+            bool lhcoords, DirectX::XMVECTOR* position = nullptr)
+        {
+            using namespace DirectX;
+
+            XMVECTOR dir = XMVector3Rotate((lhcoords) ? g_XMNegIdentityR2 : g_XMIdentityR2, rotation);
+            XMVECTOR up = XMVector3Rotate(g_XMIdentityR1, rotation);
+
+            XMVECTOR eye = XMVectorAdd(focus, XMVectorScale(dir, radius));
+            if (position)
+            {
+                *position = eye;
+            }
+
+            if (lhcoords)
+            {
+                return XMMatrixLookAtLH(eye, focus, up);
+            }
+            else
+            {
+                return XMMatrixLookAtRH(eye, focus, up);
+            }
+        }
+
+        DirectX::XMMATRIX GetView(bool lhcoords, DirectX::XMVECTOR* position = nullptr) const
+        {
+            return ComputeView(DirectX::XMLoadFloat3(&focus), DirectX::XMLoadFloat4(&rotation), radius, lhcoords, position);
+        }
+    };
+}
@@ -0,0 +1,37 @@
+/*
+ * Header File: AllocationCounter.h
+ * Last Update: 2026/10/18
+ *
+ * Copyright (C) Hydr10n@GitHub. All Rights Reserved.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace Hydr10n::Benchmarks {
+	/*
+	 * Counts global operator new calls in executables that replace it to call Record, such as the test runner, which
+	 * also set IsAvailable. Elsewhere the counts stay at zero.
+	 */
+	struct AllocationCounter {
+		struct Counts {
+			uint64_t AllocationCount, AllocatedBytes;
+
+			Counts operator-(const Counts& rhs) const { return { AllocationCount - rhs.AllocationCount, AllocatedBytes - rhs.AllocatedBytes }; }
+		};
+
+		static inline std::atomic<bool> IsAvailable;
+
+		static void Record(size_t size) noexcept {
+			s_allocationCount.fetch_add(1, std::memory_order_relaxed);
+			s_allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+		}
+
+		static Counts GetCounts() noexcept { return { s_allocationCount.load(std::memory_order_relaxed), s_allocatedBytes.load(std::memory_order_relaxed) }; }
+
+	private:
+		static inline std::atomic<uint64_t> s_allocationCount, s_allocatedBytes;
+	};
+}
@@ -1,11 +1,62 @@
 #include "MainWindow.h"
 
+#include <shellapi.h>
+
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <string_view>
+
 // Indicate to hybrid graphics systems to prefer the discrete part by default
 extern "C" {
 	__declspec(dllexport) DWORD NvOptimusEnablement = 1;
 	__declspec(dllexport) int AmdPowerXpressRequestHighPerformance = 1;
 }
 
+// Usage: "Mesh Demo.exe" [-record <input log>] [-replay <input log>] [-benchmark <camera path> <timings CSV>] [-updaterate <Hz>] [-maxfps <Hz>]
+static D3DApp::LaunchOptions ParseCommandLine() {
+	struct LocalDeleter { void operator()(LPWSTR* p) const { LocalFree(p); } };
+
+	int argc;
+	const std::unique_ptr<LPWSTR, LocalDeleter> argv(CommandLineToArgvW(GetCommandLineW(), &argc));
+	if (!argv) ErrorHelpers::throw_std_system_error(GetLastError(), "CommandLineToArgvW");
+
+	D3DApp::LaunchOptions options;
+
+	// Next to the executable, so that every working directory shares one cache.
+	std::wstring modulePath(MAX_PATH, L'\0');
+	for (;;) {
+		const auto length = GetModuleFileNameW(nullptr, modulePath.data(), static_cast<DWORD>(modulePath.size()));
+		if (!length) ErrorHelpers::throw_std_system_error(GetLastError(), "GetModuleFileNameW");
+		if (length < modulePath.size()) {
+			modulePath.resize(length);
+			break;
+		}
+		modulePath.resize(modulePath.size() * 2);
+	}
+	options.PipelineCachePath = std::filesystem::path(modulePath).replace_filename(L"PipelineCache.bin");
+
+	for (int i = 1; i < argc; i++) {
+		const std::wstring_view option = argv.get()[i];
+		if (i + 1 < argc && option == L"-record") options.InputRecordPath = argv.get()[++i];
+		else if (i + 1 < argc && option == L"-replay") options.InputReplayPath = argv.get()[++i];
+		else if (i + 2 < argc && option == L"-benchmark") {
+			options.BenchmarkCameraPath = argv.get()[++i];
+			options.BenchmarkTimingsPath = argv.get()[++i];
+		}
+		else if (i + 1 < argc && option == L"-updaterate") {
+			options.UpdateRate = std::wcstod(argv.get()[++i], nullptr);
+			if (!(options.UpdateRate > 0)) throw std::invalid_argument("Update rate must be positive");
+		}
+		else if (i + 1 < argc && option == L"-maxfps") {
+			options.FrameRateLimit = std::wcstod(argv.get()[++i], nullptr);
+			if (!(options.FrameRateLimit > 0)) throw std::invalid_argument("Frame rate limit must be positive");
+		}
+		else throw std::invalid_argument("Usage: [-record <input log>] [-replay <input log>] [-benchmark <camera path> <timings CSV>] [-updaterate <Hz>] [-maxfps <Hz>]");
+	}
+	return options;
+}
+
 int APIENTRY wWinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE, _In_ LPWSTR lpCmdLine, _In_ int nCmdShow) {
 	if (!DirectX::XMVerifyCPUSupport()) {
 		MessageBoxA(nullptr, "DirectXMath is not supported", nullptr, MB_OK | MB_ICONERROR);
@@ -17,7 +68,7 @@ int APIENTRY wWinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE, _In_ LPWSTR
 		Microsoft::WRL::Wrappers::RoInitializeWrapper roInitializeWrapper(RO_INIT_MULTITHREADED);
 		DX::ThrowIfFailed(roInitializeWrapper);
 
-		ret = static_cast<int>(MainWindow().Run());
+		ret = static_cast<int>(MainWindow(ParseCommandLine()).Run());
 	}
 	catch (const std::system_error& e) {
 		ret = e.code().value();
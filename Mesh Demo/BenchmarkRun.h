@@ -0,0 +1,78 @@
+/*
+ * Header File: BenchmarkRun.h
+ * Last Update: 2026/10/18
+ *
+ * Copyright (C) Hydr10n@GitHub. All Rights Reserved.
+ */
+
+#pragma once
+
+#include "CameraPath.h"
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+namespace Hydr10n::Benchmarks {
+	enum class FrameStage { Update, Cull, Draw, Present, Count };
+
+	constexpr const char* FrameStageNames[]{ "Update", "Cull", "Draw", "Present" };
+
+	// Plays a camera path and collects the CPU time each frame spends in every stage.
+	class BenchmarkRun {
+	public:
+		using Clock = std::chrono::steady_clock;
+
+		struct FrameTimings { Clock::duration Stages[static_cast<size_t>(FrameStage::Count)]; };
+
+		BenchmarkRun(DX::CameraPath cameraPath, std::filesystem::path timingsPath) noexcept(false) :
+			m_cameraPath(std::move(cameraPath)), m_timingsPath(std::move(timingsPath)) {}
+
+		const DX::CameraPath& GetCameraPath() const { return m_cameraPath; }
+
+		const std::filesystem::path& GetTimingsPath() const { return m_timingsPath; }
+
+		bool IsFinished(double totalSeconds) const { return totalSeconds >= m_cameraPath.GetDuration(); }
+
+		const std::vector<FrameTimings>& GetFrameTimings() const { return m_frameTimings; }
+
+		// A stage may be measured several times per frame, e.g. Update under a fixed timestep; the times add up.
+		template <class Function>
+		void Measure(FrameStage stage, const Function& function) {
+			const auto start = Clock::now();
+			function();
+			m_currentFrameTimings.Stages[static_cast<size_t>(stage)] += Clock::now() - start;
+		}
+
+		void EndFrame() {
+			m_frameTimings.push_back(m_currentFrameTimings);
+			m_currentFrameTimings = {};
+		}
+
+		// One CSV row per frame with the time of each stage in milliseconds.
+		void WriteTimings() const {
+			std::ofstream file(m_timingsPath, std::ios::trunc);
+			if (!file) throw std::runtime_error("Failed to create benchmark timings file");
+
+			file << "Frame";
+			for (const auto name : FrameStageNames) file << ',' << name;
+			file << '\n';
+			for (size_t i = 0; i < m_frameTimings.size(); i++) {
+				file << i;
+				for (const auto& duration : m_frameTimings[i].Stages) file << ',' << std::chrono::duration<double, std::milli>(duration).count();
+				file << '\n';
+			}
+
+			if (!file) throw std::runtime_error("Failed to write benchmark timings file");
+		}
+
+	private:
+		DX::CameraPath m_cameraPath;
+		std::filesystem::path m_timingsPath;
+
+		FrameTimings m_currentFrameTimings{};
+		std::vector<FrameTimings> m_frameTimings;
+	};
+}
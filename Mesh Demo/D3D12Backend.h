@@ -0,0 +1,315 @@
+/*
+ * Header File: D3D12Backend.h
+ * Last Update: 2026/10/18
+ *
+ * Copyright (C) Hydr10n@GitHub. All Rights Reserved.
+ */
+
+#pragma once
+
+#include "RenderBackend.h"
+
+#include "DeviceResources.h"
+#include "GraphicsMemory.h"
+
+#include "CommonStates.h"
+#include "EffectPipelineStateDescription.h"
+#include "VertexTypes.h"
+
+#include "MeshEffectPS.inc"
+#include "MeshEffectVS.inc"
+
+#include <memory>
+#include <vector>
+
+namespace Hydr10n::Rendering {
+	class D3D12CommandQueue : public ICommandQueue {
+	public:
+		D3D12CommandQueue(ID3D12Device* device, ID3D12CommandQueue* commandQueue) noexcept(false) : m_commandQueue(commandQueue) {
+			DX::ThrowIfFailed(device->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&m_fence)));
+
+			m_fenceEvent.Attach(CreateEventExW(nullptr, nullptr, 0, EVENT_MODIFY_STATE | SYNCHRONIZE));
+			if (!m_fenceEvent.IsValid()) ErrorHelpers::throw_std_system_error(GetLastError(), "CreateEventEx");
+		}
+
+		uint64_t Signal() override {
+			DX::ThrowIfFailed(m_commandQueue->Signal(m_fence.Get(), ++m_fenceValue));
+			return m_fenceValue;
+		}
+
+		uint64_t GetCompletedValue() const override { return m_fence->GetCompletedValue(); }
+
+		void WaitForValue(uint64_t fenceValue) override {
+			if (m_fence->GetCompletedValue() >= fenceValue) return;
+
+			DX::ThrowIfFailed(m_fence->SetEventOnCompletion(fenceValue, m_fenceEvent.Get()));
+			WaitForSingleObjectEx(m_fenceEvent.Get(), INFINITE, FALSE);
+		}
+
+	private:
+		ID3D12CommandQueue* m_commandQueue;
+
+		Microsoft::WRL::ComPtr<ID3D12Fence> m_fence;
+		uint64_t m_fenceValue{};
+		Microsoft::WRL::Wrappers::Event m_fenceEvent;
+	};
+
+	/*
+	 * Renders through DX::DeviceResources, which keeps owning the device, swap chain and frame fences. Every draw is lit
+	 * like BasicEffect with default lighting by the shaders of MeshEffect.hlsli, with one pipeline state per topology from
+	 * DeviceResources' pipeline state cache.
+	 * Effect constants are written to DeviceResources' upload ring and bound as a root CBV.
+	 * Device-dependent: destroy it when the device is lost and create it again once restored.
+	 */
+	class D3D12Device : public IDevice {
+	public:
+		static constexpr int PrimitiveTopologyCount = 3;
+
+		// Without effects, CreateEffect must be called for every topology before the first frame.
+		explicit D3D12Device(DX::DeviceResources& deviceResources, bool createEffects = true) noexcept(false) :
+			m_deviceResources(deviceResources),
+			m_graphicsMemory(std::make_unique<decltype(m_graphicsMemory)::element_type>(deviceResources.GetD3DDevice())),
+			m_commandQueue(deviceResources.GetD3DDevice(), deviceResources.GetCommandQueue()),
+			m_commandList(*this),
+			m_rootSignatureKey(DX::HashBuilder().AddBytes(g_MeshEffectVS, sizeof(g_MeshEffectVS)).GetHash()) {
+			DX::ThrowIfFailed(deviceResources.GetD3DDevice()->CreateRootSignature(0, g_MeshEffectVS, sizeof(g_MeshEffectVS), IID_PPV_ARGS(&m_rootSignature)));
+
+			if (createEffects) {
+				for (int i = 0; i < PrimitiveTopologyCount; i++) CreateEffect(static_cast<PrimitiveTopology>(i));
+			}
+		}
+
+		~D3D12Device() override {
+			for (const auto& buffer : m_buffers) m_deviceResources.GetResourceStates().Forget(buffer.Resource.Get());
+		}
+
+		// Compiling the pipeline state dominates, unless DeviceResources' pipeline state cache has it from an earlier run;
+		// different topologies may be created on different threads at once.
+		void CreateEffect(PrimitiveTopology topology) {
+			using namespace DirectX;
+
+			const RenderTargetState rtState(m_deviceResources.GetBackBufferFormat(), m_deviceResources.GetDepthBufferFormat());
+
+			const EffectPipelineStateDescription psd(
+				&VertexPositionNormal::InputLayout, CommonStates::Opaque, CommonStates::DepthDefault, CommonStates::CullNone, rtState,
+				topology == PrimitiveTopology::LineList ? D3D12_PRIMITIVE_TOPOLOGY_TYPE_LINE : D3D12_PRIMITIVE_TOPOLOGY_TYPE_TRIANGLE,
+				topology == PrimitiveTopology::TriangleStrip ? D3D12_INDEX_BUFFER_STRIP_CUT_VALUE_0xFFFFFFFF : D3D12_INDEX_BUFFER_STRIP_CUT_VALUE_DISABLED
+			);
+
+			auto desc = psd.GetDesc();
+			desc.pRootSignature = m_rootSignature.Get();
+			desc.VS = { g_MeshEffectVS, sizeof(g_MeshEffectVS) };
+			desc.PS = { g_MeshEffectPS, sizeof(g_MeshEffectPS) };
+
+			auto& pipelineState = m_pipelineStates[static_cast<int>(topology)];
+			if (const auto pipelineStateCache = m_deviceResources.GetPipelineStateCache()) pipelineState = pipelineStateCache->GetOrCreate(desc, m_rootSignatureKey);
+			else DX::ThrowIfFailed(m_deviceResources.GetD3DDevice()->CreateGraphicsPipelineState(&desc, IID_PPV_ARGS(pipelineState.ReleaseAndGetAddressOf())));
+		}
+
+		// The upload is submitted to DeviceResources' copy queue at once, so it runs while the CPU carries on; the first frame
+		// that binds the buffer waits for it on the GPU.
+		BufferHandle CreateBuffer(BufferType, const void* data, size_t size) override {
+			Buffer buffer{ nullptr, static_cast<uint32_t>(size), 0 };
+
+			const CD3DX12_HEAP_PROPERTIES heapProperties(D3D12_HEAP_TYPE_DEFAULT);
+			const auto resourceDesc = CD3DX12_RESOURCE_DESC::Buffer(size);
+			DX::ThrowIfFailed(m_deviceResources.GetD3DDevice()->CreateCommittedResource(&heapProperties, D3D12_HEAP_FLAG_NONE, &resourceDesc, D3D12_RESOURCE_STATE_COMMON, nullptr, IID_PPV_ARGS(&buffer.Resource)));
+
+			buffer.Upload = m_deviceResources.UploadBuffer(buffer.Resource.Get(), data, size);
+			m_deviceResources.SubmitUploads();
+
+			m_deviceResources.GetResourceStates().SetState(buffer.Resource.Get(), D3D12_RESOURCE_STATE_COMMON, DX::ResourcePromotion::Any);
+
+			m_buffers.push_back(std::move(buffer));
+			return static_cast<BufferHandle>(m_buffers.size() - 1);
+		}
+
+		bool IsBufferReady(BufferHandle buffer) const { return m_deviceResources.IsUploadComplete(m_buffers.at(buffer).Upload); }
+
+		D3D12CommandQueue& GetCommandQueue() override { return m_commandQueue; }
+
+		OutputSize GetOutputSize() const override {
+			const auto rc = m_deviceResources.GetOutputSize();
+			return { static_cast<uint32_t>(rc.right - rc.left), static_cast<uint32_t>(rc.bottom - rc.top) };
+		}
+
+		// DeviceResources waits for the back buffer in Present, so it is free by now.
+		ICommandList& BeginFrame() override {
+			m_deviceResources.Prepare();
+
+			const auto commandList = m_deviceResources.GetCommandList();
+
+			const auto rtvDescriptor = m_deviceResources.GetRenderTargetView(), dsvDescriptor = m_deviceResources.GetDepthStencilView();
+			commandList->OMSetRenderTargets(1, &rtvDescriptor, FALSE, &dsvDescriptor);
+			commandList->SetGraphicsRootSignature(m_rootSignature.Get());
+
+			m_commandList.Reset();
+			return m_commandList;
+		}
+
+		void Present() override {
+			m_deviceResources.Present();
+
+			m_graphicsMemory->Commit(m_deviceResources.GetCommandQueue());
+		}
+
+	private:
+		// Buffers stay in the common state, which they decay to after the copy queue has written them; every frame promotes
+		// them to the states it uses them in without barriers, and they decay again once it has executed.
+		struct Buffer {
+			Microsoft::WRL::ComPtr<ID3D12Resource> Resource;
+			uint32_t Size;
+			DX::UploadTicket Upload;
+		};
+
+		// The constant buffer of MeshEffect.hlsli.
+		struct MeshEffectConstants {
+			DirectX::XMFLOAT4X4 WorldViewProjection, WorldInverseTranspose;
+			DirectX::XMFLOAT3 DiffuseColor;
+			float Alpha;
+			DirectX::XMFLOAT3 EmissiveColor;
+			float Padding;
+		};
+
+		static MeshEffectConstants GetMeshEffectConstants(const EffectConstants& constants) {
+			using namespace DirectX;
+
+			const auto world = XMLoadFloat4x4(&constants.World);
+			const auto diffuseColor = XMLoadFloat4(&constants.DiffuseColor);
+			const auto alpha = constants.DiffuseColor.w;
+
+			MeshEffectConstants meshEffectConstants{};
+			XMStoreFloat4x4(&meshEffectConstants.WorldViewProjection, world * XMLoadFloat4x4(&constants.View) * XMLoadFloat4x4(&constants.Projection));
+			XMStoreFloat4x4(&meshEffectConstants.WorldInverseTranspose, XMMatrixTranspose(XMMatrixInverse(nullptr, world)));
+			XMStoreFloat3(&meshEffectConstants.DiffuseColor, XMVectorScale(diffuseColor, alpha));
+			XMStoreFloat3(&meshEffectConstants.EmissiveColor, XMVectorScale(XMVectorMultiply(XMVectorSet(0.05333332f, 0.09882354f, 0.1819608f, 0), diffuseColor), alpha));
+			meshEffectConstants.Alpha = alpha;
+			return meshEffectConstants;
+		}
+
+		class CommandList : public ICommandList {
+		public:
+			explicit CommandList(D3D12Device& device) : m_device(device) {}
+
+			void Reset() {
+				m_topology = PrimitiveTopology::TriangleList;
+				m_appliedPipelineState = nullptr;
+				m_constantsAddress = 0;
+				m_graphicsResources.clear();
+			}
+
+			void Clear(const DirectX::XMFLOAT4& color, float depth) override {
+				auto& deviceResources = m_device.m_deviceResources;
+				const auto commandList = deviceResources.GetCommandList();
+
+				deviceResources.GetResourceStateTracker().Transition(deviceResources.GetDepthStencil(), D3D12_RESOURCE_STATE_DEPTH_WRITE);
+				deviceResources.FlushResourceBarriers();
+
+				const float rgba[]{ color.x, color.y, color.z, color.w };
+				commandList->ClearRenderTargetView(deviceResources.GetRenderTargetView(), rgba, 0, nullptr);
+				commandList->ClearDepthStencilView(deviceResources.GetDepthStencilView(), D3D12_CLEAR_FLAG_DEPTH | D3D12_CLEAR_FLAG_STENCIL, depth, 0, 0, nullptr);
+
+				const auto viewport = deviceResources.GetScreenViewport();
+				const auto scissorRect = deviceResources.GetScissorRect();
+				commandList->RSSetViewports(1, &viewport);
+				commandList->RSSetScissorRects(1, &scissorRect);
+			}
+
+			void SetViewport(const Viewport& viewport, const ScissorRect& scissorRect) override {
+				const auto commandList = m_device.m_deviceResources.GetCommandList();
+
+				const D3D12_VIEWPORT d3dViewport{ viewport.X, viewport.Y, viewport.Width, viewport.Height, viewport.MinDepth, viewport.MaxDepth };
+				const D3D12_RECT d3dScissorRect{ scissorRect.Left, scissorRect.Top, scissorRect.Right, scissorRect.Bottom };
+				commandList->RSSetViewports(1, &d3dViewport);
+				commandList->RSSetScissorRects(1, &d3dScissorRect);
+			}
+
+			void SetVertexBuffer(BufferHandle buffer, uint32_t stride) override {
+				const auto& vertexBuffer = m_device.m_buffers.at(buffer);
+				m_device.m_deviceResources.UseUpload(vertexBuffer.Upload);
+				m_device.m_deviceResources.GetResourceStateTracker().Transition(vertexBuffer.Resource.Get(), D3D12_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER);
+
+				const D3D12_VERTEX_BUFFER_VIEW vertexBufferView{ vertexBuffer.Resource->GetGPUVirtualAddress(), vertexBuffer.Size, stride };
+				m_device.m_deviceResources.GetCommandList()->IASetVertexBuffers(0, 1, &vertexBufferView);
+			}
+
+			void SetIndexBuffer(BufferHandle buffer) override {
+				const auto& indexBuffer = m_device.m_buffers.at(buffer);
+				m_device.m_deviceResources.UseUpload(indexBuffer.Upload);
+				m_device.m_deviceResources.GetResourceStateTracker().Transition(indexBuffer.Resource.Get(), D3D12_RESOURCE_STATE_INDEX_BUFFER);
+
+				const D3D12_INDEX_BUFFER_VIEW indexBufferView{ indexBuffer.Resource->GetGPUVirtualAddress(), indexBuffer.Size, DXGI_FORMAT_R32_UINT };
+				m_device.m_deviceResources.GetCommandList()->IASetIndexBuffer(&indexBufferView);
+			}
+
+			void SetPrimitiveTopology(PrimitiveTopology topology) override {
+				constexpr D3D_PRIMITIVE_TOPOLOGY Topologies[]{ D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST, D3D_PRIMITIVE_TOPOLOGY_TRIANGLESTRIP, D3D_PRIMITIVE_TOPOLOGY_LINELIST };
+
+				m_topology = topology;
+				m_device.m_deviceResources.GetCommandList()->IASetPrimitiveTopology(Topologies[static_cast<int>(topology)]);
+			}
+
+			void SetEffect(const EffectConstants& constants) override {
+				m_effectConstants = constants;
+				m_constantsAddress = 0;
+			}
+
+			// The pipeline state of the current topology and the latest constants are bound before the first draw that needs them.
+			void DrawIndexed(uint32_t indexCount, uint32_t startIndex) override {
+				const auto commandList = m_device.m_deviceResources.GetCommandList();
+
+				const auto pipelineState = m_device.m_pipelineStates[static_cast<int>(m_topology)].Get();
+				if (pipelineState != m_appliedPipelineState) {
+					commandList->SetPipelineState(pipelineState);
+
+					m_appliedPipelineState = pipelineState;
+				}
+
+				if (!m_constantsAddress) {
+					m_constantsAddress = UploadConstants(GetMeshEffectConstants(m_effectConstants));
+					commandList->SetGraphicsRootConstantBufferView(0, m_constantsAddress);
+				}
+
+				m_device.m_deviceResources.FlushResourceBarriers();
+
+				commandList->DrawIndexedInstanced(indexCount, 1, startIndex, 0, 0);
+			}
+
+		private:
+			D3D12Device& m_device;
+
+			PrimitiveTopology m_topology = PrimitiveTopology::TriangleList;
+			EffectConstants m_effectConstants{};
+			ID3D12PipelineState* m_appliedPipelineState{};
+			D3D12_GPU_VIRTUAL_ADDRESS m_constantsAddress{};
+
+			// Constants that did not fit in the upload ring, kept until the frame has been submitted.
+			std::vector<DirectX::GraphicsResource> m_graphicsResources;
+
+			// The ring belongs to the frame being recorded and is reclaimed once its fence value completes.
+			D3D12_GPU_VIRTUAL_ADDRESS UploadConstants(const MeshEffectConstants& constants) {
+				if (DX::UploadAllocation allocation; m_device.m_deviceResources.AllocateUpload(sizeof(constants), D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT, allocation)) {
+					std::memcpy(allocation.cpuAddress, &constants, sizeof(constants));
+					return allocation.gpuAddress;
+				}
+
+				return m_graphicsResources.emplace_back(m_device.m_graphicsMemory->AllocateConstant(constants)).GpuAddress();
+			}
+		};
+
+		DX::DeviceResources& m_deviceResources;
+
+		const std::unique_ptr<DirectX::GraphicsMemory> m_graphicsMemory;
+
+		D3D12CommandQueue m_commandQueue;
+
+		CommandList m_commandList;
+
+		Microsoft::WRL::ComPtr<ID3D12RootSignature> m_rootSignature;
+		// Stands for the root signature in pipeline state hashes; it is the one compiled into the vertex shader.
+		const uint64_t m_rootSignatureKey;
+		Microsoft::WRL::ComPtr<ID3D12PipelineState> m_pipelineStates[PrimitiveTopologyCount];
+
+		std::vector<Buffer> m_buffers;
+	};
+}
@@ -6,51 +6,117 @@
 #include "pch.h"
 
 #include "DeviceResources.h"
-#include "GraphicsMemory.h"
-#include "ResourceUploadBatch.h"
-#include "BufferHelpers.h"
+#include "D3D12Backend.h"
 
 #include "StepTimer.h"
 
-#include "CommonStates.h"
-#include "EffectPipelineStateDescription.h"
-
-#include "VertexTypes.h"
-#include "Model.h"
-#include "Meshes.h"
+#include "MeshScene.h"
+#include "TaskGraph.h"
 
 #include "GamePad.h"
 #include "Keyboard.h"
 #include "Mouse.h"
+#include "InputLog.h"
 
-#include "OrbitCamera.h"
+#include "BenchmarkRun.h"
 
-#include <map>
+#include "OrbitCamera.h"
 
 #pragma warning(pop)
 
+#include <format>
+#include <optional>
+
 class D3DApp : public DX::IDeviceNotify {
 public:
 	D3DApp(const D3DApp&) = delete;
 	D3DApp& operator=(const D3DApp&) = delete;
 
-	D3DApp(HWND hWnd, const SIZE& outputSize) noexcept(false) {
+	// Empty paths leave the corresponding feature off.
+	struct LaunchOptions {
+		// Input is recorded to InputRecordPath and/or read back from InputReplayPath.
+		std::filesystem::path InputRecordPath, InputReplayPath;
+
+		// The camera path file is played at a fixed timestep, then per-frame stage timings are written, along with frame time
+		// statistics in a JSON file of the same name, and the window closes.
+		std::filesystem::path BenchmarkCameraPath, BenchmarkTimingsPath;
+
+		// Updates per second at a fixed timestep, with rendering interpolated between the last two updates; 0 for a variable timestep.
+		// Benchmarks default to 60.
+		double UpdateRate = 0;
+
+		// Frames per second to cap rendering at, e.g. below the refresh rate, or with tearing allowed where Present does not wait; 0 for no cap.
+		double FrameRateLimit = 0;
+
+		// Compiled pipeline states are loaded from and saved to this file between runs.
+		std::filesystem::path PipelineCachePath;
+	};
+
+	D3DApp(HWND hWnd, const SIZE& outputSize, const LaunchOptions& options = {}) noexcept(false) {
+		m_stepTimer.SetFrameStatistics(m_frameStatistics.get());
+
 		m_deviceResources->RegisterDeviceNotify(this);
 
 		m_deviceResources->SetWindow(hWnd, static_cast<int>(outputSize.cx), static_cast<int>(outputSize.cy));
 
+		m_deviceResources->SetPipelineCachePath(options.PipelineCachePath);
+
 		m_deviceResources->CreateDeviceResources();
-		CreateDeviceDependentResources();
 
+		// The swap chain comes first, since resizing it waits for the uploads that the startup tasks submit.
 		m_deviceResources->CreateWindowSizeDependentResources();
 		CreateWindowSizeDependentResources();
 
+		StartCreatingDeviceDependentResources();
+
 		m_mouse->SetWindow(hWnd);
 
-		m_orbitCamera.SetRadius(m_cameraRadius, MinCameraRadius, MaxCameraRadius);
+		for (auto& orbitCamera : m_orbitCameras) orbitCamera.SetRadius(m_cameraRadius, MinCameraRadius, MaxCameraRadius);
+
+		SaveCameraStates();
+		std::copy(std::cbegin(m_cameraStates), std::cend(m_cameraStates), m_previousCameraStates);
+
+		if (!options.InputReplayPath.empty()) m_inputReplayer = std::make_unique<decltype(m_inputReplayer)::element_type>(options.InputReplayPath);
+		if (!options.InputRecordPath.empty()) m_inputRecorder = std::make_unique<decltype(m_inputRecorder)::element_type>(options.InputRecordPath);
+
+		if (!options.BenchmarkCameraPath.empty()) {
+			m_benchmarkRun = std::make_unique<decltype(m_benchmarkRun)::element_type>(DX::CameraPath::CreateFromFile(options.BenchmarkCameraPath), options.BenchmarkTimingsPath);
+
+			m_stepTimer.SetFixedTimeStep(true);
+			m_stepTimer.SetTargetElapsedSeconds(1. / 60);
+		}
+
+		if (options.UpdateRate > 0) {
+			m_stepTimer.SetFixedTimeStep(true);
+			m_stepTimer.SetTargetElapsedSeconds(1 / options.UpdateRate);
+		}
+	}
+
+	~D3DApp() {
+		m_startupTasks.reset();
+
+		m_deviceResources->WaitForGpu();
 	}
 
-	~D3DApp() { m_deviceResources->WaitForGpu(); }
+	// Effects and meshes are created by startup tasks on worker threads; in the meantime frames are skipped and size
+	// changes held back.
+	bool IsStarting() const { return m_startupTasks != nullptr; }
+
+	// Returns whether the startup tasks have finished, waiting up to timeout for them; rethrows what any of them threw.
+	template <class Rep, class Period>
+	bool WaitForStartup(const std::chrono::duration<Rep, Period>& timeout) {
+		if (!m_startupTasks) return true;
+		if (!m_startupTasks->WaitFor(timeout)) return false;
+
+		FinishCreatingDeviceDependentResources();
+
+		if (m_pendingOutputSize) {
+			OnWindowSizeChanged(*m_pendingOutputSize);
+			m_pendingOutputSize.reset();
+		}
+
+		return true;
+	}
 
 	SIZE GetOutputSize() const {
 		const auto rc = m_deviceResources->GetOutputSize();
@@ -58,12 +124,37 @@ public:
 	}
 
 	void Tick() {
-		m_stepTimer.Tick([&] { Update(); });
+		using Hydr10n::Benchmarks::FrameStage;
+
+		if (IsStarting()) return;
+
+		m_stepTimer.Tick([&] { MeasureStage(FrameStage::Update, [&] { Update(); }); });
 
 		Render();
+
+		if (m_benchmarkRun && m_stepTimer.GetFrameCount()) {
+			m_benchmarkRun->EndFrame();
+
+			if (m_benchmarkRun->IsFinished(m_stepTimer.GetTotalSeconds())) {
+				m_benchmarkRun->WriteTimings();
+
+				std::ofstream statisticsFile(std::filesystem::path(m_benchmarkRun->GetTimingsPath()).replace_extension(".json"), std::ios::trunc);
+				m_frameStatistics->WriteJson(statisticsFile);
+				if (!statisticsFile) throw std::runtime_error("Failed to write frame statistics");
+
+				m_benchmarkRun.reset();
+
+				PostMessageW(m_deviceResources->GetWindow(), WM_CLOSE, 0, 0);
+			}
+		}
 	}
 
 	void OnWindowSizeChanged(const SIZE& outputSize) {
+		if (IsStarting()) {
+			m_pendingOutputSize = outputSize;
+			return;
+		}
+
 		if (!m_deviceResources->WindowSizeChanged(static_cast<int>(outputSize.cx), static_cast<int>(outputSize.cy))) return;
 
 		CreateWindowSizeDependentResources();
@@ -82,11 +173,9 @@ public:
 	void OnSuspending() { m_gamepad->Suspend(); }
 
 	void OnDeviceLost() override {
-		m_modelMeshPart.reset();
-
-		m_basicEffects.clear();
+		m_meshScene.reset();
 
-		m_graphicsMemory.reset();
+		m_renderDevice.reset();
 	}
 
 	void OnDeviceRestored() override {
@@ -96,178 +185,253 @@ public:
 	}
 
 private:
-	using Vertex = DirectX::VertexPositionNormalColor;
-
 	enum class RenderMode { Solid, Wireframe, Count };
 
 	static constexpr float MinCameraRadius = 1, MaxCameraRadius = 10;
 
+	static_assert(DirectX::GamePad::MAX_PLAYER_COUNT <= Hydr10n::Rendering::MeshScene::MaxViewCount);
+
+	// Time to first frame is measured from here.
+	const std::chrono::steady_clock::time_point m_launchTime = std::chrono::steady_clock::now();
+
 	const std::unique_ptr<DirectX::GamePad> m_gamepad = std::make_unique<decltype(m_gamepad)::element_type>();
 	const std::unique_ptr<DirectX::Keyboard> m_keyboard = std::make_unique<decltype(m_keyboard)::element_type>();
 	const std::unique_ptr<DirectX::Mouse> m_mouse = std::make_unique<decltype(m_mouse)::element_type>();
 
 	std::unique_ptr<DX::DeviceResources> m_deviceResources = std::make_unique<decltype(m_deviceResources)::element_type>();
-	std::unique_ptr<DirectX::GraphicsMemory> m_graphicsMemory;
+	std::unique_ptr<Hydr10n::Rendering::D3D12Device> m_renderDevice;
 
 	DX::StepTimer m_stepTimer;
+	const std::unique_ptr<DX::FrameStatistics> m_frameStatistics = std::make_unique<decltype(m_frameStatistics)::element_type>();
 
 	DirectX::GamePad::ButtonStateTracker m_gamepadButtonStateTrackers[DirectX::GamePad::MAX_PLAYER_COUNT];
 	DirectX::Keyboard::KeyboardStateTracker m_keyboardStateTracker;
 	DirectX::Mouse::ButtonStateTracker m_mouseButtonStateTracker;
 
-	float m_cameraRadius = 3;
-	DX::OrbitCamera m_orbitCamera;
+	std::unique_ptr<Hydr10n::Inputs::InputRecorder> m_inputRecorder;
+	std::unique_ptr<Hydr10n::Inputs::InputReplayer> m_inputReplayer;
+	Hydr10n::Inputs::InputFrame m_input{};
 
-	RenderMode m_renderMode = RenderMode::Solid;
-	std::map<RenderMode, std::unique_ptr<DirectX::BasicEffect>> m_basicEffects;
+	std::unique_ptr<Hydr10n::Benchmarks::BenchmarkRun> m_benchmarkRun;
+
+	float m_cameraRadius = 3;
+	DX::OrbitCamera m_orbitCameras[DirectX::GamePad::MAX_PLAYER_COUNT];
 
-	std::shared_ptr<DirectX::ModelMeshPart> m_modelMeshPart;
+	// Camera states after the last two updates, which frames in between blend by the timer's interpolation factor.
+	DX::OrbitCameraState m_previousCameraStates[DirectX::GamePad::MAX_PLAYER_COUNT], m_cameraStates[DirectX::GamePad::MAX_PLAYER_COUNT];
 
-	void Clear() {
-		const auto commandList = m_deviceResources->GetCommandList();
+	// Split screen is on while at least two gamepads are connected, with view i showing the camera of player m_viewPlayers[i].
+	size_t m_viewCount = 1;
+	int m_viewPlayers[DirectX::GamePad::MAX_PLAYER_COUNT]{};
+	Hydr10n::Rendering::Viewport m_viewports[DirectX::GamePad::MAX_PLAYER_COUNT]{};
+	Hydr10n::Rendering::ScissorRect m_scissorRects[DirectX::GamePad::MAX_PLAYER_COUNT]{};
 
-		PIXBeginEvent(commandList, PIX_COLOR_DEFAULT, L"Clear");
+	RenderMode m_renderMode = RenderMode::Solid;
 
-		const auto rtvDescriptor = m_deviceResources->GetRenderTargetView(), dsvDescriptor = m_deviceResources->GetDepthStencilView();
-		commandList->OMSetRenderTargets(1, &rtvDescriptor, FALSE, &dsvDescriptor);
-		commandList->ClearRenderTargetView(rtvDescriptor, DirectX::Colors::LightSteelBlue, 0, nullptr);
-		commandList->ClearDepthStencilView(dsvDescriptor, D3D12_CLEAR_FLAG_DEPTH | D3D12_CLEAR_FLAG_STENCIL, 1, 0, 0, nullptr);
+	std::unique_ptr<Hydr10n::Rendering::MeshScene> m_meshScene;
 
-		const auto viewport = m_deviceResources->GetScreenViewport();
-		const auto scissorRect = m_deviceResources->GetScissorRect();
-		commandList->RSSetViewports(1, &viewport);
-		commandList->RSSetScissorRects(1, &scissorRect);
+	std::unique_ptr<Hydr10n::Rendering::TaskGraph> m_startupTasks;
+	std::optional<SIZE> m_pendingOutputSize;
 
-		PIXEndEvent(commandList);
-	}
+	// Startup task timings relative to m_launchTime, kept until the first frame is presented.
+	std::vector<Hydr10n::Rendering::TaskGraph::TaskTiming> m_startupTimings;
+	bool m_isFirstFramePresented{};
 
 	void Render() {
+		using Hydr10n::Benchmarks::FrameStage;
+
 		if (!m_stepTimer.GetFrameCount()) return;
 
-		m_deviceResources->Prepare();
+		Hydr10n::Rendering::SceneView views[DirectX::GamePad::MAX_PLAYER_COUNT];
+		GetSceneViews(views);
 
-		Clear();
+		const std::span<const Hydr10n::Rendering::SceneView> activeViews(views, m_viewCount);
 
-		const auto commandList = m_deviceResources->GetCommandList();
+		MeasureStage(FrameStage::Cull, [&] { m_meshScene->Cull(activeViews); });
 
-		PIXBeginEvent(commandList, PIX_COLOR_DEFAULT, L"Render");
+		MeasureStage(FrameStage::Draw, [&] {
+			auto& renderCommandList = m_renderDevice->BeginFrame();
 
-		const auto& basicEffect = m_basicEffects[m_renderMode];
-		basicEffect->SetMatrices(DirectX::XMMatrixIdentity(), m_orbitCamera.GetView(), m_orbitCamera.GetProjection());
-		basicEffect->Apply(commandList);
+			const auto commandList = m_deviceResources->GetCommandList();
 
-		m_modelMeshPart->Draw(commandList);
+			PIXBeginEvent(commandList, PIX_COLOR_DEFAULT, L"Clear");
 
-		PIXEndEvent(commandList);
+			Hydr10n::Rendering::MeshScene::Clear(renderCommandList);
 
-		PIXBeginEvent(PIX_COLOR_DEFAULT, L"Present");
+			PIXEndEvent(commandList);
 
-		m_deviceResources->Present();
+			PIXBeginEvent(commandList, PIX_COLOR_DEFAULT, L"Render");
 
-		m_graphicsMemory->Commit(m_deviceResources->GetCommandQueue());
+			m_meshScene->Draw(renderCommandList, activeViews, m_renderMode == RenderMode::Wireframe);
 
-		PIXEndEvent();
-	}
+			PIXEndEvent(commandList);
+		});
 
-	void Update() {
-		using namespace DirectX;
+		MeasureStage(FrameStage::Present, [&] {
+			PIXBeginEvent(PIX_COLOR_DEFAULT, L"Present");
 
-		PIXBeginEvent(PIX_COLOR_DEFAULT, L"Update");
+			m_renderDevice->Present();
 
-		GamePad::State gamepadStates[GamePad::MAX_PLAYER_COUNT];
-		for (int i = 0; i < GamePad::MAX_PLAYER_COUNT; i++) {
-			gamepadStates[i] = m_gamepad->GetState(i);
-			m_gamepadButtonStateTrackers[i].Update(gamepadStates[i]);
+			PIXEndEvent();
+		});
+
+		if (!m_isFirstFramePresented) {
+			m_isFirstFramePresented = true;
+
+			ReportStartup(std::chrono::duration<double>(std::chrono::steady_clock::now() - m_launchTime).count());
 		}
+	}
 
-		const auto keyboardState = m_keyboard->GetState();
-		m_keyboardStateTracker.Update(keyboardState);
+	// Logs when each startup task ran and the time to first frame in debug builds, and writes it next to the timings of a
+	// benchmark.
+	void ReportStartup(double timeToFirstFrameSeconds) {
+		std::string report = "Task,StartMilliseconds,EndMilliseconds,Thread\n";
+		for (const auto& timing : m_startupTimings) {
+			report += std::format("{},{:.3f},{:.3f},{}\n", timing.Name, timing.StartSeconds * 1000, timing.EndSeconds * 1000, timing.Thread);
+		}
+		report += std::format("FirstFrame,0,{:.3f},0\n", timeToFirstFrameSeconds * 1000);
 
-		const auto mouseState = m_mouse->GetState(), lastMouseState = m_mouseButtonStateTracker.GetLastState();
-		m_mouseButtonStateTracker.Update(mouseState);
+#ifdef _DEBUG
+		OutputDebugStringA(report.c_str());
+#endif
 
-		UpdateCamera(gamepadStates, mouseState, lastMouseState);
+		if (m_benchmarkRun) {
+			std::ofstream file(std::filesystem::path(m_benchmarkRun->GetTimingsPath()).replace_extension(".startup.csv"), std::ios::trunc);
+			file << report;
+			if (!file) throw std::runtime_error("Failed to write startup timings");
+		}
 
-		PIXEndEvent();
+		m_startupTimings.clear();
 	}
 
-	void CreateDeviceDependentResources() {
-		const auto device = m_deviceResources->GetD3DDevice();
+	template <class Function>
+	void MeasureStage(Hydr10n::Benchmarks::FrameStage stage, const Function& function) {
+		if (m_benchmarkRun) m_benchmarkRun->Measure(stage, function);
+		else function();
+	}
 
-		m_graphicsMemory = std::make_unique<decltype(m_graphicsMemory)::element_type>(device);
+	void SaveCameraStates() {
+		for (int i = 0; i < DirectX::GamePad::MAX_PLAYER_COUNT; i++) m_cameraStates[i] = m_orbitCameras[i].GetState();
+	}
 
-		CreateEffects();
+	// Under a fixed timestep, each view shows its camera between the last two updates; otherwise the interpolation factor is 1 and the last update is shown as is.
+	void GetSceneViews(Hydr10n::Rendering::SceneView(&views)[DirectX::GamePad::MAX_PLAYER_COUNT]) const {
+		const auto interpolationFactor = static_cast<float>(m_stepTimer.GetInterpolationFactor());
 
-		CreateMeshes();
-	}
+		for (size_t i = 0; i < m_viewCount; i++) {
+			const auto player = m_viewPlayers[i];
+			const auto& orbitCamera = m_orbitCameras[player];
 
-	void CreateWindowSizeDependentResources() {
-		const auto size = GetOutputSize();
-		m_orbitCamera.SetWindow(static_cast<int>(size.cx), static_cast<int>(size.cy));
+			auto& view = views[i];
+			view.View = orbitCamera.GetView(DX::OrbitCameraState::Lerp(m_previousCameraStates[player], m_cameraStates[player], interpolationFactor), &view.Position);
+			view.Projection = orbitCamera.GetProjection();
+			view.Viewport = m_viewports[i];
+			view.ScissorRect = m_scissorRects[i];
+		}
 	}
 
-	void CreateEffects() {
+	void Update() {
 		using namespace DirectX;
 
-		const RenderTargetState rtState(m_deviceResources->GetBackBufferFormat(), m_deviceResources->GetDepthBufferFormat());
+		PIXBeginEvent(PIX_COLOR_DEFAULT, L"Update");
 
-		for (int i = 0; i < static_cast<int>(RenderMode::Count); i++) {
-			const auto renderMode = static_cast<RenderMode>(i);
+		// Everything below depends only on the input frame, so replaying a log reproduces the camera trajectories exactly; once the log ends, live input takes over.
+		if (m_inputReplayer && !m_inputReplayer->Read(m_input)) m_inputReplayer.reset();
+		if (!m_inputReplayer) m_input.Capture(m_stepTimer.GetElapsedTicks(), *m_gamepad, *m_keyboard, *m_mouse);
 
-			auto rasterizerDesc = CommonStates::CullNone;
-			rasterizerDesc.FillMode = renderMode == RenderMode::Solid ? D3D12_FILL_MODE_SOLID : D3D12_FILL_MODE_WIREFRAME;
+		if (m_inputRecorder) m_inputRecorder->Write(m_input);
 
-			const EffectPipelineStateDescription psd(&Vertex::InputLayout, CommonStates::Opaque, CommonStates::DepthDefault, rasterizerDesc, rtState);
+		for (int i = 0; i < GamePad::MAX_PLAYER_COUNT; i++) m_gamepadButtonStateTrackers[i].Update(m_input.GamePads[i]);
 
-			auto& basicEffect = m_basicEffects[renderMode];
-			basicEffect = std::make_unique<BasicEffect>(m_deviceResources->GetD3DDevice(), EffectFlags::Lighting, psd);
-			basicEffect->EnableDefaultLighting();
-			basicEffect->DisableSpecular();
-			basicEffect->SetDiffuseColor(Colors::Teal);
-		}
+		m_keyboardStateTracker.Update(m_input.Keyboard);
+
+		const auto lastMouseState = m_mouseButtonStateTracker.GetLastState();
+		m_mouseButtonStateTracker.Update(m_input.Mouse);
+
+		UpdateViews(m_input.GamePads);
+
+		UpdateCamera(m_input.GamePads, m_input.Mouse, lastMouseState);
+
+		if (m_benchmarkRun) m_benchmarkRun->GetCameraPath().Apply(m_orbitCameras[m_viewPlayers[0]], m_stepTimer.GetTotalSeconds(), MinCameraRadius, MaxCameraRadius);
+
+		std::copy(std::cbegin(m_cameraStates), std::cend(m_cameraStates), m_previousCameraStates);
+		SaveCameraStates();
+
+		PIXEndEvent();
 	}
 
-	void CreateMeshes() {
-		using namespace DirectX;
-		using namespace Hydr10n::Meshes;
+	void CreateDeviceDependentResources() {
+		StartCreatingDeviceDependentResources();
+		FinishCreatingDeviceDependentResources();
+	}
 
-		MeshGenerator::VertexCollection vertices;
-		MeshGenerator::IndexCollection indices;
+	// Every effect compiles its pipeline state while the mesh is generated and its upload recorded, each on a thread of its own where there are enough.
+	void StartCreatingDeviceDependentResources() {
+		using namespace Hydr10n::Rendering;
 
-		constexpr auto SemiCircleSliceCount = 200;
-		std::vector<XMFLOAT2> points;
-		for (uint32_t i = 0; i <= SemiCircleSliceCount; i++) {
-			const auto radians = -XM_PIDIV2 + XM_PI * static_cast<float>(i) / SemiCircleSliceCount;
-			points.push_back({ cos(radians), sin(radians) });
+		m_renderDevice = std::make_unique<decltype(m_renderDevice)::element_type>(*m_deviceResources, false);
+
+		auto startupTasks = std::make_unique<TaskGraph>();
+
+		for (int i = 0; i < D3D12Device::PrimitiveTopologyCount; i++) {
+			startupTasks->Add(std::format("Effect{}", i), [this, i] { m_renderDevice->CreateEffect(static_cast<PrimitiveTopology>(i)); });
 		}
 
-		MeshGenerator::CreateMeshAroundYAxis(vertices, indices, points.data(), points.size(), 1, SemiCircleSliceCount * 2);
+		MeshScene::AddCreationTasks(*startupTasks, *m_renderDevice, m_meshScene);
 
-		Microsoft::WRL::ComPtr<ID3D12Resource> vertexBuffer, indexBuffer;
+		startupTasks->Start();
 
-		const auto device = m_deviceResources->GetD3DDevice();
+		m_startupTasks = std::move(startupTasks);
+	}
 
-		ResourceUploadBatch resourceUpload(device);
-		resourceUpload.Begin();
+	void FinishCreatingDeviceDependentResources() {
+		m_startupTasks->Join();
 
-		DX::ThrowIfFailed(CreateStaticBuffer(device, resourceUpload, vertices, D3D12_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER, &vertexBuffer));
-		DX::ThrowIfFailed(CreateStaticBuffer(device, resourceUpload, indices, D3D12_RESOURCE_STATE_INDEX_BUFFER, &indexBuffer));
+		if (!m_isFirstFramePresented) {
+			const auto offsetSeconds = std::chrono::duration<double>(m_startupTasks->GetStartTime() - m_launchTime).count();
+			for (auto timing : m_startupTasks->GetTimings()) {
+				timing.StartSeconds += offsetSeconds;
+				timing.EndSeconds += offsetSeconds;
+				m_startupTimings.push_back(std::move(timing));
+			}
+		}
 
-		resourceUpload.End(m_deviceResources->GetCommandQueue()).wait();
+		m_startupTasks.reset();
+	}
 
-		m_modelMeshPart = std::make_shared<decltype(m_modelMeshPart)::element_type>(0);
+	void CreateWindowSizeDependentResources() {
+		UpdateViewports();
+	}
+
+	// Each camera's aspect ratio follows its viewport.
+	void UpdateViewports() {
+		const auto outputSize = GetOutputSize();
+		Hydr10n::Rendering::LayOutSplitScreen({ static_cast<uint32_t>(outputSize.cx), static_cast<uint32_t>(outputSize.cy) }, std::span(m_viewports, m_viewCount), std::span(m_scissorRects, m_viewCount));
+
+		for (size_t i = 0; i < m_viewCount; i++) {
+			m_orbitCameras[m_viewPlayers[i]].SetWindow(static_cast<int>(m_viewports[i].Width), static_cast<int>(m_viewports[i].Height));
+		}
+	}
+
+	void UpdateViews(const DirectX::GamePad::State(&gamepadStates)[DirectX::GamePad::MAX_PLAYER_COUNT]) {
+		using namespace DirectX;
+
+		size_t viewCount = 0;
+		int viewPlayers[GamePad::MAX_PLAYER_COUNT]{};
+		for (int i = 0; i < GamePad::MAX_PLAYER_COUNT; i++) {
+			if (gamepadStates[i].IsConnected()) viewPlayers[viewCount++] = i;
+		}
+		if (viewCount < 2) {
+			viewCount = 1;
+			viewPlayers[0] = 0;
+		}
 
-		m_modelMeshPart->primitiveType = D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST;
+		if (viewCount == m_viewCount && std::equal(viewPlayers, viewPlayers + viewCount, m_viewPlayers)) return;
 
-		m_modelMeshPart->vertexStride = sizeof(vertices[0]);
-		m_modelMeshPart->vertexCount = static_cast<uint32_t>(vertices.size());
-		m_modelMeshPart->vertexBufferSize = static_cast<uint32_t>(m_modelMeshPart->vertexStride * vertices.size());
-		m_modelMeshPart->staticVertexBuffer = vertexBuffer;
+		m_viewCount = viewCount;
+		std::copy_n(viewPlayers, viewCount, m_viewPlayers);
 
-		m_modelMeshPart->indexFormat = DXGI_FORMAT_R32_UINT;
-		m_modelMeshPart->indexCount = static_cast<uint32_t>(indices.size());
-		m_modelMeshPart->indexBufferSize = static_cast<uint32_t>(sizeof(indices[0]) * indices.size());
-		m_modelMeshPart->staticIndexBuffer = indexBuffer;
+		UpdateViewports();
 	}
 
 	void UpdateCamera(const DirectX::GamePad::State(&gamepadStates)[DirectX::GamePad::MAX_PLAYER_COUNT], const DirectX::Mouse::State& mouseState, const DirectX::Mouse::State& lastMouseState) {
@@ -276,7 +440,7 @@ private:
 		using MouseButtonState = Mouse::ButtonStateTracker::ButtonState;
 		using GamepadButtonState = GamePad::ButtonStateTracker::ButtonState;
 
-		const auto elapsedSeconds = static_cast<float>(m_stepTimer.GetElapsedSeconds());
+		const auto elapsedSeconds = static_cast<float>(DX::StepTimer::TicksToSeconds(m_input.ElapsedTicks));
 
 		for (int i = 0; i < GamePad::MAX_PLAYER_COUNT; i++) {
 			const auto& gamepadState = gamepadStates[i];
@@ -293,7 +457,8 @@ private:
 					m_renderMode = m_renderMode == RenderMode::Solid ? RenderMode::Wireframe : RenderMode::Solid;
 				}
 
-				m_orbitCamera.Update(elapsedSeconds * 4, gamepadState);
+				// Without split screen, every gamepad drives the only camera.
+				m_orbitCameras[m_viewCount > 1 ? i : 0].Update(elapsedSeconds * 4, gamepadState);
 			}
 		}
 
@@ -313,15 +478,19 @@ private:
 			m_mouse->SetVisible(true);
 		}
 
+		// The wheel is consumed here, so the camera sees it at rest.
+		auto cameraMouseState = mouseState;
 		if (mouseState.scrollWheelValue) {
 			m_mouse->ResetScrollWheelValue();
+			cameraMouseState.scrollWheelValue = 0;
 
 			m_mouse->SetVisible(false);
 
 			m_cameraRadius = std::clamp(m_cameraRadius - 0.5f * mouseState.scrollWheelValue / WHEEL_DELTA, MinCameraRadius, MaxCameraRadius);
-			m_orbitCamera.SetRadius(m_cameraRadius, MinCameraRadius, MaxCameraRadius);
+			m_orbitCameras[m_viewPlayers[0]].SetRadius(m_cameraRadius, MinCameraRadius, MaxCameraRadius);
 		}
 
-		m_orbitCamera.Update(elapsedSeconds, *m_mouse, *m_keyboard);
+		// A replayed mouse state already carries the position mode the camera switched to while recording.
+		m_orbitCameras[m_viewPlayers[0]].Update(elapsedSeconds, cameraMouseState, m_input.Keyboard, m_inputReplayer ? nullptr : m_mouse.get());
 	}
 };
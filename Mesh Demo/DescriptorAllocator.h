@@ -0,0 +1,95 @@
+//
+// DescriptorAllocator.h - A shader-visible descriptor heap with persistent and per-frame regions
+//
+
+#pragma once
+
+#include "DescriptorIndexAllocator.h"
+
+
+namespace DX
+{
+    // A contiguous range of transient descriptors, valid until the GPU has finished the frame it was allocated in.
+    struct DescriptorRange
+    {
+        D3D12_CPU_DESCRIPTOR_HANDLE cpuHandle;
+        D3D12_GPU_DESCRIPTOR_HANDLE gpuHandle;
+        uint32_t                    count;
+    };
+
+    // Owns one shader-visible heap of CBV/SRV/UAV or sampler descriptors, split by a DescriptorIndexAllocator into
+    // descriptors that live until freed and ranges that last one frame. Thread-safety is that of DescriptorIndexAllocator.
+    // Its owner closes each frame with EndFrame and the fence value the frame is signaled with, and calls Reclaim as fence
+    // values complete, as DeviceResources does for its upload ring. Nothing in the demo binds descriptors yet: mesh
+    // constants go through a root CBV, and there are no textures.
+    class DescriptorAllocator
+    {
+    public:
+        DescriptorAllocator(ID3D12Device* device, D3D12_DESCRIPTOR_HEAP_TYPE type, uint32_t persistentCount, uint32_t transientCount) noexcept(false) :
+            m_indices(persistentCount, transientCount)
+        {
+            if (type != D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV && type != D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER)
+            {
+                throw std::invalid_argument("only CBV/SRV/UAV and sampler heaps can be shader-visible");
+            }
+
+            D3D12_DESCRIPTOR_HEAP_DESC heapDesc = {};
+            heapDesc.Type = type;
+            heapDesc.NumDescriptors = persistentCount + transientCount;
+            heapDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE;
+
+            ThrowIfFailed(device->CreateDescriptorHeap(&heapDesc, IID_PPV_ARGS(m_heap.ReleaseAndGetAddressOf())));
+
+            m_heap->SetName(type == D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER ? L"DescriptorAllocator Samplers" : L"DescriptorAllocator");
+
+            m_descriptorSize = device->GetDescriptorHandleIncrementSize(type);
+            m_cpuStart = m_heap->GetCPUDescriptorHandleForHeapStart();
+            m_gpuStart = m_heap->GetGPUDescriptorHandleForHeapStart();
+        }
+
+        ID3D12DescriptorHeap* GetHeap() const noexcept { return m_heap.Get(); }
+        DescriptorIndexAllocator& GetIndexAllocator() noexcept { return m_indices; }
+
+        // Returns a null handle if the persistent region is full.
+        DescriptorHandle AllocatePersistent() noexcept { return m_indices.AllocatePersistent(); }
+        void FreePersistent(DescriptorHandle handle) { m_indices.FreePersistent(handle); }
+
+        CD3DX12_CPU_DESCRIPTOR_HANDLE GetCpuHandle(DescriptorHandle handle) const
+        {
+            m_indices.Validate(handle);
+            return CD3DX12_CPU_DESCRIPTOR_HANDLE(m_cpuStart, static_cast<INT>(handle.index), m_descriptorSize);
+        }
+
+        CD3DX12_GPU_DESCRIPTOR_HANDLE GetGpuHandle(DescriptorHandle handle) const
+        {
+            m_indices.Validate(handle);
+            return CD3DX12_GPU_DESCRIPTOR_HANDLE(m_gpuStart, static_cast<INT>(handle.index), m_descriptorSize);
+        }
+
+        // Returns false if the frames in flight leave no room for count descriptors.
+        bool AllocateTransient(uint32_t count, DescriptorRange& range) noexcept
+        {
+            const uint32_t index = m_indices.AllocateTransient(count);
+            if (index == DescriptorHandle::c_InvalidIndex)
+            {
+                return false;
+            }
+
+            range.cpuHandle = CD3DX12_CPU_DESCRIPTOR_HANDLE(m_cpuStart, static_cast<INT>(index), m_descriptorSize);
+            range.gpuHandle = CD3DX12_GPU_DESCRIPTOR_HANDLE(m_gpuStart, static_cast<INT>(index), m_descriptorSize);
+            range.count = count;
+            return true;
+        }
+
+        void EndFrame(uint64_t fenceValue) { m_indices.EndFrame(fenceValue); }
+        void Reclaim(uint64_t completedFenceValue) noexcept { m_indices.Reclaim(completedFenceValue); }
+
+    private:
+        DescriptorIndexAllocator                        m_indices;
+
+        Microsoft::WRL::ComPtr<ID3D12DescriptorHeap>    m_heap;
+        UINT                                            m_descriptorSize;
+        D3D12_CPU_DESCRIPTOR_HANDLE                     m_cpuStart;
+        D3D12_GPU_DESCRIPTOR_HANDLE                     m_gpuStart;
+    };
+}
@@ -0,0 +1,104 @@
+/*
+ * Header File: DescriptorBenchmark.h
+ * Last Update: 2026/10/18
+ *
+ * Copyright (C) Hydr10n@GitHub. All Rights Reserved.
+ */
+
+#pragma once
+
+#include "DescriptorIndexAllocator.h"
+#include "WorkerPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <vector>
+
+namespace Hydr10n::Benchmarks {
+	/*
+	 * Measures how many descriptors a DescriptorIndexAllocator hands out per second with every thread allocating at once.
+	 * Persistent descriptors are allocated and freed in batches; transient ranges are allocated over simulated frames,
+	 * each closed with a fence value that completes FrameLatency frames later.
+	 */
+	class DescriptorBenchmark {
+	public:
+		struct Options {
+			// 0 for one thread per hardware thread.
+			uint32_t ThreadCount = 0;
+			uint32_t PersistentCount = 16384, TransientCount = 16384;
+			uint32_t BatchSize = 64, BatchCount = 20000;
+			uint32_t FrameCount = 2000, FrameLatency = 2, MaxTransientRangeSize = 8;
+		};
+
+		struct Result {
+			uint32_t ThreadCount;
+			uint64_t PersistentAllocationCount, TransientAllocationCount;
+			// Transient allocations that failed because the frames in flight had no room left.
+			uint64_t TransientFailureCount;
+			double PersistentAllocationsPerSecond, TransientAllocationsPerSecond;
+		};
+
+		static Result Run() { return Run(Options()); }
+
+		static Result Run(const Options& options) {
+			if (!options.BatchSize || options.BatchSize > options.PersistentCount || !options.MaxTransientRangeSize) throw std::invalid_argument("Invalid descriptor benchmark options");
+
+			Rendering::WorkerPool workerPool(options.ThreadCount);
+			const auto threadCount = workerPool.GetThreadCount();
+
+			// Each thread allocates its share of the persistent region at most, so that allocations never fail.
+			const auto batchSize = std::min(options.BatchSize, options.PersistentCount / threadCount);
+			if (!batchSize) throw std::invalid_argument("Too few persistent descriptors for the thread count");
+
+			DX::DescriptorIndexAllocator allocator(options.PersistentCount, options.TransientCount);
+
+			Result result{ threadCount, static_cast<uint64_t>(threadCount) * options.BatchCount * batchSize, 0, 0, 0, 0 };
+
+			auto start = std::chrono::steady_clock::now();
+
+			workerPool.Run(threadCount, [&](uint32_t) {
+				std::vector<DX::DescriptorHandle> handles(batchSize);
+				for (uint32_t i = 0; i < options.BatchCount; i++) {
+					for (auto& handle : handles) handle = allocator.AllocatePersistent();
+					for (const auto& handle : handles) allocator.FreePersistent(handle);
+				}
+			});
+
+			result.PersistentAllocationsPerSecond = static_cast<double>(result.PersistentAllocationCount) / std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+			// Every frame, each thread takes an equal share of the transient region, in ranges of varying sizes; a range is
+			// left for the padding skipped when the ring wraps around.
+			const auto frameRegion = options.TransientCount / (options.FrameLatency + 1);
+			const auto frameBudget = frameRegion > options.MaxTransientRangeSize ? (frameRegion - options.MaxTransientRangeSize) / threadCount : 0;
+
+			std::atomic<uint64_t> transientAllocationCount{}, transientFailureCount{};
+
+			start = std::chrono::steady_clock::now();
+
+			for (uint32_t frame = 0; frame < options.FrameCount; frame++) {
+				workerPool.Run(threadCount, [&](uint32_t thread) {
+					uint64_t allocationCount = 0, failureCount = 0;
+					for (uint32_t allocated = 0, i = 0; allocated < frameBudget; i++) {
+						const auto count = std::min(1 + (frame + thread + i) % options.MaxTransientRangeSize, frameBudget - allocated);
+						if (allocator.AllocateTransient(count) == DX::DescriptorHandle::c_InvalidIndex) failureCount++;
+						else allocationCount++;
+						allocated += count;
+					}
+					transientAllocationCount.fetch_add(allocationCount, std::memory_order_relaxed);
+					transientFailureCount.fetch_add(failureCount, std::memory_order_relaxed);
+				});
+
+				allocator.EndFrame(frame + 1);
+				if (frame + 1 >= options.FrameLatency) allocator.Reclaim(frame + 1 - options.FrameLatency);
+			}
+
+			result.TransientAllocationCount = transientAllocationCount;
+			result.TransientFailureCount = transientFailureCount;
+			result.TransientAllocationsPerSecond = static_cast<double>(result.TransientAllocationCount) / std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+			return result;
+		}
+	};
+}
@@ -0,0 +1,184 @@
+//
+// DescriptorIndexAllocator.h - Lock-free allocation of descriptor heap indices
+//
+
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+
+#include "UploadRing.h"
+
+
+namespace DX
+{
+    // A persistent descriptor; in debug builds it carries the generation of its slot, so that handles used after being
+    // freed are caught.
+    struct DescriptorHandle
+    {
+        static constexpr uint32_t c_InvalidIndex = UINT32_MAX;
+
+        uint32_t index = c_InvalidIndex;
+#if defined(_DEBUG)
+        uint32_t generation = 0;
+#endif
+
+        bool IsNull() const noexcept { return index == c_InvalidIndex; }
+    };
+
+    // Splits the indices of a descriptor heap into two regions:
+    //   - [0, persistentCount): single descriptors that live until freed, tracked by a bitmap;
+    //   - [persistentCount, persistentCount + transientCount): contiguous ranges for one frame, handed out by an
+    //     UploadRing and reclaimed once the fence value the frame was closed with completes.
+    //
+    // AllocatePersistent, FreePersistent and AllocateTransient may be called from any number of threads at once and
+    // never block. EndFrame and Reclaim must be called from one thread, as with UploadRing.
+    class DescriptorIndexAllocator
+    {
+    public:
+        DescriptorIndexAllocator(uint32_t persistentCount, uint32_t transientCount) noexcept(false) :
+            m_persistentCount(ValidateCounts(persistentCount, transientCount)),
+            m_wordCount((persistentCount + c_WordBits - 1) / c_WordBits),
+            m_words(std::make_unique<std::atomic<uint64_t>[]>(m_wordCount)),
+#if defined(_DEBUG)
+            m_generations(std::make_unique<std::atomic<uint32_t>[]>(persistentCount)),
+#endif
+            m_transientRing(transientCount ? std::make_unique<UploadRing>(transientCount) : nullptr)
+        {
+            // Bits past the last index are kept set so they are never handed out.
+            if (persistentCount % c_WordBits)
+            {
+                m_words[m_wordCount - 1].store(~0ull << (persistentCount % c_WordBits), std::memory_order_relaxed);
+            }
+        }
+
+        DescriptorIndexAllocator(DescriptorIndexAllocator const&) = delete;
+        DescriptorIndexAllocator& operator= (DescriptorIndexAllocator const&) = delete;
+
+        uint32_t GetPersistentCount() const noexcept { return m_persistentCount; }
+        uint32_t GetTransientCount() const noexcept { return m_transientRing ? static_cast<uint32_t>(m_transientRing->GetCapacity()) : 0; }
+
+        // Returns a null handle if every persistent descriptor is in use.
+        DescriptorHandle AllocatePersistent() noexcept
+        {
+            if (!m_wordCount)
+            {
+                return {};
+            }
+
+            // Threads start searching at different words, so that they rarely contend for the same one.
+            thread_local uint32_t t_searchStart = static_cast<uint32_t>(std::hash<std::thread::id>()(std::this_thread::get_id()));
+
+            const uint32_t start = t_searchStart % m_wordCount;
+            for (uint32_t i = 0; i < m_wordCount; i++)
+            {
+                const uint32_t wordIndex = (start + i) % m_wordCount;
+                std::atomic<uint64_t>& word = m_words[wordIndex];
+
+                uint64_t bits = word.load(std::memory_order_relaxed);
+                while (~bits)
+                {
+                    const int bit = std::countr_zero(~bits);
+                    if (word.compare_exchange_weak(bits, bits | (1ull << bit), std::memory_order_acquire, std::memory_order_relaxed))
+                    {
+                        t_searchStart = wordIndex;
+
+                        DescriptorHandle handle;
+                        handle.index = wordIndex * c_WordBits + static_cast<uint32_t>(bit);
+#if defined(_DEBUG)
+                        handle.generation = m_generations[handle.index].load(std::memory_order_relaxed);
+#endif
+                        return handle;
+                    }
+                }
+            }
+
+            return {};
+        }
+
+        // The GPU must be done with the descriptor.
+        void FreePersistent(DescriptorHandle handle)
+        {
+            Validate(handle);
+
+#if defined(_DEBUG)
+            m_generations[handle.index].fetch_add(1, std::memory_order_relaxed);
+#endif
+
+            m_words[handle.index / c_WordBits].fetch_and(~(1ull << (handle.index % c_WordBits)), std::memory_order_release);
+        }
+
+        // Throws in debug builds if the handle is null, out of range, or was freed since it was allocated.
+        void Validate([[maybe_unused]] DescriptorHandle handle) const
+        {
+#if defined(_DEBUG)
+            if (handle.index >= m_persistentCount)
+            {
+                throw std::logic_error("invalid descriptor handle");
+            }
+
+            if (handle.generation != m_generations[handle.index].load(std::memory_order_relaxed)
+                || !(m_words[handle.index / c_WordBits].load(std::memory_order_relaxed) & (1ull << (handle.index % c_WordBits))))
+            {
+                throw std::logic_error("descriptor handle used after being freed");
+            }
+#endif
+        }
+
+        // Returns the first of count contiguous transient indices, or DescriptorHandle::c_InvalidIndex if the frames in
+        // flight leave no room.
+        uint32_t AllocateTransient(uint32_t count) noexcept
+        {
+            const uint64_t offset = m_transientRing ? m_transientRing->Allocate(count) : UploadRing::c_InvalidOffset;
+            return offset == UploadRing::c_InvalidOffset ? DescriptorHandle::c_InvalidIndex : m_persistentCount + static_cast<uint32_t>(offset);
+        }
+
+        void EndFrame(uint64_t fenceValue)
+        {
+            if (m_transientRing)
+            {
+                m_transientRing->EndFrame(fenceValue);
+            }
+        }
+
+        void Reclaim(uint64_t completedFenceValue) noexcept
+        {
+            if (m_transientRing)
+            {
+                m_transientRing->Reclaim(completedFenceValue);
+            }
+        }
+
+    private:
+        static constexpr uint32_t c_WordBits = 64;
+
+        // Checked before anything is allocated for the counts.
+        static uint32_t ValidateCounts(uint32_t persistentCount, uint32_t transientCount)
+        {
+            if (static_cast<uint64_t>(persistentCount) + transientCount >= DescriptorHandle::c_InvalidIndex)
+            {
+                throw std::out_of_range("too many descriptors");
+            }
+
+            return persistentCount;
+        }
+
+        const uint32_t                              m_persistentCount;
+        const uint32_t                              m_wordCount;
+
+        // One bit per persistent descriptor, set while it is allocated.
+        std::unique_ptr<std::atomic<uint64_t>[]>    m_words;
+
+#if defined(_DEBUG)
+        // Incremented whenever a persistent descriptor is freed.
+        std::unique_ptr<std::atomic<uint32_t>[]>    m_generations;
+#endif
+
+        std::unique_ptr<UploadRing>                 m_transientRing;
+    };
+}
@@ -37,9 +37,13 @@ DeviceResources::DeviceResources(
     DXGI_FORMAT depthBufferFormat,
     UINT backBufferCount,
     D3D_FEATURE_LEVEL minFeatureLevel,
-    unsigned int flags) noexcept(false) :
+    unsigned int flags,
+    UINT64 uploadHeapSize) noexcept(false) :
         m_backBufferIndex(0),
         m_fenceValues{},
+        m_uploadHeapAddress(nullptr),
+        m_uploadHeapSize(uploadHeapSize),
+        m_copyWaitValue(0),
         m_rtvDescriptorSize(0),
         m_screenViewport{},
         m_scissorRect{},
@@ -64,6 +68,11 @@ DeviceResources::DeviceResources(
     {
         throw std::out_of_range("minFeatureLevel too low");
     }
+
+    if (!uploadHeapSize)
+    {
+        throw std::out_of_range("uploadHeapSize must not be zero");
+    }
 }
 
 // Destructor for DeviceResources.
@@ -71,6 +80,20 @@ DeviceResources::~DeviceResources()
 {
     // Ensure that the GPU is no longer referencing resources that are about to be destroyed.
     WaitForGpu();
+
+    if (m_pipelineStateCache)
+    {
+        try
+        {
+            m_pipelineStateCache->Save();
+        }
+        catch (const std::exception&)
+        {
+#ifdef _DEBUG
+            OutputDebugStringA("WARNING: Failed to save the pipeline state cache\n");
+#endif
+        }
+    }
 }
 
 // Configures the Direct3D device, and stores handles to it and the device context.
@@ -237,6 +260,8 @@ void DeviceResources::CreateDeviceResources()
         wchar_t name[25] = {};
         swprintf_s(name, L"Render target %u", n);
         m_commandAllocators[n]->SetName(name);
+
+        ThrowIfFailed(m_d3dDevice->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_DIRECT, IID_PPV_ARGS(m_resolveCommandAllocators[n].ReleaseAndGetAddressOf())));
     }
 
     // Create a command list for recording graphics commands.
@@ -245,6 +270,12 @@ void DeviceResources::CreateDeviceResources()
 
     m_commandList->SetName(L"DeviceResources");
 
+    // And one for the barriers resolved when it is submitted.
+    ThrowIfFailed(m_d3dDevice->CreateCommandList(0, D3D12_COMMAND_LIST_TYPE_DIRECT, m_resolveCommandAllocators[0].Get(), nullptr, IID_PPV_ARGS(m_resolveCommandList.ReleaseAndGetAddressOf())));
+    ThrowIfFailed(m_resolveCommandList->Close());
+
+    m_resolveCommandList->SetName(L"DeviceResources Resolve");
+
     // Create a fence for tracking GPU execution progress.
     ThrowIfFailed(m_d3dDevice->CreateFence(m_fenceValues[m_backBufferIndex], D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(m_fence.ReleaseAndGetAddressOf())));
     m_fenceValues[m_backBufferIndex]++;
@@ -256,6 +287,40 @@ void DeviceResources::CreateDeviceResources()
     {
         throw std::system_error(std::error_code(static_cast<int>(GetLastError()), std::system_category()), "CreateEventEx");
     }
+
+    // Create the upload heap and leave it mapped; upload heaps are write-combined, so the CPU should only write to it.
+    const CD3DX12_HEAP_PROPERTIES uploadHeapProperties(D3D12_HEAP_TYPE_UPLOAD);
+    const D3D12_RESOURCE_DESC uploadHeapDesc = CD3DX12_RESOURCE_DESC::Buffer(m_uploadHeapSize);
+    ThrowIfFailed(m_d3dDevice->CreateCommittedResource(&uploadHeapProperties, D3D12_HEAP_FLAG_NONE, &uploadHeapDesc,
+        D3D12_RESOURCE_STATE_GENERIC_READ, nullptr, IID_PPV_ARGS(m_uploadHeap.ReleaseAndGetAddressOf())));
+
+    m_uploadHeap->SetName(L"DeviceResources Upload Heap");
+
+    const CD3DX12_RANGE readRange(0, 0);
+    void* uploadHeapAddress;
+    ThrowIfFailed(m_uploadHeap->Map(0, &readRange, &uploadHeapAddress));
+    m_uploadHeapAddress = static_cast<uint8_t*>(uploadHeapAddress);
+
+    m_uploadRing = std::make_unique<UploadRing>(m_uploadHeapSize);
+
+    m_uploadScheduler = std::make_unique<UploadScheduler<CopyQueue>>(m_d3dDevice.Get());
+    m_copyWaitValue = 0;
+
+    // Pipeline libraries only load on the adapter and driver that serialized them.
+    {
+        DXGI_ADAPTER_DESC1 desc;
+        ThrowIfFailed(adapter->GetDesc1(&desc));
+
+        LARGE_INTEGER driverVersion;
+        if (FAILED(adapter->CheckInterfaceSupport(__uuidof(IDXGIDevice), &driverVersion)))
+        {
+            driverVersion.QuadPart = 0;
+        }
+
+        const uint64_t compatibilityKey = HashBuilder().Add(desc.VendorId).Add(desc.DeviceId).Add(desc.SubSysId).Add(desc.Revision)
+            .Add(driverVersion.QuadPart).GetHash();
+        m_pipelineStateCache = std::make_unique<PipelineStateCache>(m_d3dDevice.Get(), m_pipelineCachePath, compatibilityKey);
+    }
 }
 
 // These resources need to be recreated every time the window size is changed.
@@ -272,6 +337,8 @@ void DeviceResources::CreateWindowSizeDependentResources()
     // Release resources that are tied to the swap chain and update fence values.
     for (UINT n = 0; n < m_backBufferCount; n++)
     {
+        m_stateTracker.Forget(m_renderTargets[n].Get());
+        m_resourceStates.Forget(m_renderTargets[n].Get());
         m_renderTargets[n].Reset();
         m_fenceValues[n] = m_fenceValues[m_backBufferIndex];
     }
@@ -358,6 +425,8 @@ void DeviceResources::CreateWindowSizeDependentResources()
     {
         ThrowIfFailed(m_swapChain->GetBuffer(n, IID_PPV_ARGS(m_renderTargets[n].GetAddressOf())));
 
+        m_resourceStates.SetState(m_renderTargets[n].Get(), D3D12_RESOURCE_STATE_PRESENT);
+
         wchar_t name[25] = {};
         swprintf_s(name, L"Render target %u", n);
         m_renderTargets[n]->SetName(name);
@@ -390,6 +459,9 @@ void DeviceResources::CreateWindowSizeDependentResources()
             );
         depthStencilDesc.Flags |= D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL;
 
+        m_stateTracker.Forget(m_depthStencil.Get());
+        m_resourceStates.Forget(m_depthStencil.Get());
+
         D3D12_CLEAR_VALUE depthOptimizedClearValue = {};
         depthOptimizedClearValue.Format = m_depthBufferFormat;
         depthOptimizedClearValue.DepthStencil.Depth = 1.0f;
@@ -406,6 +478,8 @@ void DeviceResources::CreateWindowSizeDependentResources()
 
         m_depthStencil->SetName(L"Depth stencil");
 
+        m_resourceStates.SetState(m_depthStencil.Get(), D3D12_RESOURCE_STATE_DEPTH_WRITE);
+
         D3D12_DEPTH_STENCIL_VIEW_DESC dsvDesc = {};
         dsvDesc.Format = m_depthBufferFormat;
         dsvDesc.ViewDimension = D3D12_DSV_DIMENSION_TEXTURE2D;
@@ -469,15 +543,24 @@ void DeviceResources::HandleDeviceLost()
     for (UINT n = 0; n < m_backBufferCount; n++)
     {
         m_commandAllocators[n].Reset();
+        m_resolveCommandAllocators[n].Reset();
         m_renderTargets[n].Reset();
     }
 
+    m_stateTracker.Reset();
+    m_resourceStates.Reset();
     m_depthStencil.Reset();
     m_commandQueue.Reset();
     m_commandList.Reset();
+    m_resolveCommandList.Reset();
     m_fence.Reset();
+    m_uploadScheduler.reset();
+    m_uploadRing.reset();
+    m_uploadHeapAddress = nullptr;
+    m_uploadHeap.Reset();
     m_rtvDescriptorHeap.Reset();
     m_dsvDescriptorHeap.Reset();
+    m_pipelineStateCache.reset();
     m_swapChain.Reset();
     m_d3dDevice.Reset();
     m_dxgiFactory.Reset();
@@ -508,28 +591,50 @@ void DeviceResources::Prepare(D3D12_RESOURCE_STATES beforeState, D3D12_RESOURCE_
     ThrowIfFailed(m_commandAllocators[m_backBufferIndex]->Reset());
     ThrowIfFailed(m_commandList->Reset(m_commandAllocators[m_backBufferIndex].Get(), nullptr));
 
-    if (beforeState != afterState)
-    {
-        // Transition the render target into the correct state to allow for drawing into it.
-        D3D12_RESOURCE_BARRIER barrier = CD3DX12_RESOURCE_BARRIER::Transition(m_renderTargets[m_backBufferIndex].Get(),
-            beforeState, afterState);
-        m_commandList->ResourceBarrier(1, &barrier);
-    }
+    // Transition the render target into the correct state to allow for drawing into it, once barriers are flushed.
+    ID3D12Resource* renderTarget = m_renderTargets[m_backBufferIndex].Get();
+    m_stateTracker.SetState(renderTarget, beforeState);
+    m_stateTracker.Transition(renderTarget, afterState);
 }
 
 // Present the contents of the swap chain to the screen.
 void DeviceResources::Present(D3D12_RESOURCE_STATES beforeState)
 {
-    if (beforeState != D3D12_RESOURCE_STATE_PRESENT)
+    // Transition the render target to the state that allows it to be presented to the display, along with any pending
+    // barriers. beforeState only matters if the render target was transitioned without the state tracker.
+    ID3D12Resource* renderTarget = m_renderTargets[m_backBufferIndex].Get();
+    if (m_stateTracker.GetState(renderTarget) != beforeState)
     {
-        // Transition the render target to the state that allows it to be presented to the display.
-        D3D12_RESOURCE_BARRIER barrier = CD3DX12_RESOURCE_BARRIER::Transition(m_renderTargets[m_backBufferIndex].Get(), beforeState, D3D12_RESOURCE_STATE_PRESENT);
-        m_commandList->ResourceBarrier(1, &barrier);
+        m_stateTracker.SetState(renderTarget, beforeState);
     }
+    m_stateTracker.Transition(renderTarget, D3D12_RESOURCE_STATE_PRESENT);
+    FlushResourceBarriers();
+
+    // Start the copies enqueued during the frame, and hold the frame back until the uploads it uses have completed.
+    m_uploadScheduler->Submit();
+    if (m_copyWaitValue)
+    {
+        ThrowIfFailed(m_commandQueue->Wait(m_uploadScheduler->GetQueue().GetFence(), m_copyWaitValue));
+        m_copyWaitValue = 0;
+    }
+
+    // Resources first used by the command list may need barriers from the state earlier frames left them in, recorded
+    // into a command list of their own that runs first. The allocator of this frame was released in MoveToNextFrame.
+    ID3D12CommandList* commandLists[2];
+    UINT commandListCount = 0;
+    m_stateTracker.Resolve(m_resourceStates, [&](std::span<const D3D12ResourceStateTracker::Barrier> barriers)
+    {
+        ThrowIfFailed(m_resolveCommandAllocators[m_backBufferIndex]->Reset());
+        ThrowIfFailed(m_resolveCommandList->Reset(m_resolveCommandAllocators[m_backBufferIndex].Get(), nullptr));
+        RecordBarriers(m_resolveCommandList.Get(), barriers);
+        ThrowIfFailed(m_resolveCommandList->Close());
+        commandLists[commandListCount++] = m_resolveCommandList.Get();
+    });
 
     // Send the command list off to the GPU for processing.
     ThrowIfFailed(m_commandList->Close());
-    m_commandQueue->ExecuteCommandLists(1, CommandListCast(m_commandList.GetAddressOf()));
+    commandLists[commandListCount++] = m_commandList.Get();
+    m_commandQueue->ExecuteCommandLists(commandListCount, commandLists);
 
     HRESULT hr;
     if (m_options & c_AllowTearing)
@@ -571,9 +676,45 @@ void DeviceResources::Present(D3D12_RESOURCE_STATES beforeState)
     }
 }
 
+// Record all pending transitions with a single ResourceBarrier call.
+void DeviceResources::FlushResourceBarriers()
+{
+    m_stateTracker.Flush([&](std::span<const D3D12ResourceStateTracker::Barrier> barriers)
+    {
+        RecordBarriers(m_commandList.Get(), barriers);
+    });
+}
+
+void DeviceResources::RecordBarriers(ID3D12GraphicsCommandList* commandList, std::span<const D3D12ResourceStateTracker::Barrier> barriers)
+{
+    m_barriers.clear();
+    for (const auto& barrier : barriers)
+    {
+        D3D12_RESOURCE_BARRIER_FLAGS flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
+        if (barrier.split == D3D12ResourceStateTracker::Split::Begin)
+        {
+            flags = D3D12_RESOURCE_BARRIER_FLAG_BEGIN_ONLY;
+        }
+        else if (barrier.split == D3D12ResourceStateTracker::Split::End)
+        {
+            flags = D3D12_RESOURCE_BARRIER_FLAG_END_ONLY;
+        }
+
+        m_barriers.push_back(CD3DX12_RESOURCE_BARRIER::Transition(barrier.resource, barrier.before, barrier.after,
+            D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES, flags));
+    }
+
+    commandList->ResourceBarrier(static_cast<UINT>(m_barriers.size()), m_barriers.data());
+}
+
 // Wait for pending GPU work to complete.
 void DeviceResources::WaitForGpu() noexcept
 {
+    if (m_uploadScheduler)
+    {
+        m_uploadScheduler->GetQueue().WaitForGpu();
+    }
+
     if (m_commandQueue && m_fence && m_fenceEvent.IsValid())
     {
         // Schedule a Signal command in the GPU queue.
@@ -585,6 +726,11 @@ void DeviceResources::WaitForGpu() noexcept
             {
                 WaitForSingleObjectEx(m_fenceEvent.Get(), INFINITE, FALSE);
 
+                if (m_uploadRing)
+                {
+                    m_uploadRing->Reclaim(fenceValue);
+                }
+
                 // Increment the fence value for the current frame.
                 m_fenceValues[m_backBufferIndex]++;
             }
@@ -599,6 +745,9 @@ void DeviceResources::MoveToNextFrame()
     const UINT64 currentFenceValue = m_fenceValues[m_backBufferIndex];
     ThrowIfFailed(m_commandQueue->Signal(m_fence.Get(), currentFenceValue));
 
+    // Uploads made for this frame stay in use until the signal is reached.
+    m_uploadRing->EndFrame(currentFenceValue);
+
     // Update the back buffer index.
     m_backBufferIndex = m_swapChain->GetCurrentBackBufferIndex();
 
@@ -609,10 +758,135 @@ void DeviceResources::MoveToNextFrame()
         WaitForSingleObjectEx(m_fenceEvent.Get(), INFINITE, FALSE);
     }
 
+    m_uploadRing->Reclaim(m_fence->GetCompletedValue());
+
     // Set the fence value for the next frame.
     m_fenceValues[m_backBufferIndex] = currentFenceValue + 1;
 }
 
+// Sub-allocate the upload heap for the current frame.
+bool DeviceResources::AllocateUpload(UINT64 size, UINT64 alignment, UploadAllocation& allocation) noexcept
+{
+    if (!m_uploadRing)
+    {
+        return false;
+    }
+
+    const UINT64 offset = m_uploadRing->Allocate(size, alignment);
+    if (offset == UploadRing::c_InvalidOffset)
+    {
+        return false;
+    }
+
+    allocation.resource = m_uploadHeap.Get();
+    allocation.offset = offset;
+    allocation.cpuAddress = m_uploadHeapAddress + offset;
+    allocation.gpuAddress = m_uploadHeap->GetGPUVirtualAddress() + offset;
+    return true;
+}
+
+// Stage data in its own upload buffer, kept until the copy has completed, and enqueue the copy.
+UploadTicket DeviceResources::UploadBuffer(ID3D12Resource* destination, const void* data, UINT64 size)
+{
+    const CD3DX12_HEAP_PROPERTIES heapProperties(D3D12_HEAP_TYPE_UPLOAD);
+    const D3D12_RESOURCE_DESC resourceDesc = CD3DX12_RESOURCE_DESC::Buffer(size);
+    ComPtr<ID3D12Resource> staging;
+    ThrowIfFailed(m_d3dDevice->CreateCommittedResource(&heapProperties, D3D12_HEAP_FLAG_NONE, &resourceDesc,
+        D3D12_RESOURCE_STATE_GENERIC_READ, nullptr, IID_PPV_ARGS(staging.GetAddressOf())));
+
+    const CD3DX12_RANGE readRange(0, 0);
+    void* stagingAddress;
+    ThrowIfFailed(staging->Map(0, &readRange, &stagingAddress));
+    memcpy(stagingAddress, data, static_cast<size_t>(size));
+    staging->Unmap(0, nullptr);
+
+    ID3D12Resource* const source = staging.Get();
+    return m_uploadScheduler->Enqueue({ destination, source, size }, std::move(staging));
+}
+
+void DeviceResources::SubmitUploads()
+{
+    m_uploadScheduler->Submit();
+}
+
+void DeviceResources::UseUpload(UploadTicket ticket)
+{
+    m_copyWaitValue = std::max(m_copyWaitValue, m_uploadScheduler->AcquireForUse(ticket));
+}
+
+CopyQueue::CopyQueue(ID3D12Device* device) noexcept(false) :
+    m_device(device),
+    m_fenceValue(0)
+{
+    D3D12_COMMAND_QUEUE_DESC queueDesc = {};
+    queueDesc.Flags = D3D12_COMMAND_QUEUE_FLAG_NONE;
+    queueDesc.Type = D3D12_COMMAND_LIST_TYPE_COPY;
+
+    ThrowIfFailed(device->CreateCommandQueue(&queueDesc, IID_PPV_ARGS(m_commandQueue.ReleaseAndGetAddressOf())));
+
+    m_commandQueue->SetName(L"DeviceResources Copy");
+
+    ThrowIfFailed(device->CreateFence(m_fenceValue, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(m_fence.ReleaseAndGetAddressOf())));
+
+    m_fence->SetName(L"DeviceResources Copy");
+
+    m_fenceEvent.Attach(CreateEventEx(nullptr, nullptr, 0, EVENT_MODIFY_STATE | SYNCHRONIZE));
+    if (!m_fenceEvent.IsValid())
+    {
+        throw std::system_error(std::error_code(static_cast<int>(GetLastError()), std::system_category()), "CreateEventEx");
+    }
+}
+
+// Record the copies with the oldest command allocator the GPU is done with, or a new one, then execute and signal.
+UINT64 CopyQueue::Submit(std::span<const Copy> copies)
+{
+    ComPtr<ID3D12CommandAllocator> allocator;
+    if (!m_allocators.empty() && m_allocators.front().fenceValue <= m_fence->GetCompletedValue())
+    {
+        allocator = std::move(m_allocators.front().allocator);
+        m_allocators.pop_front();
+        ThrowIfFailed(allocator->Reset());
+    }
+    else
+    {
+        ThrowIfFailed(m_device->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_COPY, IID_PPV_ARGS(allocator.GetAddressOf())));
+    }
+
+    if (m_commandList)
+    {
+        ThrowIfFailed(m_commandList->Reset(allocator.Get(), nullptr));
+    }
+    else
+    {
+        ThrowIfFailed(m_device->CreateCommandList(0, D3D12_COMMAND_LIST_TYPE_COPY, allocator.Get(), nullptr, IID_PPV_ARGS(m_commandList.ReleaseAndGetAddressOf())));
+
+        m_commandList->SetName(L"DeviceResources Copy");
+    }
+
+    for (const auto& copy : copies)
+    {
+        m_commandList->CopyBufferRegion(copy.destination, 0, copy.source, 0, copy.size);
+    }
+
+    ThrowIfFailed(m_commandList->Close());
+    m_commandQueue->ExecuteCommandLists(1, CommandListCast(m_commandList.GetAddressOf()));
+
+    ThrowIfFailed(m_commandQueue->Signal(m_fence.Get(), ++m_fenceValue));
+
+    m_allocators.push_back({ std::move(allocator), m_fenceValue });
+    return m_fenceValue;
+}
+
+// Wait for every submitted copy to complete.
+void CopyQueue::WaitForGpu() noexcept
+{
+    if (m_fence->GetCompletedValue() < m_fenceValue
+        && SUCCEEDED(m_fence->SetEventOnCompletion(m_fenceValue, m_fenceEvent.Get())))
+    {
+        WaitForSingleObjectEx(m_fenceEvent.Get(), INFINITE, FALSE);
+    }
+}
+
 // This method acquires the first available hardware adapter that supports Direct3D 12.
 // If no such adapter can be found, try WARP. Otherwise throw an exception.
 void DeviceResources::GetAdapter(IDXGIAdapter1** ppAdapter)
@@ -4,6 +4,15 @@
 
 #pragma once
 
+#include "PipelineStateCache.h"
+#include "ResourceStateTracker.h"
+#include "UploadRing.h"
+#include "UploadScheduler.h"
+
+#include <deque>
+#include <span>
+#include <vector>
+
 namespace DX
 {
     // Provides an interface for an application that owns DeviceResources to be notified of the device being lost or created.
@@ -16,6 +25,59 @@ namespace DX
         ~IDeviceNotify() = default;
     };
 
+    using D3D12ResourceStateTracker = ResourceStateTracker<ID3D12Resource*, D3D12_RESOURCE_STATES,
+        D3D12_RESOURCE_STATES(D3D12_RESOURCE_STATE_GENERIC_READ | D3D12_RESOURCE_STATE_DEPTH_READ),
+        D3D12_RESOURCE_STATES(D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE | D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE |
+            D3D12_RESOURCE_STATE_COPY_DEST | D3D12_RESOURCE_STATE_COPY_SOURCE)>;
+
+    // A sub-allocation of the upload heap, writable through cpuAddress until the GPU has finished the frame it was made in.
+    struct UploadAllocation
+    {
+        ID3D12Resource*             resource;
+        UINT64                      offset;
+        void*                       cpuAddress;
+        D3D12_GPU_VIRTUAL_ADDRESS   gpuAddress;
+    };
+
+    // A copy queue with its own fence. Command allocators are reused once the copies recorded with them have completed.
+    class CopyQueue
+    {
+    public:
+        // Copies a whole buffer into the start of another.
+        struct Copy
+        {
+            ID3D12Resource* destination;
+            ID3D12Resource* source;
+            UINT64          size;
+        };
+
+        using Staging = Microsoft::WRL::ComPtr<ID3D12Resource>;
+
+        explicit CopyQueue(ID3D12Device* device) noexcept(false);
+
+        UINT64 Submit(std::span<const Copy> copies);
+        UINT64 GetCompletedValue() const noexcept { return m_fence->GetCompletedValue(); }
+        void WaitForGpu() noexcept;
+
+        ID3D12CommandQueue* GetCommandQueue() const noexcept { return m_commandQueue.Get(); }
+        ID3D12Fence*        GetFence() const noexcept        { return m_fence.Get(); }
+
+    private:
+        struct Allocator
+        {
+            Microsoft::WRL::ComPtr<ID3D12CommandAllocator>  allocator;
+            UINT64                                          fenceValue;
+        };
+
+        Microsoft::WRL::ComPtr<ID3D12Device>                m_device;
+        Microsoft::WRL::ComPtr<ID3D12CommandQueue>          m_commandQueue;
+        Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList>   m_commandList;
+        std::deque<Allocator>                               m_allocators;
+        Microsoft::WRL::ComPtr<ID3D12Fence>                 m_fence;
+        UINT64                                              m_fenceValue;
+        Microsoft::WRL::Wrappers::Event                     m_fenceEvent;
+    };
+
     // Controls all the DirectX device resources.
     class DeviceResources
     {
@@ -27,7 +89,8 @@ namespace DX
                         DXGI_FORMAT depthBufferFormat = DXGI_FORMAT_D32_FLOAT,
                         UINT backBufferCount = 2,
                         D3D_FEATURE_LEVEL minFeatureLevel = D3D_FEATURE_LEVEL_11_0,
-                        unsigned int flags = 0) noexcept(false);
+                        unsigned int flags = 0,
+                        UINT64 uploadHeapSize = 32 * 1024 * 1024) noexcept(false);
         ~DeviceResources();
 
         DeviceResources(DeviceResources&&) = default;
@@ -45,8 +108,32 @@ namespace DX
         void Prepare(D3D12_RESOURCE_STATES beforeState = D3D12_RESOURCE_STATE_PRESENT,
                      D3D12_RESOURCE_STATES afterState = D3D12_RESOURCE_STATE_RENDER_TARGET);
         void Present(D3D12_RESOURCE_STATES beforeState = D3D12_RESOURCE_STATE_RENDER_TARGET);
+
+        // Transitions of the command list go through the state tracker; pending barriers must be flushed before commands
+        // that use the resources. Resources the command list transitions without giving their state first must be in the
+        // global states, which already know the render targets and the depth stencil; Present resolves them.
+        D3D12ResourceStateTracker& GetResourceStateTracker() noexcept { return m_stateTracker; }
+        D3D12ResourceStateTracker::GlobalStates& GetResourceStates() noexcept { return m_resourceStates; }
+        void FlushResourceBarriers();
         void WaitForGpu() noexcept;
 
+        // Thread-safe; allocations made before Present belong to the frame it submits. Returns false if the frames in
+        // flight leave no room, or the size exceeds the heap.
+        bool AllocateUpload(UINT64 size, UINT64 alignment, UploadAllocation& allocation) noexcept;
+
+        // Stages data and enqueues its copy into destination, a buffer in the common state, on the copy queue; copies are
+        // submitted by SubmitUploads, UseUpload or Present. The buffer is back in the common state once the copy completes.
+        UploadTicket UploadBuffer(ID3D12Resource* destination, const void* data, UINT64 size);
+        void SubmitUploads();
+        bool IsUploadComplete(UploadTicket ticket) const noexcept { return !m_uploadScheduler || m_uploadScheduler->IsComplete(ticket); }
+
+        // Holds back the command list of the current frame until the upload has completed; call before its first use.
+        void UseUpload(UploadTicket ticket);
+
+        // Where the pipeline state cache of devices created from now on is loaded from and saved to; empty keeps it in
+        // memory only. The cache is saved when DeviceResources is destroyed, and may be saved earlier with Save.
+        void SetPipelineCachePath(std::filesystem::path path) { m_pipelineCachePath = std::move(path); }
+
         // Device Accessors.
         RECT GetOutputSize() const noexcept { return m_outputSize; }
 
@@ -61,6 +148,8 @@ namespace DX
         ID3D12CommandQueue*         GetCommandQueue() const noexcept       { return m_commandQueue.Get(); }
         ID3D12CommandAllocator*     GetCommandAllocator() const noexcept   { return m_commandAllocators[m_backBufferIndex].Get(); }
         auto                        GetCommandList() const noexcept        { return m_commandList.Get(); }
+        ID3D12Resource*             GetUploadHeap() const noexcept         { return m_uploadHeap.Get(); }
+        PipelineStateCache*         GetPipelineStateCache() const noexcept { return m_pipelineStateCache.get(); }
         DXGI_FORMAT                 GetBackBufferFormat() const noexcept   { return m_backBufferFormat; }
         DXGI_FORMAT                 GetDepthBufferFormat() const noexcept  { return m_depthBufferFormat; }
         D3D12_VIEWPORT              GetScreenViewport() const noexcept     { return m_screenViewport; }
@@ -83,6 +172,7 @@ namespace DX
 
     private:
         void MoveToNextFrame();
+        void RecordBarriers(ID3D12GraphicsCommandList* commandList, std::span<const D3D12ResourceStateTracker::Barrier> barriers);
         void GetAdapter(IDXGIAdapter1** ppAdapter);
         void UpdateColorSpace();
 
@@ -107,10 +197,31 @@ namespace DX
         UINT64                                              m_fenceValues[MAX_BACK_BUFFER_COUNT];
         Microsoft::WRL::Wrappers::Event                     m_fenceEvent;
 
+        // Upload heap, persistently mapped and shared by the frames in flight.
+        Microsoft::WRL::ComPtr<ID3D12Resource>              m_uploadHeap;
+        std::unique_ptr<UploadRing>                         m_uploadRing;
+        uint8_t*                                            m_uploadHeapAddress;
+        UINT64                                              m_uploadHeapSize;
+
+        // Buffer uploads on the copy queue, and the copy fence value the current frame waits on.
+        std::unique_ptr<UploadScheduler<CopyQueue>>         m_uploadScheduler;
+        UINT64                                              m_copyWaitValue;
+
+        // Resource states of the command list and between frames, and the barriers of the last flush.
+        D3D12ResourceStateTracker                           m_stateTracker;
+        D3D12ResourceStateTracker::GlobalStates             m_resourceStates;
+        std::vector<D3D12_RESOURCE_BARRIER>                 m_barriers;
+
+        // Barriers resolved on submission, executed just before the command list of the frame.
+        Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList>   m_resolveCommandList;
+        Microsoft::WRL::ComPtr<ID3D12CommandAllocator>      m_resolveCommandAllocators[MAX_BACK_BUFFER_COUNT];
+
         // Direct3D rendering objects.
         Microsoft::WRL::ComPtr<ID3D12DescriptorHeap>        m_rtvDescriptorHeap;
         Microsoft::WRL::ComPtr<ID3D12DescriptorHeap>        m_dsvDescriptorHeap;
         UINT                                                m_rtvDescriptorSize;
+        std::unique_ptr<PipelineStateCache>                 m_pipelineStateCache;
+        std::filesystem::path                               m_pipelineCachePath;
         D3D12_VIEWPORT                                      m_screenViewport;
         D3D12_RECT                                          m_scissorRect;
 
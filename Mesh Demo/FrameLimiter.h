@@ -0,0 +1,251 @@
+//
+// FrameLimiter.h - Paces frames to a target frame time by sleeping, then spinning on the clock
+//
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <concepts>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <thread>
+#include <utility>
+
+#include "StepTimer.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+#if defined(_WIN32) && !defined(CREATE_WAITABLE_TIMER_HIGH_RESOLUTION)
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+
+
+namespace DX
+{
+    // A clock that waits by itself, e.g. a VirtualClock advancing by the counts asked for, replaces sleeping and spinning.
+    template<typename T>
+    concept SleepableStepTimerClock = StepTimerClock<T> && requires(T& clock, uint64_t counts)
+    {
+        clock.Sleep(counts);
+    };
+
+    struct FrameLimiterStatistics
+    {
+        uint64_t frameCount;        // Waits since the last reset
+        uint64_t lateFrameCount;    // Waits that found their deadline already passed and returned at once
+        double meanJitterSeconds;   // How long after its deadline each on-time wait returned
+        double rmsJitterSeconds;
+        double maxJitterSeconds;
+    };
+
+    // Keeps frames at least a target time apart. The OS sleep is too coarse on its own, so each wait sleeps until
+    // the spin time before the deadline and spins on the clock for the rest.
+    //
+    // Deadlines advance by exactly the target from one frame to the next, so a slightly late frame is made up by the
+    // following one; once a frame is more than a whole target late, the schedule restarts from it instead of
+    // bunching the frames that follow.
+    template<StepTimerClock TClock>
+    class BasicFrameLimiter
+    {
+    public:
+        explicit BasicFrameLimiter(TClock clock = TClock()) noexcept(false) :
+            m_clock(std::move(clock)),
+            m_targetElapsedCounts(0),
+            m_spinCounts(0),
+            m_nextDeadline(0),
+            m_isScheduled(false),
+            m_frameCount(0),
+            m_lateFrameCount(0),
+            m_jitterSum(0),
+            m_jitterSquareSum(0),
+            m_maxJitter(0)
+        {
+            m_clockFrequency = m_clock.GetFrequency();
+
+            // Spin for the last millisecond by default.
+            SetSpinSeconds(0.001);
+
+#if defined(_WIN32)
+            if constexpr (!SleepableStepTimerClock<TClock>)
+            {
+                // A high resolution timer wakes within about half a millisecond, where Sleep rounds up to the
+                // scheduler period of up to 15.6 ms; it is only available on Windows 10 1803 and later.
+                m_timer.reset(CreateWaitableTimerExW(nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS));
+                if (!m_timer)
+                {
+                    m_timer.reset(CreateWaitableTimerExW(nullptr, nullptr, 0, TIMER_ALL_ACCESS));
+                    if (!m_timer)
+                    {
+                        throw std::exception();
+                    }
+                }
+            }
+#endif
+        }
+
+        // Get the clock source, e.g. to advance a VirtualClock.
+        TClock& GetClock() noexcept { return m_clock; }
+        const TClock& GetClock() const noexcept { return m_clock; }
+
+        // Set the minimum time between the returns of consecutive Wait calls; 0 turns the limiter off.
+        void SetTargetElapsedSeconds(double targetElapsed) noexcept
+        {
+            m_targetElapsedCounts = SecondsToCounts(targetElapsed);
+            m_isScheduled = false;
+        }
+        double GetTargetElapsedSeconds() const noexcept { return CountsToSeconds(m_targetElapsedCounts); }
+
+        // Set how long before each deadline to stop sleeping and start spinning. It needs to cover how late
+        // the OS sleep may wake up; more spinning costs CPU time, less lets frames start late.
+        void SetSpinSeconds(double spin) noexcept { m_spinCounts = SecondsToCounts(spin); }
+
+        // Block until the target time has passed since the previous deadline. Calling this right before a frame
+        // samples its input, rather than after it presents, keeps the wait from adding to input latency.
+        void Wait()
+        {
+            if (!m_targetElapsedCounts)
+            {
+                return;
+            }
+
+            uint64_t currentTime = m_clock.GetCount();
+
+            if (!m_isScheduled)
+            {
+                m_isScheduled = true;
+                m_nextDeadline = currentTime + m_targetElapsedCounts;
+                return;
+            }
+
+            const uint64_t deadline = m_nextDeadline;
+
+            m_frameCount++;
+
+            if (currentTime >= deadline)
+            {
+                m_lateFrameCount++;
+
+                m_nextDeadline = (currentTime - deadline >= m_targetElapsedCounts ? currentTime : deadline) + m_targetElapsedCounts;
+                return;
+            }
+
+            if constexpr (SleepableStepTimerClock<TClock>)
+            {
+                m_clock.Sleep(deadline - currentTime);
+            }
+            else
+            {
+                if (deadline - currentTime > m_spinCounts)
+                {
+                    SleepFor(deadline - currentTime - m_spinCounts);
+                }
+
+                while (m_clock.GetCount() < deadline)
+                {
+                    Pause();
+                }
+            }
+
+            currentTime = m_clock.GetCount();
+
+            const double jitter = CountsToSeconds(currentTime - deadline);
+            m_jitterSum += jitter;
+            m_jitterSquareSum += jitter * jitter;
+            m_maxJitter = std::max(m_maxJitter, jitter);
+
+            m_nextDeadline = deadline + m_targetElapsedCounts;
+        }
+
+        // After an intentional timing discontinuity (for instance a blocking IO operation), call this to start a
+        // new schedule from the next Wait rather than counting the frame as late.
+        void ResetSchedule() noexcept { m_isScheduled = false; }
+
+        FrameLimiterStatistics GetStatistics() const noexcept
+        {
+            FrameLimiterStatistics statistics{ m_frameCount, m_lateFrameCount, 0, 0, 0 };
+
+            const uint64_t onTimeFrameCount = m_frameCount - m_lateFrameCount;
+            if (onTimeFrameCount)
+            {
+                statistics.meanJitterSeconds = m_jitterSum / static_cast<double>(onTimeFrameCount);
+                statistics.rmsJitterSeconds = std::sqrt(m_jitterSquareSum / static_cast<double>(onTimeFrameCount));
+                statistics.maxJitterSeconds = m_maxJitter;
+            }
+
+            return statistics;
+        }
+
+        void ResetStatistics() noexcept
+        {
+            m_frameCount = 0;
+            m_lateFrameCount = 0;
+            m_jitterSum = 0;
+            m_jitterSquareSum = 0;
+            m_maxJitter = 0;
+        }
+
+    private:
+        TClock m_clock;
+
+        // Timing data uses clock units.
+        uint64_t m_clockFrequency;
+        uint64_t m_targetElapsedCounts;
+        uint64_t m_spinCounts;
+        uint64_t m_nextDeadline;
+        bool m_isScheduled;
+
+        // Members for tracking jitter; the sums are in seconds.
+        uint64_t m_frameCount;
+        uint64_t m_lateFrameCount;
+        double m_jitterSum;
+        double m_jitterSquareSum;
+        double m_maxJitter;
+
+#if defined(_WIN32)
+        struct HandleCloser { void operator()(HANDLE h) const noexcept { CloseHandle(h); } };
+        std::unique_ptr<void, HandleCloser> m_timer;
+#endif
+
+        uint64_t SecondsToCounts(double seconds) const noexcept { return static_cast<uint64_t>(std::max(seconds, 0.) * static_cast<double>(m_clockFrequency)); }
+        double CountsToSeconds(uint64_t counts) const noexcept { return static_cast<double>(counts) / static_cast<double>(m_clockFrequency); }
+
+        void SleepFor(uint64_t counts) const
+        {
+#if defined(_WIN32)
+            // Negative due times are relative, in 100 ns units.
+            LARGE_INTEGER dueTime;
+            dueTime.QuadPart = -static_cast<LONGLONG>(CountsToSeconds(counts) * 10000000);
+
+            if (!SetWaitableTimerEx(m_timer.get(), &dueTime, 0, nullptr, nullptr, nullptr, 0)
+                || WaitForSingleObject(m_timer.get(), INFINITE) != WAIT_OBJECT_0)
+            {
+                throw std::exception();
+            }
+#else
+            std::this_thread::sleep_for(std::chrono::duration<double>(CountsToSeconds(counts)));
+#endif
+        }
+
+        static void Pause() noexcept
+        {
+#if defined(_WIN32)
+            YieldProcessor();
+#elif defined(__x86_64__) || defined(__i386__)
+            _mm_pause();
+#else
+            std::this_thread::yield();
+#endif
+        }
+    };
+
+#if defined(_WIN32)
+    using FrameLimiter = BasicFrameLimiter<QpcClock>;
+#else
+    using FrameLimiter = BasicFrameLimiter<SteadyClock>;
+#endif
+}
@@ -0,0 +1,343 @@
+//
+// FrameStatistics.h - Rolling and cumulative frame time statistics
+//
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <ostream>
+#include <vector>
+
+
+namespace DX
+{
+    struct FrameTimeSummary
+    {
+        uint64_t frameCount;
+        uint64_t framesOverBudget;
+        double minSeconds;
+        double averageSeconds;
+        double p50Seconds;
+        double p95Seconds;
+        double p99Seconds;
+        double maxSeconds;
+    };
+
+    // Collects the time of every frame, in StepTimer ticks, into a ring of the most recent frames and a
+    // log-linear histogram of all frames (each power of two split into c_SubBucketCount linear buckets,
+    // so histogram percentiles are within about 2%).
+    //
+    // AddFrame must only be called from one thread (the one calling StepTimer::Tick) and never blocks.
+    // Summaries and exports may be taken from any thread; they copy a consistent snapshot, retrying if
+    // a frame was added during the copy.
+    class FrameStatistics
+    {
+    public:
+        static constexpr size_t c_HistoryLength = 1024;
+
+        static constexpr uint32_t c_SubBucketBits = 5;
+        static constexpr uint32_t c_SubBucketCount = 1u << c_SubBucketBits;
+        static constexpr size_t c_BucketCount = (64 - c_SubBucketBits + 1) * c_SubBucketCount;
+
+        static constexpr uint64_t TicksPerSecond = 10000000;
+
+        explicit FrameStatistics(uint64_t budgetTicks = TicksPerSecond / 60) noexcept :
+            m_budgetTicks(budgetTicks),
+            m_sequence(0),
+            m_frameCount(0),
+            m_framesOverBudget(0),
+            m_totalTicks(0),
+            m_minTicks(std::numeric_limits<uint64_t>::max()),
+            m_maxTicks(0),
+            m_history{},
+            m_buckets{}
+        {
+        }
+
+        FrameStatistics(FrameStatistics const&) = delete;
+        FrameStatistics& operator=(FrameStatistics const&) = delete;
+
+        // Frames longer than the budget are counted as over budget.
+        void SetBudgetTicks(uint64_t budgetTicks) noexcept { m_budgetTicks.store(budgetTicks, std::memory_order_relaxed); }
+        uint64_t GetBudgetTicks() const noexcept { return m_budgetTicks.load(std::memory_order_relaxed); }
+
+        void AddFrame(uint64_t ticks) noexcept
+        {
+            // Only this thread writes, so plain loads and stores of the atomics suffice; the odd sequence number
+            // tells readers that a write is in progress.
+            const uint64_t sequence = m_sequence.load(std::memory_order_relaxed);
+            m_sequence.store(sequence + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+
+            const uint64_t frameCount = m_frameCount.load(std::memory_order_relaxed);
+            m_history[frameCount % c_HistoryLength].store(ticks, std::memory_order_relaxed);
+
+            auto& bucket = m_buckets[GetBucketIndex(ticks)];
+            bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+            if (ticks > m_budgetTicks.load(std::memory_order_relaxed))
+            {
+                m_framesOverBudget.store(m_framesOverBudget.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            }
+
+            m_totalTicks.store(m_totalTicks.load(std::memory_order_relaxed) + ticks, std::memory_order_relaxed);
+            m_minTicks.store(std::min(m_minTicks.load(std::memory_order_relaxed), ticks), std::memory_order_relaxed);
+            m_maxTicks.store(std::max(m_maxTicks.load(std::memory_order_relaxed), ticks), std::memory_order_relaxed);
+            m_frameCount.store(frameCount + 1, std::memory_order_relaxed);
+
+            m_sequence.store(sequence + 2, std::memory_order_release);
+        }
+
+        // Exact statistics of the last c_HistoryLength frames.
+        FrameTimeSummary GetRecentSummary() const
+        {
+            return TakeSnapshot().GetRecentSummary();
+        }
+
+        // Statistics of all frames; percentiles are the midpoints of histogram buckets.
+        FrameTimeSummary GetSummary() const
+        {
+            return TakeSnapshot().GetSummary();
+        }
+
+        // One row per recent frame, oldest first.
+        void WriteCsv(std::ostream& stream) const
+        {
+            const Snapshot snapshot = TakeSnapshot();
+
+            const std::vector<uint64_t> ticks = snapshot.GetRecentTicks();
+            const uint64_t firstFrame = snapshot.frameCount - ticks.size();
+
+            stream << "Frame,Milliseconds\n";
+            for (size_t i = 0; i < ticks.size(); ++i)
+            {
+                stream << firstFrame + i << ',' << TicksToSeconds(ticks[i]) * 1000. << '\n';
+            }
+        }
+
+        // Both summaries and the non-empty histogram buckets.
+        void WriteJson(std::ostream& stream) const
+        {
+            const Snapshot snapshot = TakeSnapshot();
+
+            const auto WriteSummary = [&](const char* name, const FrameTimeSummary& summary)
+            {
+                stream << "  \"" << name << "\": { \"frames\": " << summary.frameCount
+                    << ", \"overBudget\": " << summary.framesOverBudget
+                    << ", \"minMs\": " << summary.minSeconds * 1000.
+                    << ", \"avgMs\": " << summary.averageSeconds * 1000.
+                    << ", \"p50Ms\": " << summary.p50Seconds * 1000.
+                    << ", \"p95Ms\": " << summary.p95Seconds * 1000.
+                    << ", \"p99Ms\": " << summary.p99Seconds * 1000.
+                    << ", \"maxMs\": " << summary.maxSeconds * 1000. << " },\n";
+            };
+
+            stream << "{\n";
+            stream << "  \"budgetMs\": " << TicksToSeconds(snapshot.budgetTicks) * 1000. << ",\n";
+            WriteSummary("recent", snapshot.GetRecentSummary());
+            WriteSummary("all", snapshot.GetSummary());
+
+            stream << "  \"histogram\": [";
+            bool first = true;
+            for (size_t i = 0; i < c_BucketCount; ++i)
+            {
+                if (snapshot.buckets[i])
+                {
+                    stream << (first ? "\n" : ",\n") << "    { \"fromMs\": " << TicksToSeconds(GetBucketLowerBound(i)) * 1000.
+                        << ", \"toMs\": " << TicksToSeconds(GetBucketUpperBound(i)) * 1000.
+                        << ", \"frames\": " << snapshot.buckets[i] << " }";
+                    first = false;
+                }
+            }
+            stream << (first ? "]\n" : "\n  ]\n") << "}\n";
+        }
+
+        static constexpr double TicksToSeconds(uint64_t ticks) noexcept { return static_cast<double>(ticks) / TicksPerSecond; }
+
+        // Values below c_SubBucketCount get one bucket each; above, every power of two [2^e, 2^(e+1)) is split into
+        // c_SubBucketCount buckets of width 2^(e - c_SubBucketBits).
+        static constexpr size_t GetBucketIndex(uint64_t ticks) noexcept
+        {
+            if (ticks < c_SubBucketCount)
+            {
+                return static_cast<size_t>(ticks);
+            }
+
+            const uint32_t shift = static_cast<uint32_t>(std::bit_width(ticks)) - c_SubBucketBits - 1;
+            return static_cast<size_t>(shift + 1) * c_SubBucketCount + static_cast<size_t>((ticks >> shift) - c_SubBucketCount);
+        }
+
+        static constexpr uint64_t GetBucketLowerBound(size_t index) noexcept
+        {
+            if (index < c_SubBucketCount)
+            {
+                return index;
+            }
+
+            const size_t shift = index / c_SubBucketCount - 1;
+            return static_cast<uint64_t>(index % c_SubBucketCount + c_SubBucketCount) << shift;
+        }
+
+        // Inclusive
+        static constexpr uint64_t GetBucketUpperBound(size_t index) noexcept
+        {
+            const size_t shift = index < c_SubBucketCount ? 0 : index / c_SubBucketCount - 1;
+            return GetBucketLowerBound(index) + (uint64_t(1) << shift) - 1;
+        }
+
+    private:
+        struct Snapshot
+        {
+            uint64_t budgetTicks;
+            uint64_t frameCount;
+            uint64_t framesOverBudget;
+            uint64_t totalTicks;
+            uint64_t minTicks;
+            uint64_t maxTicks;
+            std::array<uint64_t, c_HistoryLength> history;
+            std::array<uint64_t, c_BucketCount> buckets;
+
+            std::vector<uint64_t> GetRecentTicks() const
+            {
+                const size_t count = static_cast<size_t>(std::min<uint64_t>(frameCount, c_HistoryLength));
+
+                std::vector<uint64_t> ticks(count);
+                for (size_t i = 0; i < count; ++i)
+                {
+                    ticks[i] = history[(frameCount - count + i) % c_HistoryLength];
+                }
+                return ticks;
+            }
+
+            FrameTimeSummary GetRecentSummary() const
+            {
+                std::vector<uint64_t> ticks = GetRecentTicks();
+
+                FrameTimeSummary summary = {};
+                summary.frameCount = ticks.size();
+                if (ticks.empty())
+                {
+                    return summary;
+                }
+
+                uint64_t total = 0;
+                for (const uint64_t t : ticks)
+                {
+                    total += t;
+                    if (t > budgetTicks)
+                    {
+                        ++summary.framesOverBudget;
+                    }
+                }
+
+                std::sort(ticks.begin(), ticks.end());
+
+                const auto Percentile = [&](double p)
+                {
+                    // Nearest rank
+                    const size_t rank = static_cast<size_t>(std::ceil(p * static_cast<double>(ticks.size())));
+                    return TicksToSeconds(ticks[std::max<size_t>(rank, 1) - 1]);
+                };
+
+                summary.minSeconds = TicksToSeconds(ticks.front());
+                summary.averageSeconds = TicksToSeconds(total) / static_cast<double>(ticks.size());
+                summary.p50Seconds = Percentile(0.50);
+                summary.p95Seconds = Percentile(0.95);
+                summary.p99Seconds = Percentile(0.99);
+                summary.maxSeconds = TicksToSeconds(ticks.back());
+                return summary;
+            }
+
+            FrameTimeSummary GetSummary() const
+            {
+                FrameTimeSummary summary = {};
+                summary.frameCount = frameCount;
+                summary.framesOverBudget = framesOverBudget;
+                if (!frameCount)
+                {
+                    return summary;
+                }
+
+                const auto Percentile = [&](double p)
+                {
+                    const uint64_t rank = std::max<uint64_t>(static_cast<uint64_t>(std::ceil(p * static_cast<double>(frameCount))), 1);
+
+                    uint64_t count = 0;
+                    for (size_t i = 0; i < c_BucketCount; ++i)
+                    {
+                        count += buckets[i];
+                        if (count >= rank)
+                        {
+                            // The extremes are known exactly, which keeps the estimate within [min, max]
+                            const uint64_t middle = (GetBucketLowerBound(i) + GetBucketUpperBound(i)) / 2;
+                            return TicksToSeconds(std::clamp(middle, minTicks, maxTicks));
+                        }
+                    }
+                    return TicksToSeconds(maxTicks);
+                };
+
+                summary.minSeconds = TicksToSeconds(minTicks);
+                summary.averageSeconds = TicksToSeconds(totalTicks) / static_cast<double>(frameCount);
+                summary.p50Seconds = Percentile(0.50);
+                summary.p95Seconds = Percentile(0.95);
+                summary.p99Seconds = Percentile(0.99);
+                summary.maxSeconds = TicksToSeconds(maxTicks);
+                return summary;
+            }
+        };
+
+        std::atomic<uint64_t> m_budgetTicks;
+
+        // Seqlock: odd while AddFrame is writing
+        std::atomic<uint64_t> m_sequence;
+
+        std::atomic<uint64_t> m_frameCount;
+        std::atomic<uint64_t> m_framesOverBudget;
+        std::atomic<uint64_t> m_totalTicks;
+        std::atomic<uint64_t> m_minTicks;
+        std::atomic<uint64_t> m_maxTicks;
+
+        std::array<std::atomic<uint64_t>, c_HistoryLength> m_history;
+        std::array<std::atomic<uint64_t>, c_BucketCount> m_buckets;
+
+        Snapshot TakeSnapshot() const
+        {
+            Snapshot snapshot;
+            for (;;)
+            {
+                const uint64_t sequence = m_sequence.load(std::memory_order_acquire);
+                if (sequence & 1)
+                {
+                    continue;
+                }
+
+                snapshot.budgetTicks = m_budgetTicks.load(std::memory_order_relaxed);
+                snapshot.frameCount = m_frameCount.load(std::memory_order_relaxed);
+                snapshot.framesOverBudget = m_framesOverBudget.load(std::memory_order_relaxed);
+                snapshot.totalTicks = m_totalTicks.load(std::memory_order_relaxed);
+                snapshot.minTicks = m_minTicks.load(std::memory_order_relaxed);
+                snapshot.maxTicks = m_maxTicks.load(std::memory_order_relaxed);
+                for (size_t i = 0; i < c_HistoryLength; ++i)
+                {
+                    snapshot.history[i] = m_history[i].load(std::memory_order_relaxed);
+                }
+                for (size_t i = 0; i < c_BucketCount; ++i)
+                {
+                    snapshot.buckets[i] = m_buckets[i].load(std::memory_order_relaxed);
+                }
+
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (m_sequence.load(std::memory_order_relaxed) == sequence)
+                {
+                    return snapshot;
+                }
+            }
+        }
+    };
+}
@@ -0,0 +1,134 @@
+/*
+ * Header File: FrustumCullingBenchmark.h
+ * Last Update: 2026/10/18
+ *
+ * Copyright (C) Hydr10n@GitHub. All Rights Reserved.
+ */
+
+#pragma once
+
+#include "FrustumCulling.h"
+
+#include <DirectXCollision.h>
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace Hydr10n::Benchmarks {
+	/*
+	 * Measures the batch sphere and box tests of FrustumCulling.h against a plain loop testing one volume at a time, on
+	 * volumes scattered at random through a cube around a camera that sees about a tenth of them. Both write the same
+	 * visibility bits, up to volumes touching a plane, which the two may round differently.
+	 */
+	class FrustumCullingBenchmark {
+	public:
+		enum class VolumeType { Sphere, Box };
+
+		static constexpr const char* VolumeNames[]{ "spheres", "boxes" };
+
+		struct Options {
+			std::vector<uint32_t> ObjectCounts{ 1000, 100000, 1000000 };
+			// Each test is repeated until it has run this long.
+			double MinSeconds = 0.2;
+			float SceneExtent = 100, MinRadius = 0.5f, MaxRadius = 2;
+		};
+
+		struct Result {
+			uint32_t ObjectCount;
+			VolumeType Volume;
+			uint32_t VisibleCount, MismatchCount;
+			double ScalarNanosecondsPerObject, BatchNanosecondsPerObject;
+
+			double GetSpeedup() const { return BatchNanosecondsPerObject > 0 ? ScalarNanosecondsPerObject / BatchNanosecondsPerObject : 0; }
+		};
+
+		static std::vector<Result> Run() { return Run(Options()); }
+
+		static std::vector<Result> Run(const Options& options) {
+			using namespace DirectX;
+
+			if (!(options.MinRadius > 0 && options.MinRadius <= options.MaxRadius && options.MaxRadius < options.SceneExtent)) throw std::invalid_argument("Invalid frustum culling benchmark options");
+
+			const auto frustum = DX::FrustumPlanes::CreateFromMatrix(
+				XMMatrixLookAtRH(g_XMZero, XMVectorSet(0, 0, -1, 0), XMVectorSet(0, 1, 0, 0))
+				* XMMatrixPerspectiveFovRH(XM_PI / 3, 16.0f / 9, 0.1f, options.SceneExtent * 1.5f));
+
+			std::vector<Result> results;
+
+			for (const auto objectCount : options.ObjectCounts) {
+				std::mt19937 random(objectCount);
+				std::uniform_real_distribution<float> positions(-options.SceneExtent, options.SceneExtent), radii(options.MinRadius, options.MaxRadius);
+
+				std::vector<BoundingSphere> spheres(objectCount);
+				std::vector<BoundingBox> boxes(objectCount);
+				for (uint32_t i = 0; i < objectCount; i++) {
+					const XMFLOAT3 center{ positions(random), positions(random), positions(random) };
+					spheres[i] = { center, radii(random) };
+					boxes[i] = { center, { radii(random), radii(random), radii(random) } };
+				}
+
+				std::vector<uint32_t> scalarVisibility((objectCount + 31) / 32), batchVisibility(scalarVisibility.size());
+
+				for (const auto volume : { VolumeType::Sphere, VolumeType::Box }) {
+					Result result{ objectCount, volume, 0, 0, 0, 0 };
+
+					if (volume == VolumeType::Sphere) {
+						result.ScalarNanosecondsPerObject = Measure(objectCount, options.MinSeconds, [&] { CullScalar(frustum, spheres, scalarVisibility); });
+						result.BatchNanosecondsPerObject = Measure(objectCount, options.MinSeconds, [&] { DX::CullSpheres(frustum, spheres.data(), spheres.size(), batchVisibility.data()); });
+					}
+					else {
+						result.ScalarNanosecondsPerObject = Measure(objectCount, options.MinSeconds, [&] { CullScalar(frustum, boxes, scalarVisibility); });
+						result.BatchNanosecondsPerObject = Measure(objectCount, options.MinSeconds, [&] { DX::CullBoxes(frustum, boxes.data(), boxes.size(), batchVisibility.data()); });
+					}
+
+					for (size_t i = 0; i < scalarVisibility.size(); i++) {
+						result.VisibleCount += static_cast<uint32_t>(std::popcount(batchVisibility[i]));
+						result.MismatchCount += static_cast<uint32_t>(std::popcount(batchVisibility[i] ^ scalarVisibility[i]));
+					}
+
+					results.push_back(result);
+				}
+			}
+
+			return results;
+		}
+
+	private:
+		template <class T>
+		static double Measure(uint32_t objectCount, double minSeconds, const T& cull) {
+			uint64_t iterationCount = 0;
+			const auto start = std::chrono::steady_clock::now();
+			std::chrono::duration<double, std::nano> elapsed;
+			do {
+				cull();
+				iterationCount++;
+			} while ((elapsed = std::chrono::steady_clock::now() - start).count() < minSeconds * 1e9);
+			return objectCount ? elapsed.count() / static_cast<double>(iterationCount) / objectCount : 0;
+		}
+
+		static float GetDistance(const DX::FrustumPlanes& frustum, size_t plane, const DirectX::BoundingSphere& sphere) {
+			return frustum.x[plane] * sphere.Center.x + frustum.y[plane] * sphere.Center.y + frustum.z[plane] * sphere.Center.z + frustum.w[plane] + sphere.Radius;
+		}
+
+		static float GetDistance(const DX::FrustumPlanes& frustum, size_t plane, const DirectX::BoundingBox& box) {
+			return frustum.x[plane] * box.Center.x + frustum.y[plane] * box.Center.y + frustum.z[plane] * box.Center.z + frustum.w[plane]
+				+ std::abs(frustum.x[plane]) * box.Extents.x + std::abs(frustum.y[plane]) * box.Extents.y + std::abs(frustum.z[plane]) * box.Extents.z;
+		}
+
+		template <class T>
+		static void CullScalar(const DX::FrustumPlanes& frustum, const std::vector<T>& volumes, std::vector<uint32_t>& visibility) {
+			std::fill(visibility.begin(), visibility.end(), 0u);
+
+			for (size_t i = 0; i < volumes.size(); i++) {
+				auto isVisible = true;
+				for (size_t plane = 0; plane < 6 && isVisible; plane++) isVisible = GetDistance(frustum, plane, volumes[i]) >= 0;
+				if (isVisible) visibility[i / 32] |= 1u << (i % 32);
+			}
+		}
+	};
+}
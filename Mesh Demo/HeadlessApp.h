@@ -0,0 +1,123 @@
+/*
+ * Header File: HeadlessApp.h
+ * Last Update: 2026/10/18
+ *
+ * Copyright (C) Hydr10n@GitHub. All Rights Reserved.
+ */
+
+#pragma once
+
+#include "BenchmarkRun.h"
+#include "MeshScene.h"
+#include "StepTimer.h"
+
+#include "OrbitCameraState.h"
+
+namespace Hydr10n::Benchmarks {
+	/*
+	 * D3DApp's update and render loop on any backend, with a camera path in place of input and a virtual clock in place of
+	 * real time, so that runs are reproducible and need neither a window nor a GPU. Stage timings are collected as in a
+	 * D3DApp benchmark run.
+	 */
+	class HeadlessApp {
+	public:
+		struct Options {
+			double FrameRate = 60, UpdateRate = 60;
+			bool IsWireframe = false;
+		};
+
+		HeadlessApp(Rendering::IDevice& device, DX::CameraPath cameraPath) noexcept(false) : HeadlessApp(device, std::move(cameraPath), Options()) {}
+
+		HeadlessApp(Rendering::IDevice& device, DX::CameraPath cameraPath, const Options& options) noexcept(false) :
+			m_device(device), m_meshScene(device), m_benchmarkRun(std::move(cameraPath), {}), m_options(options) {
+			if (!(options.FrameRate > 0) || !(options.UpdateRate > 0)) throw std::invalid_argument("Frame and update rates must be positive");
+
+			m_stepTimer.SetFixedTimeStep(true);
+			m_stepTimer.SetTargetElapsedSeconds(1 / options.UpdateRate);
+
+			m_cameraState = m_previousCameraState = EvaluateCameraPath(0);
+		}
+
+		// Advances the virtual clock by one frame, runs the updates due by then and renders.
+		void Tick() {
+			m_stepTimer.GetClock().AdvanceSeconds(1 / m_options.FrameRate);
+
+			m_stepTimer.Tick([&] { m_benchmarkRun.Measure(FrameStage::Update, [&] { Update(); }); });
+
+			Render();
+
+			if (m_stepTimer.GetFrameCount()) m_benchmarkRun.EndFrame();
+		}
+
+		bool IsFinished() const { return m_benchmarkRun.IsFinished(m_stepTimer.GetTotalSeconds()); }
+
+		const DX::BasicStepTimer<DX::VirtualClock>& GetStepTimer() const { return m_stepTimer; }
+
+		const BenchmarkRun& GetBenchmarkRun() const { return m_benchmarkRun; }
+
+	private:
+		// As in D3DApp, and OrbitCamera's default projection.
+		static constexpr float MinCameraRadius = 1, MaxCameraRadius = 10;
+		static constexpr float FieldOfView = DirectX::XM_PI / 4, NearDistance = 0.1f, FarDistance = 10000;
+
+		Rendering::IDevice& m_device;
+
+		Rendering::MeshScene m_meshScene;
+
+		DX::BasicStepTimer<DX::VirtualClock> m_stepTimer;
+
+		BenchmarkRun m_benchmarkRun;
+
+		Options m_options;
+
+		DX::OrbitCameraState m_previousCameraState, m_cameraState;
+
+		DX::OrbitCameraState EvaluateCameraPath(double time) const {
+			using namespace DirectX;
+
+			XMVECTOR focus, rotation;
+			float radius;
+			m_benchmarkRun.GetCameraPath().Evaluate(time, focus, rotation, radius);
+
+			DX::OrbitCameraState state;
+			XMStoreFloat3(&state.focus, focus);
+			XMStoreFloat4(&state.rotation, rotation);
+			state.radius = std::clamp(radius, MinCameraRadius, MaxCameraRadius);
+			return state;
+		}
+
+		void Update() {
+			m_previousCameraState = m_cameraState;
+			m_cameraState = EvaluateCameraPath(m_stepTimer.GetTotalSeconds());
+		}
+
+		void Render() {
+			using namespace DirectX;
+			using namespace Hydr10n::Rendering;
+
+			if (!m_stepTimer.GetFrameCount()) return;
+
+			const auto outputSize = m_device.GetOutputSize();
+
+			SceneView view;
+			view.View = DX::OrbitCameraState::Lerp(m_previousCameraState, m_cameraState, static_cast<float>(m_stepTimer.GetInterpolationFactor())).GetView(false, &view.Position);
+			view.Projection = XMMatrixPerspectiveFovRH(FieldOfView, outputSize.Height ? static_cast<float>(outputSize.Width) / static_cast<float>(outputSize.Height) : 1, NearDistance, FarDistance);
+			view.Viewport = { 0, 0, static_cast<float>(outputSize.Width), static_cast<float>(outputSize.Height), 0, 1 };
+			view.ScissorRect = { 0, 0, static_cast<int32_t>(outputSize.Width), static_cast<int32_t>(outputSize.Height) };
+
+			const std::span<const SceneView> views(&view, 1);
+
+			m_benchmarkRun.Measure(FrameStage::Cull, [&] { m_meshScene.Cull(views); });
+
+			m_benchmarkRun.Measure(FrameStage::Draw, [&] {
+				auto& commandList = m_device.BeginFrame();
+
+				MeshScene::Clear(commandList);
+
+				m_meshScene.Draw(commandList, views, m_options.IsWireframe);
+			});
+
+			m_benchmarkRun.Measure(FrameStage::Present, [&] { m_device.Present(); });
+		}
+	};
+}
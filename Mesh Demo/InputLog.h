@@ -0,0 +1,177 @@
+/*
+ * Header File: InputLog.h
+ * Last Update: 2026/10/18
+ *
+ * Copyright (C) Hydr10n@GitHub. All Rights Reserved.
+ */
+
+#pragma once
+
+#include "GamePad.h"
+#include "Keyboard.h"
+#include "Mouse.h"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+
+namespace Hydr10n::Inputs {
+	// Everything one update reads: the StepTimer elapsed ticks and the states of all input devices.
+	struct InputFrame {
+		uint64_t ElapsedTicks;
+		DirectX::GamePad::State GamePads[DirectX::GamePad::MAX_PLAYER_COUNT];
+		DirectX::Keyboard::State Keyboard;
+		DirectX::Mouse::State Mouse;
+
+		/*
+		 * States are copied member by member over zeroed storage, leaving their padding bytes zero
+		 * so that identical input always compares and serializes to identical bytes.
+		 */
+		void Capture(uint64_t elapsedTicks, DirectX::GamePad& gamepad, DirectX::Keyboard& keyboard, DirectX::Mouse& mouse) {
+			std::memset(this, 0, sizeof(*this));
+
+			ElapsedTicks = elapsedTicks;
+
+			for (int i = 0; i < DirectX::GamePad::MAX_PLAYER_COUNT; i++) {
+				const auto state = gamepad.GetState(i);
+				auto& gamepadState = GamePads[i];
+				gamepadState.connected = state.connected;
+				gamepadState.packet = state.packet;
+				gamepadState.buttons = state.buttons;
+				gamepadState.dpad = state.dpad;
+				gamepadState.thumbSticks = state.thumbSticks;
+				gamepadState.triggers = state.triggers;
+			}
+
+			Keyboard = keyboard.GetState();
+
+			const auto state = mouse.GetState();
+			Mouse.leftButton = state.leftButton;
+			Mouse.middleButton = state.middleButton;
+			Mouse.rightButton = state.rightButton;
+			Mouse.xButton1 = state.xButton1;
+			Mouse.xButton2 = state.xButton2;
+			Mouse.x = state.x;
+			Mouse.y = state.y;
+			Mouse.scrollWheelValue = state.scrollWheelValue;
+			Mouse.positionMode = state.positionMode;
+		}
+	};
+
+	/*
+	 * Layout:
+	 *   Header
+	 *   per update: uint16_t change mask, followed by the raw bytes of each InputFrame field whose bit is set
+	 *
+	 * Bit 0 is ElapsedTicks, bit 1 + i is GamePads[i], followed by Keyboard and Mouse. Fields that are not written keep
+	 * their value from the previous update (all zero before the first), so idle input at a fixed timestep costs two bytes
+	 * per update. States are stored in their in-memory layout; the header records their sizes so that logs from an
+	 * incompatible build are rejected rather than misread.
+	 */
+	struct InputLog {
+		static constexpr uint32_t Magic = 0x54504E49; // "INPT"
+		static constexpr uint16_t Version = 1;
+
+		static constexpr uint16_t ElapsedTicksBit = 0x1;
+		static constexpr uint16_t GamePadBit(int player) { return static_cast<uint16_t>(0x2 << player); }
+		static constexpr uint16_t KeyboardBit = static_cast<uint16_t>(0x2 << DirectX::GamePad::MAX_PLAYER_COUNT), MouseBit = KeyboardBit << 1;
+
+		static_assert(DirectX::GamePad::MAX_PLAYER_COUNT <= 13);
+
+		struct Header {
+			uint32_t Magic;
+			uint16_t Version, HeaderSize;
+			uint16_t PlayerCount, GamePadStateSize, KeyboardStateSize, MouseStateSize;
+		};
+
+		static constexpr Header CurrentHeader{
+			Magic, Version, sizeof(Header),
+			DirectX::GamePad::MAX_PLAYER_COUNT, sizeof(DirectX::GamePad::State), sizeof(DirectX::Keyboard::State), sizeof(DirectX::Mouse::State)
+		};
+	};
+
+	class InputRecorder {
+	public:
+		explicit InputRecorder(const std::filesystem::path& path) noexcept(false) : m_file(path, std::ios::binary | std::ios::trunc) {
+			if (!m_file) throw std::runtime_error("Failed to create input log");
+
+			std::memset(&m_lastFrame, 0, sizeof(m_lastFrame));
+
+			Write(&InputLog::CurrentHeader, sizeof(InputLog::CurrentHeader));
+		}
+
+		// Frames are expected to be filled by InputFrame::Capture or InputReplayer::Read, which leave padding bytes zero.
+		void Write(const InputFrame& frame) {
+			uint16_t mask = 0;
+			const auto Compare = [&](const auto& field, const auto& lastField, uint16_t bit) {
+				if (std::memcmp(&field, &lastField, sizeof(field))) mask |= bit;
+			};
+			Compare(frame.ElapsedTicks, m_lastFrame.ElapsedTicks, InputLog::ElapsedTicksBit);
+			for (int i = 0; i < DirectX::GamePad::MAX_PLAYER_COUNT; i++) Compare(frame.GamePads[i], m_lastFrame.GamePads[i], InputLog::GamePadBit(i));
+			Compare(frame.Keyboard, m_lastFrame.Keyboard, InputLog::KeyboardBit);
+			Compare(frame.Mouse, m_lastFrame.Mouse, InputLog::MouseBit);
+
+			Write(&mask, sizeof(mask));
+			if (mask & InputLog::ElapsedTicksBit) Write(&frame.ElapsedTicks, sizeof(frame.ElapsedTicks));
+			for (int i = 0; i < DirectX::GamePad::MAX_PLAYER_COUNT; i++) {
+				if (mask & InputLog::GamePadBit(i)) Write(&frame.GamePads[i], sizeof(frame.GamePads[i]));
+			}
+			if (mask & InputLog::KeyboardBit) Write(&frame.Keyboard, sizeof(frame.Keyboard));
+			if (mask & InputLog::MouseBit) Write(&frame.Mouse, sizeof(frame.Mouse));
+
+			std::memcpy(&m_lastFrame, &frame, sizeof(frame));
+		}
+
+	private:
+		std::ofstream m_file;
+
+		InputFrame m_lastFrame;
+
+		void Write(const void* data, size_t size) {
+			if (!m_file.write(static_cast<const char*>(data), static_cast<std::streamsize>(size))) throw std::runtime_error("Failed to write input log");
+		}
+	};
+
+	class InputReplayer {
+	public:
+		explicit InputReplayer(const std::filesystem::path& path) noexcept(false) : m_file(path, std::ios::binary) {
+			if (!m_file) throw std::runtime_error("Failed to open input log");
+
+			std::memset(&m_frame, 0, sizeof(m_frame));
+
+			InputLog::Header header;
+			if (!m_file.read(reinterpret_cast<char*>(&header), sizeof(header))) throw std::runtime_error("Input log is truncated");
+			if (header.Magic != InputLog::Magic) throw std::runtime_error("Not an input log");
+			if (std::memcmp(&header, &InputLog::CurrentHeader, sizeof(header))) throw std::runtime_error("Unsupported input log version");
+		}
+
+		// Returns false once every recorded update has been read.
+		bool Read(InputFrame& frame) {
+			uint16_t mask;
+			if (!m_file.read(reinterpret_cast<char*>(&mask), sizeof(mask))) {
+				if (m_file.gcount()) throw std::runtime_error("Input log is truncated");
+				return false;
+			}
+
+			if (mask & InputLog::ElapsedTicksBit) Read(&m_frame.ElapsedTicks, sizeof(m_frame.ElapsedTicks));
+			for (int i = 0; i < DirectX::GamePad::MAX_PLAYER_COUNT; i++) {
+				if (mask & InputLog::GamePadBit(i)) Read(&m_frame.GamePads[i], sizeof(m_frame.GamePads[i]));
+			}
+			if (mask & InputLog::KeyboardBit) Read(&m_frame.Keyboard, sizeof(m_frame.Keyboard));
+			if (mask & InputLog::MouseBit) Read(&m_frame.Mouse, sizeof(m_frame.Mouse));
+
+			std::memcpy(&frame, &m_frame, sizeof(frame));
+			return true;
+		}
+
+	private:
+		std::ifstream m_file;
+
+		InputFrame m_frame;
+
+		void Read(void* data, size_t size) {
+			if (!m_file.read(static_cast<char*>(data), static_cast<std::streamsize>(size))) throw std::runtime_error("Input log is truncated");
+		}
+	};
+}
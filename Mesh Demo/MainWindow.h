@@ -4,12 +4,16 @@
 #include "WindowHelpers.h"
 
 #include "D3DApp.h"
+#include "FrameLimiter.h"
 
 #include "resource.h"
 
+#include <chrono>
+#include <format>
+
 class MainWindow : public Windows::WindowBase {
 public:
-	MainWindow() noexcept(false) :
+	explicit MainWindow(const D3DApp::LaunchOptions& options = {}) noexcept(false) :
 		WindowBase(
 			WNDCLASSEXW{
 				.hIcon = LoadIcon(GetModuleHandle(nullptr), MAKEINTRESOURCE(IDI_ICON_DIRECTX)),
@@ -26,7 +30,9 @@ public:
 		DX::ThrowIfFailed(GetClientRect(hWnd, &rc));
 		const SIZE outputSize{ rc.right - rc.left, rc.bottom - rc.top };
 
-		m_app = std::make_unique<decltype(m_app)::element_type>(hWnd, outputSize);
+		m_app = std::make_unique<decltype(m_app)::element_type>(hWnd, outputSize, options);
+
+		if (options.FrameRateLimit > 0) m_frameLimiter.SetTargetElapsedSeconds(1 / options.FrameRateLimit);
 
 		m_windowModeHelper.Window = hWnd;
 		m_windowModeHelper.ClientSize = outputSize;
@@ -42,7 +48,18 @@ public:
 				TranslateMessage(&msg);
 				DispatchMessageW(&msg);
 			}
-			else m_app->Tick();
+			else if (m_app->IsStarting()) {
+				// Messages are handled as they arrive while the startup tasks run; the first frame waits for the tasks.
+				if (!m_app->WaitForStartup(std::chrono::milliseconds(0))) MsgWaitForMultipleObjectsEx(0, nullptr, 1, QS_ALLINPUT, MWMO_INPUTAVAILABLE);
+			}
+			else {
+				// Waiting before the frame rather than after it lets the frame read the latest input.
+				m_frameLimiter.Wait();
+
+				m_app->Tick();
+
+				UpdateFrameLimiterTitle();
+			}
 		} while (msg.message != WM_QUIT);
 		return msg.wParam;
 	}
@@ -54,6 +71,22 @@ private:
 
 	std::unique_ptr<D3DApp> m_app;
 
+	DX::FrameLimiter m_frameLimiter;
+
+	// Shows the jitter of the frame limiter over about the last second.
+	void UpdateFrameLimiterTitle() {
+		const auto targetElapsedSeconds = m_frameLimiter.GetTargetElapsedSeconds();
+		if (!targetElapsedSeconds) return;
+
+		const auto statistics = m_frameLimiter.GetStatistics();
+		if (statistics.frameCount * targetElapsedSeconds < 1) return;
+
+		SetWindowTextW(GetHandle(), std::format(L"{} - {:.0f} fps cap, jitter {:.3f} ms mean, {:.3f} ms max, {} late",
+			DefaultTitle, 1 / targetElapsedSeconds, statistics.meanJitterSeconds * 1000, statistics.maxJitterSeconds * 1000, statistics.lateFrameCount).c_str());
+
+		m_frameLimiter.ResetStatistics();
+	}
+
 	LRESULT CALLBACK OnMessageReceived(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam) override {
 		using namespace DirectX;
 
@@ -107,7 +140,7 @@ private:
 		case WM_SIZE: {
 			switch (wParam) {
 			case SIZE_MINIMIZED: m_app->OnSuspending(); break;
-			case SIZE_RESTORED: m_app->OnResuming(); [[fallthrough]];
+			case SIZE_RESTORED: m_app->OnResuming(); m_frameLimiter.ResetSchedule(); [[fallthrough]];
 			default: m_app->OnWindowSizeChanged(m_windowModeHelper.ClientSize = { LOWORD(lParam), HIWORD(lParam) }); break;
 			}
 		}	break;
@@ -0,0 +1,414 @@
+/*
+ * Header File: MaskedOcclusionCulling.h
+ * Last Update: 2026/10/18
+ *
+ * Copyright (C) Hydr10n@GitHub. All Rights Reserved.
+ */
+
+#pragma once
+
+#include "WorkerPool.h"
+
+#include <DirectXCollision.h>
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define MASKED_OCCLUSION_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#define MASKED_OCCLUSION_TARGET_AVX2
+#else
+#define MASKED_OCCLUSION_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+namespace Hydr10n::Rendering {
+	enum class OcclusionResult { Visible, Occluded, ViewCulled };
+
+	/*
+	 * CPU occlusion culling after Intel's Masked Occlusion Culling. The buffer is split into 32x8 pixel tiles of eight
+	 * 8x4 subtiles, and instead of a depth per pixel each subtile keeps two layers: a reference depth behind which all
+	 * of its pixels are occluded, and a working layer made of a 32-bit mask of the pixels covered since and their
+	 * farthest depth. A full mask turns the working layer into the reference; a triangle much closer than the working
+	 * layer discards it first. Each tile also keeps the farthest reference depth of its subtiles, so that occluders and
+	 * occludees behind a whole tile are settled without looking at the subtiles.
+	 *
+	 * Depth is z/w in [0, 1] with 0 nearest. Results are conservative: occluders cover the pixels whose centers they
+	 * contain, occluder triangles crossing the near plane are skipped, and occludees are tested by the nearest depth of
+	 * their screen rectangle.
+	 */
+	class MaskedOcclusionCuller {
+	public:
+		static constexpr uint32_t TileWidth = 32, TileHeight = 8, SubtileWidth = 8, SubtileHeight = 4;
+
+		// With a worker pool, Flush sets up and bins occluder triangles on every worker, then rasterizes tiles in parallel.
+		MaskedOcclusionCuller(uint32_t width, uint32_t height, WorkerPool* pWorkerPool = nullptr) noexcept(false) :
+			m_width(width), m_height(height),
+			m_tileCountX((width + TileWidth - 1) / TileWidth), m_tileCountY((height + TileHeight - 1) / TileHeight),
+			m_tiles(static_cast<size_t>(m_tileCountX) * m_tileCountY),
+			m_workerPool(pWorkerPool), m_workers(pWorkerPool == nullptr ? 1 : pWorkerPool->GetThreadCount()) {
+			if (!width || !height) throw std::invalid_argument("Occlusion buffer size must be positive");
+
+			if (pWorkerPool != nullptr) for (auto& worker : m_workers) worker.Bins.resize(m_tiles.size());
+
+			Clear();
+		}
+
+		uint32_t GetWidth() const { return m_width; }
+
+		uint32_t GetHeight() const { return m_height; }
+
+		bool IsAVX2Enabled() const { return m_isAVX2Enabled; }
+
+		// AVX2 is used by default where the CPU supports it; enabling it elsewhere has no effect.
+		void SetAVX2Enabled(bool value) { m_isAVX2Enabled = value && HasAVX2(); }
+
+		void Clear() {
+			for (auto& tile : m_tiles) {
+				std::fill_n(tile.Masks, SubtileCount, 0);
+				std::fill_n(tile.ReferenceDepths, SubtileCount, 1.0f);
+				std::fill_n(tile.WorkingDepths, SubtileCount, 0.0f);
+				tile.MaxReferenceDepth = 1;
+			}
+		}
+
+		// Queues a triangle list until Flush; vertices and indices must stay alive until then.
+		void AddOccluder(std::span<const DirectX::XMFLOAT3> vertices, std::span<const uint32_t> indices, DirectX::FXMMATRIX worldViewProjection) {
+			Occluder occluder{ vertices, indices, {}, m_triangleCount };
+			DirectX::XMStoreFloat4x4(&occluder.WorldViewProjection, worldViewProjection);
+
+			m_occluders.push_back(occluder);
+			m_triangleCount += indices.size() / 3;
+		}
+
+		// Rasterizes the queued occluders in the order they were added.
+		void Flush() {
+			if (m_occluders.empty()) return;
+
+			if (m_workerPool == nullptr) SetUpTriangles(m_workers[0], 0, m_triangleCount, false);
+			else {
+				const auto workerCount = static_cast<uint32_t>(m_workers.size());
+				m_workerPool->Run(workerCount, [&](uint32_t i) { SetUpTriangles(m_workers[i], m_triangleCount * i / workerCount, m_triangleCount * (i + 1) / workerCount, true); });
+
+				m_workerPool->Run(static_cast<uint32_t>(m_tiles.size()), [&](uint32_t tile) {
+					for (const auto& worker : m_workers) {
+						for (const auto triangle : worker.Bins[tile]) RasterizeTriangle(worker.Triangles[triangle], tile);
+					}
+				});
+			}
+
+			m_occluders.clear();
+			m_triangleCount = 0;
+		}
+
+		// Tests a world-space box; occluders must have been flushed. Safe to call from several threads at once.
+		OcclusionResult XM_CALLCONV TestBox(const DirectX::BoundingBox& box, DirectX::FXMMATRIX viewProjection) const {
+			using namespace DirectX;
+
+			const auto center = XMLoadFloat3(&box.Center), extents = XMLoadFloat3(&box.Extents);
+
+			auto minX = FLT_MAX, minY = FLT_MAX, minZ = FLT_MAX, maxX = -FLT_MAX, maxY = -FLT_MAX;
+			for (uint32_t i = 0; i < 8; i++) {
+				const auto sign = XMVectorSet(i & 1 ? 1.0f : -1.0f, i & 2 ? 1.0f : -1.0f, i & 4 ? 1.0f : -1.0f, 0);
+				XMFLOAT4 corner;
+				XMStoreFloat4(&corner, XMVector3Transform(XMVectorMultiplyAdd(extents, sign, center), viewProjection));
+
+				// A box reaching past the near plane surrounds the camera or is about to; it is never occluded.
+				if (corner.z < 0 || corner.w <= 0) return OcclusionResult::Visible;
+
+				const auto invW = 1 / corner.w;
+				minX = std::min(minX, corner.x * invW);
+				maxX = std::max(maxX, corner.x * invW);
+				minY = std::min(minY, corner.y * invW);
+				maxY = std::max(maxY, corner.y * invW);
+				minZ = std::min(minZ, corner.z * invW);
+			}
+
+			return TestRect((minX + 1) * 0.5f * m_width, (1 - maxY) * 0.5f * m_height, (maxX + 1) * 0.5f * m_width, (1 - minY) * 0.5f * m_height, minZ);
+		}
+
+		// Tests a screen rectangle in pixels, nothing of which is nearer than minDepth.
+		OcclusionResult TestRect(float left, float top, float right, float bottom, float minDepth) const {
+			if (right < 0 || bottom < 0 || left > static_cast<float>(m_width) || top > static_cast<float>(m_height) || minDepth > 1) return OcclusionResult::ViewCulled;
+
+			// Pixels overlapping the rectangle.
+			const auto minPixelX = std::max(0, static_cast<int32_t>(std::floor(left))), minPixelY = std::max(0, static_cast<int32_t>(std::floor(top)));
+			const auto maxPixelX = std::min(static_cast<int32_t>(m_width) - 1, std::max(minPixelX, static_cast<int32_t>(std::ceil(right)) - 1));
+			const auto maxPixelY = std::min(static_cast<int32_t>(m_height) - 1, std::max(minPixelY, static_cast<int32_t>(std::ceil(bottom)) - 1));
+
+			const auto minSubtileX = minPixelX / static_cast<int32_t>(SubtileWidth), maxSubtileX = maxPixelX / static_cast<int32_t>(SubtileWidth);
+			const auto minSubtileY = minPixelY / static_cast<int32_t>(SubtileHeight), maxSubtileY = maxPixelY / static_cast<int32_t>(SubtileHeight);
+			constexpr auto SubtileCountX = static_cast<int32_t>(TileWidth / SubtileWidth), SubtileCountY = static_cast<int32_t>(TileHeight / SubtileHeight);
+
+			for (auto tileY = minSubtileY / SubtileCountY; tileY <= maxSubtileY / SubtileCountY; tileY++) {
+				for (auto tileX = minSubtileX / SubtileCountX; tileX <= maxSubtileX / SubtileCountX; tileX++) {
+					const auto& tile = m_tiles[static_cast<size_t>(tileY) * m_tileCountX + tileX];
+					if (minDepth >= tile.MaxReferenceDepth) continue;
+
+					for (auto y = std::max(minSubtileY, tileY * SubtileCountY); y <= std::min(maxSubtileY, tileY * SubtileCountY + SubtileCountY - 1); y++) {
+						for (auto x = std::max(minSubtileX, tileX * SubtileCountX); x <= std::min(maxSubtileX, tileX * SubtileCountX + SubtileCountX - 1); x++) {
+							if (minDepth < tile.ReferenceDepths[(y - tileY * SubtileCountY) * SubtileCountX + x - tileX * SubtileCountX]) return OcclusionResult::Visible;
+						}
+					}
+				}
+			}
+
+			return OcclusionResult::Occluded;
+		}
+
+		// The depth behind which the pixel is known to be occluded.
+		float GetReferenceDepth(uint32_t x, uint32_t y) const {
+			const auto& tile = m_tiles[static_cast<size_t>(y / TileHeight) * m_tileCountX + x / TileWidth];
+			return tile.ReferenceDepths[(y % TileHeight / SubtileHeight) * (TileWidth / SubtileWidth) + x % TileWidth / SubtileWidth];
+		}
+
+	private:
+		static constexpr uint32_t SubtileCount = (TileWidth / SubtileWidth) * (TileHeight / SubtileHeight);
+
+		struct alignas(32) Tile {
+			uint32_t Masks[SubtileCount];
+			float ReferenceDepths[SubtileCount], WorkingDepths[SubtileCount];
+			float MaxReferenceDepth;
+		};
+
+		struct Occluder {
+			std::span<const DirectX::XMFLOAT3> Vertices;
+			std::span<const uint32_t> Indices;
+			DirectX::XMFLOAT4X4 WorldViewProjection;
+			size_t FirstTriangle;
+		};
+
+		// Edge k is opposite vertex k and non-negative inside; depth is a plane through the first vertex, clamped to the vertex range.
+		struct Triangle {
+			int32_t MinX, MinY, MaxX, MaxY;
+			float EdgeA[3], EdgeB[3], EdgeC[3];
+			float OriginX, OriginY, OriginDepth, DepthStepX, DepthStepY;
+			float MinDepth, MaxDepth;
+		};
+
+		struct Worker {
+			std::vector<Triangle> Triangles;
+			std::vector<std::vector<uint32_t>> Bins;
+		};
+
+		uint32_t m_width, m_height, m_tileCountX, m_tileCountY;
+
+		std::vector<Tile> m_tiles;
+
+		WorkerPool* m_workerPool;
+		std::vector<Worker> m_workers;
+
+		std::vector<Occluder> m_occluders;
+		size_t m_triangleCount{};
+
+		bool m_isAVX2Enabled = HasAVX2();
+
+		static bool HasAVX2() {
+#ifdef MASKED_OCCLUSION_X86
+#ifdef _MSC_VER
+			static const auto s_hasAVX2 = [] {
+				int info[4];
+				__cpuid(info, 0);
+				if (info[0] < 7) return false;
+
+				__cpuid(info, 1);
+				constexpr int OSXSAVE = 1 << 27, AVX = 1 << 28;
+				if ((info[2] & (OSXSAVE | AVX)) != (OSXSAVE | AVX) || (_xgetbv(0) & 6) != 6) return false;
+
+				__cpuidex(info, 7, 0);
+				return (info[1] & (1 << 5)) != 0;
+			}();
+			return s_hasAVX2;
+#else
+			return __builtin_cpu_supports("avx2");
+#endif
+#else
+			return false;
+#endif
+		}
+
+		// With binning, triangles are kept and listed in the bins of the tiles they overlap; otherwise each is rasterized at once.
+		void SetUpTriangles(Worker& worker, size_t firstTriangle, size_t endTriangle, bool isBinning) {
+			using namespace DirectX;
+
+			worker.Triangles.clear();
+			if (isBinning) for (auto& bin : worker.Bins) bin.clear();
+
+			auto occluder = std::upper_bound(m_occluders.cbegin(), m_occluders.cend(), firstTriangle, [](size_t triangle, const Occluder& occluder) { return triangle < occluder.FirstTriangle; }) - 1;
+			for (auto triangle = firstTriangle; triangle < endTriangle; ++occluder) {
+				const auto worldViewProjection = XMLoadFloat4x4(&occluder->WorldViewProjection);
+				const auto occluderEndTriangle = std::min(endTriangle, occluder->FirstTriangle + occluder->Indices.size() / 3);
+
+				for (; triangle < occluderEndTriangle; triangle++) {
+					const auto firstIndex = (triangle - occluder->FirstTriangle) * 3;
+
+					XMFLOAT4 vertices[3];
+					bool isClipped = false;
+					for (size_t i = 0; i < 3; i++) {
+						XMStoreFloat4(&vertices[i], XMVector3Transform(XMLoadFloat3(&occluder->Vertices[occluder->Indices[firstIndex + i]]), worldViewProjection));
+						isClipped |= vertices[i].z < 0 || vertices[i].w <= 0;
+					}
+					if (isClipped) continue;
+
+					Triangle setup;
+					if (!SetUpTriangle(vertices, setup)) continue;
+
+					if (!isBinning) {
+						ForEachTile(setup, [&](uint32_t tile) { RasterizeTriangle(setup, tile); });
+						continue;
+					}
+
+					worker.Triangles.push_back(setup);
+					const auto index = static_cast<uint32_t>(worker.Triangles.size() - 1);
+					ForEachTile(setup, [&](uint32_t tile) { worker.Bins[tile].push_back(index); });
+				}
+			}
+		}
+
+		bool SetUpTriangle(const DirectX::XMFLOAT4(&vertices)[3], Triangle& triangle) const {
+			float x[3], y[3], z[3];
+			for (int i = 0; i < 3; i++) {
+				const auto invW = 1 / vertices[i].w;
+				x[i] = (vertices[i].x * invW + 1) * 0.5f * static_cast<float>(m_width);
+				y[i] = (1 - vertices[i].y * invW) * 0.5f * static_cast<float>(m_height);
+				z[i] = vertices[i].z * invW;
+			}
+
+			auto area = (x[1] - x[0]) * (y[2] - y[0]) - (x[2] - x[0]) * (y[1] - y[0]);
+			if (!(std::abs(area) > 0)) return false;
+			if (area < 0) {
+				std::swap(x[1], x[2]);
+				std::swap(y[1], y[2]);
+				std::swap(z[1], z[2]);
+				area = -area;
+			}
+
+			// Pixels whose centers lie within the bounding box.
+			triangle.MinX = std::max(0, static_cast<int32_t>(std::ceil(std::min({ x[0], x[1], x[2] }) - 0.5f)));
+			triangle.MinY = std::max(0, static_cast<int32_t>(std::ceil(std::min({ y[0], y[1], y[2] }) - 0.5f)));
+			triangle.MaxX = std::min(static_cast<int32_t>(m_width) - 1, static_cast<int32_t>(std::floor(std::max({ x[0], x[1], x[2] }) - 0.5f)));
+			triangle.MaxY = std::min(static_cast<int32_t>(m_height) - 1, static_cast<int32_t>(std::floor(std::max({ y[0], y[1], y[2] }) - 0.5f)));
+			if (triangle.MinX > triangle.MaxX || triangle.MinY > triangle.MaxY) return false;
+
+			for (int k = 0; k < 3; k++) {
+				const auto from = (k + 1) % 3, to = (k + 2) % 3;
+				triangle.EdgeA[k] = y[from] - y[to];
+				triangle.EdgeB[k] = x[to] - x[from];
+				triangle.EdgeC[k] = -(triangle.EdgeA[k] * x[from] + triangle.EdgeB[k] * y[from]);
+			}
+
+			const auto dx1 = x[1] - x[0], dy1 = y[1] - y[0], dx2 = x[2] - x[0], dy2 = y[2] - y[0], dz1 = z[1] - z[0], dz2 = z[2] - z[0];
+			triangle.OriginX = x[0];
+			triangle.OriginY = y[0];
+			triangle.OriginDepth = z[0];
+			triangle.DepthStepX = (dz1 * dy2 - dz2 * dy1) / area;
+			triangle.DepthStepY = (dz2 * dx1 - dz1 * dx2) / area;
+			triangle.MinDepth = std::min({ z[0], z[1], z[2] });
+			triangle.MaxDepth = std::max({ z[0], z[1], z[2] });
+			return true;
+		}
+
+		template <typename Function>
+		void ForEachTile(const Triangle& triangle, const Function& function) const {
+			for (auto tileY = static_cast<uint32_t>(triangle.MinY) / TileHeight; tileY <= static_cast<uint32_t>(triangle.MaxY) / TileHeight; tileY++) {
+				for (auto tileX = static_cast<uint32_t>(triangle.MinX) / TileWidth; tileX <= static_cast<uint32_t>(triangle.MaxX) / TileWidth; tileX++) {
+					function(tileY * m_tileCountX + tileX);
+				}
+			}
+		}
+
+		void RasterizeTriangle(const Triangle& triangle, uint32_t tileIndex) {
+			auto& tile = m_tiles[tileIndex];
+			if (triangle.MinDepth >= tile.MaxReferenceDepth) return;
+
+			const auto tileX = tileIndex % m_tileCountX * TileWidth, tileY = tileIndex / m_tileCountX * TileHeight;
+
+			uint32_t coverage[SubtileCount]{};
+#ifdef MASKED_OCCLUSION_X86
+			if (m_isAVX2Enabled) ComputeCoverageAVX2(triangle, static_cast<float>(tileX), static_cast<float>(tileY), coverage);
+			else
+#endif
+				ComputeCoverage(triangle, static_cast<float>(tileX), static_cast<float>(tileY), coverage);
+
+			auto maxReferenceDepth = 0.0f;
+			for (uint32_t i = 0; i < SubtileCount; i++) {
+				auto& referenceDepth = tile.ReferenceDepths[i];
+
+				if (coverage[i]) {
+					// The farthest the triangle gets within the subtile: its depth plane at the far corner, which cannot exceed the farthest vertex.
+					const auto subtileX = static_cast<float>(tileX + i % (TileWidth / SubtileWidth) * SubtileWidth) + (triangle.DepthStepX > 0 ? SubtileWidth : 0);
+					const auto subtileY = static_cast<float>(tileY + i / (TileWidth / SubtileWidth) * SubtileHeight) + (triangle.DepthStepY > 0 ? SubtileHeight : 0);
+					const auto depth = std::min(triangle.MaxDepth, triangle.OriginDepth + triangle.DepthStepX * (subtileX - triangle.OriginX) + triangle.DepthStepY * (subtileY - triangle.OriginY));
+
+					if (depth < referenceDepth) {
+						auto& mask = tile.Masks[i];
+						auto& workingDepth = tile.WorkingDepths[i];
+
+						if (mask && workingDepth - depth > referenceDepth - workingDepth) mask = 0;
+
+						workingDepth = mask ? std::max(workingDepth, depth) : depth;
+						mask |= coverage[i];
+
+						if (mask == ~0u) {
+							referenceDepth = workingDepth;
+							mask = 0;
+						}
+					}
+				}
+
+				maxReferenceDepth = std::max(maxReferenceDepth, referenceDepth);
+			}
+			tile.MaxReferenceDepth = maxReferenceDepth;
+		}
+
+		// Bit y * SubtileWidth + x of a subtile's mask is the pixel at (x, y) within it.
+		static void ComputeCoverage(const Triangle& triangle, float tileX, float tileY, uint32_t(&coverage)[SubtileCount]) {
+			for (uint32_t y = 0; y < TileHeight; y++) {
+				const auto pixelY = tileY + static_cast<float>(y) + 0.5f;
+
+				for (uint32_t x = 0; x < TileWidth; x++) {
+					const auto pixelX = tileX + static_cast<float>(x) + 0.5f;
+
+					bool isInside = true;
+					for (int k = 0; k < 3; k++) isInside &= triangle.EdgeA[k] * pixelX + triangle.EdgeB[k] * pixelY + triangle.EdgeC[k] >= 0;
+
+					if (isInside) coverage[y / SubtileHeight * (TileWidth / SubtileWidth) + x / SubtileWidth] |= 1u << (y % SubtileHeight * SubtileWidth + x % SubtileWidth);
+				}
+			}
+		}
+
+#ifdef MASKED_OCCLUSION_X86
+		// One subtile row of eight pixels per step.
+		MASKED_OCCLUSION_TARGET_AVX2 static void ComputeCoverageAVX2(const Triangle& triangle, float tileX, float tileY, uint32_t(&coverage)[SubtileCount]) {
+			const auto laneX = _mm256_add_ps(_mm256_set1_ps(tileX), _mm256_setr_ps(0.5f, 1.5f, 2.5f, 3.5f, 4.5f, 5.5f, 6.5f, 7.5f));
+			const auto zero = _mm256_setzero_ps();
+
+			__m256 rows[3], stepsX[3];
+			for (int k = 0; k < 3; k++) {
+				rows[k] = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(triangle.EdgeA[k]), laneX), _mm256_set1_ps(triangle.EdgeB[k] * (tileY + 0.5f) + triangle.EdgeC[k]));
+				stepsX[k] = _mm256_set1_ps(triangle.EdgeA[k] * SubtileWidth);
+			}
+
+			for (uint32_t y = 0; y < TileHeight; y++) {
+				__m256 edges[]{ rows[0], rows[1], rows[2] };
+
+				for (uint32_t x = 0; x < TileWidth / SubtileWidth; x++) {
+					const auto inside = _mm256_and_ps(_mm256_and_ps(_mm256_cmp_ps(edges[0], zero, _CMP_GE_OQ), _mm256_cmp_ps(edges[1], zero, _CMP_GE_OQ)), _mm256_cmp_ps(edges[2], zero, _CMP_GE_OQ));
+					coverage[y / SubtileHeight * (TileWidth / SubtileWidth) + x] |= static_cast<uint32_t>(_mm256_movemask_ps(inside)) << (y % SubtileHeight * SubtileWidth);
+
+					for (int k = 0; k < 3; k++) edges[k] = _mm256_add_ps(edges[k], stepsX[k]);
+				}
+
+				for (int k = 0; k < 3; k++) rows[k] = _mm256_add_ps(rows[k], _mm256_set1_ps(triangle.EdgeB[k]));
+			}
+		}
+#endif
+	};
+}
@@ -0,0 +1,356 @@
+/*
+ * Header File: MeshCodec.h
+ * Last Update: 2026/10/18
+ *
+ * Copyright (C) Hydr10n@GitHub. All Rights Reserved.
+ */
+
+#pragma once
+
+#include "MeshFile.h"
+
+#include <array>
+#include <cstring>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define MESH_CODEC_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#define MESH_CODEC_TARGET_SSSE3
+#else
+#define MESH_CODEC_TARGET_SSSE3 __attribute__((target("ssse3")))
+#endif
+#endif
+
+namespace Hydr10n::Meshes {
+	/*
+	 * Indices: zigzag delta against the index DeltaDistance positions back, packed with Stream VByte
+	 * (a control byte per 4 values followed by 1-4 data bytes per value). With the default distance of 6
+	 * every quad of a revolve grid is the previous quad plus one, so almost every value costs a single byte.
+	 *
+	 * Vertices: each 32-bit word is XORed with the same word of the previous vertex, the result is split into
+	 * byte planes and every plane is zero-run-length encoded. Position/normal bits of neighboring vertices
+	 * mostly agree in their high bytes, so those planes collapse into a few runs.
+	 *
+	 * Neither stream has an entropy coding stage: both stay byte-aligned so that they decode with shuffles at close to
+	 * memory speed, and a general-purpose compressor can still be run over a whole file where size matters more.
+	 */
+	struct MeshCodec {
+		static constexpr uint32_t DefaultIndexDeltaDistance = 6;
+
+		// Limits on what a vertex stream header may claim, checked before anything is allocated: run-length encoded planes
+		// can describe far more data than they occupy. 2048 bytes is D3D12_REQ_MULTI_ELEMENT_STRUCTURE_SIZE_IN_BYTES.
+		static constexpr uint32_t MaxVertexStride = 2048;
+		static constexpr size_t MaxDecodedVertexSize = size_t(1) << 30;
+
+		static std::vector<std::byte> EncodeIndices(std::span<const uint32_t> indices, uint32_t deltaDistance = DefaultIndexDeltaDistance) {
+			if (!deltaDistance) throw std::invalid_argument("Index delta distance must be positive");
+
+			const auto count = indices.size(), controlSize = (count + 3) / 4;
+
+			std::vector<std::byte> data(sizeof(IndexStreamHeader) + controlSize);
+			const IndexStreamHeader header{ static_cast<uint32_t>(count), deltaDistance };
+			std::memcpy(data.data(), &header, sizeof(header));
+			data.reserve(data.size() + count * 2);
+
+			for (size_t i = 0; i < count; i++) {
+				const auto delta = indices[i] - (i >= deltaDistance ? indices[i - deltaDistance] : 0);
+				const auto value = (delta << 1) ^ static_cast<uint32_t>(static_cast<int32_t>(delta) >> 31);
+				const uint32_t code = value < 1 << 8 ? 0 : value < 1 << 16 ? 1 : value < 1 << 24 ? 2 : 3;
+
+				data[sizeof(IndexStreamHeader) + i / 4] |= static_cast<std::byte>(code << (i % 4 * 2));
+				for (uint32_t j = 0; j <= code; j++) data.push_back(static_cast<std::byte>(value >> (j * 8)));
+			}
+
+			return data;
+		}
+
+		static void DecodeIndices(std::span<const std::byte> data, MeshGenerator::IndexCollection& indices) {
+			IndexStreamHeader header;
+			if (data.size() < sizeof(header)) throw std::runtime_error("Index stream is truncated");
+			std::memcpy(&header, data.data(), sizeof(header));
+
+			const size_t count = header.Count, controlSize = (count + 3) / 4;
+			if (!header.DeltaDistance || data.size() - sizeof(header) < controlSize) throw std::runtime_error("Index stream is corrupted");
+
+			indices.resize(count);
+
+			const auto control = reinterpret_cast<const uint8_t*>(data.data()) + sizeof(header);
+			auto values = control + controlSize;
+			const auto end = reinterpret_cast<const uint8_t*>(data.data() + data.size());
+
+#ifdef MESH_CODEC_X86
+			if (header.DeltaDistance >= 4 && HasSSSE3()) {
+				switch (header.DeltaDistance) {
+				case 4: DecodeIndicesSSSE3<4>(control, values, end, header.DeltaDistance, indices.data(), count); break;
+				case 6: DecodeIndicesSSSE3<6>(control, values, end, header.DeltaDistance, indices.data(), count); break;
+				case 8: DecodeIndicesSSSE3<8>(control, values, end, header.DeltaDistance, indices.data(), count); break;
+				default: DecodeIndicesSSSE3<0>(control, values, end, header.DeltaDistance, indices.data(), count); break;
+				}
+				return;
+			}
+#endif
+
+			DecodeIndicesScalar(control, values, end, header.DeltaDistance, indices.data(), 0, count);
+		}
+
+		static std::vector<std::byte> EncodeVertices(std::span<const std::byte> vertices, uint32_t stride) {
+			if (!stride || stride % 4 || vertices.size() % stride) throw std::invalid_argument("Vertex stride must be a positive multiple of 4");
+			if (stride > MaxVertexStride || vertices.size() > MaxDecodedVertexSize) throw std::invalid_argument("Vertex data exceeds the stream limits");
+
+			const auto count = vertices.size() / stride;
+
+			std::vector<std::byte> data(sizeof(VertexStreamHeader));
+			const VertexStreamHeader header{ static_cast<uint32_t>(count), stride };
+			std::memcpy(data.data(), &header, sizeof(header));
+
+			std::vector<uint8_t> plane(count);
+			for (uint32_t word = 0; word < stride / 4; word++) {
+				for (uint32_t byte = 0; byte < 4; byte++) {
+					uint32_t previous = 0;
+					for (size_t i = 0; i < count; i++) {
+						uint32_t value;
+						std::memcpy(&value, vertices.data() + i * stride + word * 4, sizeof(value));
+						plane[i] = static_cast<uint8_t>((value ^ previous) >> (byte * 8));
+						previous = value;
+					}
+
+					EncodePlane(plane, data);
+				}
+			}
+
+			return data;
+		}
+
+		static std::vector<std::byte> EncodeVertices(const MeshGenerator::VertexCollection& vertices) {
+			return EncodeVertices(std::as_bytes(std::span(vertices)), sizeof(MeshGenerator::Vertex));
+		}
+
+		// Decodes into raw bytes; the stream's vertex stride is returned.
+		static uint32_t DecodeVertices(std::span<const std::byte> data, std::vector<std::byte>& vertices) {
+			VertexStreamHeader header;
+			if (data.size() < sizeof(header)) throw std::runtime_error("Vertex stream is truncated");
+			std::memcpy(&header, data.data(), sizeof(header));
+			if (!header.Stride || header.Stride % 4 || header.Stride > MaxVertexStride) throw std::runtime_error("Vertex stream is corrupted");
+
+			const size_t count = header.Count, stride = header.Stride;
+			if (count > MaxDecodedVertexSize / stride) throw std::runtime_error("Vertex stream is too large");
+
+			vertices.resize(count * stride);
+
+			auto p = reinterpret_cast<const uint8_t*>(data.data()) + sizeof(header);
+			const auto end = reinterpret_cast<const uint8_t*>(data.data() + data.size());
+
+			std::array<std::vector<uint8_t>, 4> planes;
+			std::vector<uint32_t> words(count);
+			for (size_t word = 0; word < stride / 4; word++) {
+				for (auto& plane : planes) {
+					plane.resize(count);
+					p = DecodePlane(p, end, plane.data(), count);
+				}
+
+				UnpackWords(planes, words.data(), count);
+
+				for (size_t i = 0; i < count; i++) std::memcpy(vertices.data() + i * stride + word * 4, &words[i], sizeof(uint32_t));
+			}
+
+			return header.Stride;
+		}
+
+		static void DecodeVertices(std::span<const std::byte> data, MeshGenerator::VertexCollection& vertices) {
+			std::vector<std::byte> bytes;
+			if (DecodeVertices(data, bytes) != sizeof(MeshGenerator::Vertex)) throw std::runtime_error("Vertex stream stride mismatch");
+
+			vertices.resize(bytes.size() / sizeof(MeshGenerator::Vertex));
+			std::memcpy(vertices.data(), bytes.data(), bytes.size());
+		}
+
+		// Loads raw sections when present and falls back to the encoded ones.
+		static void Load(const MappedMeshFile& file, MeshGenerator::VertexCollection& vertices, MeshGenerator::IndexCollection& indices) {
+			if (const auto raw = file.GetVertices(); !raw.empty()) vertices.assign(raw.begin(), raw.end());
+			else DecodeVertices(file.GetSection(MeshFile::SectionType::EncodedVertices), vertices);
+
+			if (const auto raw = file.GetIndices(); !raw.empty()) indices.assign(raw.begin(), raw.end());
+			else DecodeIndices(file.GetSection(MeshFile::SectionType::EncodedIndices), indices);
+		}
+
+		static void WriteEncoded(const std::filesystem::path& path, const MeshGenerator::VertexCollection& vertices, const MeshGenerator::IndexCollection& indices, bool computeChecksum = true) {
+			DirectX::BoundingBox bounds;
+			if (!vertices.empty()) DirectX::BoundingBox::CreateFromPoints(bounds, vertices.size(), &vertices[0].position, sizeof(vertices[0]));
+
+			const auto encodedVertices = EncodeVertices(vertices), encodedIndices = EncodeIndices(indices);
+			const MeshFile::SectionData sections[]{
+				{ MeshFile::SectionType::EncodedVertices, 1, encodedVertices },
+				{ MeshFile::SectionType::EncodedIndices, 1, encodedIndices }
+			};
+			MeshFile::Write(path, sections, bounds, computeChecksum);
+		}
+
+	private:
+		struct IndexStreamHeader { uint32_t Count, DeltaDistance; };
+
+		struct VertexStreamHeader { uint32_t Count, Stride; };
+
+		static void AppendVarint(std::vector<std::byte>& data, size_t value) {
+			for (; value >= 0x80; value >>= 7) data.push_back(static_cast<std::byte>(value | 0x80));
+			data.push_back(static_cast<std::byte>(value));
+		}
+
+		static const uint8_t* ReadVarint(const uint8_t* p, const uint8_t* end, size_t& value) {
+			value = 0;
+			for (uint32_t shift = 0; ; shift += 7) {
+				if (p == end || shift > 63) throw std::runtime_error("Vertex stream is corrupted");
+				const auto byte = *p++;
+				value |= static_cast<size_t>(byte & 0x7F) << shift;
+				if (!(byte & 0x80)) return p;
+			}
+		}
+
+		// Alternating (literal count, literals, zero count) tokens.
+		static void EncodePlane(std::span<const uint8_t> plane, std::vector<std::byte>& data) {
+			for (size_t i = 0; i < plane.size();) {
+				auto literalEnd = i;
+				while (literalEnd < plane.size() && (plane[literalEnd] || (literalEnd + 1 < plane.size() && plane[literalEnd + 1]))) literalEnd++;
+
+				AppendVarint(data, literalEnd - i);
+				data.insert(data.end(), reinterpret_cast<const std::byte*>(plane.data() + i), reinterpret_cast<const std::byte*>(plane.data() + literalEnd));
+
+				auto zeroEnd = literalEnd;
+				while (zeroEnd < plane.size() && !plane[zeroEnd]) zeroEnd++;
+				AppendVarint(data, zeroEnd - literalEnd);
+
+				i = zeroEnd;
+			}
+		}
+
+		static const uint8_t* DecodePlane(const uint8_t* p, const uint8_t* end, uint8_t* plane, size_t size) {
+			for (size_t i = 0; i < size;) {
+				size_t literalCount, zeroCount;
+				p = ReadVarint(p, end, literalCount);
+				if (literalCount > size - i || literalCount > static_cast<size_t>(end - p)) throw std::runtime_error("Vertex stream is corrupted");
+				std::memcpy(plane + i, p, literalCount);
+				p += literalCount;
+				i += literalCount;
+
+				p = ReadVarint(p, end, zeroCount);
+				if (zeroCount > size - i) throw std::runtime_error("Vertex stream is corrupted");
+				std::memset(plane + i, 0, zeroCount);
+				i += zeroCount;
+			}
+			return p;
+		}
+
+		static void UnpackWords(const std::array<std::vector<uint8_t>, 4>& planes, uint32_t* words, size_t count) {
+			size_t i = 0;
+			uint32_t previous = 0;
+
+#ifdef MESH_CODEC_X86
+			auto carry = _mm_setzero_si128();
+			for (; i + 16 <= count; i += 16) {
+				const auto b0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(planes[0].data() + i)), b1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(planes[1].data() + i)),
+					b2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(planes[2].data() + i)), b3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(planes[3].data() + i));
+				const auto lo01 = _mm_unpacklo_epi8(b0, b1), hi01 = _mm_unpackhi_epi8(b0, b1), lo23 = _mm_unpacklo_epi8(b2, b3), hi23 = _mm_unpackhi_epi8(b2, b3);
+				const __m128i deltas[]{ _mm_unpacklo_epi16(lo01, lo23), _mm_unpackhi_epi16(lo01, lo23), _mm_unpacklo_epi16(hi01, hi23), _mm_unpackhi_epi16(hi01, hi23) };
+
+				for (size_t j = 0; j < 4; j++) {
+					auto value = _mm_xor_si128(deltas[j], _mm_slli_si128(deltas[j], 4));
+					value = _mm_xor_si128(value, _mm_slli_si128(value, 8));
+					value = _mm_xor_si128(value, carry);
+					carry = _mm_shuffle_epi32(value, _MM_SHUFFLE(3, 3, 3, 3));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(words + i + j * 4), value);
+				}
+			}
+			previous = static_cast<uint32_t>(_mm_cvtsi128_si32(carry));
+#endif
+
+			for (; i < count; i++) {
+				previous ^= static_cast<uint32_t>(planes[0][i]) | static_cast<uint32_t>(planes[1][i]) << 8 | static_cast<uint32_t>(planes[2][i]) << 16 | static_cast<uint32_t>(planes[3][i]) << 24;
+				words[i] = previous;
+			}
+		}
+
+		static constexpr uint32_t DecodeZigzag(uint32_t value) { return (value >> 1) ^ (0 - (value & 1)); }
+
+		static void DecodeIndicesScalar(const uint8_t* control, const uint8_t*& values, const uint8_t* end, uint32_t deltaDistance, uint32_t* indices, size_t first, size_t last) {
+			for (auto i = first; i < last; i++) {
+				const uint32_t length = ((control[i / 4] >> (i % 4 * 2)) & 3) + 1;
+				if (static_cast<size_t>(end - values) < length) throw std::runtime_error("Index stream is corrupted");
+
+				uint32_t value = 0;
+				for (uint32_t j = 0; j < length; j++) value |= static_cast<uint32_t>(values[j]) << (j * 8);
+				values += length;
+
+				indices[i] = DecodeZigzag(value) + (i >= deltaDistance ? indices[i - deltaDistance] : 0);
+			}
+		}
+
+#ifdef MESH_CODEC_X86
+		struct StreamVByteTables {
+			uint8_t Shuffles[256][16], Lengths[256];
+
+			constexpr StreamVByteTables() : Shuffles{}, Lengths{} {
+				for (uint32_t control = 0; control < 256; control++) {
+					uint8_t offset = 0;
+					for (uint32_t lane = 0; lane < 4; lane++) {
+						const auto length = static_cast<uint8_t>(((control >> (lane * 2)) & 3) + 1);
+						for (uint8_t byte = 0; byte < 4; byte++) Shuffles[control][lane * 4 + byte] = byte < length ? static_cast<uint8_t>(offset + byte) : 0x80;
+						offset += length;
+					}
+					Lengths[control] = offset;
+				}
+			}
+		};
+
+		static bool HasSSSE3() {
+#ifdef _MSC_VER
+			static const auto s_hasSSSE3 = [] {
+				int info[4];
+				__cpuid(info, 1);
+				return (info[2] & (1 << 9)) != 0;
+			}();
+			return s_hasSSSE3;
+#else
+			return __builtin_cpu_supports("ssse3");
+#endif
+		}
+
+		// Distances 4, 6 and 8 take the reference from the last two decoded groups held in registers; reloading
+		// freshly stored values across a group boundary would defeat store forwarding.
+		template <uint32_t DeltaDistance>
+		MESH_CODEC_TARGET_SSSE3 static void DecodeIndicesSSSE3(const uint8_t* control, const uint8_t* values, const uint8_t* end, uint32_t deltaDistance, uint32_t* indices, size_t count) {
+			static constexpr StreamVByteTables Tables;
+
+			// Values that reference the implicit zero prefix, then whole groups for as long as a 16-byte load stays in bounds.
+			size_t i = std::min<size_t>((std::max(deltaDistance, 8u) + 3) / 4 * 4, count / 4 * 4);
+			DecodeIndicesScalar(control, values, end, deltaDistance, indices, 0, i);
+
+			if (i >= 8) {
+				const auto one = _mm_set1_epi32(1);
+
+				auto previous2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(indices + i - 8)), previous1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(indices + i - 4));
+				for (; i + 4 <= count && end - values >= 16; i += 4) {
+					const auto controlByte = control[i / 4];
+
+					const auto packed = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values));
+					const auto value = _mm_shuffle_epi8(packed, _mm_loadu_si128(reinterpret_cast<const __m128i*>(Tables.Shuffles[controlByte])));
+					values += Tables.Lengths[controlByte];
+
+					__m128i reference;
+					if constexpr (DeltaDistance == 4) reference = previous1;
+					else if constexpr (DeltaDistance == 6) reference = _mm_alignr_epi8(previous1, previous2, 8);
+					else if constexpr (DeltaDistance == 8) reference = previous2;
+					else reference = _mm_loadu_si128(reinterpret_cast<const __m128i*>(indices + i - deltaDistance));
+
+					const auto delta = _mm_xor_si128(_mm_srli_epi32(value, 1), _mm_sub_epi32(_mm_setzero_si128(), _mm_and_si128(value, one)));
+					previous2 = previous1;
+					previous1 = _mm_add_epi32(delta, reference);
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(indices + i), previous1);
+				}
+			}
+
+			DecodeIndicesScalar(control, values, end, deltaDistance, indices, i, count);
+		}
+#endif
+	};
+}
@@ -0,0 +1,104 @@
+/*
+ * Header File: MeshCulling.h
+ * Last Update: 2026/10/18
+ *
+ * Copyright (C) Hydr10n@GitHub. All Rights Reserved.
+ */
+
+#pragma once
+
+#include "Meshes.h"
+
+#include "FrustumCulling.h"
+
+#include <span>
+
+namespace Hydr10n::Meshes {
+	struct IndexRange { uint32_t StartIndex, IndexCount; };
+
+	struct ChunkCuller {
+		/*
+		 * Appends the index ranges of the chunks that may be visible, merging chunks that are adjacent in the index data.
+		 * Chunk bounds are in the space transformed by world; projection may be left- or right-handed with depth in [0, 1].
+		 *
+		 * cullBackFacing also drops chunks whose every face points away from the camera, which only leaves the image
+		 * unchanged for closed meshes.
+		 */
+		static void XM_CALLCONV Cull(
+			std::span<const MeshGenerator::Chunk> chunks,
+			DirectX::FXMMATRIX world, DirectX::CXMMATRIX view, DirectX::CXMMATRIX projection,
+			bool cullBackFacing,
+			std::vector<IndexRange>& indexRanges, std::vector<IndexRange>* pLineIndexRanges = nullptr
+		) {
+			using namespace DirectX;
+
+			const auto worldView = XMMatrixMultiply(world, view);
+
+			// The chunk bounds are gathered for the batch test of FrustumCulling.h, reusing the buffers of earlier calls on the same thread.
+			thread_local std::vector<BoundingBox> t_bounds;
+			thread_local std::vector<uint32_t> t_visibility;
+			t_bounds.clear();
+			for (const auto& chunk : chunks) t_bounds.push_back(chunk.Bounds);
+			t_visibility.resize((chunks.size() + 31) / 32);
+			DX::CullBoxes(DX::FrustumPlanes::CreateFromMatrix(XMMatrixMultiply(worldView, projection)), t_bounds.data(), t_bounds.size(), t_visibility.data());
+
+			Cull(chunks, t_visibility.data(), XMMatrixInverse(nullptr, worldView).r[3], cullBackFacing, indexRanges, pLineIndexRanges);
+		}
+
+		/*
+		 * Same as above for frustum tests already done in a batch, e.g. once for several views: chunks[i] is considered
+		 * inside the frustum if bit i % 32 of frustumVisibility[i / 32] is set. eyePosition is in the space of the chunk bounds.
+		 */
+		static void XM_CALLCONV Cull(
+			std::span<const MeshGenerator::Chunk> chunks,
+			const uint32_t* frustumVisibility, DirectX::FXMVECTOR eyePosition,
+			bool cullBackFacing,
+			std::vector<IndexRange>& indexRanges, std::vector<IndexRange>* pLineIndexRanges = nullptr
+		) {
+			using namespace DirectX;
+
+			for (size_t i = 0; i < chunks.size(); i++) {
+				if (!(frustumVisibility[i >> 5] & (1u << (i & 31)))) continue;
+
+				const auto& chunk = chunks[i];
+
+				if (cullBackFacing) {
+					const auto center = XMLoadFloat3(&chunk.Bounds.Center), extents = XMLoadFloat3(&chunk.Bounds.Extents);
+					if (IsBackFacing(center, XMVectorGetX(XMVector3Length(extents)), XMLoadFloat3(&chunk.ConeAxis), chunk.ConeCutoff, eyePosition)) continue;
+				}
+
+				AppendRange(indexRanges, chunk.StartIndex, chunk.IndexCount);
+				if (pLineIndexRanges != nullptr) AppendRange(*pLineIndexRanges, chunk.StartLineIndex, chunk.LineIndexCount);
+			}
+		}
+
+	private:
+		/*
+		 * Every face normal is within alpha = acos(coneCutoff) of the axis, and every point of the bounding sphere is seen
+		 * within beta = asin(radius / distance) of its center. All faces point away once the axis is within
+		 * 90 degrees - alpha - beta of the view direction to the center.
+		 */
+		static bool XM_CALLCONV IsBackFacing(DirectX::FXMVECTOR center, float radius, DirectX::FXMVECTOR coneAxis, float coneCutoff, DirectX::GXMVECTOR eyePosition) {
+			using namespace DirectX;
+
+			if (coneCutoff <= 0) return false;
+
+			const auto direction = XMVectorSubtract(center, eyePosition);
+			const auto distance = XMVectorGetX(XMVector3Length(direction));
+			if (distance <= radius) return false;
+
+			const auto sinAlpha = std::sqrt(1 - coneCutoff * coneCutoff), cosAlpha = coneCutoff,
+				sinBeta = radius / distance, cosBeta = std::sqrt(1 - sinBeta * sinBeta);
+			if (cosAlpha * cosBeta - sinAlpha * sinBeta <= 0) return false;
+
+			return XMVectorGetX(XMVector3Dot(coneAxis, direction)) > (sinAlpha * cosBeta + cosAlpha * sinBeta) * distance;
+		}
+
+		static void AppendRange(std::vector<IndexRange>& ranges, uint32_t startIndex, uint32_t indexCount) {
+			if (!indexCount) return;
+
+			if (!ranges.empty() && ranges.back().StartIndex + ranges.back().IndexCount == startIndex) ranges.back().IndexCount += indexCount;
+			else ranges.push_back({ startIndex, indexCount });
+		}
+	};
+}
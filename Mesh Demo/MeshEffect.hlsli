@@ -0,0 +1,31 @@
+//
+// MeshEffect.hlsli - BasicEffect's per-vertex default lighting without specular, with its constants behind a root CBV
+//
+
+#define MeshEffectRootSignature \
+    "RootFlags(ALLOW_INPUT_ASSEMBLER_INPUT_LAYOUT | DENY_HULL_SHADER_ROOT_ACCESS | DENY_DOMAIN_SHADER_ROOT_ACCESS | " \
+    "DENY_GEOMETRY_SHADER_ROOT_ACCESS | DENY_PIXEL_SHADER_ROOT_ACCESS), " \
+    "CBV(b0, visibility = SHADER_VISIBILITY_VERTEX)"
+
+// As BasicEffect sets its constants: ambient light is folded into the emissive color and both colors are premultiplied
+// by alpha. Matrices are stored as DirectXMath stores them.
+cbuffer Constants : register(b0)
+{
+    row_major float4x4 WorldViewProjection;
+    row_major float4x4 WorldInverseTranspose;
+    float3 DiffuseColor;
+    float Alpha;
+    float3 EmissiveColor;
+};
+
+struct VSInput
+{
+    float3 Position : SV_Position;
+    float3 Normal : NORMAL;
+};
+
+struct VSOutput
+{
+    float4 Position : SV_Position;
+    float4 Color : COLOR0;
+};
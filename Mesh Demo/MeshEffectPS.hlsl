@@ -0,0 +1,11 @@
+//
+// MeshEffectPS.hlsl - Passes the lit vertex color through
+//
+
+#include "MeshEffect.hlsli"
+
+[RootSignature(MeshEffectRootSignature)]
+float4 main(VSOutput input) : SV_Target
+{
+    return input.Color;
+}
@@ -0,0 +1,37 @@
+//
+// MeshEffectVS.hlsl - Lights every vertex with the three lights of BasicEffect::EnableDefaultLighting
+//
+
+#include "MeshEffect.hlsli"
+
+static const float3 LightDirections[3] =
+{
+    float3(-0.5265408, -0.5735765, -0.6275069),
+    float3(0.7198464, 0.3420201, 0.6040227),
+    float3(0.4545195, -0.7660444, 0.4545195)
+};
+
+static const float3 LightDiffuseColors[3] =
+{
+    float3(1, 0.9607844, 0.8078432),
+    float3(0.9647059, 0.7607844, 0.4078432),
+    float3(0.3231373, 0.3607844, 0.3937255)
+};
+
+[RootSignature(MeshEffectRootSignature)]
+VSOutput main(VSInput input)
+{
+    const float3 worldNormal = normalize(mul(input.Normal, (float3x3)WorldInverseTranspose));
+
+    float3 diffuse = 0;
+    [unroll]
+    for (int i = 0; i < 3; i++)
+    {
+        diffuse += max(dot(-LightDirections[i], worldNormal), 0) * LightDiffuseColors[i];
+    }
+
+    VSOutput output;
+    output.Position = mul(float4(input.Position, 1), WorldViewProjection);
+    output.Color = float4(diffuse * DiffuseColor + EmissiveColor, Alpha);
+    return output;
+}
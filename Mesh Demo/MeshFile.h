@@ -0,0 +1,279 @@
+/*
+ * Header File: MeshFile.h
+ * Last Update: 2026/10/18
+ *
+ * Copyright (C) Hydr10n@GitHub. All Rights Reserved.
+ */
+
+#pragma once
+
+#include "Meshes.h"
+
+#include <DirectXCollision.h>
+
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <stdexcept>
+#include <system_error>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Hydr10n::Meshes {
+	/*
+	 * Layout (little-endian):
+	 *   Header
+	 *   SectionEntry[Header::SectionCount]
+	 *   (padding) section 0, (padding) section 1, ...
+	 *
+	 * Every section starts on a SectionAlignment boundary so that its payload can be copied as-is into
+	 * upload heap memory. Nothing is ever decoded on load: the loader only maps the file and hands out spans.
+	 */
+	struct MeshFile {
+		static constexpr uint32_t Magic = 0x4853454D; // "MESH"
+		static constexpr uint16_t Version = 1;
+		static constexpr uint64_t SectionAlignment = 256;
+		static constexpr uint32_t MaxSectionCount = 16;
+
+		static constexpr uint32_t FlagHasChecksum = 0x1;
+
+		enum class SectionType : uint32_t { Vertices, Indices, Meshlets, LODs, EncodedVertices, EncodedIndices };
+
+		struct SectionEntry {
+			SectionType Type;
+			uint32_t Stride;
+			uint64_t Offset, Size;
+		};
+
+		struct Header {
+			uint32_t Magic;
+			uint16_t Version, HeaderSize;
+			uint32_t Flags, SectionCount;
+			uint64_t FileSize, Checksum;
+			DirectX::BoundingBox Bounds;
+			uint32_t Reserved[2];
+		};
+
+		static_assert(sizeof(SectionEntry) == 24 && sizeof(Header) == 64);
+
+		struct SectionData {
+			SectionType Type;
+			uint32_t Stride;
+			std::span<const std::byte> Data;
+		};
+
+		// FNV-1a over every section payload, in section table order.
+		static constexpr uint64_t ChecksumBasis = 0xCBF29CE484222325;
+
+		static uint64_t ComputeChecksum(std::span<const std::byte> data, uint64_t hash = ChecksumBasis) {
+			for (const auto byte : data) hash = (hash ^ static_cast<uint8_t>(byte)) * 0x100000001B3;
+			return hash;
+		}
+
+		static void Write(const std::filesystem::path& path, std::span<const SectionData> sections, const DirectX::BoundingBox& bounds, bool computeChecksum = true) {
+			if (sections.size() > MaxSectionCount) throw std::out_of_range("Too many mesh file sections");
+
+			Header header{
+				.Magic = Magic,
+				.Version = Version,
+				.HeaderSize = sizeof(Header),
+				.Flags = computeChecksum ? FlagHasChecksum : 0,
+				.SectionCount = static_cast<uint32_t>(sections.size()),
+				.FileSize = 0,
+				.Checksum = computeChecksum ? ChecksumBasis : 0,
+				.Bounds = bounds,
+				.Reserved = {}
+			};
+
+			std::vector<SectionEntry> entries;
+			entries.reserve(sections.size());
+
+			auto offset = static_cast<uint64_t>(sizeof(Header) + sizeof(SectionEntry) * sections.size());
+			for (const auto& section : sections) {
+				offset = AlignUp(offset);
+				entries.push_back({ section.Type, section.Stride, offset, section.Data.size() });
+				offset += section.Data.size();
+
+				if (computeChecksum) header.Checksum = ComputeChecksum(section.Data, header.Checksum);
+			}
+			header.FileSize = offset;
+
+			std::ofstream file(path, std::ios::binary | std::ios::trunc);
+			if (!file) throw std::runtime_error("Failed to create mesh file");
+
+			file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+			file.write(reinterpret_cast<const char*>(entries.data()), static_cast<std::streamsize>(sizeof(SectionEntry) * entries.size()));
+
+			constexpr char Padding[SectionAlignment]{};
+			for (size_t i = 0; i < sections.size(); i++) {
+				file.write(Padding, static_cast<std::streamsize>(entries[i].Offset - static_cast<uint64_t>(file.tellp())));
+				file.write(reinterpret_cast<const char*>(sections[i].Data.data()), static_cast<std::streamsize>(sections[i].Data.size()));
+			}
+
+			if (!file) throw std::runtime_error("Failed to write mesh file");
+		}
+
+		static void Write(const std::filesystem::path& path, const MeshGenerator::VertexCollection& vertices, const MeshGenerator::IndexCollection& indices, bool computeChecksum = true) {
+			DirectX::BoundingBox bounds;
+			if (!vertices.empty()) DirectX::BoundingBox::CreateFromPoints(bounds, vertices.size(), &vertices[0].position, sizeof(vertices[0]));
+
+			const SectionData sections[]{
+				{ SectionType::Vertices, sizeof(MeshGenerator::Vertex), std::as_bytes(std::span(vertices)) },
+				{ SectionType::Indices, sizeof(MeshGenerator::IndexCollection::value_type), std::as_bytes(std::span(indices)) }
+			};
+			Write(path, sections, bounds, computeChecksum);
+		}
+
+	private:
+		static constexpr uint64_t AlignUp(uint64_t value) { return (value + SectionAlignment - 1) & ~(SectionAlignment - 1); }
+	};
+
+	class MappedMeshFile {
+	public:
+		MappedMeshFile(const MappedMeshFile&) = delete;
+		MappedMeshFile& operator=(const MappedMeshFile&) = delete;
+
+		explicit MappedMeshFile(const std::filesystem::path& path, bool verifyChecksum = false) noexcept(false) {
+			Map(path);
+
+			try { Validate(verifyChecksum); }
+			catch (...) {
+				Unmap();
+				throw;
+			}
+		}
+
+		~MappedMeshFile() { Unmap(); }
+
+		const MeshFile::Header& GetHeader() const { return *reinterpret_cast<const MeshFile::Header*>(m_data); }
+
+		std::span<const MeshFile::SectionEntry> GetSectionEntries() const {
+			return { reinterpret_cast<const MeshFile::SectionEntry*>(m_data + sizeof(MeshFile::Header)), GetHeader().SectionCount };
+		}
+
+		const DirectX::BoundingBox& GetBounds() const { return GetHeader().Bounds; }
+
+		// Returns an empty span if the section is absent.
+		std::span<const std::byte> GetSection(MeshFile::SectionType type) const {
+			for (const auto& entry : GetSectionEntries()) {
+				if (entry.Type == type) return { m_data + entry.Offset, static_cast<size_t>(entry.Size) };
+			}
+			return {};
+		}
+
+		template <class T>
+		std::span<const T> GetSection(MeshFile::SectionType type) const {
+			for (const auto& entry : GetSectionEntries()) {
+				if (entry.Type == type) {
+					if (entry.Stride != sizeof(T)) throw std::runtime_error("Mesh file section stride mismatch");
+					return { reinterpret_cast<const T*>(m_data + entry.Offset), static_cast<size_t>(entry.Size / sizeof(T)) };
+				}
+			}
+			return {};
+		}
+
+		std::span<const MeshGenerator::Vertex> GetVertices() const { return GetSection<MeshGenerator::Vertex>(MeshFile::SectionType::Vertices); }
+
+		std::span<const MeshGenerator::IndexCollection::value_type> GetIndices() const { return GetSection<MeshGenerator::IndexCollection::value_type>(MeshFile::SectionType::Indices); }
+
+	private:
+		const std::byte* m_data{};
+		size_t m_size{};
+
+#ifdef _WIN32
+		HANDLE m_hFile = INVALID_HANDLE_VALUE, m_hMapping{};
+#else
+		int m_fd = -1;
+#endif
+
+		void Map(const std::filesystem::path& path) {
+#ifdef _WIN32
+			m_hFile = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+			if (m_hFile == INVALID_HANDLE_VALUE) ThrowLastError("CreateFileW");
+
+			LARGE_INTEGER size;
+			if (!GetFileSizeEx(m_hFile, &size)) ThrowLastError("GetFileSizeEx");
+			m_size = static_cast<size_t>(size.QuadPart);
+
+			if (m_size) {
+				m_hMapping = CreateFileMappingW(m_hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+				if (!m_hMapping) ThrowLastError("CreateFileMappingW");
+
+				m_data = static_cast<const std::byte*>(MapViewOfFile(m_hMapping, FILE_MAP_READ, 0, 0, 0));
+				if (!m_data) ThrowLastError("MapViewOfFile");
+			}
+#else
+			m_fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+			if (m_fd == -1) ThrowLastError("open");
+
+			struct stat st;
+			if (fstat(m_fd, &st)) ThrowLastError("fstat");
+			m_size = static_cast<size_t>(st.st_size);
+
+			if (m_size) {
+				const auto data = mmap(nullptr, m_size, PROT_READ, MAP_SHARED, m_fd, 0);
+				if (data == MAP_FAILED) ThrowLastError("mmap");
+				m_data = static_cast<const std::byte*>(data);
+			}
+#endif
+		}
+
+		void Unmap() noexcept {
+#ifdef _WIN32
+			if (m_data) UnmapViewOfFile(m_data);
+			if (m_hMapping) CloseHandle(m_hMapping);
+			if (m_hFile != INVALID_HANDLE_VALUE) CloseHandle(m_hFile);
+			m_hFile = INVALID_HANDLE_VALUE;
+			m_hMapping = nullptr;
+#else
+			if (m_data) munmap(const_cast<std::byte*>(m_data), m_size);
+			if (m_fd != -1) close(m_fd);
+			m_fd = -1;
+#endif
+			m_data = nullptr;
+			m_size = 0;
+		}
+
+		void ThrowLastError(const char* message) {
+#ifdef _WIN32
+			const auto error = static_cast<int>(GetLastError());
+#else
+			const auto error = errno;
+#endif
+			Unmap();
+			throw std::system_error(error, std::system_category(), message);
+		}
+
+		// Header and section table checks only; payloads are never touched unless the checksum is requested.
+		void Validate(bool verifyChecksum) const {
+			if (m_size < sizeof(MeshFile::Header)) throw std::runtime_error("Mesh file is truncated");
+
+			const auto& header = GetHeader();
+			if (header.Magic != MeshFile::Magic) throw std::runtime_error("Not a mesh file");
+			if (header.Version != MeshFile::Version || header.HeaderSize != sizeof(MeshFile::Header)) throw std::runtime_error("Unsupported mesh file version");
+			if (header.FileSize != m_size || header.SectionCount > MeshFile::MaxSectionCount
+				|| sizeof(MeshFile::Header) + sizeof(MeshFile::SectionEntry) * header.SectionCount > m_size) {
+				throw std::runtime_error("Mesh file is corrupted");
+			}
+
+			auto checksum = MeshFile::ChecksumBasis;
+			for (const auto& entry : GetSectionEntries()) {
+				if (entry.Offset % MeshFile::SectionAlignment || entry.Offset > m_size || entry.Size > m_size - entry.Offset
+					|| !entry.Stride || entry.Size % entry.Stride) {
+					throw std::runtime_error("Mesh file is corrupted");
+				}
+
+				if (verifyChecksum) checksum = MeshFile::ComputeChecksum({ m_data + entry.Offset, static_cast<size_t>(entry.Size) }, checksum);
+			}
+
+			if (verifyChecksum && (header.Flags & MeshFile::FlagHasChecksum) && checksum != header.Checksum) throw std::runtime_error("Mesh file checksum mismatch");
+		}
+	};
+}
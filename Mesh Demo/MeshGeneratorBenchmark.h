@@ -0,0 +1,326 @@
+/*
+ * Header File: MeshGeneratorBenchmark.h
+ * Last Update: 2026/10/18
+ *
+ * Copyright (C) Hydr10n@GitHub. All Rights Reserved.
+ */
+
+#pragma once
+
+#include "AllocationCounter.h"
+#include "MeshCodec.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+namespace Hydr10n::Benchmarks {
+	/*
+	 * Times every stage of building a revolved mesh, and of post-processing it, over a grid of profiles, horizontal
+	 * tessellations and X offsets. A stage's output starts empty every repetition, so its allocations are part of the
+	 * measurement; they are counted where AllocationCounter is available.
+	 *
+	 * Results are written as JSON with one case per line, which is also what a baseline is read from. Against a baseline,
+	 * a case regresses once its throughput in bytes per second drops by more than RegressionThreshold.
+	 */
+	class MeshGeneratorBenchmark {
+	public:
+		enum class ProfileType { Sphere, Arbitrary, Degenerate, Count };
+
+		static constexpr const char* ProfileNames[]{ "Sphere", "Arbitrary", "Degenerate" };
+
+		enum class StageType { TriangleList, LineList, TriangleStrip, Chunks, Sector, ExpandSector, EncodeIndices, EncodeVertices, DecodeIndices, DecodeVertices, Count };
+
+		static constexpr const char* StageNames[]{ "TriangleList", "LineList", "TriangleStrip", "Chunks", "Sector", "ExpandSector", "EncodeIndices", "EncodeVertices", "DecodeIndices", "DecodeVertices" };
+
+		static_assert(std::size(ProfileNames) == static_cast<size_t>(ProfileType::Count) && std::size(StageNames) == static_cast<size_t>(StageType::Count));
+
+		struct Options {
+			std::vector<uint32_t> Tessellations{ 3, 4, 8, 16, 32, 64, 128, 256, 512, 1024, 2048, 4096 };
+			std::vector<float> OffsetXs{ 0, 0.5f };
+
+			// Each stage is repeated for at least this long, and at least MinRepetitionCount times; the median is kept.
+			double MinSecondsPerCase = 0.02;
+			uint32_t MinRepetitionCount = 3;
+
+			// Sectors per profile segment for StageType::Chunks, at most the tessellation.
+			uint32_t ChunkSectorCount = 16;
+
+			double RegressionThreshold = 0.1;
+
+			// Cases faster than this in the baseline are too noisy to compare.
+			double MinComparedNanoseconds = 1000;
+		};
+
+		struct Result {
+			ProfileType Profile;
+			uint32_t Tessellation;
+			float OffsetX;
+			StageType Stage;
+			double Nanoseconds;
+			AllocationCounter::Counts Allocations;
+
+			// Mesh data produced by the stage, or consumed by it for the encoders.
+			uint64_t Bytes;
+
+			double GetBytesPerSecond() const { return Nanoseconds > 0 ? static_cast<double>(Bytes) / Nanoseconds * 1e9 : 0; }
+		};
+
+		static std::vector<Result> Run() { return Run(Options()); }
+
+		static std::vector<Result> Run(const Options& options) {
+			using namespace Hydr10n::Meshes;
+
+			if (!options.MinRepetitionCount || !options.ChunkSectorCount) throw std::invalid_argument("Invalid mesh generator benchmark options");
+
+			std::vector<Result> results;
+
+			for (size_t profileIndex = 0; profileIndex < static_cast<size_t>(ProfileType::Count); profileIndex++) {
+				const auto profile = static_cast<ProfileType>(profileIndex);
+				const auto points = GetProfilePoints(profile);
+				const auto verticalTessellation = profile == ProfileType::Arbitrary ? 10u : 1u;
+
+				for (const auto tessellation : options.Tessellations) {
+					if (tessellation < 3) throw std::invalid_argument("Tessellation must be at least 3");
+
+					for (const auto offsetX : options.OffsetXs) {
+						Mesh mesh, sector;
+						std::vector<DirectX::XMFLOAT3X4> instanceTransforms;
+						std::vector<std::byte> encodedIndices, encodedVertices;
+
+						const auto Measure = [&](StageType stage, const auto& function) {
+							Result result{ profile, tessellation, offsetX, stage, 0, {}, 0 };
+
+							std::vector<double> nanoseconds;
+							const auto start = std::chrono::steady_clock::now();
+							do {
+								const auto allocations = AllocationCounter::GetCounts();
+								const auto stageStart = std::chrono::steady_clock::now();
+
+								result.Bytes = function();
+
+								nanoseconds.push_back(std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - stageStart).count());
+								result.Allocations = AllocationCounter::GetCounts() - allocations;
+							} while (nanoseconds.size() < options.MinRepetitionCount || std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() < options.MinSecondsPerCase);
+
+							const auto middle = nanoseconds.begin() + static_cast<ptrdiff_t>(nanoseconds.size() / 2);
+							std::nth_element(nanoseconds.begin(), middle, nanoseconds.end());
+							result.Nanoseconds = *middle;
+
+							results.push_back(result);
+						};
+
+						const auto Generate = [&](Mesh& output, MeshGenerator::IndexCollection* pLineIndices, MeshGenerator::IndexTopology topology, MeshGenerator::ChunkCollection* pChunks) {
+							output = {};
+							MeshGenerator::CreateMeshAroundYAxis(output.Vertices, output.Indices, points.data(), points.size(), verticalTessellation, tessellation, offsetX, pLineIndices, topology, pChunks, std::min(options.ChunkSectorCount, tessellation));
+							return output.GetSize();
+						};
+
+						Measure(StageType::TriangleList, [&] { return Generate(mesh, nullptr, MeshGenerator::IndexTopology::TriangleList, nullptr); });
+
+						Measure(StageType::LineList, [&] {
+							Mesh output;
+							return Generate(output, &output.LineIndices, MeshGenerator::IndexTopology::TriangleList, nullptr);
+						});
+
+						Measure(StageType::TriangleStrip, [&] {
+							Mesh output;
+							return Generate(output, nullptr, MeshGenerator::IndexTopology::TriangleStrip, nullptr);
+						});
+
+						Measure(StageType::Chunks, [&] {
+							Mesh output;
+							return Generate(output, &output.LineIndices, MeshGenerator::IndexTopology::TriangleStrip, &output.Chunks);
+						});
+
+						Measure(StageType::Sector, [&] {
+							sector = {};
+							instanceTransforms = {};
+							MeshGenerator::CreateSectorAroundYAxis(sector.Vertices, sector.Indices, instanceTransforms, points.data(), points.size(), verticalTessellation, tessellation, 1, offsetX);
+							return sector.GetSize() + sizeof(instanceTransforms[0]) * instanceTransforms.size();
+						});
+
+						Measure(StageType::ExpandSector, [&] {
+							Mesh output;
+							MeshGenerator::ExpandSectorInstances(output.Vertices, output.Indices, sector.Vertices, sector.Indices, instanceTransforms);
+							return output.GetSize();
+						});
+
+						Measure(StageType::EncodeIndices, [&] {
+							encodedIndices = MeshCodec::EncodeIndices(mesh.Indices);
+							return static_cast<uint64_t>(sizeof(mesh.Indices[0]) * mesh.Indices.size());
+						});
+
+						Measure(StageType::EncodeVertices, [&] {
+							encodedVertices = MeshCodec::EncodeVertices(mesh.Vertices);
+							return static_cast<uint64_t>(sizeof(mesh.Vertices[0]) * mesh.Vertices.size());
+						});
+
+						Measure(StageType::DecodeIndices, [&] {
+							MeshGenerator::IndexCollection indices;
+							MeshCodec::DecodeIndices(encodedIndices, indices);
+							return static_cast<uint64_t>(sizeof(indices[0]) * indices.size());
+						});
+
+						Measure(StageType::DecodeVertices, [&] {
+							MeshGenerator::VertexCollection vertices;
+							MeshCodec::DecodeVertices(encodedVertices, vertices);
+							return static_cast<uint64_t>(sizeof(vertices[0]) * vertices.size());
+						});
+					}
+				}
+			}
+
+			return results;
+		}
+
+		static void WriteJson(std::ostream& stream, const std::vector<Result>& results) {
+			stream << "{\n";
+			stream << "  \"allocationsCounted\": " << (AllocationCounter::IsAvailable ? "true" : "false") << ",\n";
+			stream << "  \"cases\": [";
+			for (size_t i = 0; i < results.size(); i++) {
+				const auto& result = results[i];
+				stream << (i ? ",\n" : "\n") << "    { \"profile\": \"" << ProfileNames[static_cast<size_t>(result.Profile)]
+					<< "\", \"tessellation\": " << result.Tessellation
+					<< ", \"offsetX\": " << result.OffsetX
+					<< ", \"stage\": \"" << StageNames[static_cast<size_t>(result.Stage)]
+					<< "\", \"ns\": " << result.Nanoseconds
+					<< ", \"allocations\": " << result.Allocations.AllocationCount
+					<< ", \"allocatedBytes\": " << result.Allocations.AllocatedBytes
+					<< ", \"bytes\": " << result.Bytes
+					<< ", \"bytesPerSecond\": " << result.GetBytesPerSecond() << " }";
+			}
+			stream << (results.empty() ? "]\n" : "\n  ]\n") << "}\n";
+		}
+
+		static void WriteJson(const std::filesystem::path& path, const std::vector<Result>& results) {
+			std::ofstream file(path, std::ios::trunc);
+			if (!file) throw std::runtime_error("Failed to create mesh generator benchmark results file");
+
+			WriteJson(file, results);
+
+			if (!file) throw std::runtime_error("Failed to write mesh generator benchmark results file");
+		}
+
+		// Reads what WriteJson wrote; cases with unknown profiles or stages are skipped.
+		static std::vector<Result> ReadJson(const std::filesystem::path& path) {
+			std::ifstream file(path);
+			if (!file) throw std::runtime_error("Failed to open mesh generator benchmark baseline file");
+
+			std::vector<Result> results;
+
+			std::string line;
+			while (std::getline(file, line)) {
+				if (line.find("\"profile\"") == std::string::npos) continue;
+
+				const auto profile = FindName(ProfileNames, GetJsonValue(line, "profile")), stage = FindName(StageNames, GetJsonValue(line, "stage"));
+				if (profile == std::size(ProfileNames) || stage == std::size(StageNames)) continue;
+
+				Result result{ static_cast<ProfileType>(profile), 0, 0, static_cast<StageType>(stage), 0, {}, 0 };
+				result.Tessellation = static_cast<uint32_t>(ParseNumber(line, "tessellation"));
+				result.OffsetX = static_cast<float>(ParseNumber(line, "offsetX"));
+				result.Nanoseconds = ParseNumber(line, "ns");
+				result.Allocations = { static_cast<uint64_t>(ParseNumber(line, "allocations")), static_cast<uint64_t>(ParseNumber(line, "allocatedBytes")) };
+				result.Bytes = static_cast<uint64_t>(ParseNumber(line, "bytes"));
+				results.push_back(result);
+			}
+
+			return results;
+		}
+
+		// One line per regressed case; cases missing from either side are not compared.
+		static std::vector<std::string> Compare(const std::vector<Result>& results, const std::vector<Result>& baseline, const Options& options) {
+			const auto GetKey = [](const Result& result) { return std::tuple(result.Profile, result.Tessellation, result.OffsetX, result.Stage); };
+
+			std::map<decltype(GetKey(baseline[0])), const Result*> baselineResults;
+			for (const auto& result : baseline) baselineResults[GetKey(result)] = &result;
+
+			std::vector<std::string> regressions;
+
+			for (const auto& result : results) {
+				const auto baselineResult = baselineResults.find(GetKey(result));
+				if (baselineResult == baselineResults.cend() || baselineResult->second->Nanoseconds < options.MinComparedNanoseconds) continue;
+
+				const auto bytesPerSecond = result.GetBytesPerSecond(), baselineBytesPerSecond = baselineResult->second->GetBytesPerSecond();
+				if (bytesPerSecond < baselineBytesPerSecond * (1 - options.RegressionThreshold)) {
+					std::ostringstream regression;
+					regression << ProfileNames[static_cast<size_t>(result.Profile)] << '/' << result.Tessellation << '/' << result.OffsetX << '/' << StageNames[static_cast<size_t>(result.Stage)]
+						<< ": " << bytesPerSecond / 1e6 << " MB/s against a baseline of " << baselineBytesPerSecond / 1e6 << " MB/s";
+					regressions.push_back(regression.str());
+				}
+			}
+
+			return regressions;
+		}
+
+		// Radius, height.
+		static std::vector<DirectX::XMFLOAT2> GetProfilePoints(ProfileType profile) {
+			switch (profile) {
+			case ProfileType::Sphere: {
+				constexpr uint32_t SliceCount = 32;
+
+				std::vector<DirectX::XMFLOAT2> points;
+				for (uint32_t i = 0; i <= SliceCount; i++) {
+					const auto radians = -DirectX::XM_PIDIV2 + DirectX::XM_PI * static_cast<float>(i) / SliceCount;
+					points.push_back({ std::cos(radians), std::sin(radians) });
+				}
+				return points;
+			}
+
+			// As in README.md.
+			case ProfileType::Arbitrary: return { { 0, 1 }, { 0.4f, 0.4f }, { 1, 0 }, { 0.4f, -0.4f }, { 0, -1 } };
+
+			// Repeated points, a flat ring, a point on the axis between segments and a collinear run.
+			case ProfileType::Degenerate: return { { 0, 0 }, { 0, 0 }, { 1, 0 }, { 1, 0 }, { 1, 0.5f }, { 1, 1 }, { 0.5f, 1 }, { 0.5f, 1 }, { 0, 1.5f }, { 0.5f, 2 }, { 0, 2 } };
+
+			default: throw std::out_of_range("Invalid mesh generator benchmark profile");
+			}
+		}
+
+	private:
+		struct Mesh {
+			Hydr10n::Meshes::MeshGenerator::VertexCollection Vertices;
+			Hydr10n::Meshes::MeshGenerator::IndexCollection Indices, LineIndices;
+			Hydr10n::Meshes::MeshGenerator::ChunkCollection Chunks;
+
+			uint64_t GetSize() const {
+				return sizeof(Vertices[0]) * Vertices.size() + sizeof(Indices[0]) * (Indices.size() + LineIndices.size()) + sizeof(Chunks[0]) * Chunks.size();
+			}
+		};
+
+		template <size_t Size>
+		static size_t FindName(const char* const (&names)[Size], std::string_view name) {
+			return static_cast<size_t>(std::find(std::begin(names), std::end(names), name) - std::begin(names));
+		}
+
+		static std::string_view GetJsonValue(std::string_view line, std::string_view key) {
+			const auto keyStart = line.find('"' + std::string(key) + "\":");
+			if (keyStart == std::string_view::npos) throw std::runtime_error("Invalid mesh generator benchmark baseline file");
+
+			auto value = line.substr(keyStart + key.size() + 3);
+			value.remove_prefix(std::min(value.find_first_not_of(' '), value.size()));
+
+			if (value.starts_with('"')) return value.substr(1, value.find('"', 1) - 1);
+			return value.substr(0, value.find_first_of(",}"));
+		}
+
+		static double ParseNumber(std::string_view line, std::string_view key) {
+			const std::string value(GetJsonValue(line, key));
+
+			char* end;
+			const auto number = std::strtod(value.c_str(), &end);
+			if (end == value.c_str()) throw std::runtime_error("Invalid mesh generator benchmark baseline file");
+			return number;
+		}
+	};
+}
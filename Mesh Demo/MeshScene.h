@@ -0,0 +1,181 @@
+/*
+ * Header File: MeshScene.h
+ * Last Update: 2026/10/18
+ *
+ * Copyright (C) Hydr10n@GitHub. All Rights Reserved.
+ */
+
+#pragma once
+
+#include "RenderBackend.h"
+
+#include "Meshes.h"
+#include "MeshCulling.h"
+#include "TaskGraph.h"
+
+#include "FrustumCulling.h"
+
+#include <DirectXColors.h>
+
+#include <cmath>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <utility>
+
+namespace Hydr10n::Rendering {
+	struct SceneView {
+		DirectX::XMMATRIX View, Projection;
+		DirectX::XMVECTOR Position;
+		Rendering::Viewport Viewport;
+		Rendering::ScissorRect ScissorRect;
+	};
+
+	// Lays split-screen views out in a grid with as many columns as rows or one more, in row-major order, covering the output
+	// without gaps or overlaps.
+	inline void LayOutSplitScreen(const OutputSize& outputSize, std::span<Viewport> viewports, std::span<ScissorRect> scissorRects) {
+		if (viewports.size() != scissorRects.size()) throw std::invalid_argument("Every view needs a viewport and a scissor rectangle");
+
+		const auto outputWidth = static_cast<int32_t>(outputSize.Width), outputHeight = static_cast<int32_t>(outputSize.Height);
+
+		const auto viewCount = static_cast<int32_t>(viewports.size());
+		int32_t columnCount = 1;
+		while (columnCount * columnCount < viewCount) columnCount++;
+		const auto rowCount = (viewCount + columnCount - 1) / columnCount;
+
+		for (int32_t i = 0; i < viewCount; i++) {
+			const auto column = i % columnCount, row = i / columnCount;
+
+			auto& scissorRect = scissorRects[i];
+			scissorRect = {
+				outputWidth * column / columnCount, outputHeight * row / rowCount,
+				outputWidth * (column + 1) / columnCount, outputHeight * (row + 1) / rowCount
+			};
+
+			viewports[i] = {
+				static_cast<float>(scissorRect.Left), static_cast<float>(scissorRect.Top),
+				static_cast<float>(scissorRect.Right - scissorRect.Left), static_cast<float>(scissorRect.Bottom - scissorRect.Top),
+				0, 1
+			};
+		}
+	}
+
+	// The demo sphere split into chunks, which are culled per view before their draws are submitted to any backend.
+	class MeshScene {
+	public:
+		static constexpr size_t MaxViewCount = DX::MultiViewFrustum::c_MaxViews;
+
+		static constexpr uint32_t ChunkSectorCount = 16;
+
+		// The CPU side of the scene, which may be generated on any thread before the buffers are created from it.
+		struct Geometry {
+			Hydr10n::Meshes::MeshGenerator::VertexCollection Vertices;
+			Hydr10n::Meshes::MeshGenerator::IndexCollection Indices, LineIndices;
+			Hydr10n::Meshes::MeshGenerator::ChunkCollection Chunks;
+
+			static Geometry Generate() {
+				using namespace DirectX;
+				using namespace Hydr10n::Meshes;
+
+				Geometry geometry;
+
+				constexpr auto SemiCircleSliceCount = 200;
+				std::vector<XMFLOAT2> points;
+				for (uint32_t i = 0; i <= SemiCircleSliceCount; i++) {
+					const auto radians = -XM_PIDIV2 + XM_PI * static_cast<float>(i) / SemiCircleSliceCount;
+					points.push_back({ std::cos(radians), std::sin(radians) });
+				}
+
+				MeshGenerator::CreateMeshAroundYAxis(geometry.Vertices, geometry.Indices, points.data(), points.size(), 1, SemiCircleSliceCount * 2, 0, &geometry.LineIndices, MeshGenerator::IndexTopology::TriangleStrip, &geometry.Chunks, ChunkSectorCount);
+
+				return geometry;
+			}
+		};
+
+		explicit MeshScene(IDevice& device) noexcept(false) : MeshScene(device, Geometry::Generate()) {}
+
+		MeshScene(IDevice& device, Geometry geometry) noexcept(false) : m_chunks(std::move(geometry.Chunks)) {
+			const auto& [vertices, indices, lineIndices, chunks] = geometry;
+
+			for (const auto& chunk : m_chunks) m_chunkBounds.push_back(chunk.Bounds);
+
+			m_vertexBuffer = device.CreateBuffer(BufferType::Vertex, vertices.data(), sizeof(vertices[0]) * vertices.size());
+			m_indexBuffer = device.CreateBuffer(BufferType::Index, indices.data(), sizeof(indices[0]) * indices.size());
+			m_lineIndexBuffer = device.CreateBuffer(BufferType::Index, lineIndices.data(), sizeof(lineIndices[0]) * lineIndices.size());
+		}
+
+		// Adds a "Mesh" task that generates the geometry on a worker thread and an "Upload" task after it that creates the
+		// scene's buffers on device into scene, which must outlive the graph; returns the Upload task.
+		static TaskGraph::TaskId AddCreationTasks(TaskGraph& taskGraph, IDevice& device, std::unique_ptr<MeshScene>& scene) {
+			const auto geometry = std::make_shared<Geometry>();
+			const auto generateMesh = taskGraph.Add("Mesh", [geometry] { *geometry = Geometry::Generate(); });
+			return taskGraph.Add("Upload", [&device, &scene, geometry] { scene = std::make_unique<MeshScene>(device, std::move(*geometry)); }, { generateMesh });
+		}
+
+		const Hydr10n::Meshes::MeshGenerator::ChunkCollection& GetChunks() const { return m_chunks; }
+
+		static void Clear(ICommandList& commandList) {
+			DirectX::XMFLOAT4 color;
+			DirectX::XMStoreFloat4(&color, DirectX::Colors::LightSteelBlue);
+			commandList.Clear(color, 1);
+		}
+
+		// Tests every chunk once against the frustums of all views, leaving one visibility mask per view.
+		void Cull(std::span<const SceneView> views) {
+			using namespace DirectX;
+
+			if (views.size() > MaxViewCount) throw std::out_of_range("Too many views");
+
+			XMMATRIX viewProjections[MaxViewCount];
+			uint32_t* visibility[MaxViewCount];
+			for (size_t i = 0; i < views.size(); i++) {
+				viewProjections[i] = XMMatrixMultiply(views[i].View, views[i].Projection);
+
+				m_chunkVisibility[i].resize((m_chunkBounds.size() + 31) / 32);
+				visibility[i] = m_chunkVisibility[i].data();
+			}
+
+			DX::CullBoxes(DX::MultiViewFrustum::CreateFromMatrices(viewProjections, views.size()), m_chunkBounds.data(), m_chunkBounds.size(), visibility);
+		}
+
+		// Only the chunks inside the view frustum are drawn; in solid mode, chunks facing away are skipped as well since the mesh is closed. Cull must have been called with the same views.
+		void Draw(ICommandList& commandList, std::span<const SceneView> views, bool isWireframe) {
+			using namespace DirectX;
+			using namespace Hydr10n::Meshes;
+
+			commandList.SetVertexBuffer(m_vertexBuffer, sizeof(MeshGenerator::Vertex));
+			commandList.SetIndexBuffer(isWireframe ? m_lineIndexBuffer : m_indexBuffer);
+			commandList.SetPrimitiveTopology(isWireframe ? PrimitiveTopology::LineList : PrimitiveTopology::TriangleStrip);
+
+			EffectConstants effectConstants;
+			XMStoreFloat4x4(&effectConstants.World, XMMatrixIdentity());
+			XMStoreFloat4(&effectConstants.DiffuseColor, Colors::Teal);
+
+			for (size_t i = 0; i < views.size(); i++) {
+				const auto& view = views[i];
+
+				m_visibleIndexRanges.clear();
+				m_visibleLineIndexRanges.clear();
+				ChunkCuller::Cull(m_chunks, m_chunkVisibility[i].data(), view.Position, !isWireframe, m_visibleIndexRanges, &m_visibleLineIndexRanges);
+
+				commandList.SetViewport(view.Viewport, view.ScissorRect);
+
+				XMStoreFloat4x4(&effectConstants.View, view.View);
+				XMStoreFloat4x4(&effectConstants.Projection, view.Projection);
+				commandList.SetEffect(effectConstants);
+
+				for (const auto& range : isWireframe ? m_visibleLineIndexRanges : m_visibleIndexRanges) {
+					commandList.DrawIndexed(range.IndexCount, range.StartIndex);
+				}
+			}
+		}
+
+	private:
+		Hydr10n::Meshes::MeshGenerator::ChunkCollection m_chunks;
+		std::vector<DirectX::BoundingBox> m_chunkBounds;
+		std::vector<uint32_t> m_chunkVisibility[MaxViewCount];
+		std::vector<Hydr10n::Meshes::IndexRange> m_visibleIndexRanges, m_visibleLineIndexRanges;
+
+		BufferHandle m_vertexBuffer{}, m_indexBuffer{}, m_lineIndexBuffer{};
+	};
+}
@@ -1,6 +1,6 @@
 /*
  * Header File: Meshes.h
- * Last Update: 2022/01/10
+ * Last Update: 2026/10/18
  *
  * Copyright (C) Hydr10n@GitHub. All Rights Reserved.
  */
@@ -9,6 +9,13 @@
 
 #include "VertexTypes.h"
 
+#include <DirectXCollision.h>
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <span>
+#include <stdexcept>
 #include <vector>
 #include <map>
 #include <set>
@@ -19,11 +26,114 @@ namespace Hydr10n::Meshes {
 		using VertexCollection = std::vector<Vertex>;
 		using IndexCollection = std::vector<uint32_t>;
 
+		// Triangle strips are separated by StripCutIndex (D3D12_INDEX_BUFFER_STRIP_CUT_VALUE_0xFFFFFFFF).
+		enum class IndexTopology { TriangleList, TriangleStrip };
+
+		static constexpr uint32_t StripCutIndex = 0xFFFFFFFF;
+
+		// One angular sector of one profile segment, drawn by its own contiguous ranges of the index and line index data.
+		struct Chunk {
+			uint32_t StartIndex, IndexCount, StartLineIndex, LineIndexCount;
+			DirectX::BoundingBox Bounds;
+
+			// Every face normal is within acos(ConeCutoff) of ConeAxis; ConeCutoff <= 0 leaves nothing to cull by facing.
+			DirectX::XMFLOAT3 ConeAxis;
+			float ConeCutoff;
+		};
+
+		using ChunkCollection = std::vector<Chunk>;
+
+		/*
+		 * pLineIndices, if not null, receives a line list with each unique edge of every profile segment's grid or fan once,
+		 * the seam vertices closing a full revolution being treated as merged with the first ones they duplicate by position.
+		 * A ring shared by two profile segments has vertices of its own in each, so it is listed once per segment, and edges
+		 * of a row collapsed onto Y-axis, such as a pole of a sphere, coincide with those of the next row.
+		 *
+		 * pChunks, if not null, receives chunkSectorCount chunks per profile segment and the index data is grouped by chunk:
+		 * sector by sector, and bottom to top within a sector, so that neighbouring visible chunks tend to form one range.
+		 */
 		static void CreateMeshAroundYAxis(
 			VertexCollection& vertices, IndexCollection& indices,
 			const DirectX::XMFLOAT2* pPoints, size_t pointCount,
 			uint32_t verticalTessellation = 3, uint32_t horizontalTessellation = 3,
-			float offsetX = 0
+			float offsetX = 0,
+			IndexCollection* pLineIndices = nullptr,
+			IndexTopology topology = IndexTopology::TriangleList,
+			ChunkCollection* pChunks = nullptr, uint32_t chunkSectorCount = 1
+		) {
+			if (pChunks != nullptr && (!chunkSectorCount || chunkSectorCount > horizontalTessellation)) throw std::invalid_argument("Chunk sector count must be between 1 and horizontal tessellation");
+
+			CreateSlices(vertices, indices, pPoints, pointCount, verticalTessellation, horizontalTessellation, horizontalTessellation, offsetX, pLineIndices, topology, pChunks, chunkSectorCount);
+		}
+
+		/*
+		 * The mesh revolved around Y-axis is horizontalTessellation identical slices, so it can be drawn as one sector of
+		 * sectorSliceCount slices instanced horizontalTessellation / sectorSliceCount times. instanceTransforms receives one
+		 * rotation per instance, stored with XMStoreFloat3x4 for use as a per-instance float3x4 world matrix.
+		 *
+		 * Instance k covers slices [k * sectorSliceCount, (k + 1) * sectorSliceCount) of the equivalent CreateMeshAroundYAxis mesh.
+		 */
+		static void CreateSectorAroundYAxis(
+			VertexCollection& vertices, IndexCollection& indices, std::vector<DirectX::XMFLOAT3X4>& instanceTransforms,
+			const DirectX::XMFLOAT2* pPoints, size_t pointCount,
+			uint32_t verticalTessellation = 3, uint32_t horizontalTessellation = 3, uint32_t sectorSliceCount = 1,
+			float offsetX = 0,
+			IndexCollection* pLineIndices = nullptr,
+			IndexTopology topology = IndexTopology::TriangleList
+		) {
+			using namespace DirectX;
+
+			if (!sectorSliceCount || horizontalTessellation % sectorSliceCount) throw std::invalid_argument("Sector slice count must divide horizontal tessellation");
+
+			CreateSlices(vertices, indices, pPoints, pointCount, verticalTessellation, horizontalTessellation, sectorSliceCount, offsetX, pLineIndices, topology, nullptr, 1);
+
+			const auto instanceCount = horizontalTessellation / sectorSliceCount;
+			const auto radiansStep = XM_2PI / static_cast<float>(instanceCount);
+			for (uint32_t i = 0; i < instanceCount; i++) {
+				// Slice angles grow from +X towards +Z, which XMMatrixRotationY does for negative angles.
+				XMStoreFloat3x4(&instanceTransforms.emplace_back(), XMMatrixRotationY(-radiansStep * static_cast<float>(i)));
+			}
+		}
+
+		// Reference expansion of an instanced sector on the CPU. Strip cut indices are kept as they are.
+		static void ExpandSectorInstances(
+			VertexCollection& vertices, IndexCollection& indices,
+			const VertexCollection& sectorVertices, const IndexCollection& sectorIndices, std::span<const DirectX::XMFLOAT3X4> instanceTransforms
+		) {
+			using namespace DirectX;
+
+			for (const auto& instanceTransform : instanceTransforms) {
+				const auto baseIndex = static_cast<uint32_t>(vertices.size());
+
+				const auto transform = XMLoadFloat3x4(&instanceTransform);
+				for (const auto& sectorVertex : sectorVertices) {
+					Vertex vertex;
+					XMStoreFloat3(&vertex.position, XMVector3Transform(XMLoadFloat3(&sectorVertex.position), transform));
+					XMStoreFloat3(&vertex.normal, XMVector3TransformNormal(XMLoadFloat3(&sectorVertex.normal), transform));
+					vertices.emplace_back(vertex);
+				}
+
+				for (const auto index : sectorIndices) indices.emplace_back(index == StripCutIndex ? StripCutIndex : index + baseIndex);
+			}
+		}
+
+	private:
+		// Vertices of one profile segment: a grid of rowCount rows of quads, or a fan around centerIndex if rowCount is 0.
+		struct Band {
+			uint32_t BaseIndex, RowCount, CenterIndex;
+			bool ReverseWinding;
+			float MinY;
+		};
+
+		// Slices [0, sliceCount) of the mesh revolved around Y-axis, each spanning 2 * pi / horizontalTessellation radians.
+		static void CreateSlices(
+			VertexCollection& vertices, IndexCollection& indices,
+			const DirectX::XMFLOAT2* pPoints, size_t pointCount,
+			uint32_t verticalTessellation, uint32_t horizontalTessellation, uint32_t sliceCount,
+			float offsetX,
+			IndexCollection* pLineIndices,
+			IndexTopology topology,
+			ChunkCollection* pChunks, uint32_t chunkSectorCount
 		) {
 			using namespace DirectX;
 
@@ -41,13 +151,15 @@ namespace Hydr10n::Meshes {
 			for (size_t i = 0; i < pointCount; i++) {
 				const auto& a = pPoints[i], & b = pPoints[(i + 1) % pointCount];
 
-				minY = min(minY, min(a.y, b.y));
+				minY = std::min({ minY, a.y, b.y });
 
 				if ((i != pointCount - 1 || (a.x == b.x && a.y == b.y)) && (!points.contains(b) || !points[b].contains(a))) {
 					points[a].insert(b);
 				}
 			}
 
+			std::vector<Band> bands;
+
 			for (const auto& pair : points) {
 				for (const auto& point : pair.second) {
 					const auto baseIndex = static_cast<uint32_t>(vertices.size());
@@ -61,7 +173,7 @@ namespace Hydr10n::Meshes {
 						for (uint32_t i = 0; i <= verticalTessellation; i++) {
 							const auto radius = i * radiusStep + bottom.x + offsetX;
 
-							for (uint32_t j = 0; j <= horizontalTessellation; j++) {
+							for (uint32_t j = 0; j <= sliceCount; j++) {
 								const auto c = cosf(j * radiansStep), s = sinf(j * radiansStep),
 									dr = bottom.x - top.x;
 
@@ -72,27 +184,40 @@ namespace Hydr10n::Meshes {
 							}
 						}
 
-						const auto ringVertexCount = horizontalTessellation + 1;
-						for (uint32_t i = 0; i < verticalTessellation; i++)
-							for (uint32_t j = 0; j < horizontalTessellation; j++) {
-								const auto a = i * ringVertexCount + j + baseIndex, b = (i + 1) * ringVertexCount + j + baseIndex, c = b + 1, d = a + 1;
+						bands.push_back({ baseIndex, verticalTessellation, 0, false, bottom.y });
+					}
+					else bands.emplace_back(CreateRing(vertices, std::min(bottom.x, top.x) + offsetX, std::max(bottom.x, top.x) + offsetX, bottom.y, bottom.y > minY, horizontalTessellation, sliceCount));
+				}
+			}
 
-								indices.emplace_back(a);
-								indices.emplace_back(b);
-								indices.emplace_back(c);
+			const auto ringVertexCount = sliceCount + 1;
 
-								indices.emplace_back(a);
-								indices.emplace_back(c);
-								indices.emplace_back(d);
-							}
-					}
-					else CreateRing(vertices, indices, min(bottom.x, top.x) + offsetX, max(bottom.x, top.x) + offsetX, bottom.y, bottom.y > minY, horizontalTessellation);
+			if (pChunks == nullptr) {
+				for (const auto& band : bands) AppendBandIndices(indices, pLineIndices, band, ringVertexCount, 0, sliceCount, topology);
+				return;
+			}
+
+			std::stable_sort(bands.begin(), bands.end(), [](const Band& a, const Band& b) { return a.MinY < b.MinY; });
+
+			for (uint32_t i = 0; i < chunkSectorCount; i++) {
+				const auto firstColumn = sliceCount * i / chunkSectorCount, lastColumn = sliceCount * (i + 1) / chunkSectorCount;
+
+				for (const auto& band : bands) {
+					auto& chunk = pChunks->emplace_back();
+					chunk.StartIndex = static_cast<uint32_t>(indices.size());
+					chunk.StartLineIndex = pLineIndices == nullptr ? 0 : static_cast<uint32_t>(pLineIndices->size());
+
+					AppendBandIndices(indices, pLineIndices, band, ringVertexCount, firstColumn, lastColumn, topology);
+
+					chunk.IndexCount = static_cast<uint32_t>(indices.size()) - chunk.StartIndex;
+					chunk.LineIndexCount = pLineIndices == nullptr ? 0 : static_cast<uint32_t>(pLineIndices->size()) - chunk.StartLineIndex;
+
+					ComputeChunkBounds(vertices, band, ringVertexCount, firstColumn, lastColumn, chunk);
 				}
 			}
 		}
 
-	private:
-		static void CreateRing(VertexCollection& vertices, IndexCollection& indices, float innerRadius, float outerRadius, float y, bool clockwiseWinding, uint32_t tessellation) {
+		static Band CreateRing(VertexCollection& vertices, float innerRadius, float outerRadius, float y, bool clockwiseWinding, uint32_t tessellation, uint32_t sliceCount) {
 			using namespace DirectX;
 
 			const XMFLOAT3 normal{ 0, clockwiseWinding ? 1.f : -1.f, 0 };
@@ -101,40 +226,174 @@ namespace Hydr10n::Meshes {
 
 			const auto baseIndex = static_cast<uint32_t>(vertices.size());
 
-			for (uint32_t i = 0; i <= tessellation; i++) {
+			for (uint32_t i = 0; i <= sliceCount; i++) {
 				const auto radians = radiansStep * static_cast<float>(i), x = outerRadius * cosf(radians), z = outerRadius * sinf(radians);
 				vertices.push_back({ { x, y, z }, normal });
 			}
 
 			if (innerRadius != 0) {
-				for (uint32_t i = 0; i <= tessellation; i++) {
+				for (uint32_t i = 0; i <= sliceCount; i++) {
 					const auto radians = radiansStep * static_cast<float>(i), x = innerRadius * cosf(radians), z = innerRadius * sinf(radians);
 					vertices.push_back({ { x, y, z }, normal });
 				}
 
-				const auto ringVertexCount = tessellation + 1;
-				for (uint32_t i = 0; i < tessellation; i++) {
-					const auto a = i + baseIndex, b = ringVertexCount + i + baseIndex, c = b + 1, d = a + 1;
+				// The outer ring is row 0 and the inner ring is row 1 of a single-row grid.
+				return { baseIndex, 1, 0, !clockwiseWinding, y };
+			}
+
+			vertices.push_back({ { 0, y, 0 }, normal });
 
-					indices.emplace_back(a);
-					indices.emplace_back(clockwiseWinding ? b : d);
-					indices.emplace_back(c);
+			return { baseIndex, 0, static_cast<uint32_t>(vertices.size() - 1), !clockwiseWinding, y };
+		}
 
-					indices.emplace_back(a);
-					indices.emplace_back(c);
-					indices.emplace_back(clockwiseWinding ? d : b);
-				}
+		static void AppendBandIndices(IndexCollection& indices, IndexCollection* pLineIndices, const Band& band, uint32_t ringVertexCount, uint32_t firstColumn, uint32_t lastColumn, IndexTopology topology) {
+			if (band.RowCount) AppendGridIndices(indices, pLineIndices, band.BaseIndex, ringVertexCount, band.RowCount, firstColumn, lastColumn, band.ReverseWinding, topology);
+			else AppendFanIndices(indices, pLineIndices, band.CenterIndex, band.BaseIndex, firstColumn, lastColumn, !band.ReverseWinding, topology);
+		}
+
+		// The normal cone is built from face normals, each oriented to agree with the outward vertex normals.
+		static void ComputeChunkBounds(const VertexCollection& vertices, const Band& band, uint32_t ringVertexCount, uint32_t firstColumn, uint32_t lastColumn, Chunk& chunk) {
+			using namespace DirectX;
+
+			std::vector<XMFLOAT3> positions;
+			std::vector<XMVECTOR> normals;
+
+			const auto AddTriangle = [&](uint32_t a, uint32_t b, uint32_t c) {
+				const auto A = XMLoadFloat3(&vertices[a].position);
+				const auto normal = XMVector3Cross(XMVectorSubtract(XMLoadFloat3(&vertices[b].position), A), XMVectorSubtract(XMLoadFloat3(&vertices[c].position), A));
+				if (XMVectorGetX(XMVector3LengthSq(normal)) <= FLT_MIN) return;
+
+				const auto orientedNormal = XMVector3Normalize(normal);
+				normals.emplace_back(XMVectorGetX(XMVector3Dot(orientedNormal, XMLoadFloat3(&vertices[a].normal))) < 0 ? XMVectorNegate(orientedNormal) : orientedNormal);
+			};
+
+			if (band.RowCount) {
+				for (uint32_t i = 0; i <= band.RowCount; i++)
+					for (auto j = firstColumn; j <= lastColumn; j++) {
+						const auto a = i * ringVertexCount + j + band.BaseIndex;
+
+						positions.emplace_back(vertices[a].position);
+
+						if (i < band.RowCount && j < lastColumn) {
+							const auto b = a + ringVertexCount, c = b + 1, d = a + 1;
+
+							AddTriangle(a, b, c);
+							AddTriangle(a, c, d);
+						}
+					}
 			}
 			else {
-				vertices.push_back({ { 0, y, 0 }, normal });
+				positions.emplace_back(vertices[band.CenterIndex].position);
+
+				for (auto j = firstColumn; j <= lastColumn; j++) {
+					positions.emplace_back(vertices[band.BaseIndex + j].position);
+
+					if (j < lastColumn) AddTriangle(band.CenterIndex, band.BaseIndex + j, band.BaseIndex + j + 1);
+				}
+			}
+
+			BoundingBox::CreateFromPoints(chunk.Bounds, positions.size(), positions.data(), sizeof(positions[0]));
+
+			auto axis = XMVectorZero();
+			for (const auto& normal : normals) axis = XMVectorAdd(axis, normal);
+
+			chunk.ConeCutoff = -1;
+			if (XMVectorGetX(XMVector3LengthSq(axis)) > FLT_MIN) {
+				axis = XMVector3Normalize(axis);
+
+				chunk.ConeCutoff = 1;
+				for (const auto& normal : normals) chunk.ConeCutoff = std::min(chunk.ConeCutoff, XMVectorGetX(XMVector3Dot(axis, normal)));
+			}
+			XMStoreFloat3(&chunk.ConeAxis, axis);
+		}
+
+		/*
+		 * Vertex (i, j) of the grid is baseIndex + i * ringVertexCount + j. Every quad (a, b, c, d) with a = (i, j),
+		 * b = (i + 1, j), c = (i + 1, j + 1) and d = (i, j + 1) is split along a-c into (a, b, c) and (a, c, d), or into
+		 * (a, d, c) and (a, c, b) when the winding is reversed.
+		 *
+		 * Each row of quads becomes one strip zigzagging b, a, b, a, ... With that order the first triangle comes out
+		 * reversed, so the forward winding starts with a repeated b to flip the parity.
+		 */
+		static void AppendGridIndices(
+			IndexCollection& indices, IndexCollection* pLineIndices,
+			uint32_t baseIndex, uint32_t ringVertexCount, uint32_t rowCount, uint32_t firstColumn, uint32_t lastColumn,
+			bool reverseWinding, IndexTopology topology
+		) {
+			for (uint32_t i = 0; i < rowCount; i++) {
+				if (topology == IndexTopology::TriangleStrip) {
+					if (!reverseWinding) indices.emplace_back((i + 1) * ringVertexCount + firstColumn + baseIndex);
+
+					for (auto j = firstColumn; j <= lastColumn; j++) {
+						indices.emplace_back((i + 1) * ringVertexCount + j + baseIndex);
+						indices.emplace_back(i * ringVertexCount + j + baseIndex);
+					}
+
+					indices.emplace_back(StripCutIndex);
+				}
+				else {
+					for (auto j = firstColumn; j < lastColumn; j++) {
+						const auto a = i * ringVertexCount + j + baseIndex, b = (i + 1) * ringVertexCount + j + baseIndex, c = b + 1, d = a + 1;
+
+						indices.emplace_back(a);
+						indices.emplace_back(reverseWinding ? d : b);
+						indices.emplace_back(c);
 
-				const auto centerIndex = static_cast<uint32_t>(vertices.size() - 1);
-				for (uint32_t i = 0; i < tessellation; i++) {
+						indices.emplace_back(a);
+						indices.emplace_back(c);
+						indices.emplace_back(reverseWinding ? b : d);
+					}
+				}
+			}
+
+			if (pLineIndices != nullptr) {
+				// Vertical, diagonal and bottom edges of every quad, then the top row. The column after the last one is either shared with the next range or duplicates the first column, so its vertical edges are skipped.
+				for (uint32_t i = 0; i < rowCount; i++)
+					for (auto j = firstColumn; j < lastColumn; j++) {
+						const auto a = i * ringVertexCount + j + baseIndex, b = (i + 1) * ringVertexCount + j + baseIndex, c = b + 1, d = a + 1;
+
+						pLineIndices->insert(pLineIndices->end(), { a, b, a, c, a, d });
+					}
+
+				for (auto j = firstColumn; j < lastColumn; j++) {
+					const auto a = rowCount * ringVertexCount + j + baseIndex;
+
+					pLineIndices->insert(pLineIndices->end(), { a, a + 1 });
+				}
+			}
+		}
+
+		/*
+		 * Triangles (center, rim[j + 1], rim[j]) when clockwise, (center, rim[j], rim[j + 1]) otherwise.
+		 * As a strip the center alternates with the rim: rim, center, rim, center, ..., where every other triangle is degenerate.
+		 */
+		static void AppendFanIndices(
+			IndexCollection& indices, IndexCollection* pLineIndices,
+			uint32_t centerIndex, uint32_t baseIndex, uint32_t firstColumn, uint32_t lastColumn,
+			bool clockwiseWinding, IndexTopology topology
+		) {
+			if (topology == IndexTopology::TriangleStrip) {
+				indices.emplace_back(baseIndex + firstColumn);
+				if (!clockwiseWinding) indices.emplace_back(baseIndex + firstColumn);
+
+				for (auto j = firstColumn + 1; j <= lastColumn; j++) {
+					indices.emplace_back(centerIndex);
+					indices.emplace_back(baseIndex + j);
+				}
+
+				indices.emplace_back(StripCutIndex);
+			}
+			else {
+				for (auto j = firstColumn; j < lastColumn; j++) {
 					indices.emplace_back(centerIndex);
-					indices.emplace_back(baseIndex + i + static_cast<uint32_t>(clockwiseWinding));
-					indices.emplace_back(baseIndex + i + static_cast<uint32_t>(!clockwiseWinding));
+					indices.emplace_back(baseIndex + j + static_cast<uint32_t>(clockwiseWinding));
+					indices.emplace_back(baseIndex + j + static_cast<uint32_t>(!clockwiseWinding));
 				}
 			}
+
+			if (pLineIndices != nullptr) {
+				for (auto j = firstColumn; j < lastColumn; j++) pLineIndices->insert(pLineIndices->end(), { centerIndex, baseIndex + j, baseIndex + j, baseIndex + j + 1 });
+			}
 		}
 	};
 }
@@ -0,0 +1,242 @@
+/*
+ * Header File: OcclusionBenchmark.h
+ * Last Update: 2026/10/18
+ *
+ * Copyright (C) Hydr10n@GitHub. All Rights Reserved.
+ */
+
+#pragma once
+
+#include "MaskedOcclusionCulling.h"
+#include "Meshes.h"
+
+#include "CameraPath.h"
+#include "FrustumCulling.h"
+#include "OrbitCameraState.h"
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+
+namespace Hydr10n::Benchmarks {
+	/*
+	 * A grid of turned parts flown through along a camera path. Every frame, the parts left by frustum culling are
+	 * sorted front to back, the nearest ones are drawn into a MaskedOcclusionCuller as occluders, and all of them are
+	 * then tested against it.
+	 *
+	 * Occluders are the parts' profiles revolved with OccluderSliceCount slices. Each slice polygon is inscribed in the
+	 * circle it approximates, so the occluder stays inside any finer tessellation whose slice count is a multiple of it.
+	 */
+	class OcclusionBenchmark {
+	public:
+		struct Options {
+			uint32_t GridSize = 48;
+			float Spacing = 3;
+			uint32_t Width = 512, Height = 256;
+			uint32_t OccluderSliceCount = 8, MaxOccluderCount = 96;
+			// Above 1, occluders are binned and rasterized on that many threads.
+			uint32_t ThreadCount = 1;
+			bool IsAVX2Enabled = true;
+			double FrameRate = 60;
+		};
+
+		struct FrameResult {
+			uint32_t VisiblePartCount, OccludedPartCount;
+			std::chrono::steady_clock::duration RasterizeTime, TestTime;
+		};
+
+		explicit OcclusionBenchmark(DX::CameraPath cameraPath) noexcept(false) : OcclusionBenchmark(std::move(cameraPath), Options()) {}
+
+		OcclusionBenchmark(DX::CameraPath cameraPath, const Options& options) noexcept(false) : m_cameraPath(std::move(cameraPath)), m_options(options) {
+			using namespace DirectX;
+			using namespace Hydr10n::Meshes;
+
+			if (!options.GridSize || !options.OccluderSliceCount || !(options.FrameRate > 0)) throw std::invalid_argument("Invalid occlusion benchmark options");
+
+			if (options.ThreadCount > 1) m_workerPool = std::make_unique<decltype(m_workerPool)::element_type>(options.ThreadCount);
+			m_culler = std::make_unique<decltype(m_culler)::element_type>(options.Width, options.Height, m_workerPool.get());
+			m_culler->SetAVX2Enabled(options.IsAVX2Enabled);
+
+			// Radius, height: a stepped shaft, a flanged bushing and a pulley.
+			const std::vector<XMFLOAT2> profiles[]{
+				{ { 0, 0 }, { 0.5f, 0 }, { 0.5f, 1.2f }, { 0.35f, 1.2f }, { 0.35f, 2.6f }, { 0.25f, 2.6f }, { 0.25f, 3 }, { 0, 3 } },
+				{ { 0.3f, 0 }, { 1, 0 }, { 1, 0.3f }, { 0.6f, 0.3f }, { 0.6f, 1.6f }, { 0.3f, 1.6f } },
+				{ { 0, 0 }, { 1.1f, 0 }, { 1.1f, 0.2f }, { 0.8f, 0.5f }, { 1.1f, 0.8f }, { 1.1f, 1 }, { 0, 1 } }
+			};
+
+			for (const auto& profile : profiles) {
+				MeshGenerator::VertexCollection vertices;
+				auto& occluder = m_occluders.emplace_back();
+				MeshGenerator::CreateMeshAroundYAxis(vertices, occluder.Indices, profile.data(), profile.size(), 1, options.OccluderSliceCount);
+
+				for (const auto& vertex : vertices) occluder.Vertices.push_back(vertex.position);
+
+				auto maxRadius = 0.0f, minY = FLT_MAX, maxY = -FLT_MAX;
+				for (const auto& point : profile) {
+					maxRadius = std::max(maxRadius, point.x);
+					minY = std::min(minY, point.y);
+					maxY = std::max(maxY, point.y);
+				}
+				occluder.Bounds = { { 0, (minY + maxY) / 2, 0 }, { maxRadius, (maxY - minY) / 2, maxRadius } };
+			}
+
+			// Parts are scattered by a fixed hash so that every run sees the same scene.
+			for (uint32_t z = 0; z < options.GridSize; z++) {
+				for (uint32_t x = 0; x < options.GridSize; x++) {
+					auto hash = (x * 73856093u) ^ (z * 19349663u);
+					hash ^= hash >> 13;
+					hash *= 0x5bd1e995u;
+					hash ^= hash >> 15;
+
+					Part part;
+					part.Occluder = hash % static_cast<uint32_t>(m_occluders.size());
+					part.Scale = 0.75f + static_cast<float>(hash >> 8 & 0xff) / 255 * 0.5f;
+
+					const auto offset = (static_cast<float>(options.GridSize) - 1) / 2;
+					part.Position = { (static_cast<float>(x) - offset) * options.Spacing, 0, (static_cast<float>(z) - offset) * options.Spacing };
+
+					const auto& bounds = m_occluders[part.Occluder].Bounds;
+					m_partBounds.push_back({
+						{ part.Position.x + bounds.Center.x * part.Scale, part.Position.y + bounds.Center.y * part.Scale, part.Position.z + bounds.Center.z * part.Scale },
+						{ bounds.Extents.x * part.Scale, bounds.Extents.y * part.Scale, bounds.Extents.z * part.Scale }
+					});
+					m_parts.push_back(part);
+				}
+			}
+
+			m_partVisibility.resize((m_parts.size() + 31) / 32);
+		}
+
+		const Options& GetOptions() const { return m_options; }
+
+		size_t GetPartCount() const { return m_parts.size(); }
+
+		const Rendering::MaskedOcclusionCuller& GetCuller() const { return *m_culler; }
+
+		const std::vector<FrameResult>& GetFrameResults() const { return m_frameResults; }
+
+		// Plays the whole camera path at the frame rate, from the start.
+		void Run() {
+			m_frameResults.clear();
+
+			for (uint64_t frame = 0;; frame++) {
+				const auto time = static_cast<double>(frame) / m_options.FrameRate;
+				if (time >= m_cameraPath.GetDuration()) break;
+
+				RunFrame(time);
+			}
+		}
+
+		void RunFrame(double time) {
+			using namespace DirectX;
+			using Hydr10n::Rendering::OcclusionResult;
+
+			XMVECTOR focus, rotation, position;
+			float radius;
+			m_cameraPath.Evaluate(time, focus, rotation, radius);
+			const auto viewProjection = DX::OrbitCameraState::ComputeView(focus, rotation, radius, false, &position)
+				* XMMatrixPerspectiveFovRH(XM_PI / 4, static_cast<float>(m_options.Width) / static_cast<float>(m_options.Height), 0.1f, 10000);
+
+			DX::CullBoxes(DX::FrustumPlanes::CreateFromMatrix(viewProjection), m_partBounds.data(), m_partBounds.size(), m_partVisibility.data());
+
+			m_visibleParts.clear();
+			for (uint32_t i = 0; i < static_cast<uint32_t>(m_parts.size()); i++) {
+				if (m_partVisibility[i / 32] & (1u << (i % 32))) {
+					m_visibleParts.push_back({ XMVectorGetX(XMVector3LengthSq(XMVectorSubtract(XMLoadFloat3(&m_partBounds[i].Center), position))), i });
+				}
+			}
+			std::sort(m_visibleParts.begin(), m_visibleParts.end(), [](const VisiblePart& a, const VisiblePart& b) { return a.DistanceSquared < b.DistanceSquared; });
+
+			FrameResult result{ static_cast<uint32_t>(m_visibleParts.size()), 0, {}, {} };
+
+			auto start = std::chrono::steady_clock::now();
+
+			m_culler->Clear();
+			for (size_t i = 0; i < std::min<size_t>(m_visibleParts.size(), m_options.MaxOccluderCount); i++) {
+				const auto& part = m_parts[m_visibleParts[i].Index];
+				const auto& occluder = m_occluders[part.Occluder];
+				const auto world = XMMatrixScaling(part.Scale, part.Scale, part.Scale) * XMMatrixTranslation(part.Position.x, part.Position.y, part.Position.z);
+				m_culler->AddOccluder(occluder.Vertices, occluder.Indices, world * viewProjection);
+			}
+			m_culler->Flush();
+
+			auto end = std::chrono::steady_clock::now();
+			result.RasterizeTime = end - start;
+			start = end;
+
+			for (const auto& visiblePart : m_visibleParts) {
+				if (m_culler->TestBox(m_partBounds[visiblePart.Index], viewProjection) != OcclusionResult::Visible) result.OccludedPartCount++;
+			}
+
+			result.TestTime = std::chrono::steady_clock::now() - start;
+
+			m_frameResults.push_back(result);
+		}
+
+		// Occluded parts out of all parts inside the view frustum, over every frame.
+		double GetCulledFraction() const {
+			uint64_t visiblePartCount = 0, occludedPartCount = 0;
+			for (const auto& result : m_frameResults) {
+				visiblePartCount += result.VisiblePartCount;
+				occludedPartCount += result.OccludedPartCount;
+			}
+			return visiblePartCount ? static_cast<double>(occludedPartCount) / static_cast<double>(visiblePartCount) : 0;
+		}
+
+		double GetMeanFrameMilliseconds() const {
+			std::chrono::duration<double, std::milli> total{};
+			for (const auto& result : m_frameResults) total += result.RasterizeTime + result.TestTime;
+			return m_frameResults.empty() ? 0 : total.count() / static_cast<double>(m_frameResults.size());
+		}
+
+		// One CSV row per frame: parts in the frustum, parts occluded, and the occluder and test times in milliseconds.
+		void WriteResults(const std::filesystem::path& path) const {
+			std::ofstream file(path, std::ios::trunc);
+			if (!file) throw std::runtime_error("Failed to create occlusion benchmark results file");
+
+			file << "Frame,VisibleParts,OccludedParts,Rasterize,Test\n";
+			for (size_t i = 0; i < m_frameResults.size(); i++) {
+				const auto& result = m_frameResults[i];
+				file << i << ',' << result.VisiblePartCount << ',' << result.OccludedPartCount << ','
+					<< std::chrono::duration<double, std::milli>(result.RasterizeTime).count() << ','
+					<< std::chrono::duration<double, std::milli>(result.TestTime).count() << '\n';
+			}
+
+			if (!file) throw std::runtime_error("Failed to write occlusion benchmark results file");
+		}
+
+	private:
+		struct Occluder {
+			std::vector<DirectX::XMFLOAT3> Vertices;
+			Hydr10n::Meshes::MeshGenerator::IndexCollection Indices;
+			DirectX::BoundingBox Bounds;
+		};
+
+		struct Part {
+			uint32_t Occluder;
+			float Scale;
+			DirectX::XMFLOAT3 Position;
+		};
+
+		struct VisiblePart {
+			float DistanceSquared;
+			uint32_t Index;
+		};
+
+		DX::CameraPath m_cameraPath;
+
+		Options m_options;
+
+		std::unique_ptr<Hydr10n::Rendering::WorkerPool> m_workerPool;
+		std::unique_ptr<Hydr10n::Rendering::MaskedOcclusionCuller> m_culler;
+
+		std::vector<Occluder> m_occluders;
+		std::vector<Part> m_parts;
+		std::vector<DirectX::BoundingBox> m_partBounds;
+		std::vector<uint32_t> m_partVisibility;
+		std::vector<VisiblePart> m_visibleParts;
+
+		std::vector<FrameResult> m_frameResults;
+	};
+}
@@ -0,0 +1,289 @@
+//
+// PipelineCache.h - Deduplicating pipeline cache persisted to disk between runs
+//
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <atomic>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+
+namespace DX
+{
+    // Incremental 64-bit FNV-1a. Values are hashed by their bytes, so structures with padding must be added field by
+    // field; pointers hash their address, which does not survive the process.
+    class HashBuilder
+    {
+    public:
+        static constexpr uint64_t c_Seed = 0xcbf29ce484222325;
+
+        explicit HashBuilder(uint64_t seed = c_Seed) noexcept : m_hash(seed) {}
+
+        HashBuilder& AddBytes(const void* data, size_t size) noexcept
+        {
+            const auto bytes = static_cast<const uint8_t*>(data);
+            for (size_t i = 0; i < size; i++)
+            {
+                m_hash = (m_hash ^ bytes[i]) * c_Prime;
+            }
+            return *this;
+        }
+
+        template <class T>
+        HashBuilder& Add(const T& value) noexcept
+        {
+            static_assert(std::is_trivially_copyable_v<T>, "only trivially copyable values can be hashed by their bytes");
+            return AddBytes(&value, sizeof(value));
+        }
+
+        // Strings are prefixed with their length so that consecutive ones cannot run into each other; null hashes unlike
+        // the empty string.
+        HashBuilder& AddString(const char* string) noexcept
+        {
+            if (!string)
+            {
+                return Add(UINT64_MAX);
+            }
+
+            const std::string_view view(string);
+            Add(static_cast<uint64_t>(view.size()));
+            return AddBytes(view.data(), view.size());
+        }
+
+        uint64_t GetHash() const noexcept { return m_hash; }
+
+    private:
+        static constexpr uint64_t c_Prime = 0x100000001b3;
+
+        uint64_t m_hash;
+    };
+
+    // A serialized pipeline cache on disk: a header naming the device and driver it was built with, then the blob.
+    // Reading returns nothing, rather than throwing, for a file that is missing, truncated, corrupt or from another
+    // device, so that the caller simply starts with an empty cache.
+    class PipelineCacheFile
+    {
+    public:
+        static std::vector<uint8_t> Read(const std::filesystem::path& path, uint64_t compatibilityKey)
+        {
+            std::ifstream file(path, std::ios::binary);
+            if (!file)
+            {
+                return {};
+            }
+
+            Header header;
+            if (!file.read(reinterpret_cast<char*>(&header), sizeof(header))
+                || std::memcmp(header.magic, c_Magic, sizeof(c_Magic))
+                || header.version != c_Version
+                || header.compatibilityKey != compatibilityKey
+                || header.size > c_MaxSize)
+            {
+                return {};
+            }
+
+            std::vector<uint8_t> data(static_cast<size_t>(header.size));
+            if (!file.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data.size()))
+                || file.peek() != std::ifstream::traits_type::eof()
+                || HashBuilder().AddBytes(data.data(), data.size()).GetHash() != header.checksum)
+            {
+                return {};
+            }
+
+            return data;
+        }
+
+        // The file is written next to path first and then renamed over it, so that an interrupted write never leaves a
+        // truncated cache behind.
+        static void Write(const std::filesystem::path& path, uint64_t compatibilityKey, std::span<const uint8_t> data)
+        {
+            Header header = {};
+            std::memcpy(header.magic, c_Magic, sizeof(c_Magic));
+            header.version = c_Version;
+            header.compatibilityKey = compatibilityKey;
+            header.size = data.size();
+            header.checksum = HashBuilder().AddBytes(data.data(), data.size()).GetHash();
+
+            auto temporaryPath = path;
+            temporaryPath += ".tmp";
+
+            {
+                std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+                if (!file.write(reinterpret_cast<const char*>(&header), sizeof(header))
+                    || !file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()))
+                    || !file.flush())
+                {
+                    throw std::runtime_error("failed to write pipeline cache file");
+                }
+            }
+
+            std::error_code error;
+            std::filesystem::rename(temporaryPath, path, error);
+            if (error)
+            {
+                std::filesystem::remove(temporaryPath, error);
+                throw std::runtime_error("failed to replace pipeline cache file");
+            }
+        }
+
+    private:
+        static constexpr char       c_Magic[8] = { 'P', 'S', 'O', 'C', 'A', 'C', 'H', 'E' };
+        static constexpr uint32_t   c_Version = 1;
+        static constexpr uint64_t   c_MaxSize = 1ull << 31;
+
+        struct Header
+        {
+            char        magic[8];
+            uint32_t    version;
+            uint32_t    reserved;
+            uint64_t    compatibilityKey;
+            uint64_t    size;
+            uint64_t    checksum;
+        };
+    };
+
+    // Hands out one pipeline per hash, asking Library for it only the first time: a pipeline the library already holds
+    // is loaded from it, and any other is created and stored, to be written out by Save. Hashes must cover everything
+    // that makes pipelines differ; the library should still reject a description that does not match what it stored.
+    //
+    // Library provides:
+    //     typename Library::Description    what a pipeline is created from
+    //     typename Library::Pipeline       a shared reference to a pipeline, false when null
+    //     Pipeline Load(uint64_t hash, const Description&)      the stored pipeline, or null if there is none
+    //     Pipeline Create(const Description&)
+    //     void Store(uint64_t hash, const Pipeline&)
+    //     std::vector<uint8_t> Serialize()
+    // and must allow its methods to be called from several threads at once, except for loads of the same hash, which
+    // the cache never makes.
+    //
+    // GetOrCreate is thread-safe; a thread asking for a pipeline that another is creating waits for it.
+    template <class Library>
+    class PipelineCache
+    {
+    public:
+        using Description = typename Library::Description;
+        using Pipeline = typename Library::Pipeline;
+
+        template <class... Args>
+        explicit PipelineCache(Args&&... args) noexcept(false) :
+            m_library(std::forward<Args>(args)...),
+            m_hitCount(0),
+            m_loadCount(0),
+            m_createCount(0),
+            m_isDirty(false)
+        {
+        }
+
+        PipelineCache(PipelineCache const&) = delete;
+        PipelineCache& operator= (PipelineCache const&) = delete;
+
+        Library& GetLibrary() noexcept { return m_library; }
+
+        Pipeline GetOrCreate(uint64_t hash, const Description& description)
+        {
+            std::promise<Pipeline> promise;
+            std::shared_future<Pipeline> future;
+            {
+                std::lock_guard lock(m_mutex);
+
+                const auto [pipeline, isInserted] = m_pipelines.try_emplace(hash);
+                if (isInserted)
+                {
+                    pipeline->second = promise.get_future().share();
+                }
+                else
+                {
+                    future = pipeline->second;
+                }
+            }
+
+            if (future.valid())
+            {
+                m_hitCount++;
+                return future.get();
+            }
+
+            try
+            {
+                Pipeline pipeline = m_library.Load(hash, description);
+                if (pipeline)
+                {
+                    m_loadCount++;
+                }
+                else
+                {
+                    pipeline = m_library.Create(description);
+                    m_library.Store(hash, pipeline);
+                    m_createCount++;
+                    m_isDirty = true;
+                }
+
+                promise.set_value(pipeline);
+                return pipeline;
+            }
+            catch (...)
+            {
+                // Waiting threads see the failure; later requests try again.
+                promise.set_exception(std::current_exception());
+                {
+                    std::lock_guard lock(m_mutex);
+                    m_pipelines.erase(hash);
+                }
+                throw;
+            }
+        }
+
+        // Writes the library to path if pipelines were stored since it was loaded or last saved; returns whether it did.
+        bool Save(const std::filesystem::path& path, uint64_t compatibilityKey)
+        {
+            if (!m_isDirty.exchange(false))
+            {
+                return false;
+            }
+
+            try
+            {
+                const std::vector<uint8_t> data = m_library.Serialize();
+                PipelineCacheFile::Write(path, compatibilityKey, data);
+            }
+            catch (...)
+            {
+                m_isDirty = true;
+                throw;
+            }
+
+            return true;
+        }
+
+        bool IsDirty() const noexcept { return m_isDirty; }
+
+        // Requests answered from memory, pipelines loaded from the library, and pipelines created.
+        uint64_t GetHitCount() const noexcept { return m_hitCount; }
+        uint64_t GetLoadCount() const noexcept { return m_loadCount; }
+        uint64_t GetCreateCount() const noexcept { return m_createCount; }
+
+    private:
+        Library                                                         m_library;
+
+        std::mutex                                                      m_mutex;
+        std::unordered_map<uint64_t, std::shared_future<Pipeline>>      m_pipelines;
+
+        std::atomic<uint64_t>                                           m_hitCount;
+        std::atomic<uint64_t>                                           m_loadCount;
+        std::atomic<uint64_t>                                           m_createCount;
+        std::atomic<bool>                                               m_isDirty;
+    };
+}
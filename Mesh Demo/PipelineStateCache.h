@@ -0,0 +1,360 @@
+//
+// PipelineStateCache.h - Pipeline state objects deduplicated by a hash of their description and kept in a pipeline library
+//
+
+#pragma once
+
+#include "PipelineCache.h"
+
+#include <algorithm>
+#include <string>
+#include <variant>
+
+
+namespace DX
+{
+    // Hashes every subobject of a pipeline state stream by content, following the pointers to shader bytecode, input
+    // elements, stream output declarations and view instance locations. The stream is first normalized into a
+    // CD3DX12_PIPELINE_STATE_STREAM2, so that neither the order of subobjects nor leaving out one that has its default
+    // value changes the hash. A root signature is an object whose address differs between runs, so the caller gives a
+    // key for it instead, such as a hash of its serialized blob; cached pipeline blobs are ignored.
+    class PipelineStateHasher : private ID3DX12PipelineParserCallbacks
+    {
+    public:
+        static uint64_t Hash(const D3D12_PIPELINE_STATE_STREAM_DESC& desc, uint64_t rootSignatureKey)
+        {
+            CD3DX12_PIPELINE_STATE_STREAM2_PARSE_HELPER normalizer;
+            if (FAILED(D3DX12ParsePipelineStream(desc, &normalizer)))
+            {
+                throw std::invalid_argument("invalid pipeline state stream");
+            }
+
+            return HashNormalized(normalizer.PipelineStream, rootSignatureKey);
+        }
+
+        static uint64_t Hash(const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc, uint64_t rootSignatureKey)
+        {
+            return HashNormalized(CD3DX12_PIPELINE_STATE_STREAM2(desc), rootSignatureKey);
+        }
+
+        static uint64_t Hash(const D3D12_COMPUTE_PIPELINE_STATE_DESC& desc, uint64_t rootSignatureKey)
+        {
+            return HashNormalized(CD3DX12_PIPELINE_STATE_STREAM2(desc), rootSignatureKey);
+        }
+
+    private:
+        static uint64_t HashNormalized(CD3DX12_PIPELINE_STATE_STREAM2 stream, uint64_t rootSignatureKey)
+        {
+            PipelineStateHasher hasher;
+            hasher.m_hash.Add(rootSignatureKey);
+
+            const D3D12_PIPELINE_STATE_STREAM_DESC streamDesc = { sizeof(stream), &stream };
+            ThrowIfFailed(D3DX12ParsePipelineStream(streamDesc, &hasher));
+
+            return hasher.m_hash.GetHash();
+        }
+
+        void AddType(D3D12_PIPELINE_STATE_SUBOBJECT_TYPE type) { m_hash.Add(type); }
+
+        void AddShader(D3D12_PIPELINE_STATE_SUBOBJECT_TYPE type, const D3D12_SHADER_BYTECODE& shader)
+        {
+            AddType(type);
+            m_hash.Add(static_cast<uint64_t>(shader.pShaderBytecode ? shader.BytecodeLength : 0));
+            if (shader.pShaderBytecode)
+            {
+                m_hash.AddBytes(shader.pShaderBytecode, shader.BytecodeLength);
+            }
+        }
+
+        void AddStencilOp(const D3D12_DEPTH_STENCILOP_DESC& op)
+        {
+            m_hash.Add(op.StencilFailOp).Add(op.StencilDepthFailOp).Add(op.StencilPassOp).Add(op.StencilFunc);
+        }
+
+        // The fields of D3D12_DEPTH_STENCIL_DESC; the stencil masks leave padding behind them.
+        template <class Desc>
+        void AddDepthStencil(const Desc& desc)
+        {
+            m_hash.Add(desc.DepthEnable).Add(desc.DepthWriteMask).Add(desc.DepthFunc).Add(desc.StencilEnable)
+                .Add(desc.StencilReadMask).Add(desc.StencilWriteMask);
+            AddStencilOp(desc.FrontFace);
+            AddStencilOp(desc.BackFace);
+        }
+
+        void FlagsCb(D3D12_PIPELINE_STATE_FLAGS flags) override { AddType(D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_FLAGS); m_hash.Add(flags); }
+        void NodeMaskCb(UINT nodeMask) override { AddType(D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_NODE_MASK); m_hash.Add(nodeMask); }
+
+        void InputLayoutCb(const D3D12_INPUT_LAYOUT_DESC& inputLayout) override
+        {
+            AddType(D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_INPUT_LAYOUT);
+            m_hash.Add(inputLayout.NumElements);
+            for (UINT i = 0; i < inputLayout.NumElements; i++)
+            {
+                const D3D12_INPUT_ELEMENT_DESC& element = inputLayout.pInputElementDescs[i];
+                m_hash.AddString(element.SemanticName);
+                m_hash.Add(element.SemanticIndex).Add(element.Format).Add(element.InputSlot).Add(element.AlignedByteOffset)
+                    .Add(element.InputSlotClass).Add(element.InstanceDataStepRate);
+            }
+        }
+
+        void IBStripCutValueCb(D3D12_INDEX_BUFFER_STRIP_CUT_VALUE value) override { AddType(D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_IB_STRIP_CUT_VALUE); m_hash.Add(value); }
+        void PrimitiveTopologyTypeCb(D3D12_PRIMITIVE_TOPOLOGY_TYPE type) override { AddType(D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_PRIMITIVE_TOPOLOGY); m_hash.Add(type); }
+
+        void VSCb(const D3D12_SHADER_BYTECODE& shader) override { AddShader(D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_VS, shader); }
+        void GSCb(const D3D12_SHADER_BYTECODE& shader) override { AddShader(D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_GS, shader); }
+        void HSCb(const D3D12_SHADER_BYTECODE& shader) override { AddShader(D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_HS, shader); }
+        void DSCb(const D3D12_SHADER_BYTECODE& shader) override { AddShader(D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_DS, shader); }
+        void PSCb(const D3D12_SHADER_BYTECODE& shader) override { AddShader(D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_PS, shader); }
+        void CSCb(const D3D12_SHADER_BYTECODE& shader) override { AddShader(D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_CS, shader); }
+        void ASCb(const D3D12_SHADER_BYTECODE& shader) override { AddShader(D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_AS, shader); }
+        void MSCb(const D3D12_SHADER_BYTECODE& shader) override { AddShader(D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_MS, shader); }
+
+        void StreamOutputCb(const D3D12_STREAM_OUTPUT_DESC& streamOutput) override
+        {
+            AddType(D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_STREAM_OUTPUT);
+            m_hash.Add(streamOutput.NumEntries);
+            for (UINT i = 0; i < streamOutput.NumEntries; i++)
+            {
+                const D3D12_SO_DECLARATION_ENTRY& entry = streamOutput.pSODeclaration[i];
+                m_hash.Add(entry.Stream);
+                m_hash.AddString(entry.SemanticName);
+                m_hash.Add(entry.SemanticIndex).Add(entry.StartComponent).Add(entry.ComponentCount).Add(entry.OutputSlot);
+            }
+
+            m_hash.Add(streamOutput.NumStrides);
+            if (streamOutput.NumStrides)
+            {
+                m_hash.AddBytes(streamOutput.pBufferStrides, streamOutput.NumStrides * sizeof(UINT));
+            }
+            m_hash.Add(streamOutput.RasterizedStream);
+        }
+
+        void BlendStateCb(const D3D12_BLEND_DESC& blendState) override
+        {
+            AddType(D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_BLEND);
+            m_hash.Add(blendState.AlphaToCoverageEnable).Add(blendState.IndependentBlendEnable);
+            for (const D3D12_RENDER_TARGET_BLEND_DESC& target : blendState.RenderTarget)
+            {
+                m_hash.Add(target.BlendEnable).Add(target.LogicOpEnable).Add(target.SrcBlend).Add(target.DestBlend).Add(target.BlendOp)
+                    .Add(target.SrcBlendAlpha).Add(target.DestBlendAlpha).Add(target.BlendOpAlpha).Add(target.LogicOp)
+                    .Add(target.RenderTargetWriteMask);
+            }
+        }
+
+        void DepthStencilStateCb(const D3D12_DEPTH_STENCIL_DESC& depthStencilState) override
+        {
+            AddType(D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_DEPTH_STENCIL);
+            AddDepthStencil(depthStencilState);
+        }
+
+        void DepthStencilState1Cb(const D3D12_DEPTH_STENCIL_DESC1& depthStencilState) override
+        {
+            AddType(D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_DEPTH_STENCIL1);
+            AddDepthStencil(depthStencilState);
+            m_hash.Add(depthStencilState.DepthBoundsTestEnable);
+        }
+
+        void DSVFormatCb(DXGI_FORMAT format) override { AddType(D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_DEPTH_STENCIL_FORMAT); m_hash.Add(format); }
+
+        // Every field is four bytes wide, so there is no padding.
+        void RasterizerStateCb(const D3D12_RASTERIZER_DESC& rasterizerState) override
+        {
+            AddType(D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_RASTERIZER);
+            m_hash.Add(rasterizerState);
+        }
+
+        // Formats past the render target count are not used.
+        void RTVFormatsCb(const D3D12_RT_FORMAT_ARRAY& formats) override
+        {
+            AddType(D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_RENDER_TARGET_FORMATS);
+            const UINT count = std::min<UINT>(formats.NumRenderTargets, D3D12_SIMULTANEOUS_RENDER_TARGET_COUNT);
+            m_hash.Add(count);
+            m_hash.AddBytes(formats.RTFormats, count * sizeof(DXGI_FORMAT));
+        }
+
+        void SampleDescCb(const DXGI_SAMPLE_DESC& sampleDesc) override { AddType(D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_SAMPLE_DESC); m_hash.Add(sampleDesc); }
+        void SampleMaskCb(UINT sampleMask) override { AddType(D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_SAMPLE_MASK); m_hash.Add(sampleMask); }
+
+        void ViewInstancingCb(const D3D12_VIEW_INSTANCING_DESC& viewInstancing) override
+        {
+            AddType(D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_VIEW_INSTANCING);
+            m_hash.Add(viewInstancing.ViewInstanceCount);
+            for (UINT i = 0; i < viewInstancing.ViewInstanceCount; i++)
+            {
+                m_hash.Add(viewInstancing.pViewInstanceLocations[i]);
+            }
+            m_hash.Add(viewInstancing.Flags);
+        }
+
+        HashBuilder m_hash;
+    };
+
+    // Backs PipelineCache with an ID3D12PipelineLibrary, naming pipelines by their hash. Without one, because the device
+    // predates ID3D12Device1 or a tool attached to it does not support libraries, pipelines are only created.
+    class D3D12PipelineLibrary
+    {
+    public:
+        using Description = std::variant<D3D12_GRAPHICS_PIPELINE_STATE_DESC, D3D12_COMPUTE_PIPELINE_STATE_DESC>;
+        using Pipeline = Microsoft::WRL::ComPtr<ID3D12PipelineState>;
+
+        // data is a library serialized earlier; one from another driver or adapter, or a corrupt one, is discarded.
+        D3D12PipelineLibrary(ID3D12Device* device, std::vector<uint8_t> data) noexcept(false) :
+            m_device(device),
+            m_data(std::move(data))
+        {
+            Microsoft::WRL::ComPtr<ID3D12Device1> device1;
+            if (FAILED(m_device.As(&device1)))
+            {
+                return;
+            }
+
+            HRESULT hr = E_FAIL;
+            if (!m_data.empty())
+            {
+                // The library reads from the blob for as long as it lives, so m_data is kept.
+                hr = device1->CreatePipelineLibrary(m_data.data(), m_data.size(), IID_PPV_ARGS(m_library.ReleaseAndGetAddressOf()));
+                if (FAILED(hr))
+                {
+#ifdef _DEBUG
+                    OutputDebugStringA("INFO: Pipeline library is out of date or corrupt and will be rebuilt\n");
+#endif
+                    m_data.clear();
+                }
+            }
+
+            if (FAILED(hr))
+            {
+                hr = device1->CreatePipelineLibrary(nullptr, 0, IID_PPV_ARGS(m_library.ReleaseAndGetAddressOf()));
+                if (hr == DXGI_ERROR_UNSUPPORTED)
+                {
+                    m_library.Reset();
+                    return;
+                }
+                ThrowIfFailed(hr);
+            }
+
+            m_library->SetName(L"D3D12PipelineLibrary");
+        }
+
+        D3D12PipelineLibrary(D3D12PipelineLibrary const&) = delete;
+        D3D12PipelineLibrary& operator= (D3D12PipelineLibrary const&) = delete;
+
+        ID3D12PipelineLibrary* GetLibrary() const noexcept { return m_library.Get(); }
+
+        Pipeline Load(uint64_t hash, const Description& description)
+        {
+            Pipeline pipeline;
+            if (!m_library)
+            {
+                return pipeline;
+            }
+
+            const auto name = GetName(hash);
+
+            // E_INVALIDARG means there is no such pipeline, or it was stored with another description.
+            const HRESULT hr = std::holds_alternative<D3D12_GRAPHICS_PIPELINE_STATE_DESC>(description) ?
+                m_library->LoadGraphicsPipeline(name.c_str(), &std::get<D3D12_GRAPHICS_PIPELINE_STATE_DESC>(description), IID_PPV_ARGS(pipeline.GetAddressOf())) :
+                m_library->LoadComputePipeline(name.c_str(), &std::get<D3D12_COMPUTE_PIPELINE_STATE_DESC>(description), IID_PPV_ARGS(pipeline.GetAddressOf()));
+            if (hr == E_INVALIDARG)
+            {
+                return nullptr;
+            }
+            ThrowIfFailed(hr);
+
+            return pipeline;
+        }
+
+        Pipeline Create(const Description& description)
+        {
+            Pipeline pipeline;
+            if (std::holds_alternative<D3D12_GRAPHICS_PIPELINE_STATE_DESC>(description))
+            {
+                ThrowIfFailed(m_device->CreateGraphicsPipelineState(&std::get<D3D12_GRAPHICS_PIPELINE_STATE_DESC>(description), IID_PPV_ARGS(pipeline.GetAddressOf())));
+            }
+            else
+            {
+                ThrowIfFailed(m_device->CreateComputePipelineState(&std::get<D3D12_COMPUTE_PIPELINE_STATE_DESC>(description), IID_PPV_ARGS(pipeline.GetAddressOf())));
+            }
+            return pipeline;
+        }
+
+        // A pipeline already stored under the name, with a description that no longer matches, is left in place.
+        void Store(uint64_t hash, const Pipeline& pipeline)
+        {
+            if (!m_library)
+            {
+                return;
+            }
+
+            const HRESULT hr = m_library->StorePipeline(GetName(hash).c_str(), pipeline.Get());
+            if (hr != E_INVALIDARG)
+            {
+                ThrowIfFailed(hr);
+            }
+        }
+
+        std::vector<uint8_t> Serialize()
+        {
+            std::vector<uint8_t> data;
+            if (m_library)
+            {
+                data.resize(m_library->GetSerializedSize());
+                ThrowIfFailed(m_library->Serialize(data.data(), data.size()));
+            }
+            return data;
+        }
+
+    private:
+        static std::wstring GetName(uint64_t hash)
+        {
+            wchar_t name[17] = {};
+            swprintf_s(name, L"%016llx", static_cast<unsigned long long>(hash));
+            return name;
+        }
+
+        Microsoft::WRL::ComPtr<ID3D12Device>            m_device;
+        Microsoft::WRL::ComPtr<ID3D12PipelineLibrary>   m_library;
+        std::vector<uint8_t>                            m_data;
+    };
+
+    // Pipeline state objects of one device, hashed with PipelineStateHasher so that identical requests share one object,
+    // and persisted at path, if given, between runs. compatibilityKey identifies the adapter and driver; a cache file
+    // written with another key is ignored. Thread-safe.
+    class PipelineStateCache
+    {
+    public:
+        PipelineStateCache(ID3D12Device* device, std::filesystem::path path, uint64_t compatibilityKey) noexcept(false) :
+            m_path(std::move(path)),
+            m_compatibilityKey(compatibilityKey),
+            m_cache(device, m_path.empty() ? std::vector<uint8_t>() : PipelineCacheFile::Read(m_path, compatibilityKey))
+        {
+        }
+
+        PipelineStateCache(PipelineStateCache const&) = delete;
+        PipelineStateCache& operator= (PipelineStateCache const&) = delete;
+
+        Microsoft::WRL::ComPtr<ID3D12PipelineState> GetOrCreate(const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc, uint64_t rootSignatureKey)
+        {
+            return m_cache.GetOrCreate(PipelineStateHasher::Hash(desc, rootSignatureKey), desc);
+        }
+
+        Microsoft::WRL::ComPtr<ID3D12PipelineState> GetOrCreate(const D3D12_COMPUTE_PIPELINE_STATE_DESC& desc, uint64_t rootSignatureKey)
+        {
+            return m_cache.GetOrCreate(PipelineStateHasher::Hash(desc, rootSignatureKey), desc);
+        }
+
+        // Writes the pipelines created since the cache was loaded or last saved; returns whether it did.
+        bool Save()
+        {
+            return !m_path.empty() && m_cache.Save(m_path, m_compatibilityKey);
+        }
+
+        const std::filesystem::path& GetPath() const noexcept { return m_path; }
+        PipelineCache<D3D12PipelineLibrary>& GetCache() noexcept { return m_cache; }
+
+    private:
+        const std::filesystem::path             m_path;
+        const uint64_t                          m_compatibilityKey;
+        PipelineCache<D3D12PipelineLibrary>     m_cache;
+    };
+}
@@ -0,0 +1,203 @@
+/*
+ * Header File: RecordingBackend.h
+ * Last Update: 2026/10/18
+ *
+ * Copyright (C) Hydr10n@GitHub. All Rights Reserved.
+ */
+
+#pragma once
+
+#include "RenderBackend.h"
+
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace Hydr10n::Rendering {
+	namespace RecordedCommands {
+		struct Clear { DirectX::XMFLOAT4 Color; float Depth; };
+		struct SetViewport { Rendering::Viewport Viewport; Rendering::ScissorRect ScissorRect; };
+		struct SetVertexBuffer { BufferHandle Buffer; uint32_t Stride; };
+		struct SetIndexBuffer { BufferHandle Buffer; };
+		struct SetPrimitiveTopology { PrimitiveTopology Topology; };
+		struct SetEffect { EffectConstants Constants; };
+		struct DrawIndexed { uint32_t IndexCount, StartIndex; };
+	}
+
+	using RecordedCommand = std::variant<
+		RecordedCommands::Clear, RecordedCommands::SetViewport,
+		RecordedCommands::SetVertexBuffer, RecordedCommands::SetIndexBuffer, RecordedCommands::SetPrimitiveTopology,
+		RecordedCommands::SetEffect, RecordedCommands::DrawIndexed
+	>;
+
+	class RecordingCommandList : public ICommandList {
+	public:
+		void Reset() {
+			m_commands.clear();
+			m_drawCount = m_indexCount = 0;
+		}
+
+		const std::vector<RecordedCommand>& GetCommands() const { return m_commands; }
+
+		uint32_t GetDrawCount() const { return m_drawCount; }
+
+		uint64_t GetIndexCount() const { return m_indexCount; }
+
+		void Clear(const DirectX::XMFLOAT4& color, float depth) override { m_commands.emplace_back(RecordedCommands::Clear{ color, depth }); }
+
+		void SetViewport(const Viewport& viewport, const ScissorRect& scissorRect) override { m_commands.emplace_back(RecordedCommands::SetViewport{ viewport, scissorRect }); }
+
+		void SetVertexBuffer(BufferHandle buffer, uint32_t stride) override { m_commands.emplace_back(RecordedCommands::SetVertexBuffer{ buffer, stride }); }
+
+		void SetIndexBuffer(BufferHandle buffer) override { m_commands.emplace_back(RecordedCommands::SetIndexBuffer{ buffer }); }
+
+		void SetPrimitiveTopology(PrimitiveTopology topology) override { m_commands.emplace_back(RecordedCommands::SetPrimitiveTopology{ topology }); }
+
+		void SetEffect(const EffectConstants& constants) override { m_commands.emplace_back(RecordedCommands::SetEffect{ constants }); }
+
+		void DrawIndexed(uint32_t indexCount, uint32_t startIndex) override {
+			m_commands.emplace_back(RecordedCommands::DrawIndexed{ indexCount, startIndex });
+
+			m_drawCount++;
+			m_indexCount += indexCount;
+		}
+
+	private:
+		std::vector<RecordedCommand> m_commands;
+
+		uint32_t m_drawCount{};
+		uint64_t m_indexCount{};
+	};
+
+	/*
+	 * Simulates a GPU on the CPU: a submitted command list executes, by calling the executor if one is set, when the first
+	 * fence value signaled after it completes. With a latency of n, a fence value completes once n more values have been
+	 * signaled, as if the GPU were n frames behind; waiting for a value that has not completed completes it at once
+	 * and counts as a stall.
+	 */
+	class RecordingCommandQueue : public ICommandQueue {
+	public:
+		using Executor = std::function<void(const RecordingCommandList&)>;
+
+		void SetExecutor(Executor executor) { m_executor = std::move(executor); }
+
+		void SetLatency(uint32_t latency) { m_latency = latency; }
+
+		uint64_t GetStallCount() const { return m_stallCount; }
+
+		// commandList must stay unchanged until the fence value it is submitted before completes.
+		void Submit(const RecordingCommandList& commandList) { m_submissions.push_back({ m_signaledValue + 1, &commandList }); }
+
+		uint64_t Signal() override {
+			++m_signaledValue;
+
+			if (m_signaledValue > m_latency) Complete(m_signaledValue - m_latency);
+
+			return m_signaledValue;
+		}
+
+		uint64_t GetCompletedValue() const override { return m_completedValue; }
+
+		void WaitForValue(uint64_t fenceValue) override {
+			if (fenceValue > m_signaledValue) throw std::invalid_argument("Fence value has not been signaled");
+
+			if (fenceValue <= m_completedValue) return;
+
+			m_stallCount++;
+
+			Complete(fenceValue);
+		}
+
+	private:
+		struct Submission { uint64_t FenceValue; const RecordingCommandList* CommandList; };
+
+		Executor m_executor;
+
+		uint32_t m_latency{};
+
+		uint64_t m_signaledValue{}, m_completedValue{}, m_stallCount{};
+
+		std::deque<Submission> m_submissions;
+
+		void Complete(uint64_t fenceValue) {
+			if (fenceValue <= m_completedValue) return;
+
+			while (!m_submissions.empty() && m_submissions.front().FenceValue <= fenceValue) {
+				const auto commandList = m_submissions.front().CommandList;
+				m_submissions.pop_front();
+
+				if (m_executor) m_executor(*commandList);
+			}
+
+			m_completedValue = fenceValue;
+		}
+	};
+
+	// A device without a GPU or a window: commands are recorded per frame, buffers are kept as bytes, and fences are simulated by RecordingCommandQueue.
+	class RecordingDevice : public IDevice {
+	public:
+		struct Buffer { BufferType Type; std::vector<std::byte> Data; };
+
+		explicit RecordingDevice(const OutputSize& outputSize, uint32_t backBufferCount = 2) noexcept(false) :
+			m_outputSize(outputSize), m_frames(backBufferCount) {
+			if (!backBufferCount) throw std::invalid_argument("Back buffer count must be positive");
+		}
+
+		BufferHandle CreateBuffer(BufferType type, const void* data, size_t size) override {
+			auto& buffer = m_buffers.emplace_back(Buffer{ type, std::vector<std::byte>(size) });
+			if (size) std::memcpy(buffer.Data.data(), data, size);
+			return static_cast<BufferHandle>(m_buffers.size() - 1);
+		}
+
+		const Buffer& GetBuffer(BufferHandle buffer) const { return m_buffers.at(buffer); }
+
+		RecordingCommandQueue& GetCommandQueue() override { return m_commandQueue; }
+
+		OutputSize GetOutputSize() const override { return m_outputSize; }
+
+		void SetOutputSize(const OutputSize& outputSize) { m_outputSize = outputSize; }
+
+		ICommandList& BeginFrame() override {
+			auto& frame = m_frames[m_frameIndex];
+			m_commandQueue.WaitForValue(frame.FenceValue);
+
+			frame.CommandList.Reset();
+			return frame.CommandList;
+		}
+
+		void Present() override {
+			auto& frame = m_frames[m_frameIndex];
+			m_commandQueue.Submit(frame.CommandList);
+			frame.FenceValue = m_commandQueue.Signal();
+
+			m_lastCommandList = &frame.CommandList;
+
+			m_frameIndex = (m_frameIndex + 1) % static_cast<uint32_t>(m_frames.size());
+			m_presentCount++;
+		}
+
+		uint64_t GetPresentCount() const { return m_presentCount; }
+
+		// The command list of the last presented frame, valid until its back buffer begins another frame.
+		const RecordingCommandList* GetLastCommandList() const { return m_lastCommandList; }
+
+	private:
+		struct Frame { RecordingCommandList CommandList; uint64_t FenceValue{}; };
+
+		OutputSize m_outputSize;
+
+		std::vector<Buffer> m_buffers;
+
+		RecordingCommandQueue m_commandQueue;
+
+		std::vector<Frame> m_frames;
+		uint32_t m_frameIndex{};
+
+		uint64_t m_presentCount{};
+		const RecordingCommandList* m_lastCommandList{};
+	};
+}
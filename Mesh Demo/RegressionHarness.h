@@ -0,0 +1,382 @@
+/*
+ * Header File: RegressionHarness.h
+ * Last Update: 2026/10/18
+ *
+ * Copyright (C) Hydr10n@GitHub. All Rights Reserved.
+ */
+
+#pragma once
+
+#include "HeadlessApp.h"
+#include "SoftwareBackend.h"
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cstdlib>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <string>
+
+namespace Hydr10n::Benchmarks {
+	// 8-bit RGB pixels, row by row with no padding.
+	struct Image {
+		uint32_t Width{}, Height{};
+		std::vector<uint8_t> Pixels;
+
+		static Image Capture(const Rendering::SoftwareRasterizer& rasterizer) {
+			Image image{ rasterizer.GetWidth(), rasterizer.GetHeight(), {} };
+			image.Pixels.resize(static_cast<size_t>(image.Width) * image.Height * 3);
+
+			for (uint32_t y = 0; y < image.Height; y++) {
+				for (uint32_t x = 0; x < image.Width; x++) {
+					const auto pixel = rasterizer.GetPixel(x, y);
+					for (uint32_t i = 0; i < 3; i++) image.Pixels[(static_cast<size_t>(y) * image.Width + x) * 3 + i] = static_cast<uint8_t>((pixel >> (i * 8)) & 0xff);
+				}
+			}
+
+			return image;
+		}
+
+		// Binary PPM (P6) with a maximum value of 255, as written by WritePPM and SoftwareRasterizer::WritePPM.
+		static Image ReadPPM(const std::filesystem::path& path) {
+			std::ifstream file(path, std::ios::binary);
+			if (!file) throw std::runtime_error("Failed to open PPM file");
+
+			const auto ReadToken = [&] {
+				std::string token;
+				for (int c; (c = file.get()) != EOF;) {
+					if (c == '#' && token.empty()) file.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+					else if (std::isspace(c)) {
+						if (!token.empty()) break;
+					}
+					else token += static_cast<char>(c);
+				}
+				return token;
+			};
+
+			const auto ReadNumber = [&] {
+				const auto token = ReadToken();
+				uint32_t value{};
+				const auto [end, error] = std::from_chars(token.data(), token.data() + token.size(), value);
+				if (error != std::errc() || end != token.data() + token.size()) throw std::runtime_error("Invalid PPM file");
+				return value;
+			};
+
+			if (ReadToken() != "P6") throw std::runtime_error("Invalid PPM file");
+
+			Image image;
+			image.Width = ReadNumber();
+			image.Height = ReadNumber();
+			if (ReadNumber() != 255) throw std::runtime_error("Unsupported PPM file");
+
+			image.Pixels.resize(static_cast<size_t>(image.Width) * image.Height * 3);
+			file.read(reinterpret_cast<char*>(image.Pixels.data()), static_cast<std::streamsize>(image.Pixels.size()));
+			if (!file) throw std::runtime_error("Failed to read PPM file");
+
+			return image;
+		}
+
+		void WritePPM(const std::filesystem::path& path) const {
+			std::ofstream file(path, std::ios::binary | std::ios::trunc);
+			if (!file) throw std::runtime_error("Failed to create PPM file");
+
+			file << "P6\n" << Width << ' ' << Height << "\n255\n";
+			file.write(reinterpret_cast<const char*>(Pixels.data()), static_cast<std::streamsize>(Pixels.size()));
+
+			if (!file) throw std::runtime_error("Failed to write PPM file");
+		}
+
+		const uint8_t* GetPixel(uint32_t x, uint32_t y) const { return &Pixels[(static_cast<size_t>(y) * Width + x) * 3]; }
+	};
+
+	struct ImageDiffOptions {
+		// Largest difference in any channel for pixels to count as equal.
+		uint8_t ChannelTolerance = 8;
+
+		// A mismatching pixel is let through if each image has an equal pixel within one pixel of it in the other, as happens when an edge moves by a pixel.
+		bool IsEdgeShiftTolerated = true;
+
+		// Fraction of all pixels allowed to mismatch before the images count as different.
+		double MaxMismatchFraction = 0.001;
+	};
+
+	struct ImageDiff {
+		uint64_t MismatchCount, EdgeShiftCount;
+		uint8_t MaxChannelDifference;
+		bool AreSizesEqual, IsEqual;
+
+		// The golden image darkened, with mismatches in red and tolerated edge shifts in yellow.
+		Image Visualization;
+	};
+
+	inline ImageDiff CompareImages(const Image& image, const Image& golden, const ImageDiffOptions& options) {
+		ImageDiff diff{};
+
+		if (image.Width != golden.Width || image.Height != golden.Height) return diff;
+
+		diff.AreSizesEqual = true;
+		diff.Visualization = golden;
+
+		const auto ChannelDifference = [](const uint8_t* a, const uint8_t* b) {
+			uint8_t difference = 0;
+			for (uint32_t i = 0; i < 3; i++) difference = std::max(difference, static_cast<uint8_t>(std::abs(a[i] - b[i])));
+			return difference;
+		};
+
+		const auto HasEqualNeighbor = [&](const Image& neighbors, uint32_t x, uint32_t y, const uint8_t* pixel) {
+			for (auto neighborY = y ? y - 1 : y; neighborY <= std::min(y + 1, neighbors.Height - 1); neighborY++) {
+				for (auto neighborX = x ? x - 1 : x; neighborX <= std::min(x + 1, neighbors.Width - 1); neighborX++) {
+					if (ChannelDifference(neighbors.GetPixel(neighborX, neighborY), pixel) <= options.ChannelTolerance) return true;
+				}
+			}
+			return false;
+		};
+
+		for (uint32_t y = 0; y < image.Height; y++) {
+			for (uint32_t x = 0; x < image.Width; x++) {
+				const auto pixel = image.GetPixel(x, y), goldenPixel = golden.GetPixel(x, y);
+				const auto difference = ChannelDifference(pixel, goldenPixel);
+
+				auto visualization = &diff.Visualization.Pixels[(static_cast<size_t>(y) * image.Width + x) * 3];
+				for (uint32_t i = 0; i < 3; i++) visualization[i] /= 4;
+
+				if (difference <= options.ChannelTolerance) continue;
+
+				diff.MaxChannelDifference = std::max(diff.MaxChannelDifference, difference);
+
+				if (options.IsEdgeShiftTolerated && HasEqualNeighbor(golden, x, y, pixel) && HasEqualNeighbor(image, x, y, goldenPixel)) {
+					diff.EdgeShiftCount++;
+					visualization[0] = visualization[1] = 255;
+				}
+				else {
+					diff.MismatchCount++;
+					visualization[0] = 255;
+					visualization[1] = visualization[2] = 0;
+				}
+			}
+		}
+
+		diff.IsEqual = static_cast<double>(diff.MismatchCount) <= options.MaxMismatchFraction * static_cast<double>(image.Pixels.size() / 3);
+
+		return diff;
+	}
+
+	/*
+	 * Runs HeadlessApp on a SoftwareDevice, compares the frames it captures with golden images, and the median CPU time of
+	 * every stage with a stored baseline. Setup covers building the scene, most of which is MeshGenerator.
+	 *
+	 * Goldens are named frame<index>.ppm in GoldenDirectory; the baseline is a CSV file of stage names and milliseconds.
+	 * Captured frames, diff visualizations of failed comparisons and the measured timings are written to OutputDirectory.
+	 * With IsUpdatingReferences set, goldens and the baseline are overwritten with the results instead of compared.
+	 */
+	class RegressionHarness {
+	public:
+		struct Options {
+			Rendering::OutputSize OutputSize{ 320, 240 };
+
+			// Threads for the software rasterizer; images do not depend on it.
+			uint32_t RasterizerThreadCount = 1;
+
+			HeadlessApp::Options App;
+
+			// Frames to render; 0 to play the whole camera path.
+			uint64_t FrameCount = 0;
+
+			std::vector<uint64_t> CaptureFrames;
+
+			std::filesystem::path GoldenDirectory, BaselinePath, OutputDirectory;
+
+			ImageDiffOptions ImageDiff;
+
+			// A stage regresses once its median time exceeds the baseline by this fraction and by MinTimingRegressionMilliseconds.
+			double TimingRegressionThreshold = 0.2, MinTimingRegressionMilliseconds = 0.05;
+
+			bool IsUpdatingReferences = false;
+		};
+
+		struct StageTiming {
+			std::string Stage;
+			double Milliseconds, BaselineMilliseconds;
+			bool IsRegressed;
+		};
+
+		struct FrameComparison {
+			uint64_t Frame;
+			bool IsGoldenMissing;
+			ImageDiff Diff;
+		};
+
+		struct Result {
+			std::vector<FrameComparison> FrameComparisons;
+			std::vector<StageTiming> StageTimings;
+
+			// One line per failed check.
+			std::vector<std::string> Failures;
+
+			bool IsPassed() const { return Failures.empty(); }
+		};
+
+		static constexpr const char* SetupStageName = "Setup";
+
+		explicit RegressionHarness(DX::CameraPath cameraPath) noexcept(false) : RegressionHarness(std::move(cameraPath), Options()) {}
+
+		RegressionHarness(DX::CameraPath cameraPath, const Options& options) noexcept(false) : m_cameraPath(std::move(cameraPath)), m_options(options) {
+			if (!options.OutputSize.Width || !options.OutputSize.Height) throw std::invalid_argument("Output size must not be zero");
+		}
+
+		const Options& GetOptions() const { return m_options; }
+
+		Result Run() const {
+			if (!m_options.OutputDirectory.empty()) std::filesystem::create_directories(m_options.OutputDirectory);
+			if (m_options.IsUpdatingReferences && !m_options.GoldenDirectory.empty()) std::filesystem::create_directories(m_options.GoldenDirectory);
+
+			Result result;
+
+			Rendering::SoftwareDevice device(m_options.OutputSize, m_options.RasterizerThreadCount);
+
+			const auto setupStart = BenchmarkRun::Clock::now();
+			HeadlessApp app(device, m_cameraPath, m_options.App);
+			const auto setupTime = BenchmarkRun::Clock::now() - setupStart;
+
+			const auto& frameTimings = app.GetBenchmarkRun().GetFrameTimings();
+			while (m_options.FrameCount ? frameTimings.size() < m_options.FrameCount : !app.IsFinished()) {
+				const auto frameCount = frameTimings.size();
+
+				app.Tick();
+
+				if (frameTimings.size() == frameCount) continue;
+
+				const uint64_t frame = frameCount;
+				if (std::find(m_options.CaptureFrames.cbegin(), m_options.CaptureFrames.cend(), frame) != m_options.CaptureFrames.cend()) {
+					result.FrameComparisons.push_back(CompareFrame(frame, Image::Capture(device.GetRasterizer()), result.Failures));
+				}
+			}
+
+			for (const auto frame : m_options.CaptureFrames) {
+				if (frame >= frameTimings.size()) result.Failures.push_back("Frame " + std::to_string(frame) + " was not rendered");
+			}
+
+			CompareTimings(setupTime, frameTimings, result);
+
+			return result;
+		}
+
+	private:
+		DX::CameraPath m_cameraPath;
+
+		Options m_options;
+
+		static std::string GetFrameFileName(uint64_t frame, const char* suffix = "") { return "frame" + std::to_string(frame) + suffix + ".ppm"; }
+
+		FrameComparison CompareFrame(uint64_t frame, const Image& image, std::vector<std::string>& failures) const {
+			FrameComparison comparison{ frame, false, {} };
+
+			if (!m_options.OutputDirectory.empty()) image.WritePPM(m_options.OutputDirectory / GetFrameFileName(frame));
+
+			const auto goldenPath = m_options.GoldenDirectory / GetFrameFileName(frame);
+
+			if (m_options.IsUpdatingReferences) {
+				image.WritePPM(goldenPath);
+				return comparison;
+			}
+
+			if (!std::filesystem::exists(goldenPath)) {
+				comparison.IsGoldenMissing = true;
+				failures.push_back("Frame " + std::to_string(frame) + " has no golden image");
+				return comparison;
+			}
+
+			comparison.Diff = CompareImages(image, Image::ReadPPM(goldenPath), m_options.ImageDiff);
+
+			if (!comparison.Diff.AreSizesEqual) failures.push_back("Frame " + std::to_string(frame) + " differs in size from its golden image");
+			else if (!comparison.Diff.IsEqual) {
+				failures.push_back("Frame " + std::to_string(frame) + " differs from its golden image in " + std::to_string(comparison.Diff.MismatchCount) + " pixels");
+
+				if (!m_options.OutputDirectory.empty()) comparison.Diff.Visualization.WritePPM(m_options.OutputDirectory / GetFrameFileName(frame, "_diff"));
+			}
+
+			return comparison;
+		}
+
+		// Medians, since a few frames stalled by the scheduler would skew means.
+		static double GetMedianMilliseconds(std::vector<BenchmarkRun::Clock::duration> durations) {
+			if (durations.empty()) return 0;
+
+			const auto middle = durations.begin() + static_cast<ptrdiff_t>(durations.size() / 2);
+			std::nth_element(durations.begin(), middle, durations.end());
+			return std::chrono::duration<double, std::milli>(*middle).count();
+		}
+
+		void CompareTimings(BenchmarkRun::Clock::duration setupTime, const std::vector<BenchmarkRun::FrameTimings>& frameTimings, Result& result) const {
+			result.StageTimings.push_back({ SetupStageName, std::chrono::duration<double, std::milli>(setupTime).count(), 0, false });
+
+			for (size_t i = 0; i < static_cast<size_t>(FrameStage::Count); i++) {
+				std::vector<BenchmarkRun::Clock::duration> durations;
+				for (const auto& timings : frameTimings) durations.push_back(timings.Stages[i]);
+				result.StageTimings.push_back({ FrameStageNames[i], GetMedianMilliseconds(std::move(durations)), 0, false });
+			}
+
+			if (!m_options.OutputDirectory.empty()) WriteStageTimings(m_options.OutputDirectory / "timings.csv", result.StageTimings);
+
+			if (m_options.BaselinePath.empty()) return;
+
+			if (m_options.IsUpdatingReferences) {
+				WriteStageTimings(m_options.BaselinePath, result.StageTimings);
+				return;
+			}
+
+			if (!std::filesystem::exists(m_options.BaselinePath)) {
+				result.Failures.push_back("No timing baseline");
+				return;
+			}
+
+			const auto baseline = ReadStageTimings(m_options.BaselinePath);
+			for (auto& timing : result.StageTimings) {
+				const auto baselineTiming = baseline.find(timing.Stage);
+				if (baselineTiming == baseline.cend()) continue;
+
+				timing.BaselineMilliseconds = baselineTiming->second;
+				timing.IsRegressed = timing.Milliseconds > timing.BaselineMilliseconds * (1 + m_options.TimingRegressionThreshold)
+					&& timing.Milliseconds - timing.BaselineMilliseconds > m_options.MinTimingRegressionMilliseconds;
+
+				if (timing.IsRegressed) {
+					std::ostringstream failure;
+					failure << timing.Stage << " took " << timing.Milliseconds << " ms against a baseline of " << timing.BaselineMilliseconds << " ms";
+					result.Failures.push_back(failure.str());
+				}
+			}
+		}
+
+		static void WriteStageTimings(const std::filesystem::path& path, const std::vector<StageTiming>& timings) {
+			std::ofstream file(path, std::ios::trunc);
+			if (!file) throw std::runtime_error("Failed to create timing baseline file");
+
+			file << "Stage,Milliseconds\n";
+			for (const auto& timing : timings) file << timing.Stage << ',' << timing.Milliseconds << '\n';
+
+			if (!file) throw std::runtime_error("Failed to write timing baseline file");
+		}
+
+		static std::map<std::string, double> ReadStageTimings(const std::filesystem::path& path) {
+			std::ifstream file(path);
+			if (!file) throw std::runtime_error("Failed to open timing baseline file");
+
+			std::map<std::string, double> timings;
+
+			std::string line;
+			std::getline(file, line);
+			while (std::getline(file, line)) {
+				const auto comma = line.find(',');
+				if (comma == std::string::npos) continue;
+
+				std::istringstream value(line.substr(comma + 1));
+				if (double milliseconds; value >> milliseconds) timings[line.substr(0, comma)] = milliseconds;
+				else throw std::runtime_error("Invalid timing baseline file");
+			}
+
+			return timings;
+		}
+	};
+}
@@ -0,0 +1,94 @@
+/*
+ * Header File: RenderBackend.h
+ * Last Update: 2026/10/18
+ *
+ * Copyright (C) Hydr10n@GitHub. All Rights Reserved.
+ */
+
+#pragma once
+
+#include <DirectXMath.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Hydr10n::Rendering {
+	/*
+	 * The small set of commands the demo renders with, so that the same frame can be submitted to Direct3D 12
+	 * or to a CPU-side backend that runs without a GPU or a window.
+	 */
+
+	enum class BufferType { Vertex, Index };
+
+	enum class PrimitiveTopology { TriangleList, TriangleStrip, LineList };
+
+	// Index buffers hold 32-bit indices; in triangle strips, StripCutIndex restarts the strip.
+	static constexpr uint32_t StripCutIndex = 0xFFFFFFFF;
+
+	using BufferHandle = uint32_t;
+
+	struct Viewport { float X, Y, Width, Height, MinDepth, MaxDepth; };
+
+	struct ScissorRect { int32_t Left, Top, Right, Bottom; };
+
+	struct OutputSize { uint32_t Width, Height; };
+
+	// Vertices carry a position and a normal, lit like BasicEffect with EnableDefaultLighting and no specular.
+	struct EffectConstants {
+		DirectX::XMFLOAT4X4 World, View, Projection;
+		DirectX::XMFLOAT4 DiffuseColor;
+	};
+
+	struct ICommandList {
+		virtual ~ICommandList() = default;
+
+		// Clears the whole render target and depth buffer.
+		virtual void Clear(const DirectX::XMFLOAT4& color, float depth) = 0;
+
+		virtual void SetViewport(const Viewport& viewport, const ScissorRect& scissorRect) = 0;
+
+		virtual void SetVertexBuffer(BufferHandle buffer, uint32_t stride) = 0;
+
+		virtual void SetIndexBuffer(BufferHandle buffer) = 0;
+
+		virtual void SetPrimitiveTopology(PrimitiveTopology topology) = 0;
+
+		virtual void SetEffect(const EffectConstants& constants) = 0;
+
+		virtual void DrawIndexed(uint32_t indexCount, uint32_t startIndex) = 0;
+	};
+
+	// Work completes in submission order; a fence value is reached once all work submitted before its Signal is done.
+	struct ICommandQueue {
+		virtual ~ICommandQueue() = default;
+
+		virtual uint64_t Signal() = 0;
+
+		virtual uint64_t GetCompletedValue() const = 0;
+
+		// Blocks until fenceValue is reached.
+		virtual void WaitForValue(uint64_t fenceValue) = 0;
+	};
+
+	struct IDevice {
+		virtual ~IDevice() = default;
+
+		// data is copied; buffers live as long as the device.
+		virtual BufferHandle CreateBuffer(BufferType type, const void* data, size_t size) = 0;
+
+		virtual ICommandQueue& GetCommandQueue() = 0;
+
+		virtual OutputSize GetOutputSize() const = 0;
+
+		// Waits until the previous frame that used the next back buffer has completed, then returns an empty command list for the new frame.
+		virtual ICommandList& BeginFrame() = 0;
+
+		// Submits the frame's command list and presents it.
+		virtual void Present() = 0;
+
+		void WaitForIdle() {
+			auto& commandQueue = GetCommandQueue();
+			commandQueue.WaitForValue(commandQueue.Signal());
+		}
+	};
+}
@@ -0,0 +1,399 @@
+//
+// ResourceStateTracker.h - Collects the state transitions of one command list into batched, minimal barriers
+//
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+
+namespace DX
+{
+    // How a resource in the common state leaves it without a barrier, as D3D12 promotes resources on first use:
+    //   - Any: buffers and simultaneous-access textures are promoted to any state, and decay back to common once every
+    //     command list that used them has executed;
+    //   - Texture: other textures are only promoted to the tracker's TexturePromotableStates, and only decay if every
+    //     promotion was to a read-only state and no barrier followed.
+    // A resource promoted to a read-only state may be promoted again to further read-only states, which accumulate.
+    enum class ResourcePromotion { Texture, Any };
+
+    // Tracks the state of whole resources as a command list is recorded. Transitions are only recorded, then handed out
+    // together by Flush, which must be called before any command using the resources:
+    //   - a resource already in the requested state, or in a read-only state that includes it, needs no barrier;
+    //   - a resource in the common state that can be promoted to the requested state needs no barrier either;
+    //   - several transitions of one resource between flushes become a single one, or none if it ends where it started;
+    //   - BeginTransition starts a split barrier that the next Transition to the same state ends, so the GPU may perform
+    //     the transition while unrelated work runs in between. The resource must not be used until then; a Transition to
+    //     another state ends the split first.
+    //
+    // SetState gives the state of a resource at the start of the command list. A resource first transitioned without it
+    // is pending: the command list assumes it is already in the requested state, and Resolve, called as the command list
+    // is submitted, compares that with the GlobalStates the queue's earlier command lists left behind and hands out the
+    // barriers to run just before it. Resolve then records the states this command list leaves behind, decayed where
+    // D3D12 decays them, and resets the tracker for the next recording.
+    //
+    // Resource is a pointer-like key; State is a bit mask type in which ReadOnlyStates are the bits that may be combined
+    // for reading, and the state with no bits set is the common state.
+    template <class Resource, class State, State ReadOnlyStates, State TexturePromotableStates = State()>
+    class ResourceStateTracker
+    {
+    public:
+        enum class Split { None, Begin, End };
+
+        struct Barrier
+        {
+            Resource    resource;
+            State       before;
+            State       after;
+            Split       split;
+
+            bool operator==(const Barrier&) const = default;
+        };
+
+        // The state of every resource between command lists on one queue, which executes them in submission order.
+        class GlobalStates
+        {
+        public:
+            void SetState(Resource resource, State state, ResourcePromotion promotion = ResourcePromotion::Texture)
+            {
+                m_entries[resource] = { state, promotion };
+            }
+
+            void Forget(Resource resource) { m_entries.erase(resource); }
+
+            void Reset() noexcept { m_entries.clear(); }
+
+            bool Contains(Resource resource) const { return m_entries.contains(resource); }
+
+            State GetState(Resource resource) const { return m_entries.at(resource).state; }
+
+        private:
+            friend class ResourceStateTracker;
+
+            struct Entry
+            {
+                State               state;
+                ResourcePromotion   promotion;
+            };
+
+            std::unordered_map<Resource, Entry> m_entries;
+        };
+
+        void SetState(Resource resource, State state, ResourcePromotion promotion = ResourcePromotion::Texture)
+        {
+            std::erase(m_pendingFirstUses, resource);
+
+            Entry& entry = m_entries[resource];
+            entry = {};
+            entry.state = entry.flushedState = state;
+            entry.promotion = promotion;
+            entry.isPromotable = !static_cast<Bits>(state);
+        }
+
+        // Barriers already recorded for the resource are dropped.
+        void Forget(Resource resource)
+        {
+            m_entries.erase(resource);
+            std::erase(m_pendingFirstUses, resource);
+            std::erase_if(m_splitEnds, [&](const Barrier& barrier) { return barrier.resource == resource; });
+            std::erase_if(m_splitBegins, [&](const Barrier& barrier) { return barrier.resource == resource; });
+        }
+
+        void Reset() noexcept
+        {
+            m_entries.clear();
+            m_pendingFirstUses.clear();
+            m_splitEnds.clear();
+            m_pendingResources.clear();
+            m_splitBegins.clear();
+        }
+
+        // The state the resource will be in once pending barriers are flushed.
+        State GetState(Resource resource) const { return m_entries.at(resource).state; }
+
+        // Whether the resource is first used in this command list without a known state, to be resolved on submission.
+        bool IsPendingFirstUse(Resource resource) const
+        {
+            const auto entryIterator = m_entries.find(resource);
+            return entryIterator != m_entries.cend() && entryIterator->second.isPendingFirstUse;
+        }
+
+        void Transition(Resource resource, State state)
+        {
+            const auto entryIterator = m_entries.find(resource);
+            if (entryIterator == m_entries.end())
+            {
+                Entry& entry = m_entries[resource];
+                entry.state = entry.flushedState = entry.firstState = state;
+                entry.isPendingFirstUse = true;
+                m_pendingFirstUses.push_back(resource);
+                return;
+            }
+
+            Entry& entry = entryIterator->second;
+
+            if (entry.isSplitting)
+            {
+                entry.isSplitting = false;
+
+                if (entry.isSplitBegun)
+                {
+                    // The split is ended on the next flush, and whatever follows is transitioned from its state.
+                    entry.isSplitBegun = false;
+                    m_splitEnds.push_back({ resource, entry.flushedState, entry.splitState, Split::End });
+                    entry.state = entry.flushedState = entry.splitState;
+                }
+                else
+                {
+                    // Nothing came between the beginning and the end, so a single barrier will do.
+                    std::erase_if(m_splitBegins, [&](const Barrier& barrier) { return barrier.resource == resource; });
+                }
+            }
+
+            if (IsSatisfied(entry.state, state))
+            {
+                return;
+            }
+
+            if (Promote(entry, state))
+            {
+                return;
+            }
+
+            entry.state = state;
+            entry.isPromotable = false;
+            entry.hasBarrier = true;
+            MarkPending(resource, entry);
+        }
+
+        // Starts moving the resource to state, to be finished by a later Transition to the same state.
+        void BeginTransition(Resource resource, State state)
+        {
+            const auto entryIterator = m_entries.find(resource);
+            if (entryIterator == m_entries.end())
+            {
+                // The state it would be split from is not known until submission.
+                return;
+            }
+
+            Entry& entry = entryIterator->second;
+            if (entry.isSplitting || IsSatisfied(entry.state, state) || CanPromote(entry, state))
+            {
+                return;
+            }
+
+            if (entry.isPending)
+            {
+                // Barriers not flushed yet can simply go all the way.
+                Transition(resource, state);
+                return;
+            }
+
+            entry.isSplitting = true;
+            entry.isPromotable = false;
+            entry.hasBarrier = true;
+            entry.splitState = state;
+            m_splitBegins.push_back({ resource, entry.flushedState, state, Split::Begin });
+        }
+
+        bool HasPendingBarriers() const noexcept { return !m_splitEnds.empty() || !m_pendingResources.empty() || !m_splitBegins.empty(); }
+
+        // Calls submit once with every pending barrier, if there are any: split ends first, then full transitions, then
+        // split beginnings.
+        template <class Submit>
+        void Flush(const Submit& submit)
+        {
+            if (!HasPendingBarriers())
+            {
+                return;
+            }
+
+            m_barriers.clear();
+            m_barriers.insert(m_barriers.end(), m_splitEnds.cbegin(), m_splitEnds.cend());
+
+            for (const Resource resource : m_pendingResources)
+            {
+                const auto entryIterator = m_entries.find(resource);
+                if (entryIterator == m_entries.end())
+                {
+                    continue;
+                }
+
+                Entry& entry = entryIterator->second;
+                if (entry.state != entry.flushedState)
+                {
+                    m_barriers.push_back({ resource, entry.flushedState, entry.state, Split::None });
+                }
+
+                entry.flushedState = entry.state;
+                entry.isPending = false;
+            }
+
+            for (const Barrier& barrier : m_splitBegins)
+            {
+                const auto entryIterator = m_entries.find(barrier.resource);
+                if (entryIterator != m_entries.end())
+                {
+                    entryIterator->second.isSplitBegun = true;
+                    m_barriers.push_back(barrier);
+                }
+            }
+
+            m_splitEnds.clear();
+            m_pendingResources.clear();
+            m_splitBegins.clear();
+
+            if (!m_barriers.empty())
+            {
+                submit(std::span<const Barrier>(m_barriers));
+            }
+        }
+
+        // Call as the command list is submitted, once every barrier has been flushed and every split ended. Calls submit
+        // once with the barriers that must execute on the queue right before the command list, if there are any: they
+        // bring resources first used in the command list from their global state into the state it expects. A resource
+        // first used without a global state throws std::out_of_range.
+        template <class Submit>
+        void Resolve(GlobalStates& globalStates, const Submit& submit)
+        {
+            if (HasPendingBarriers() || std::any_of(m_entries.cbegin(), m_entries.cend(), [](const auto& entry) { return entry.second.isSplitting; }))
+            {
+                throw std::logic_error("Barriers must be flushed and splits ended before resolving");
+            }
+
+            m_barriers.clear();
+
+            for (const Resource resource : m_pendingFirstUses)
+            {
+                Entry& entry = m_entries.at(resource);
+                const typename GlobalStates::Entry& globalEntry = globalStates.m_entries.at(resource);
+
+                entry.promotion = globalEntry.promotion;
+
+                // Only the exact state will do: the command list's own barriers start from firstState, and a combined
+                // read-only state that includes it would otherwise be left behind as the before state of a later one.
+                if (globalEntry.state == entry.firstState)
+                {
+                    continue;
+                }
+
+                if (!static_cast<Bits>(globalEntry.state) && IsPromotable(entry.promotion, entry.firstState))
+                {
+                    entry.isPromoted = true;
+                    entry.isPromotedToWrite = !IsReadOnly(entry.firstState);
+                    continue;
+                }
+
+                m_barriers.push_back({ resource, globalEntry.state, entry.firstState, Split::None });
+                entry.hasBarrier = true;
+            }
+
+            // What the command list leaves behind, once it has executed.
+            for (const auto& [resource, entry] : m_entries)
+            {
+                globalStates.m_entries[resource] = { Decays(entry) ? State() : entry.state, entry.promotion };
+            }
+
+            Reset();
+
+            if (!m_barriers.empty())
+            {
+                submit(std::span<const Barrier>(m_barriers));
+            }
+        }
+
+    private:
+        using Bits = std::underlying_type_t<State>;
+
+        struct Entry
+        {
+            State               state;              // after pending barriers
+            State               flushedState;       // after flushed barriers
+            State               splitState;         // target of a split barrier
+            State               firstState;         // the state a pending first use expects
+            ResourcePromotion   promotion;
+            bool                isSplitting;
+            bool                isSplitBegun;       // the beginning of the split has been flushed
+            bool                isPending;
+            bool                isPendingFirstUse;
+            bool                isPromotable;       // in the common state, or promoted to read-only states only, with no barrier yet
+            bool                isPromoted;
+            bool                isPromotedToWrite;
+            bool                hasBarrier;
+        };
+
+        static bool IsReadOnly(State state) noexcept
+        {
+            return !(static_cast<Bits>(state) & ~static_cast<Bits>(ReadOnlyStates));
+        }
+
+        static bool IsSatisfied(State current, State requested) noexcept
+        {
+            if (current == requested)
+            {
+                return true;
+            }
+
+            // States with no bits set, such as common, are only satisfied by themselves.
+            return static_cast<Bits>(requested) && IsReadOnly(current) && IsReadOnly(requested)
+                && (static_cast<Bits>(current) & static_cast<Bits>(requested)) == static_cast<Bits>(requested);
+        }
+
+        static bool IsPromotable(ResourcePromotion promotion, State state) noexcept
+        {
+            return static_cast<Bits>(state)
+                && (promotion == ResourcePromotion::Any || !(static_cast<Bits>(state) & ~static_cast<Bits>(TexturePromotableStates)));
+        }
+
+        // From the common state to any promotable state; from promoted read-only states only to further read-only ones.
+        static bool CanPromote(const Entry& entry, State state) noexcept
+        {
+            return entry.isPromotable && IsPromotable(entry.promotion, state)
+                && (!static_cast<Bits>(entry.state) || (IsReadOnly(entry.state) && IsReadOnly(state)));
+        }
+
+        static bool Promote(Entry& entry, State state) noexcept
+        {
+            if (!CanPromote(entry, state))
+            {
+                return false;
+            }
+
+            entry.state = entry.flushedState = static_cast<State>(static_cast<Bits>(entry.state) | static_cast<Bits>(state));
+            entry.isPromotable = IsReadOnly(state);
+            entry.isPromoted = true;
+            entry.isPromotedToWrite = !IsReadOnly(state);
+            return true;
+        }
+
+        static bool Decays(const Entry& entry) noexcept
+        {
+            return entry.promotion == ResourcePromotion::Any || (entry.isPromoted && !entry.isPromotedToWrite && !entry.hasBarrier);
+        }
+
+        void MarkPending(Resource resource, Entry& entry)
+        {
+            if (!entry.isPending)
+            {
+                entry.isPending = true;
+                m_pendingResources.push_back(resource);
+            }
+        }
+
+        std::unordered_map<Resource, Entry> m_entries;
+
+        std::vector<Resource>   m_pendingFirstUses;
+
+        std::vector<Barrier>    m_splitEnds;
+        std::vector<Resource>   m_pendingResources;
+        std::vector<Barrier>    m_splitBegins;
+
+        std::vector<Barrier>    m_barriers;
+    };
+}
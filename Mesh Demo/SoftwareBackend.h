@@ -0,0 +1,777 @@
+/*
+ * Header File: SoftwareBackend.h
+ * Last Update: 2026/10/18
+ *
+ * Copyright (C) Hydr10n@GitHub. All Rights Reserved.
+ */
+
+#pragma once
+
+#include "RecordingBackend.h"
+#include "WorkerPool.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__SSE2__)
+#define SOFTWARE_RASTERIZER_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace Hydr10n::Rendering {
+	/*
+	 * Executes recorded command lists on the CPU into an RGBA8 color buffer and a 32-bit float depth buffer, rendering
+	 * what D3D12Device renders: BasicEffect's per-vertex default lighting without specular, less-equal depth test with
+	 * writes, no culling, and lines one pixel wide.
+	 *
+	 * Draws are batched until a clear or the end of the command list. Each worker then transforms, clips and sets up a
+	 * contiguous range of the batch's primitives and bins them into 64x64 pixel tiles, after which the tiles are
+	 * rasterized in parallel. A tile visits the bins of the workers in order, so primitives land in submission order and
+	 * the image does not depend on the thread count. Triangles are tested four pixels at a time against integer edge
+	 * functions with 1/16 pixel precision and the top-left fill rule.
+	 */
+	class SoftwareRasterizer {
+	public:
+		static constexpr uint32_t TileSize = 64;
+
+		explicit SoftwareRasterizer(uint32_t threadCount = 0) noexcept(false) : m_workerPool(threadCount), m_workers(m_workerPool.GetThreadCount()) {}
+
+		uint32_t GetThreadCount() const { return m_workerPool.GetThreadCount(); }
+
+		uint32_t GetWidth() const { return m_width; }
+
+		uint32_t GetHeight() const { return m_height; }
+
+		// Rows of both buffers are GetRowPitch pixels apart.
+		uint32_t GetRowPitch() const { return m_rowPitch; }
+
+		// Pixels are R, G, B, A bytes in memory order.
+		std::span<const uint32_t> GetColorBuffer() const { return m_colorBuffer; }
+
+		std::span<const float> GetDepthBuffer() const { return m_depthBuffer; }
+
+		uint32_t GetPixel(uint32_t x, uint32_t y) const { return m_colorBuffer[static_cast<size_t>(y) * m_rowPitch + x]; }
+
+		// Both buffers are zeroed.
+		void Resize(const OutputSize& outputSize) {
+			m_width = outputSize.Width;
+			m_height = outputSize.Height;
+			m_tileCountX = (m_width + TileSize - 1) / TileSize;
+			m_tileCountY = (m_height + TileSize - 1) / TileSize;
+			m_rowPitch = m_tileCountX * TileSize;
+
+			m_colorBuffer.assign(static_cast<size_t>(m_rowPitch) * m_height, 0);
+			m_depthBuffer.assign(static_cast<size_t>(m_rowPitch) * m_height, 0);
+
+			for (auto& worker : m_workers) worker.Bins.resize(static_cast<size_t>(m_tileCountX) * m_tileCountY);
+		}
+
+		// Renders commandList, whose buffers belong to device, into targets the size of device's output, resizing them first if needed.
+		void Execute(const RecordingCommandList& commandList, const RecordingDevice& device) {
+			const auto outputSize = device.GetOutputSize();
+			if (outputSize.Width != m_width || outputSize.Height != m_height) Resize(outputSize);
+
+			DrawState state;
+			SetFullViewport(state);
+
+			for (const auto& command : commandList.GetCommands()) {
+				std::visit([&](const auto& command) { ExecuteCommand(command, state, device); }, command);
+			}
+
+			Flush();
+		}
+
+		// Writes the color buffer as a binary PPM (P6) image, dropping alpha.
+		void WritePPM(const std::filesystem::path& path) const {
+			std::ofstream file(path, std::ios::binary | std::ios::trunc);
+			if (!file) throw std::runtime_error("Failed to create PPM file");
+
+			file << "P6\n" << m_width << ' ' << m_height << "\n255\n";
+
+			std::vector<char> row(static_cast<size_t>(m_width) * 3);
+			for (uint32_t y = 0; y < m_height; y++) {
+				for (uint32_t x = 0; x < m_width; x++) {
+					const auto pixel = GetPixel(x, y);
+					for (uint32_t i = 0; i < 3; i++) row[x * 3 + i] = static_cast<char>((pixel >> (i * 8)) & 0xff);
+				}
+				file.write(row.data(), static_cast<std::streamsize>(row.size()));
+			}
+
+			if (!file) throw std::runtime_error("Failed to write PPM file");
+		}
+
+	private:
+		// Vertices start with a position and a normal, as in MeshGenerator::Vertex.
+		static constexpr uint32_t MinVertexStride = sizeof(DirectX::XMFLOAT3) * 2;
+
+		static constexpr int32_t SubpixelBits = 4, SubpixelScale = 1 << SubpixelBits;
+
+		// Primitives reaching further than this many pixels beyond the viewport are clipped; it keeps edge functions within 32 bits.
+		static constexpr float GuardBandPixels = 4096;
+
+		static constexpr uint32_t VertexCacheSize = 64;
+
+		// Interpolated per pixel: depth, 1/w and the lit color divided by w.
+		enum { AttributeZ, AttributeInvW, AttributeRed, AttributeGreen, AttributeBlue, AttributeCount };
+
+		struct Effect {
+			DirectX::XMFLOAT4X4 WorldViewProjection, WorldInverseTranspose;
+			DirectX::XMFLOAT3 DiffuseColor, EmissiveColor;
+			float Alpha;
+		};
+
+		struct PixelRect { int32_t Left, Top, Right, Bottom; };
+
+		struct DrawState {
+			Rendering::Viewport Viewport;
+			PixelRect Bounds;
+			const RecordingDevice::Buffer* VertexBuffer{};
+			uint32_t VertexStride{};
+			const RecordingDevice::Buffer* IndexBuffer{};
+			PrimitiveTopology Topology = PrimitiveTopology::TriangleList;
+			uint32_t EffectIndex = ~0u;
+		};
+
+		struct Draw {
+			const std::byte* Vertices;
+			uint32_t VertexStride, VertexCount;
+			const std::byte* Indices;
+			uint32_t IndexCount;
+			PrimitiveTopology Topology;
+			uint32_t EffectIndex;
+			Rendering::Viewport Viewport;
+			PixelRect Bounds;
+			float GuardBandX, GuardBandY;
+			uint64_t FirstPrimitive;
+		};
+
+		struct ClipVertex {
+			DirectX::XMFLOAT4 Position;
+			DirectX::XMFLOAT3 Color;
+		};
+
+		struct ScreenVertex { float X, Y, Attributes[AttributeCount]; };
+
+		// Edge k is opposite vertex k and is non-negative inside, its fill rule bias included; attribute planes are relative to the first vertex.
+		struct Triangle {
+			PixelRect Bounds;
+			int32_t EdgeA[3], EdgeB[3];
+			int64_t EdgeC[3];
+			float OriginX, OriginY;
+			float Planes[AttributeCount][3];
+			uint32_t Alpha;
+			float MaxDepth;
+		};
+
+		struct Line {
+			PixelRect Bounds;
+			float X[2], Y[2], Attributes[AttributeCount][2];
+			bool IsXMajor;
+			uint32_t Alpha;
+			float MaxDepth;
+		};
+
+		struct CachedVertex {
+			uint32_t Index;
+			ClipVertex Vertex;
+		};
+
+		// Bin entries are primitive indices shifted left by one, with the low bit set for lines.
+		struct Worker {
+			std::vector<Triangle> Triangles;
+			std::vector<Line> Lines;
+			std::vector<std::vector<uint32_t>> Bins;
+			CachedVertex VertexCache[VertexCacheSize];
+		};
+
+		WorkerPool m_workerPool;
+
+		std::vector<Worker> m_workers;
+
+		uint32_t m_width{}, m_height{}, m_rowPitch{}, m_tileCountX{}, m_tileCountY{};
+
+		std::vector<uint32_t> m_colorBuffer;
+		std::vector<float> m_depthBuffer;
+
+		std::vector<Effect> m_effects;
+		std::vector<Draw> m_draws;
+
+		static uint64_t GetPrimitiveCount(PrimitiveTopology topology, uint32_t indexCount) {
+			switch (topology) {
+			case PrimitiveTopology::TriangleList: return indexCount / 3;
+			case PrimitiveTopology::TriangleStrip: return indexCount > 2 ? indexCount - 2 : 0;
+			default: return indexCount / 2;
+			}
+		}
+
+		static uint32_t ToUNorm8(float value) { return static_cast<uint32_t>(std::clamp(value, 0.0f, 1.0f) * 255 + 0.5f); }
+
+		static uint32_t PackColor(float red, float green, float blue, uint32_t alpha) { return ToUNorm8(red) | ToUNorm8(green) << 8 | ToUNorm8(blue) << 16 | alpha << 24; }
+
+		void SetFullViewport(DrawState& state) const {
+			state.Viewport = { 0, 0, static_cast<float>(m_width), static_cast<float>(m_height), 0, 1 };
+			state.Bounds = { 0, 0, static_cast<int32_t>(m_width), static_cast<int32_t>(m_height) };
+		}
+
+		template <typename T>
+		void ExecuteCommand(const T& command, DrawState& state, const RecordingDevice& device) {
+			using namespace DirectX;
+			using namespace RecordedCommands;
+
+			if constexpr (std::is_same_v<T, Clear>) {
+				Flush();
+
+				const auto color = PackColor(command.Color.x, command.Color.y, command.Color.z, ToUNorm8(command.Color.w));
+				m_workerPool.Run(m_height, [&](uint32_t y) {
+					std::fill_n(m_colorBuffer.data() + static_cast<size_t>(y) * m_rowPitch, m_width, color);
+					std::fill_n(m_depthBuffer.data() + static_cast<size_t>(y) * m_rowPitch, m_width, command.Depth);
+				});
+
+				SetFullViewport(state);
+			}
+			else if constexpr (std::is_same_v<T, SetViewport>) {
+				const auto& viewport = command.Viewport;
+				const auto& scissorRect = command.ScissorRect;
+
+				// Pixels whose centers lie inside both the viewport and the scissor rectangle.
+				state.Viewport = viewport;
+				state.Bounds = {
+					std::max({ static_cast<int32_t>(std::ceil(viewport.X - 0.5f)), scissorRect.Left, 0 }),
+					std::max({ static_cast<int32_t>(std::ceil(viewport.Y - 0.5f)), scissorRect.Top, 0 }),
+					std::min({ static_cast<int32_t>(std::ceil(viewport.X + viewport.Width - 0.5f)), scissorRect.Right, static_cast<int32_t>(m_width) }),
+					std::min({ static_cast<int32_t>(std::ceil(viewport.Y + viewport.Height - 0.5f)), scissorRect.Bottom, static_cast<int32_t>(m_height) })
+				};
+			}
+			else if constexpr (std::is_same_v<T, SetVertexBuffer>) {
+				if (command.Stride < MinVertexStride) throw std::invalid_argument("Vertex stride is too small");
+
+				state.VertexBuffer = &device.GetBuffer(command.Buffer);
+				state.VertexStride = command.Stride;
+			}
+			else if constexpr (std::is_same_v<T, SetIndexBuffer>) state.IndexBuffer = &device.GetBuffer(command.Buffer);
+			else if constexpr (std::is_same_v<T, SetPrimitiveTopology>) state.Topology = command.Topology;
+			else if constexpr (std::is_same_v<T, SetEffect>) {
+				const auto& constants = command.Constants;
+
+				const auto world = XMLoadFloat4x4(&constants.World);
+				const auto diffuseColor = XMLoadFloat4(&constants.DiffuseColor);
+				const auto alpha = constants.DiffuseColor.w;
+
+				// As BasicEffect sets its constants: ambient light is folded into the emissive color and both colors are premultiplied by alpha.
+				Effect effect;
+				XMStoreFloat4x4(&effect.WorldViewProjection, world * XMLoadFloat4x4(&constants.View) * XMLoadFloat4x4(&constants.Projection));
+				XMStoreFloat4x4(&effect.WorldInverseTranspose, XMMatrixTranspose(XMMatrixInverse(nullptr, world)));
+				XMStoreFloat3(&effect.DiffuseColor, XMVectorScale(diffuseColor, alpha));
+				XMStoreFloat3(&effect.EmissiveColor, XMVectorScale(XMVectorMultiply(XMVectorSet(0.05333332f, 0.09882354f, 0.1819608f, 0), diffuseColor), alpha));
+				effect.Alpha = alpha;
+
+				m_effects.push_back(effect);
+				state.EffectIndex = static_cast<uint32_t>(m_effects.size() - 1);
+			}
+			else if constexpr (std::is_same_v<T, DrawIndexed>) {
+				if (!state.VertexBuffer || !state.IndexBuffer) throw std::logic_error("Vertex and index buffers must be set before drawing");
+				if (state.EffectIndex == ~0u) throw std::logic_error("Effect must be set before drawing");
+				if ((static_cast<uint64_t>(command.StartIndex) + command.IndexCount) * sizeof(uint32_t) > state.IndexBuffer->Data.size()) throw std::out_of_range("Draw exceeds index buffer");
+
+				const auto primitiveCount = GetPrimitiveCount(state.Topology, command.IndexCount);
+				const auto& bounds = state.Bounds;
+				if (!primitiveCount || bounds.Left >= bounds.Right || bounds.Top >= bounds.Bottom) return;
+
+				const auto& viewport = state.Viewport;
+				m_draws.push_back({
+					state.VertexBuffer->Data.data(), state.VertexStride, static_cast<uint32_t>(state.VertexBuffer->Data.size() / state.VertexStride),
+					state.IndexBuffer->Data.data() + static_cast<size_t>(command.StartIndex) * sizeof(uint32_t), command.IndexCount,
+					state.Topology, state.EffectIndex,
+					viewport, bounds,
+					std::max(1.0f, GuardBandPixels * 2 / viewport.Width), std::max(1.0f, GuardBandPixels * 2 / viewport.Height),
+					m_draws.empty() ? 0 : m_draws.back().FirstPrimitive + GetPrimitiveCount(m_draws.back().Topology, m_draws.back().IndexCount)
+				});
+			}
+		}
+
+		void Flush() {
+			if (m_draws.empty()) return;
+
+			const auto& lastDraw = m_draws.back();
+			const auto primitiveCount = lastDraw.FirstPrimitive + GetPrimitiveCount(lastDraw.Topology, lastDraw.IndexCount);
+
+			const auto workerCount = static_cast<uint32_t>(m_workers.size());
+			m_workerPool.Run(workerCount, [&](uint32_t i) {
+				SetUpPrimitives(m_workers[i], primitiveCount * i / workerCount, primitiveCount * (i + 1) / workerCount);
+			});
+
+			m_workerPool.Run(m_tileCountX * m_tileCountY, [&](uint32_t tile) { RasterizeTile(tile); });
+
+			m_draws.clear();
+			m_effects.clear();
+		}
+
+		void SetUpPrimitives(Worker& worker, uint64_t firstPrimitive, uint64_t endPrimitive) {
+			worker.Triangles.clear();
+			worker.Lines.clear();
+			for (auto& bin : worker.Bins) bin.clear();
+
+			auto draw = std::upper_bound(m_draws.cbegin(), m_draws.cend(), firstPrimitive, [](uint64_t primitive, const Draw& draw) { return primitive < draw.FirstPrimitive; }) - 1;
+			for (auto primitive = firstPrimitive; primitive < endPrimitive; ++draw) {
+				const auto drawEndPrimitive = std::min(endPrimitive, draw->FirstPrimitive + GetPrimitiveCount(draw->Topology, draw->IndexCount));
+
+				for (auto& cachedVertex : worker.VertexCache) cachedVertex.Index = ~0u;
+
+				const auto LoadIndex = [&](uint64_t i) {
+					uint32_t index;
+					std::memcpy(&index, draw->Indices + i * sizeof(uint32_t), sizeof(index));
+					return index;
+				};
+
+				const auto GetVertex = [&](uint32_t index) -> const ClipVertex& {
+					auto& cachedVertex = worker.VertexCache[index % VertexCacheSize];
+					if (cachedVertex.Index != index) {
+						cachedVertex.Index = index;
+						cachedVertex.Vertex = ProcessVertex(*draw, index);
+					}
+					return cachedVertex.Vertex;
+				};
+
+				for (; primitive < drawEndPrimitive; primitive++) {
+					const auto localPrimitive = primitive - draw->FirstPrimitive;
+
+					// Out-of-range indices drop the primitive; with culling off, a strip is every run of three indices without a cut.
+					if (draw->Topology == PrimitiveTopology::LineList) {
+						const uint32_t indices[]{ LoadIndex(localPrimitive * 2), LoadIndex(localPrimitive * 2 + 1) };
+						if (indices[0] >= draw->VertexCount || indices[1] >= draw->VertexCount) continue;
+
+						ClipVertex vertices[]{ GetVertex(indices[0]), GetVertex(indices[1]) };
+						ClipLine(worker, *draw, vertices);
+					}
+					else {
+						const auto firstIndex = draw->Topology == PrimitiveTopology::TriangleList ? localPrimitive * 3 : localPrimitive;
+						const uint32_t indices[]{ LoadIndex(firstIndex), LoadIndex(firstIndex + 1), LoadIndex(firstIndex + 2) };
+						if (indices[0] >= draw->VertexCount || indices[1] >= draw->VertexCount || indices[2] >= draw->VertexCount) continue;
+
+						ClipTriangle(worker, *draw, { GetVertex(indices[0]), GetVertex(indices[1]), GetVertex(indices[2]) });
+					}
+				}
+			}
+		}
+
+		// BasicEffect's vertex lighting with EnableDefaultLighting and no specular.
+		ClipVertex ProcessVertex(const Draw& draw, uint32_t index) const {
+			using namespace DirectX;
+
+			static const XMVECTORF32 LightDirections[]{
+				{ { { -0.5265408f, -0.5735765f, -0.6275069f, 0 } } },
+				{ { { 0.7198464f, 0.3420201f, 0.6040227f, 0 } } },
+				{ { { 0.4545195f, -0.7660444f, 0.4545195f, 0 } } }
+			};
+			static const XMVECTORF32 LightDiffuseColors[]{
+				{ { { 1, 0.9607844f, 0.8078432f, 0 } } },
+				{ { { 0.9647059f, 0.7607844f, 0.4078432f, 0 } } },
+				{ { { 0.3231373f, 0.3607844f, 0.3937255f, 0 } } }
+			};
+
+			const auto& effect = m_effects[draw.EffectIndex];
+
+			XMFLOAT3 position, normal;
+			const auto vertex = draw.Vertices + static_cast<size_t>(index) * draw.VertexStride;
+			std::memcpy(&position, vertex, sizeof(position));
+			std::memcpy(&normal, vertex + sizeof(position), sizeof(normal));
+
+			const auto worldNormal = XMVector3Normalize(XMVector3TransformNormal(XMLoadFloat3(&normal), XMLoadFloat4x4(&effect.WorldInverseTranspose)));
+
+			auto diffuse = XMVectorZero();
+			for (size_t i = 0; i < std::size(LightDirections); i++) {
+				diffuse = XMVectorMultiplyAdd(XMVectorMax(XMVector3Dot(XMVectorNegate(LightDirections[i]), worldNormal), XMVectorZero()), LightDiffuseColors[i], diffuse);
+			}
+
+			ClipVertex clipVertex;
+			XMStoreFloat4(&clipVertex.Position, XMVector3Transform(XMLoadFloat3(&position), XMLoadFloat4x4(&effect.WorldViewProjection)));
+			XMStoreFloat3(&clipVertex.Color, XMVectorMultiplyAdd(diffuse, XMLoadFloat3(&effect.DiffuseColor), XMLoadFloat3(&effect.EmissiveColor)));
+			return clipVertex;
+		}
+
+		// The near plane (z >= 0) and the guard band, as signed distances that are negative outside.
+		static constexpr uint32_t ClipPlaneCount = 5;
+
+		static float GetClipDistance(const ClipVertex& vertex, uint32_t plane, float guardBandX, float guardBandY) {
+			const auto& position = vertex.Position;
+			switch (plane) {
+			case 0: return position.z;
+			case 1: return guardBandX * position.w - position.x;
+			case 2: return guardBandX * position.w + position.x;
+			case 3: return guardBandY * position.w - position.y;
+			default: return guardBandY * position.w + position.y;
+			}
+		}
+
+		static uint32_t GetOutcode(const ClipVertex& vertex, const Draw& draw) {
+			uint32_t outcode = 0;
+			for (uint32_t plane = 0; plane < ClipPlaneCount; plane++) {
+				if (GetClipDistance(vertex, plane, draw.GuardBandX, draw.GuardBandY) < 0) outcode |= 1 << plane;
+			}
+			return outcode;
+		}
+
+		static ClipVertex Lerp(const ClipVertex& a, const ClipVertex& b, float t) {
+			using namespace DirectX;
+
+			ClipVertex vertex;
+			XMStoreFloat4(&vertex.Position, XMVectorLerp(XMLoadFloat4(&a.Position), XMLoadFloat4(&b.Position), t));
+			XMStoreFloat3(&vertex.Color, XMVectorLerp(XMLoadFloat3(&a.Color), XMLoadFloat3(&b.Color), t));
+			return vertex;
+		}
+
+		static ScreenVertex Project(const ClipVertex& vertex, const Viewport& viewport) {
+			const auto& position = vertex.Position;
+			const auto invW = 1 / position.w, z = position.z * invW;
+			return {
+				viewport.X + (position.x * invW + 1) * 0.5f * viewport.Width,
+				viewport.Y + (1 - position.y * invW) * 0.5f * viewport.Height,
+				{ viewport.MinDepth + z * (viewport.MaxDepth - viewport.MinDepth), invW, vertex.Color.x * invW, vertex.Color.y * invW, vertex.Color.z * invW }
+			};
+		}
+
+		void ClipTriangle(Worker& worker, const Draw& draw, const ClipVertex(&vertices)[3]) {
+			const uint32_t outcodes[]{ GetOutcode(vertices[0], draw), GetOutcode(vertices[1], draw), GetOutcode(vertices[2], draw) };
+			if (outcodes[0] & outcodes[1] & outcodes[2]) return;
+
+			if (!(outcodes[0] | outcodes[1] | outcodes[2])) {
+				SetUpTriangle(worker, draw, Project(vertices[0], draw.Viewport), Project(vertices[1], draw.Viewport), Project(vertices[2], draw.Viewport));
+				return;
+			}
+
+			// Sutherland-Hodgman against the planes crossed, then fanned back into triangles.
+			constexpr uint32_t MaxVertexCount = 3 + ClipPlaneCount;
+			ClipVertex polygons[2][MaxVertexCount]{ { vertices[0], vertices[1], vertices[2] } };
+			uint32_t vertexCount = 3, input = 0;
+			for (uint32_t plane = 0; plane < ClipPlaneCount; plane++) {
+				if (!((outcodes[0] | outcodes[1] | outcodes[2]) & (1 << plane))) continue;
+
+				const auto& inputPolygon = polygons[input];
+				auto& outputPolygon = polygons[input ^ 1];
+				uint32_t outputVertexCount = 0;
+				for (uint32_t i = 0; i < vertexCount; i++) {
+					const auto& a = inputPolygon[i], & b = inputPolygon[(i + 1) % vertexCount];
+					const auto distanceA = GetClipDistance(a, plane, draw.GuardBandX, draw.GuardBandY), distanceB = GetClipDistance(b, plane, draw.GuardBandX, draw.GuardBandY);
+					if (distanceA >= 0) outputPolygon[outputVertexCount++] = a;
+					if ((distanceA >= 0) != (distanceB >= 0)) outputPolygon[outputVertexCount++] = Lerp(a, b, distanceA / (distanceA - distanceB));
+				}
+
+				vertexCount = outputVertexCount;
+				input ^= 1;
+				if (vertexCount < 3) return;
+			}
+
+			const auto& polygon = polygons[input];
+			const auto first = Project(polygon[0], draw.Viewport);
+			auto previous = Project(polygon[1], draw.Viewport);
+			for (uint32_t i = 2; i < vertexCount; i++) {
+				const auto current = Project(polygon[i], draw.Viewport);
+				SetUpTriangle(worker, draw, first, previous, current);
+				previous = current;
+			}
+		}
+
+		void ClipLine(Worker& worker, const Draw& draw, ClipVertex(&vertices)[2]) {
+			const uint32_t outcodes[]{ GetOutcode(vertices[0], draw), GetOutcode(vertices[1], draw) };
+			if (outcodes[0] & outcodes[1]) return;
+
+			if (outcodes[0] | outcodes[1]) {
+				float t0 = 0, t1 = 1;
+				for (uint32_t plane = 0; plane < ClipPlaneCount; plane++) {
+					const auto distance0 = GetClipDistance(vertices[0], plane, draw.GuardBandX, draw.GuardBandY), distance1 = GetClipDistance(vertices[1], plane, draw.GuardBandX, draw.GuardBandY);
+					if (distance0 < 0) t0 = std::max(t0, distance0 / (distance0 - distance1));
+					else if (distance1 < 0) t1 = std::min(t1, distance0 / (distance0 - distance1));
+				}
+				if (t0 >= t1) return;
+
+				const auto vertex0 = Lerp(vertices[0], vertices[1], t0);
+				vertices[1] = Lerp(vertices[0], vertices[1], t1);
+				vertices[0] = vertex0;
+			}
+
+			SetUpLine(worker, draw, Project(vertices[0], draw.Viewport), Project(vertices[1], draw.Viewport));
+		}
+
+		void Bin(Worker& worker, const PixelRect& bounds, uint32_t entry) const {
+			for (auto tileY = bounds.Top / static_cast<int32_t>(TileSize); tileY <= bounds.Bottom / static_cast<int32_t>(TileSize); tileY++) {
+				for (auto tileX = bounds.Left / static_cast<int32_t>(TileSize); tileX <= bounds.Right / static_cast<int32_t>(TileSize); tileX++) {
+					worker.Bins[static_cast<size_t>(tileY) * m_tileCountX + tileX].push_back(entry);
+				}
+			}
+		}
+
+		void SetUpTriangle(Worker& worker, const Draw& draw, const ScreenVertex& vertex0, const ScreenVertex& vertex1, const ScreenVertex& vertex2) {
+			ScreenVertex vertices[]{ vertex0, vertex1, vertex2 };
+
+			int32_t x[3], y[3];
+			for (int i = 0; i < 3; i++) {
+				x[i] = static_cast<int32_t>(std::lrint(vertices[i].X * SubpixelScale));
+				y[i] = static_cast<int32_t>(std::lrint(vertices[i].Y * SubpixelScale));
+			}
+
+			auto area = static_cast<int64_t>(x[1] - x[0]) * (y[2] - y[0]) - static_cast<int64_t>(x[2] - x[0]) * (y[1] - y[0]);
+			if (!area) return;
+			if (area < 0) {
+				std::swap(vertices[1], vertices[2]);
+				std::swap(x[1], x[2]);
+				std::swap(y[1], y[2]);
+				area = -area;
+			}
+
+			// Pixels whose centers lie within the bounding box, inclusive.
+			Triangle triangle;
+			auto& bounds = triangle.Bounds;
+			constexpr int32_t HalfPixel = SubpixelScale / 2;
+			bounds = {
+				std::max(draw.Bounds.Left, (std::min({ x[0], x[1], x[2] }) - HalfPixel + SubpixelScale - 1) >> SubpixelBits),
+				std::max(draw.Bounds.Top, (std::min({ y[0], y[1], y[2] }) - HalfPixel + SubpixelScale - 1) >> SubpixelBits),
+				std::min(draw.Bounds.Right - 1, (std::max({ x[0], x[1], x[2] }) - HalfPixel) >> SubpixelBits),
+				std::min(draw.Bounds.Bottom - 1, (std::max({ y[0], y[1], y[2] }) - HalfPixel) >> SubpixelBits)
+			};
+			if (bounds.Left > bounds.Right || bounds.Top > bounds.Bottom) return;
+
+			// Edges are inclusive when they are top (horizontal, inside below) or left (inside to the right) edges.
+			for (int k = 0; k < 3; k++) {
+				const auto from = (k + 1) % 3, to = (k + 2) % 3;
+				const auto a = y[from] - y[to], b = x[to] - x[from];
+				const auto isTopLeft = a > 0 || (a == 0 && b > 0);
+				triangle.EdgeA[k] = a;
+				triangle.EdgeB[k] = b;
+				triangle.EdgeC[k] = -(static_cast<int64_t>(a) * x[from] + static_cast<int64_t>(b) * y[from]) - (isTopLeft ? 0 : 1);
+			}
+
+			const float originX = static_cast<float>(x[0]) / SubpixelScale, originY = static_cast<float>(y[0]) / SubpixelScale;
+			const float dx1 = static_cast<float>(x[1]) / SubpixelScale - originX, dy1 = static_cast<float>(y[1]) / SubpixelScale - originY;
+			const float dx2 = static_cast<float>(x[2]) / SubpixelScale - originX, dy2 = static_cast<float>(y[2]) / SubpixelScale - originY;
+			const auto inverseDeterminant = 1 / (dx1 * dy2 - dx2 * dy1);
+			triangle.OriginX = originX;
+			triangle.OriginY = originY;
+			for (int i = 0; i < AttributeCount; i++) {
+				const auto value = vertices[0].Attributes[i], delta1 = vertices[1].Attributes[i] - value, delta2 = vertices[2].Attributes[i] - value;
+				triangle.Planes[i][0] = value;
+				triangle.Planes[i][1] = (delta1 * dy2 - delta2 * dy1) * inverseDeterminant;
+				triangle.Planes[i][2] = (delta2 * dx1 - delta1 * dx2) * inverseDeterminant;
+			}
+
+			const auto& effect = m_effects[draw.EffectIndex];
+			triangle.Alpha = ToUNorm8(effect.Alpha);
+			triangle.MaxDepth = draw.Viewport.MaxDepth;
+
+			worker.Triangles.push_back(triangle);
+			Bin(worker, bounds, static_cast<uint32_t>(worker.Triangles.size() - 1) << 1);
+		}
+
+		void SetUpLine(Worker& worker, const Draw& draw, const ScreenVertex& vertex0, const ScreenVertex& vertex1) {
+			ScreenVertex vertices[]{ vertex0, vertex1 };
+
+			Line line;
+			line.IsXMajor = std::abs(vertices[1].X - vertices[0].X) >= std::abs(vertices[1].Y - vertices[0].Y);
+			if (line.IsXMajor ? vertices[0].X > vertices[1].X : vertices[0].Y > vertices[1].Y) std::swap(vertices[0], vertices[1]);
+
+			for (int i = 0; i < 2; i++) {
+				line.X[i] = vertices[i].X;
+				line.Y[i] = vertices[i].Y;
+				for (int j = 0; j < AttributeCount; j++) line.Attributes[j][i] = vertices[i].Attributes[j];
+			}
+
+			auto& bounds = line.Bounds;
+			bounds = {
+				std::max(draw.Bounds.Left, static_cast<int32_t>(std::floor(std::min(line.X[0], line.X[1])))),
+				std::max(draw.Bounds.Top, static_cast<int32_t>(std::floor(std::min(line.Y[0], line.Y[1])))),
+				std::min(draw.Bounds.Right - 1, static_cast<int32_t>(std::floor(std::max(line.X[0], line.X[1])))),
+				std::min(draw.Bounds.Bottom - 1, static_cast<int32_t>(std::floor(std::max(line.Y[0], line.Y[1]))))
+			};
+			if (bounds.Left > bounds.Right || bounds.Top > bounds.Bottom) return;
+
+			const auto& effect = m_effects[draw.EffectIndex];
+			line.Alpha = ToUNorm8(effect.Alpha);
+			line.MaxDepth = draw.Viewport.MaxDepth;
+
+			worker.Lines.push_back(line);
+			Bin(worker, bounds, static_cast<uint32_t>(worker.Lines.size() - 1) << 1 | 1);
+		}
+
+		void RasterizeTile(uint32_t tile) {
+			const auto tileX = static_cast<int32_t>(tile % m_tileCountX * TileSize), tileY = static_cast<int32_t>(tile / m_tileCountX * TileSize);
+			const PixelRect tileRect{ tileX, tileY, std::min(tileX + static_cast<int32_t>(TileSize), static_cast<int32_t>(m_width)) - 1, std::min(tileY + static_cast<int32_t>(TileSize), static_cast<int32_t>(m_height)) - 1 };
+
+			for (const auto& worker : m_workers) {
+				for (const auto entry : worker.Bins[tile]) {
+					if (entry & 1) RasterizeLine(worker.Lines[entry >> 1], tileRect);
+					else RasterizeTriangle(worker.Triangles[entry >> 1], tileRect);
+				}
+			}
+		}
+
+		// Spans start on a multiple of four pixels; since tiles and the row pitch are multiples of four as well, a span never touches another tile.
+		void RasterizeTriangle(const Triangle& triangle, const PixelRect& tileRect) {
+			const auto left = std::max(triangle.Bounds.Left, tileRect.Left), top = std::max(triangle.Bounds.Top, tileRect.Top);
+			const auto right = std::min(triangle.Bounds.Right, tileRect.Right), bottom = std::min(triangle.Bounds.Bottom, tileRect.Bottom);
+			if (left > right || top > bottom) return;
+
+			const auto spanLeft = left & ~3, spanRight = right | 3;
+
+			// An edge that cannot change sign within the rectangle either rejects the triangle or is dropped from the test; the rest stay within 32 bits.
+			int32_t edges[3], edgeStepsX[3], edgeStepsY[3];
+			for (int k = 0; k < 3; k++) {
+				const int64_t stepX = static_cast<int64_t>(triangle.EdgeA[k]) * SubpixelScale, stepY = static_cast<int64_t>(triangle.EdgeB[k]) * SubpixelScale;
+				const auto edge = triangle.EdgeA[k] * (static_cast<int64_t>(spanLeft) * SubpixelScale + SubpixelScale / 2) + triangle.EdgeB[k] * (static_cast<int64_t>(top) * SubpixelScale + SubpixelScale / 2) + triangle.EdgeC[k];
+				const auto rangeX = stepX * (spanRight - spanLeft), rangeY = stepY * (bottom - top);
+				const auto minEdge = edge + std::min<int64_t>(rangeX, 0) + std::min<int64_t>(rangeY, 0), maxEdge = edge + std::max<int64_t>(rangeX, 0) + std::max<int64_t>(rangeY, 0);
+				if (maxEdge < 0) return;
+
+				if (minEdge >= 0) edges[k] = edgeStepsX[k] = edgeStepsY[k] = 0;
+				else {
+					edges[k] = static_cast<int32_t>(edge);
+					edgeStepsX[k] = static_cast<int32_t>(stepX);
+					edgeStepsY[k] = static_cast<int32_t>(stepY);
+				}
+			}
+
+			float planes[AttributeCount], planeStepsX[AttributeCount], planeStepsY[AttributeCount];
+			for (int i = 0; i < AttributeCount; i++) {
+				const auto& plane = triangle.Planes[i];
+				planes[i] = plane[0] + plane[1] * (static_cast<float>(spanLeft) + 0.5f - triangle.OriginX) + plane[2] * (static_cast<float>(top) + 0.5f - triangle.OriginY);
+				planeStepsX[i] = plane[1];
+				planeStepsY[i] = plane[2];
+			}
+
+			for (auto y = top; y <= bottom; y++) {
+				const auto offset = static_cast<size_t>(y) * m_rowPitch;
+				const auto colorRow = m_colorBuffer.data() + offset;
+				const auto depthRow = m_depthBuffer.data() + offset;
+
+#ifdef SOFTWARE_RASTERIZER_SSE2
+				const auto laneOffsets = _mm_setr_epi32(0, 1, 2, 3);
+				const auto laneOffsetsF = _mm_setr_ps(0, 1, 2, 3);
+				const auto minusOne = _mm_set1_epi32(-1), leftBound = _mm_set1_epi32(left - 1), rightBound = _mm_set1_epi32(right + 1);
+				const auto zero = _mm_setzero_ps(), one = _mm_set1_ps(1), unorm = _mm_set1_ps(255), half = _mm_set1_ps(0.5f);
+				const auto maxDepth = _mm_set1_ps(triangle.MaxDepth);
+				const auto alpha = _mm_set1_epi32(static_cast<int>(triangle.Alpha << 24));
+
+				__m128i edgeValues[3], edgeSteps[3];
+				for (int k = 0; k < 3; k++) {
+					edgeValues[k] = _mm_setr_epi32(edges[k], edges[k] + edgeStepsX[k], edges[k] + edgeStepsX[k] * 2, edges[k] + edgeStepsX[k] * 3);
+					edgeSteps[k] = _mm_set1_epi32(edgeStepsX[k] * 4);
+				}
+
+				__m128 planeValues[AttributeCount], planeSteps[AttributeCount];
+				for (int i = 0; i < AttributeCount; i++) {
+					planeValues[i] = _mm_add_ps(_mm_set1_ps(planes[i]), _mm_mul_ps(_mm_set1_ps(planeStepsX[i]), laneOffsetsF));
+					planeSteps[i] = _mm_set1_ps(planeStepsX[i] * 4);
+				}
+
+				for (auto x = spanLeft; x <= spanRight; x += 4) {
+					const auto xs = _mm_add_epi32(_mm_set1_epi32(x), laneOffsets);
+					auto mask = _mm_and_si128(_mm_cmpgt_epi32(xs, leftBound), _mm_cmplt_epi32(xs, rightBound));
+					mask = _mm_and_si128(mask, _mm_cmpgt_epi32(_mm_or_si128(_mm_or_si128(edgeValues[0], edgeValues[1]), edgeValues[2]), minusOne));
+
+					if (_mm_movemask_epi8(mask)) {
+						const auto z = planeValues[AttributeZ];
+						const auto depth = _mm_loadu_ps(depthRow + x);
+						const auto depthMask = _mm_and_ps(_mm_castsi128_ps(mask), _mm_and_ps(_mm_cmple_ps(z, depth), _mm_cmple_ps(z, maxDepth)));
+
+						if (_mm_movemask_ps(depthMask)) {
+							_mm_storeu_ps(depthRow + x, _mm_or_ps(_mm_and_ps(depthMask, z), _mm_andnot_ps(depthMask, depth)));
+
+							const auto w = _mm_div_ps(one, planeValues[AttributeInvW]);
+							const auto ToUNorm = [&](__m128 value) { return _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_mul_ps(value, w), zero), one), unorm), half)); };
+							const auto pixels = _mm_or_si128(
+								_mm_or_si128(ToUNorm(planeValues[AttributeRed]), _mm_slli_epi32(ToUNorm(planeValues[AttributeGreen]), 8)),
+								_mm_or_si128(_mm_slli_epi32(ToUNorm(planeValues[AttributeBlue]), 16), alpha)
+							);
+
+							const auto colorMask = _mm_castps_si128(depthMask);
+							const auto colors = _mm_loadu_si128(reinterpret_cast<const __m128i*>(colorRow + x));
+							_mm_storeu_si128(reinterpret_cast<__m128i*>(colorRow + x), _mm_or_si128(_mm_and_si128(colorMask, pixels), _mm_andnot_si128(colorMask, colors)));
+						}
+					}
+
+					for (int k = 0; k < 3; k++) edgeValues[k] = _mm_add_epi32(edgeValues[k], edgeSteps[k]);
+					for (int i = 0; i < AttributeCount; i++) planeValues[i] = _mm_add_ps(planeValues[i], planeSteps[i]);
+				}
+#else
+				int32_t edgeValues[3]{ edges[0], edges[1], edges[2] };
+				float planeValues[AttributeCount];
+				std::copy_n(planes, AttributeCount, planeValues);
+
+				for (auto x = spanLeft; x <= spanRight; x++) {
+					if (x >= left && x <= right && (edgeValues[0] | edgeValues[1] | edgeValues[2]) >= 0) {
+						const auto z = planeValues[AttributeZ];
+						auto& depth = depthRow[x];
+						if (z <= depth && z <= triangle.MaxDepth) {
+							depth = z;
+
+							const auto w = 1 / planeValues[AttributeInvW];
+							colorRow[x] = PackColor(planeValues[AttributeRed] * w, planeValues[AttributeGreen] * w, planeValues[AttributeBlue] * w, triangle.Alpha);
+						}
+					}
+
+					for (int k = 0; k < 3; k++) edgeValues[k] += edgeStepsX[k];
+					for (int i = 0; i < AttributeCount; i++) planeValues[i] += planeStepsX[i];
+				}
+#endif
+
+				for (int k = 0; k < 3; k++) edges[k] += edgeStepsY[k];
+				for (int i = 0; i < AttributeCount; i++) planes[i] += planeStepsY[i];
+			}
+		}
+
+		// One pixel per column (or row, for y-major lines) whose center the line crosses, the far end excluded.
+		void RasterizeLine(const Line& line, const PixelRect& tileRect) {
+			const auto left = std::max(line.Bounds.Left, tileRect.Left), top = std::max(line.Bounds.Top, tileRect.Top);
+			const auto right = std::min(line.Bounds.Right, tileRect.Right), bottom = std::min(line.Bounds.Bottom, tileRect.Bottom);
+			if (left > right || top > bottom) return;
+
+			const auto& major = line.IsXMajor ? line.X : line.Y;
+			const auto& minor = line.IsXMajor ? line.Y : line.X;
+			const auto length = major[1] - major[0];
+			if (length <= 0) return;
+
+			const auto first = std::max(static_cast<int32_t>(std::ceil(major[0] - 0.5f)), line.IsXMajor ? left : top);
+			const auto last = std::min(static_cast<int32_t>(std::ceil(major[1] - 0.5f)) - 1, line.IsXMajor ? right : bottom);
+			const auto minorFirst = line.IsXMajor ? top : left, minorLast = line.IsXMajor ? bottom : right;
+
+			for (auto i = first; i <= last; i++) {
+				const auto t = (static_cast<float>(i) + 0.5f - major[0]) / length;
+				const auto j = static_cast<int32_t>(std::floor(minor[0] + (minor[1] - minor[0]) * t));
+				if (j < minorFirst || j > minorLast) continue;
+
+				float attributes[AttributeCount];
+				for (int k = 0; k < AttributeCount; k++) attributes[k] = line.Attributes[k][0] + (line.Attributes[k][1] - line.Attributes[k][0]) * t;
+
+				const auto x = line.IsXMajor ? i : j, y = line.IsXMajor ? j : i;
+				const auto offset = static_cast<size_t>(y) * m_rowPitch + x;
+
+				const auto z = attributes[AttributeZ];
+				auto& depth = m_depthBuffer[offset];
+				if (z > depth || z > line.MaxDepth) continue;
+				depth = z;
+
+				const auto w = 1 / attributes[AttributeInvW];
+				m_colorBuffer[offset] = PackColor(attributes[AttributeRed] * w, attributes[AttributeGreen] * w, attributes[AttributeBlue] * w, line.Alpha);
+			}
+		}
+	};
+
+	// A RecordingDevice whose command lists are rendered by a SoftwareRasterizer as they complete, so that presented frames can be read back.
+	class SoftwareDevice : public RecordingDevice {
+	public:
+		explicit SoftwareDevice(const OutputSize& outputSize, uint32_t threadCount = 0) noexcept(false) : RecordingDevice(outputSize), m_rasterizer(threadCount) {
+			GetCommandQueue().SetExecutor([this](const RecordingCommandList& commandList) { m_rasterizer.Execute(commandList, *this); });
+		}
+
+		// Holds the last executed frame, which is the last presented one unless the command queue has latency.
+		const SoftwareRasterizer& GetRasterizer() const { return m_rasterizer; }
+
+	private:
+		SoftwareRasterizer m_rasterizer;
+	};
+}
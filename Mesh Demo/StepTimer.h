@@ -4,42 +4,139 @@
 
 #pragma once
 
+#include <chrono>
 #include <cmath>
+#include <concepts>
 #include <cstdint>
 #include <exception>
+#include <utility>
+
+#include "FrameStatistics.h"
+
+#if defined(__linux__)
+#include <time.h>
+#endif
 
 
 namespace DX
 {
+    // A clock source provides a monotonic counter and its frequency in counts per second.
+    template<typename T>
+    concept StepTimerClock = requires(const T& clock)
+    {
+        { clock.GetFrequency() } -> std::convertible_to<uint64_t>;
+        { clock.GetCount() } -> std::convertible_to<uint64_t>;
+    };
+
+#if defined(_WIN32)
+    // QueryPerformanceCounter.
+    class QpcClock
+    {
+    public:
+        QpcClock() noexcept(false)
+        {
+            if (!QueryPerformanceFrequency(&m_frequency))
+            {
+                throw std::exception();
+            }
+        }
+
+        uint64_t GetFrequency() const noexcept { return static_cast<uint64_t>(m_frequency.QuadPart); }
+
+        uint64_t GetCount() const
+        {
+            LARGE_INTEGER count;
+
+            if (!QueryPerformanceCounter(&count))
+            {
+                throw std::exception();
+            }
+
+            return static_cast<uint64_t>(count.QuadPart);
+        }
+
+    private:
+        LARGE_INTEGER m_frequency;
+    };
+#endif
+
+    // Nanoseconds from CLOCK_MONOTONIC_RAW where available, which unlike CLOCK_MONOTONIC is not slewed by NTP,
+    // otherwise from std::chrono::steady_clock.
+    class SteadyClock
+    {
+    public:
+        uint64_t GetFrequency() const noexcept { return 1000000000; }
+
+        uint64_t GetCount() const
+        {
+#if defined(CLOCK_MONOTONIC_RAW)
+            timespec time;
+
+            if (clock_gettime(CLOCK_MONOTONIC_RAW, &time))
+            {
+                throw std::exception();
+            }
+
+            return static_cast<uint64_t>(time.tv_sec) * 1000000000 + static_cast<uint64_t>(time.tv_nsec);
+#else
+            return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+        }
+    };
+
+    // Manually advanced clock for deterministic tests and offline runs.
+    class VirtualClock
+    {
+    public:
+        explicit VirtualClock(uint64_t frequency = 10000000) noexcept :
+            m_frequency(frequency),
+            m_count(0)
+        {
+        }
+
+        uint64_t GetFrequency() const noexcept { return m_frequency; }
+        uint64_t GetCount() const noexcept { return m_count; }
+
+        void Advance(uint64_t counts) noexcept { m_count += counts; }
+        void AdvanceSeconds(double seconds) noexcept { m_count += static_cast<uint64_t>(seconds * static_cast<double>(m_frequency)); }
+
+        // Waiting on the clock, e.g. in a FrameLimiter, advances it by the time waited.
+        void Sleep(uint64_t counts) noexcept { m_count += counts; }
+
+    private:
+        uint64_t m_frequency;
+        uint64_t m_count;
+    };
+
     // Helper class for animation and simulation timing.
-    class StepTimer
+    template<StepTimerClock TClock>
+    class BasicStepTimer
     {
     public:
-        StepTimer() noexcept(false) :
+        explicit BasicStepTimer(TClock clock = TClock()) noexcept(false) :
+            m_clock(std::move(clock)),
             m_elapsedTicks(0),
             m_totalTicks(0),
             m_leftOverTicks(0),
             m_frameCount(0),
             m_framesPerSecond(0),
             m_framesThisSecond(0),
-            m_qpcSecondCounter(0),
+            m_clockSecondCounter(0),
             m_isFixedTimeStep(false),
-            m_targetElapsedTicks(TicksPerSecond / 60)
+            m_targetElapsedTicks(TicksPerSecond / 60),
+            m_frameStatistics(nullptr)
         {
-            if (!QueryPerformanceFrequency(&m_qpcFrequency))
-            {
-                throw std::exception();
-            }
-
-            if (!QueryPerformanceCounter(&m_qpcLastTime))
-            {
-                throw std::exception();
-            }
+            m_clockFrequency = m_clock.GetFrequency();
+            m_clockLastTime = m_clock.GetCount();
 
             // Initialize max delta to 1/10 of a second.
-            m_qpcMaxDelta = static_cast<uint64_t>(m_qpcFrequency.QuadPart / 10);
+            m_clockMaxDelta = m_clockFrequency / 10;
         }
 
+        // Get the clock source, e.g. to advance a VirtualClock.
+        TClock& GetClock() noexcept { return m_clock; }
+        const TClock& GetClock() const noexcept { return m_clock; }
+
         // Get elapsed time since the previous Update call.
         uint64_t GetElapsedTicks() const noexcept { return m_elapsedTicks; }
         double GetElapsedSeconds() const noexcept { return TicksToSeconds(m_elapsedTicks); }
@@ -48,12 +145,23 @@ namespace DX
         uint64_t GetTotalTicks() const noexcept { return m_totalTicks; }
         double GetTotalSeconds() const noexcept { return TicksToSeconds(m_totalTicks); }
 
+        // Get how far time has advanced past the last Update, as a fraction of the fixed timestep in [0, 1).
+        // Rendering state blended between the last two updates by this factor hides the mismatch between update and frame rates.
+        // Always 1 in variable timestep mode, where the last update is current.
+        double GetInterpolationFactor() const noexcept
+        {
+            return m_isFixedTimeStep ? static_cast<double>(m_leftOverTicks) / static_cast<double>(m_targetElapsedTicks) : 1.;
+        }
+
         // Get total number of updates since start of the program.
         uint32_t GetFrameCount() const noexcept { return m_frameCount; }
 
         // Get the current framerate.
         uint32_t GetFramesPerSecond() const noexcept { return m_framesPerSecond; }
 
+        // Set the collector fed with the unclamped time between Tick calls, or nullptr.
+        void SetFrameStatistics(FrameStatistics* frameStatistics) noexcept { m_frameStatistics = frameStatistics; }
+
         // Set whether to use fixed or variable timestep mode.
         void SetFixedTimeStep(bool isFixedTimestep) noexcept { m_isFixedTimeStep = isFixedTimestep; }
 
@@ -73,15 +181,12 @@ namespace DX
 
         void ResetElapsedTime()
         {
-            if (!QueryPerformanceCounter(&m_qpcLastTime))
-            {
-                throw std::exception();
-            }
+            m_clockLastTime = m_clock.GetCount();
 
             m_leftOverTicks = 0;
             m_framesPerSecond = 0;
             m_framesThisSecond = 0;
-            m_qpcSecondCounter = 0;
+            m_clockSecondCounter = 0;
         }
 
         // Update timer state, calling the specified Update function the appropriate number of times.
@@ -89,27 +194,28 @@ namespace DX
         void Tick(const TUpdate& update)
         {
             // Query the current time.
-            LARGE_INTEGER currentTime;
+            const uint64_t currentTime = m_clock.GetCount();
 
-            if (!QueryPerformanceCounter(&currentTime))
-            {
-                throw std::exception();
-            }
+            uint64_t timeDelta = currentTime - m_clockLastTime;
 
-            uint64_t timeDelta = static_cast<uint64_t>(currentTime.QuadPart - m_qpcLastTime.QuadPart);
+            m_clockLastTime = currentTime;
+            m_clockSecondCounter += timeDelta;
 
-            m_qpcLastTime = currentTime;
-            m_qpcSecondCounter += timeDelta;
+            if (m_frameStatistics)
+            {
+                // Split to avoid overflow, since this delta has not been clamped yet.
+                m_frameStatistics->AddFrame(timeDelta / m_clockFrequency * TicksPerSecond + timeDelta % m_clockFrequency * TicksPerSecond / m_clockFrequency);
+            }
 
             // Clamp excessively large time deltas (e.g. after paused in the debugger).
-            if (timeDelta > m_qpcMaxDelta)
+            if (timeDelta > m_clockMaxDelta)
             {
-                timeDelta = m_qpcMaxDelta;
+                timeDelta = m_clockMaxDelta;
             }
 
-            // Convert QPC units into a canonical tick format. This cannot overflow due to the previous clamp.
+            // Convert clock units into a canonical tick format. This cannot overflow due to the previous clamp.
             timeDelta *= TicksPerSecond;
-            timeDelta /= static_cast<uint64_t>(m_qpcFrequency.QuadPart);
+            timeDelta /= m_clockFrequency;
 
             uint32_t lastFrameCount = m_frameCount;
 
@@ -158,19 +264,21 @@ namespace DX
                 m_framesThisSecond++;
             }
 
-            if (m_qpcSecondCounter >= static_cast<uint64_t>(m_qpcFrequency.QuadPart))
+            if (m_clockSecondCounter >= m_clockFrequency)
             {
                 m_framesPerSecond = m_framesThisSecond;
                 m_framesThisSecond = 0;
-                m_qpcSecondCounter %= static_cast<uint64_t>(m_qpcFrequency.QuadPart);
+                m_clockSecondCounter %= m_clockFrequency;
             }
         }
 
     private:
-        // Source timing data uses QPC units.
-        LARGE_INTEGER m_qpcFrequency;
-        LARGE_INTEGER m_qpcLastTime;
-        uint64_t m_qpcMaxDelta;
+        TClock m_clock;
+
+        // Source timing data uses clock units.
+        uint64_t m_clockFrequency;
+        uint64_t m_clockLastTime;
+        uint64_t m_clockMaxDelta;
 
         // Derived timing data uses a canonical tick format.
         uint64_t m_elapsedTicks;
@@ -181,10 +289,18 @@ namespace DX
         uint32_t m_frameCount;
         uint32_t m_framesPerSecond;
         uint32_t m_framesThisSecond;
-        uint64_t m_qpcSecondCounter;
+        uint64_t m_clockSecondCounter;
 
         // Members for configuring fixed timestep mode.
         bool m_isFixedTimeStep;
         uint64_t m_targetElapsedTicks;
+
+        FrameStatistics* m_frameStatistics;
     };
+
+#if defined(_WIN32)
+    using StepTimer = BasicStepTimer<QpcClock>;
+#else
+    using StepTimer = BasicStepTimer<SteadyClock>;
+#endif
 }
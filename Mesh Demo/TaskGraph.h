@@ -0,0 +1,199 @@
+/*
+ * Header File: TaskGraph.h
+ * Last Update: 2026/10/18
+ *
+ * Copyright (C) Hydr10n@GitHub. All Rights Reserved.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <initializer_list>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Hydr10n::Rendering {
+	/*
+	 * Runs tasks on worker threads of its own as soon as the tasks they depend on are done, so that the thread that starts
+	 * the graph is free until it joins it, e.g. to keep handling window messages. A task can only depend on tasks added
+	 * before it, which keeps the graph acyclic. Once a task throws, no further task is started and Join rethrows the first
+	 * exception. When and where each task ran is recorded, relative to Start.
+	 */
+	class TaskGraph {
+	public:
+		using TaskId = uint32_t;
+
+		struct TaskTiming {
+			std::string Name;
+			double StartSeconds, EndSeconds;
+			// 1-based index of the worker thread that ran the task.
+			uint32_t Thread;
+			bool IsCompleted;
+		};
+
+		TaskGraph() = default;
+
+		TaskGraph(const TaskGraph&) = delete;
+		TaskGraph& operator=(const TaskGraph&) = delete;
+
+		// Tasks that have not started yet are dropped; the destructor waits for those running and discards any exception.
+		~TaskGraph() {
+			{
+				const std::scoped_lock lock(m_mutex);
+				m_isCancelled = true;
+			}
+			m_taskChanged.notify_all();
+
+			for (auto& thread : m_threads) thread.join();
+		}
+
+		TaskId Add(std::string name, std::function<void()> function, std::initializer_list<TaskId> dependencies = {}) {
+			if (!m_threads.empty()) throw std::logic_error("Tasks cannot be added to a started graph");
+
+			const auto id = static_cast<TaskId>(m_tasks.size());
+			for (const auto dependency : dependencies) {
+				if (dependency >= id) throw std::out_of_range("Tasks can only depend on tasks added before them");
+			}
+
+			auto& task = m_tasks.emplace_back();
+			task.Function = std::move(function);
+			task.DependencyCount = static_cast<uint32_t>(dependencies.size());
+			for (const auto dependency : dependencies) m_tasks[dependency].Dependents.emplace_back(id);
+
+			m_timings.push_back({ std::move(name), 0, 0, 0, false });
+
+			return id;
+		}
+
+		size_t GetTaskCount() const { return m_tasks.size(); }
+
+		// A thread count of 0 means one thread per hardware thread but the calling one, and at least one.
+		void Start(uint32_t threadCount = 0) {
+			if (!m_threads.empty()) throw std::logic_error("Task graph already started");
+
+			if (!threadCount) threadCount = std::max(1u, std::thread::hardware_concurrency()) - 1;
+			threadCount = std::max(threadCount, 1u);
+
+			m_startTime = std::chrono::steady_clock::now();
+
+			{
+				const std::scoped_lock lock(m_mutex);
+				for (TaskId i = 0; i < m_tasks.size(); i++) {
+					if (!m_tasks[i].DependencyCount) m_readyTasks.emplace_back(i);
+				}
+				m_remainingTaskCount = m_tasks.size();
+			}
+
+			for (uint32_t i = 0; i < threadCount; i++) m_threads.emplace_back([this, i] { Work(i + 1); });
+		}
+
+		bool IsStarted() const { return !m_threads.empty(); }
+
+		// Whether every task has completed, or the graph stopped because one threw.
+		bool IsFinished() const {
+			const std::scoped_lock lock(m_mutex);
+			return IsFinishedLocked();
+		}
+
+		// Returns whether the graph finished within timeout.
+		template <class Rep, class Period>
+		bool WaitFor(const std::chrono::duration<Rep, Period>& timeout) const {
+			std::unique_lock lock(m_mutex);
+			return m_finished.wait_for(lock, timeout, [&] { return IsFinishedLocked(); });
+		}
+
+		// Waits for the graph to finish and rethrows the first exception a task threw.
+		void Join() {
+			if (m_threads.empty()) throw std::logic_error("Task graph not started");
+
+			{
+				std::unique_lock lock(m_mutex);
+				m_finished.wait(lock, [&] { return IsFinishedLocked(); });
+			}
+
+			if (m_exception) std::rethrow_exception(m_exception);
+		}
+
+		// Complete once the graph has finished.
+		std::span<const TaskTiming> GetTimings() const { return m_timings; }
+
+		std::chrono::steady_clock::time_point GetStartTime() const { return m_startTime; }
+
+	private:
+		struct Task {
+			std::function<void()> Function;
+			uint32_t DependencyCount;
+			std::vector<TaskId> Dependents;
+		};
+
+		std::vector<Task> m_tasks;
+		std::vector<TaskTiming> m_timings;
+
+		std::vector<std::thread> m_threads;
+		std::chrono::steady_clock::time_point m_startTime;
+
+		mutable std::mutex m_mutex;
+		mutable std::condition_variable m_finished;
+		std::condition_variable m_taskChanged;
+		std::vector<TaskId> m_readyTasks;
+		size_t m_remainingTaskCount{}, m_runningTaskCount{};
+		bool m_isCancelled{};
+		std::exception_ptr m_exception;
+
+		bool IsFinishedLocked() const { return !m_remainingTaskCount || (m_exception && !m_runningTaskCount); }
+
+		double GetSecondsSinceStart() const { return std::chrono::duration<double>(std::chrono::steady_clock::now() - m_startTime).count(); }
+
+		void Work(uint32_t thread) {
+			std::unique_lock lock(m_mutex);
+			for (;;) {
+				m_taskChanged.wait(lock, [&] { return m_isCancelled || m_exception || !m_remainingTaskCount || !m_readyTasks.empty(); });
+				if (m_isCancelled || m_exception || !m_remainingTaskCount) return;
+
+				const auto id = m_readyTasks.back();
+				m_readyTasks.pop_back();
+				m_runningTaskCount++;
+
+				lock.unlock();
+
+				auto& timing = m_timings[id];
+				timing.StartSeconds = GetSecondsSinceStart();
+				timing.Thread = thread;
+
+				std::exception_ptr exception;
+				try { m_tasks[id].Function(); }
+				catch (...) { exception = std::current_exception(); }
+
+				timing.EndSeconds = GetSecondsSinceStart();
+
+				lock.lock();
+
+				m_runningTaskCount--;
+
+				if (exception) {
+					if (!m_exception) m_exception = exception;
+				}
+				else {
+					timing.IsCompleted = true;
+
+					m_remainingTaskCount--;
+					for (const auto dependent : m_tasks[id].Dependents) {
+						if (!--m_tasks[dependent].DependencyCount) m_readyTasks.emplace_back(dependent);
+					}
+				}
+
+				if (IsFinishedLocked()) m_finished.notify_all();
+				m_taskChanged.notify_all();
+			}
+		}
+	};
+}
@@ -0,0 +1,119 @@
+//
+// UploadRing.h - Lock-free ring sub-allocation of an upload heap, reclaimed by fence value
+//
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <stdexcept>
+
+
+namespace DX
+{
+    // Hands out offsets into a ring of capacity bytes, one frame's allocations after another. Frames are closed with
+    // the fence value signaled after their work, and their bytes are reclaimed once that value has completed. It only
+    // deals in offsets and fence values, so it does not depend on a device.
+    //
+    // Allocate may be called from any number of threads at once and never blocks. EndFrame and Reclaim must be called
+    // from one thread, after the allocations of the frame being closed have all returned.
+    class UploadRing
+    {
+    public:
+        static constexpr uint64_t c_InvalidOffset = UINT64_MAX;
+
+        explicit UploadRing(uint64_t capacity) noexcept(false) :
+            m_capacity(capacity),
+            m_head(0),
+            m_tail(0)
+        {
+            if (!capacity)
+            {
+                throw std::invalid_argument("capacity must not be zero");
+            }
+        }
+
+        UploadRing(UploadRing const&) = delete;
+        UploadRing& operator= (UploadRing const&) = delete;
+
+        uint64_t GetCapacity() const noexcept { return m_capacity; }
+
+        // Bytes handed out and not yet reclaimed, including padding.
+        uint64_t GetUsedSize() const noexcept { return m_head.load(std::memory_order_acquire) - m_tail.load(std::memory_order_acquire); }
+
+        // Returns the offset of size bytes aligned to alignment, a power of two dividing the capacity, or c_InvalidOffset
+        // if the frames in flight leave no room. An allocation never wraps around the end of the ring.
+        uint64_t Allocate(uint64_t size, uint64_t alignment = 1) noexcept
+        {
+            if (!size || size > m_capacity || !alignment || (alignment & (alignment - 1)) || m_capacity % alignment)
+            {
+                return c_InvalidOffset;
+            }
+
+            uint64_t head = m_head.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                uint64_t start = AlignUp(head, alignment);
+                if (start / m_capacity != (start + size - 1) / m_capacity)
+                {
+                    start = AlignUp(start, m_capacity);
+                }
+
+                const uint64_t end = start + size;
+                if (end - m_tail.load(std::memory_order_acquire) > m_capacity)
+                {
+                    return c_InvalidOffset;
+                }
+
+                if (m_head.compare_exchange_weak(head, end, std::memory_order_acq_rel, std::memory_order_relaxed))
+                {
+                    return start % m_capacity;
+                }
+            }
+        }
+
+        // Closes the current frame: everything allocated so far is reclaimed once fenceValue completes.
+        void EndFrame(uint64_t fenceValue)
+        {
+            const uint64_t head = m_head.load(std::memory_order_acquire);
+            if (head == (m_frames.empty() ? m_tail.load(std::memory_order_relaxed) : m_frames.back().head))
+            {
+                // Nothing was allocated.
+                return;
+            }
+
+            m_frames.push_back({ fenceValue, head });
+        }
+
+        // Frees the bytes of every closed frame whose fence value is at most completedFenceValue.
+        void Reclaim(uint64_t completedFenceValue) noexcept
+        {
+            while (!m_frames.empty() && m_frames.front().fenceValue <= completedFenceValue)
+            {
+                m_tail.store(m_frames.front().head, std::memory_order_release);
+                m_frames.pop_front();
+            }
+        }
+
+    private:
+        struct Frame
+        {
+            uint64_t fenceValue;
+            uint64_t head;
+        };
+
+        static constexpr uint64_t AlignUp(uint64_t value, uint64_t alignment) noexcept
+        {
+            return (value + alignment - 1) / alignment * alignment;
+        }
+
+        const uint64_t          m_capacity;
+
+        // Positions grow without wrapping; the offset in the ring is the position modulo the capacity.
+        std::atomic<uint64_t>   m_head;
+        std::atomic<uint64_t>   m_tail;
+
+        std::deque<Frame>       m_frames;
+    };
+}
@@ -0,0 +1,160 @@
+//
+// UploadScheduler.h - Batches copies for a copy queue and tracks when their results may be used
+//
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <span>
+#include <utility>
+#include <vector>
+
+
+namespace DX
+{
+    // Identifies one enqueued copy; 0 is never issued and counts as complete.
+    using UploadTicket = uint64_t;
+
+    // Collects copies into batches, submits each batch to Queue at once, and keeps the staging data of a batch until its
+    // fence value completes. Consumers on another queue call AcquireForUse before first using a copy's destination to
+    // learn the fence value to wait on, if any; each value is handed out once, as later work on that queue follows the wait.
+    //
+    // Queue provides:
+    //     typename Queue::Copy         one copy to record
+    //     typename Queue::Staging      data to keep alive until the copy has completed
+    //     uint64_t Submit(std::span<const Copy>)     records and executes the copies, returning the increasing fence value signaled after them
+    //     uint64_t GetCompletedValue() const
+    //
+    // Not thread-safe.
+    template <class Queue>
+    class UploadScheduler
+    {
+    public:
+        using Copy = typename Queue::Copy;
+        using Staging = typename Queue::Staging;
+
+        template <class... Args>
+        explicit UploadScheduler(Args&&... args) noexcept(false) :
+            m_queue(std::forward<Args>(args)...),
+            m_submittedTicket(0),
+            m_completedTicket(0),
+            m_waitedFenceValue(0)
+        {
+        }
+
+        UploadScheduler(UploadScheduler const&) = delete;
+        UploadScheduler& operator= (UploadScheduler const&) = delete;
+
+        Queue& GetQueue() noexcept { return m_queue; }
+        const Queue& GetQueue() const noexcept { return m_queue; }
+
+        // Adds the copy to the open batch; it is not submitted before Submit or AcquireForUse.
+        UploadTicket Enqueue(Copy copy, Staging staging)
+        {
+            m_openCopies.push_back(std::move(copy));
+            m_openStaging.push_back(std::move(staging));
+            return m_submittedTicket + m_openCopies.size();
+        }
+
+        bool HasOpenBatch() const noexcept { return !m_openCopies.empty(); }
+
+        // Submits the open batch, if any, and releases the staging data of completed batches.
+        void Submit()
+        {
+            if (!m_openCopies.empty())
+            {
+                const uint64_t fenceValue = m_queue.Submit(std::span<const Copy>(m_openCopies));
+
+                m_submittedTicket += m_openCopies.size();
+                m_batches.push_back({ m_submittedTicket, fenceValue, std::move(m_openStaging) });
+
+                m_openCopies.clear();
+                m_openStaging.clear();
+            }
+
+            Retire();
+        }
+
+        // Releases the staging data of every batch whose fence value has completed.
+        void Retire()
+        {
+            const uint64_t completedValue = m_queue.GetCompletedValue();
+            while (!m_batches.empty() && m_batches.front().fenceValue <= completedValue)
+            {
+                m_completedTicket = m_batches.front().lastTicket;
+                m_batches.pop_front();
+            }
+        }
+
+        bool IsComplete(UploadTicket ticket) const noexcept
+        {
+            if (ticket <= m_completedTicket)
+            {
+                return true;
+            }
+
+            const Batch* batch = FindBatch(ticket);
+            return batch && batch->fenceValue <= m_queue.GetCompletedValue();
+        }
+
+        // Returns the fence value to wait on before using the destination of the copy, submitting its batch if still
+        // open, or 0 if the copy has completed or a wait covering it was already handed out.
+        uint64_t AcquireForUse(UploadTicket ticket)
+        {
+            if (ticket <= m_completedTicket)
+            {
+                return 0;
+            }
+
+            if (ticket > m_submittedTicket)
+            {
+                Submit();
+            }
+
+            const Batch* batch = FindBatch(ticket);
+            if (!batch || batch->fenceValue <= m_waitedFenceValue || batch->fenceValue <= m_queue.GetCompletedValue())
+            {
+                return 0;
+            }
+
+            m_waitedFenceValue = batch->fenceValue;
+            return batch->fenceValue;
+        }
+
+        // The fence value of the last submitted batch, or 0 if there is none in flight.
+        uint64_t GetLastFenceValue() const noexcept
+        {
+            return m_batches.empty() ? 0 : m_batches.back().fenceValue;
+        }
+
+        size_t GetPendingBatchCount() const noexcept { return m_batches.size(); }
+
+    private:
+        struct Batch
+        {
+            UploadTicket            lastTicket;
+            uint64_t                fenceValue;
+            std::vector<Staging>    staging;
+        };
+
+        const Batch* FindBatch(UploadTicket ticket) const noexcept
+        {
+            const auto batch = std::lower_bound(m_batches.cbegin(), m_batches.cend(), ticket,
+                [](const Batch& batch, UploadTicket ticket) { return batch.lastTicket < ticket; });
+            return batch == m_batches.cend() ? nullptr : &*batch;
+        }
+
+        Queue                   m_queue;
+
+        std::vector<Copy>       m_openCopies;
+        std::vector<Staging>    m_openStaging;
+
+        UploadTicket            m_submittedTicket;
+        UploadTicket            m_completedTicket;
+        uint64_t                m_waitedFenceValue;
+
+        std::deque<Batch>       m_batches;
+    };
+}
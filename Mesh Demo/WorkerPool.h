@@ -0,0 +1,109 @@
+/*
+ * Header File: WorkerPool.h
+ * Last Update: 2026/10/18
+ *
+ * Copyright (C) Hydr10n@GitHub. All Rights Reserved.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Hydr10n::Rendering {
+	// Persistent threads that share the items of one job at a time with the calling thread; Run returns once every item is done.
+	class WorkerPool {
+	public:
+		// A thread count of 0 means one thread per hardware thread, the calling thread included.
+		explicit WorkerPool(uint32_t threadCount = 0) noexcept(false) {
+			if (!threadCount) threadCount = std::max(1u, std::thread::hardware_concurrency());
+
+			for (uint32_t i = 1; i < threadCount; i++) m_threads.emplace_back([this] { Work(); });
+		}
+
+		WorkerPool(const WorkerPool&) = delete;
+		WorkerPool& operator=(const WorkerPool&) = delete;
+
+		~WorkerPool() {
+			{
+				const std::scoped_lock lock(m_mutex);
+				m_isStopping = true;
+			}
+			m_jobChanged.notify_all();
+
+			for (auto& thread : m_threads) thread.join();
+		}
+
+		uint32_t GetThreadCount() const { return static_cast<uint32_t>(m_threads.size()) + 1; }
+
+		// Calls function(i) for every i in [0, itemCount), in any order and on any thread. function must not throw; Run must not be called from inside it.
+		template <typename Function>
+		void Run(uint32_t itemCount, const Function& function) {
+			if (m_threads.empty() || itemCount <= 1) {
+				for (uint32_t i = 0; i < itemCount; i++) function(i);
+				return;
+			}
+
+			{
+				const std::scoped_lock lock(m_mutex);
+				m_job = { [](const void* context, uint32_t item) { (*static_cast<const Function*>(context))(item); }, std::addressof(function) };
+				m_itemCount = itemCount;
+				m_nextItem.store(0, std::memory_order_relaxed);
+				m_activeThreadCount = static_cast<uint32_t>(m_threads.size());
+				m_generation++;
+			}
+			m_jobChanged.notify_all();
+
+			RunItems();
+
+			std::unique_lock lock(m_mutex);
+			m_jobDone.wait(lock, [&] { return !m_activeThreadCount; });
+			m_job = {};
+		}
+
+	private:
+		struct Job {
+			void (*Function)(const void*, uint32_t);
+			const void* Context;
+		};
+
+		std::vector<std::thread> m_threads;
+
+		std::mutex m_mutex;
+		std::condition_variable m_jobChanged, m_jobDone;
+		bool m_isStopping{};
+		uint64_t m_generation{};
+		uint32_t m_activeThreadCount{};
+
+		Job m_job{};
+		uint32_t m_itemCount{};
+		std::atomic<uint32_t> m_nextItem;
+
+		void RunItems() {
+			for (uint32_t item; (item = m_nextItem.fetch_add(1, std::memory_order_relaxed)) < m_itemCount;) m_job.Function(m_job.Context, item);
+		}
+
+		void Work() {
+			for (uint64_t generation = 0;;) {
+				{
+					std::unique_lock lock(m_mutex);
+					m_jobChanged.wait(lock, [&] { return m_isStopping || m_generation != generation; });
+					if (m_isStopping) return;
+
+					generation = m_generation;
+				}
+
+				RunItems();
+
+				const std::scoped_lock lock(m_mutex);
+				if (!--m_activeThreadCount) m_jobDone.notify_one();
+			}
+		}
+	};
+}
@@ -0,0 +1,18 @@
+#include "AllocationCounter.h"
+
+#include <cstdlib>
+#include <new>
+
+// Global operator new and delete, replaced to feed AllocationCounter; the array and nothrow forms call these.
+void* operator new(std::size_t size) {
+	Hydr10n::Benchmarks::AllocationCounter::Record(size);
+
+	if (const auto pointer = std::malloc(size ? size : 1)) return pointer;
+	throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept { std::free(pointer); }
+
+void operator delete(void* pointer, std::size_t) noexcept { std::free(pointer); }
+
+static const bool s_isAllocationCounterAvailable = (Hydr10n::Benchmarks::AllocationCounter::IsAvailable = true);
@@ -0,0 +1,99 @@
+#include "Test.h"
+
+#include "CameraPath.h"
+
+#include <sstream>
+
+using namespace DirectX;
+
+namespace {
+	DX::CameraPath CreateCameraPath(const char* keyframes) {
+		std::istringstream stream(keyframes);
+		return DX::CameraPath::CreateFromStream(stream);
+	}
+
+	struct Sample {
+		XMFLOAT3 Focus;
+		XMVECTOR Rotation;
+		float Radius;
+	};
+
+	Sample Evaluate(const DX::CameraPath& cameraPath, double time) {
+		Sample sample;
+		XMVECTOR focus;
+		cameraPath.Evaluate(time, focus, sample.Rotation, sample.Radius);
+		XMStoreFloat3(&sample.Focus, focus);
+		return sample;
+	}
+
+	// Whether the sample is the keyframe, with q and -q being the same rotation.
+	bool IsAt(const Sample& sample, const DX::CameraPath::Keyframe& keyframe) {
+		const auto rotation = XMQuaternionNormalize(XMLoadFloat4(&keyframe.rotation));
+		return std::abs(sample.Focus.x - keyframe.focus.x) < 1e-5f && std::abs(sample.Focus.y - keyframe.focus.y) < 1e-5f && std::abs(sample.Focus.z - keyframe.focus.z) < 1e-5f
+			&& std::abs(sample.Radius - keyframe.radius) < 1e-5f
+			&& std::abs(XMVectorGetX(XMVector4Dot(sample.Rotation, rotation))) > 1 - 1e-5f;
+	}
+
+	// Quarter turns about Y, one per second, with the focus moving along X at constant speed and the radius shrinking.
+	constexpr auto Keyframes =
+		"# time  focus  rotation  radius\n"
+		"0  0 0 0  0 0 0 1                  8\n"
+		"1  1 0 0  0 0.7071068 0 0.7071068  7   # a quarter turn\n"
+		"\n"
+		"2  2 0 0  0 1 0 0                  6\n"
+		"3  3 0 0  0 0.7071068 0 -0.7071068 5\n";
+}
+
+TEST(CameraPathPassesThroughKeyframes) {
+	const auto cameraPath = CreateCameraPath(Keyframes);
+
+	const auto& keyframes = cameraPath.GetKeyframes();
+	CHECK(keyframes.size() == 4);
+	CHECK(cameraPath.GetDuration() == 3);
+
+	for (const auto& keyframe : keyframes) CHECK(IsAt(Evaluate(cameraPath, keyframe.time), keyframe));
+
+	// Held before the first keyframe and after the last.
+	CHECK(IsAt(Evaluate(cameraPath, -10), keyframes.front()));
+	CHECK(IsAt(Evaluate(cameraPath, 100), keyframes.back()));
+
+	// Between keyframes spaced evenly along a line, Catmull-Rom keeps to the line; squad turns halfway between the quarter turns.
+	const auto sample = Evaluate(cameraPath, 1.5);
+	CHECK_NEAR(sample.Focus.x, 1.5f, 1e-5f);
+	CHECK_NEAR(sample.Focus.y, 0.0f, 1e-5f);
+	CHECK_NEAR(sample.Radius, 6.5f, 1e-5f);
+
+	const auto halfway = XMVectorSet(0, std::sin(XM_PI * 3 / 8), 0, std::cos(XM_PI * 3 / 8));
+	CHECK_NEAR(std::abs(XMVectorGetX(XMVector4Dot(sample.Rotation, halfway))), 1.0f, 1e-4f);
+	CHECK_NEAR(XMVectorGetX(XMVector4Dot(sample.Rotation, sample.Rotation)), 1.0f, 1e-5f);
+}
+
+TEST(CameraPathHoldsSingleKeyframe) {
+	const auto cameraPath = CreateCameraPath("2 1 2 3 0 0 0 2 4\n");
+	CHECK(cameraPath.GetDuration() == 2);
+
+	// The rotation comes back normalized.
+	const DX::CameraPath::Keyframe keyframe{ 2, { 1, 2, 3 }, { 0, 0, 0, 1 }, 4 };
+	for (const auto time : { -1.0, 0.0, 2.0, 5.0 }) CHECK(IsAt(Evaluate(cameraPath, time), keyframe));
+
+	XMVECTOR focus, rotation;
+	float radius;
+	CHECK_THROWS(std::logic_error, DX::CameraPath().Evaluate(0, focus, rotation, radius));
+}
+
+TEST(CameraPathRejectsInvalidKeyframes) {
+	// Missing, malformed and extra fields.
+	CHECK_THROWS(std::runtime_error, CreateCameraPath("0 0 0 0 0 0 0 1\n"));
+	CHECK_THROWS(std::runtime_error, CreateCameraPath("0 0 0 zero 0 0 0 1 4\n"));
+	CHECK_THROWS(std::runtime_error, CreateCameraPath("zero 0 0 0 0 0 0 1 4\n"));
+	CHECK_THROWS(std::runtime_error, CreateCameraPath("0 0 0 0 0 0 0 1 4 5\n"));
+	CHECK_THROWS(std::runtime_error, CreateCameraPath("0 0 0 0 0 0 0 1 4\n1 0 0 0 0 0 0 1 4 # fine\n2 0 0 0 0 0 0 1 4 x\n"));
+
+	// Times that do not strictly increase, and no keyframes at all.
+	CHECK_THROWS(std::invalid_argument, CreateCameraPath("1 0 0 0 0 0 0 1 4\n1 0 0 0 0 0 0 1 4\n"));
+	CHECK_THROWS(std::invalid_argument, CreateCameraPath("2 0 0 0 0 0 0 1 4\n1 0 0 0 0 0 0 1 4\n"));
+	CHECK_THROWS(std::invalid_argument, CreateCameraPath("# nothing but comments\n\n"));
+	CHECK_THROWS(std::invalid_argument, DX::CameraPath(std::vector<DX::CameraPath::Keyframe>()));
+
+	CHECK_THROWS(std::runtime_error, DX::CameraPath::CreateFromFile(Hydr10n::Tests::CreateTemporaryDirectory("CameraPath") / "missing.txt"));
+}
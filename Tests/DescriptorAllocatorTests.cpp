@@ -0,0 +1,89 @@
+#include "Test.h"
+
+#include "DescriptorBenchmark.h"
+
+#include <iostream>
+#include <set>
+
+using namespace Hydr10n::Benchmarks;
+
+TEST(DescriptorIndexAllocatorHandsOutEveryIndexOnce) {
+	DX::DescriptorIndexAllocator allocator(100, 10);
+	CHECK(allocator.GetPersistentCount() == 100 && allocator.GetTransientCount() == 10);
+
+	std::vector<DX::DescriptorHandle> handles;
+	std::set<uint32_t> indices;
+	for (auto i = 0; i < 100; i++) {
+		const auto handle = handles.emplace_back(allocator.AllocatePersistent());
+		CHECK(!handle.IsNull() && handle.index < 100);
+		indices.insert(handle.index);
+	}
+	CHECK(indices.size() == 100);
+	CHECK(allocator.AllocatePersistent().IsNull());
+
+	// A freed index is the only one left to reuse.
+	allocator.FreePersistent(handles[5]);
+	const auto reused = allocator.AllocatePersistent();
+	CHECK(reused.index == handles[5].index);
+
+#ifdef _DEBUG
+	// Handles from before the index was freed are caught.
+	CHECK(reused.generation == handles[5].generation + 1);
+	CHECK_THROWS(std::logic_error, allocator.Validate(handles[5]));
+	CHECK_THROWS(std::logic_error, allocator.FreePersistent(handles[5]));
+	CHECK_THROWS(std::logic_error, allocator.Validate({}));
+	allocator.FreePersistent(reused);
+	CHECK_THROWS(std::logic_error, allocator.FreePersistent(reused));
+#endif
+
+	CHECK_THROWS(std::out_of_range, DX::DescriptorIndexAllocator(UINT32_MAX, 0));
+	CHECK_THROWS(std::out_of_range, DX::DescriptorIndexAllocator(64, UINT32_MAX - 64));
+}
+
+TEST(DescriptorIndexAllocatorReclaimsTransientRanges) {
+	DX::DescriptorIndexAllocator allocator(64, 10);
+
+	// Transient indices follow the persistent ones.
+	CHECK(allocator.AllocateTransient(4) == 64);
+	CHECK(allocator.AllocateTransient(4) == 68);
+	CHECK(allocator.AllocateTransient(4) == DX::DescriptorHandle::c_InvalidIndex);
+	allocator.EndFrame(1);
+
+	// The frame's ranges stay in use until its fence value completes.
+	allocator.Reclaim(0);
+	CHECK(allocator.AllocateTransient(4) == DX::DescriptorHandle::c_InvalidIndex);
+	allocator.Reclaim(1);
+	CHECK(allocator.AllocateTransient(4) != DX::DescriptorHandle::c_InvalidIndex);
+
+	// Without a transient region nothing is handed out.
+	CHECK(DX::DescriptorIndexAllocator(64, 0).AllocateTransient(1) == DX::DescriptorHandle::c_InvalidIndex);
+}
+
+TEST(DescriptorBenchmarkNeverRunsOut) {
+	DescriptorBenchmark::Options options;
+	options.BatchCount = 200;
+	options.FrameCount = 50;
+
+	// Every thread takes its share of both regions at once; no allocation fails, whatever the thread count.
+	for (const auto threadCount : { 1u, 4u }) {
+		options.ThreadCount = threadCount;
+		const auto result = DescriptorBenchmark::Run(options);
+		CHECK(result.ThreadCount == threadCount);
+		CHECK(result.PersistentAllocationCount == static_cast<uint64_t>(threadCount) * options.BatchCount * options.BatchSize);
+		CHECK(result.TransientAllocationCount > 0 && result.TransientFailureCount == 0);
+	}
+
+	CHECK_THROWS(std::invalid_argument, DescriptorBenchmark::Run(DescriptorBenchmark::Options{ .BatchSize = 0 }));
+	CHECK_THROWS(std::invalid_argument, DescriptorBenchmark::Run(DescriptorBenchmark::Options{ .ThreadCount = 4, .PersistentCount = 2, .BatchSize = 1 }));
+}
+
+BENCHMARK(DescriptorAllocation) {
+	for (const auto threadCount : { 1u, 0u }) {
+		DescriptorBenchmark::Options options;
+		options.ThreadCount = threadCount;
+
+		const auto result = DescriptorBenchmark::Run(options);
+		std::cout << result.ThreadCount << " thread(s): " << result.PersistentAllocationsPerSecond / 1e6 << " M persistent, " << result.TransientAllocationsPerSecond / 1e6
+			<< " M transient allocations per second, " << result.TransientFailureCount << " transient allocation(s) failed\n";
+	}
+}
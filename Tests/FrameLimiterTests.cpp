@@ -0,0 +1,105 @@
+#include "Test.h"
+
+#include "FrameLimiter.h"
+
+namespace {
+	using VirtualFrameLimiter = DX::BasicFrameLimiter<DX::VirtualClock>;
+
+	// 100 frames per second on the default 10 MHz clock.
+	constexpr uint64_t TargetCounts = 100000;
+
+	// Spends counts on a frame, then waits for the next one and returns the clock.
+	uint64_t RunFrame(VirtualFrameLimiter& limiter, uint64_t counts) {
+		limiter.GetClock().Advance(counts);
+		limiter.Wait();
+		return limiter.GetClock().GetCount();
+	}
+}
+
+TEST(FrameLimiterWaitsForDeadlines) {
+	VirtualFrameLimiter limiter;
+
+	// Turned off, waiting takes no time.
+	CHECK(RunFrame(limiter, 1234) == 1234);
+	CHECK(limiter.GetStatistics().frameCount == 0);
+
+	limiter.SetTargetElapsedSeconds(0.01);
+	CHECK(limiter.GetTargetElapsedSeconds() == 0.01);
+
+	// The first wait starts the schedule without waiting; every later one returns exactly on its deadline, whatever the frame took.
+	const auto start = RunFrame(limiter, 0);
+	CHECK(start == 1234);
+	for (uint64_t i = 1; i <= 10; i++) CHECK(RunFrame(limiter, i * 7000) == start + i * TargetCounts);
+
+	const auto statistics = limiter.GetStatistics();
+	CHECK(statistics.frameCount == 10 && statistics.lateFrameCount == 0);
+	CHECK(statistics.meanJitterSeconds == 0 && statistics.rmsJitterSeconds == 0 && statistics.maxJitterSeconds == 0);
+
+	limiter.ResetStatistics();
+	CHECK(limiter.GetStatistics().frameCount == 0);
+}
+
+TEST(FrameLimiterReschedulesLateFrames) {
+	VirtualFrameLimiter limiter;
+	limiter.SetTargetElapsedSeconds(0.01);
+
+	const auto start = RunFrame(limiter, 0);
+	CHECK(RunFrame(limiter, 0) == start + TargetCounts);
+
+	// A frame late by less than the target returns at once and the next one makes up for it, keeping to the schedule.
+	CHECK(RunFrame(limiter, TargetCounts * 3 / 2) == start + TargetCounts * 5 / 2);
+	CHECK(RunFrame(limiter, 0) == start + TargetCounts * 3);
+
+	// A frame late by more than the target starts a new schedule rather than letting the next frames run back to back to catch up.
+	const auto late = RunFrame(limiter, TargetCounts * 7 / 2);
+	CHECK(late == start + TargetCounts * 13 / 2);
+	CHECK(RunFrame(limiter, 0) == late + TargetCounts);
+	CHECK(RunFrame(limiter, 0) == late + TargetCounts * 2);
+
+	const auto statistics = limiter.GetStatistics();
+	CHECK(statistics.frameCount == 6 && statistics.lateFrameCount == 2);
+	CHECK(statistics.maxJitterSeconds == 0);
+}
+
+TEST(FrameLimiterResetsSchedule) {
+	VirtualFrameLimiter limiter;
+	limiter.SetTargetElapsedSeconds(0.01);
+
+	const auto start = RunFrame(limiter, 0);
+	CHECK(RunFrame(limiter, 0) == start + TargetCounts);
+
+	// After a pause the next wait starts over from where it is, neither waiting nor counting the frame as late.
+	limiter.ResetSchedule();
+	const auto resumed = RunFrame(limiter, TargetCounts * 50);
+	CHECK(resumed == start + TargetCounts * 51);
+	CHECK(RunFrame(limiter, 0) == resumed + TargetCounts);
+	CHECK(limiter.GetStatistics().frameCount == 2 && limiter.GetStatistics().lateFrameCount == 0);
+
+	// So does a new target.
+	limiter.SetTargetElapsedSeconds(0.02);
+	const auto retargeted = RunFrame(limiter, TargetCounts * 5);
+	CHECK(retargeted == resumed + TargetCounts * 6);
+	CHECK(RunFrame(limiter, 0) == retargeted + TargetCounts * 2);
+	CHECK(limiter.GetStatistics().lateFrameCount == 0);
+}
+
+TEST(FrameLimiterKeepsTimeOnSteadyClock) {
+	DX::BasicFrameLimiter<DX::SteadyClock> limiter;
+	limiter.SetTargetElapsedSeconds(0.002);
+
+	constexpr uint64_t Target = 2000000, FrameCount = 50;
+
+	const auto start = limiter.GetClock().GetCount();
+	limiter.Wait();
+	for (uint64_t i = 0; i < FrameCount; i++) limiter.Wait();
+	const auto elapsed = limiter.GetClock().GetCount() - start;
+
+	// Frames never come early; the bounds on lateness are loose enough for a busy machine.
+	CHECK(elapsed >= Target * FrameCount);
+	CHECK(elapsed < Target * FrameCount * 2);
+
+	const auto statistics = limiter.GetStatistics();
+	CHECK(statistics.frameCount == FrameCount);
+	CHECK(statistics.lateFrameCount < FrameCount / 2);
+	CHECK(statistics.meanJitterSeconds < 0.001 && statistics.maxJitterSeconds < 0.01);
+}
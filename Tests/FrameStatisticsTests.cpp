@@ -0,0 +1,135 @@
+#include "Test.h"
+
+#include "StepTimer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <thread>
+
+namespace {
+	constexpr auto TicksPerSecond = DX::FrameStatistics::TicksPerSecond;
+}
+
+TEST(FrameStatisticsSummaries) {
+	DX::FrameStatistics frameStatistics(TicksPerSecond / 60);
+
+	CHECK(frameStatistics.GetSummary().frameCount == 0);
+	CHECK(frameStatistics.GetRecentSummary().frameCount == 0);
+
+	// 1024 frames of 1 ms, then 1 to 100 ms shuffled, of which the 84 from 17 ms on are over the budget of 16.7 ms.
+	std::vector<uint64_t> ticks;
+	for (uint64_t i = 1; i <= 100; i++) ticks.push_back(i * TicksPerSecond / 1000);
+	std::shuffle(ticks.begin(), ticks.end(), std::mt19937(4));
+
+	for (auto i = 0; i < 1024; i++) frameStatistics.AddFrame(TicksPerSecond / 1000);
+	for (const auto t : ticks) frameStatistics.AddFrame(t);
+
+	const auto recent = frameStatistics.GetRecentSummary();
+	CHECK(recent.frameCount == DX::FrameStatistics::c_HistoryLength);
+	CHECK(recent.framesOverBudget == 84);
+	CHECK_NEAR(recent.maxSeconds, 0.1, 1e-12);
+	CHECK_NEAR(recent.p99Seconds, 0.09, 1e-12);
+	CHECK_NEAR(recent.p95Seconds, 0.049, 1e-12);
+
+	const auto all = frameStatistics.GetSummary();
+	CHECK(all.frameCount == 1124);
+	CHECK(all.framesOverBudget == 84);
+	CHECK_NEAR(all.minSeconds, 0.001, 1e-12);
+	CHECK_NEAR(all.maxSeconds, 0.1, 1e-12);
+	CHECK_NEAR(all.averageSeconds, (1024 * 0.001 + 5.05) / 1124, 1e-9);
+	CHECK_NEAR(all.p50Seconds, 0.001, 0.001 * 0.02);
+	CHECK_NEAR(all.p99Seconds, 0.089, 0.089 * 0.02);
+}
+
+TEST(FrameStatisticsBuckets) {
+	// Buckets tile the range without gaps, and every value lands in the bucket whose bounds hold it.
+	for (size_t i = 0; i + 1 < DX::FrameStatistics::c_BucketCount; i++) {
+		CHECK(DX::FrameStatistics::GetBucketUpperBound(i) + 1 == DX::FrameStatistics::GetBucketLowerBound(i + 1));
+	}
+
+	std::mt19937_64 random(5);
+	for (auto i = 0; i < 10000; i++) {
+		const auto ticks = random() >> (random() % 64);
+		const auto index = DX::FrameStatistics::GetBucketIndex(ticks);
+		CHECK(index < DX::FrameStatistics::c_BucketCount);
+		CHECK(ticks >= DX::FrameStatistics::GetBucketLowerBound(index) && ticks <= DX::FrameStatistics::GetBucketUpperBound(index));
+	}
+	CHECK(DX::FrameStatistics::GetBucketIndex(UINT64_MAX) == DX::FrameStatistics::c_BucketCount - 1);
+}
+
+TEST(FrameStatisticsExports) {
+	DX::FrameStatistics frameStatistics;
+	for (uint64_t i = 0; i < 2000; i++) frameStatistics.AddFrame(TicksPerSecond / 100 + i);
+
+	std::ostringstream stream;
+	frameStatistics.WriteCsv(stream);
+	const auto csv = stream.str();
+	CHECK(std::count(csv.cbegin(), csv.cend(), '\n') == DX::FrameStatistics::c_HistoryLength + 1);
+	CHECK(csv.starts_with("Frame,Milliseconds\n976,"));
+
+	stream.str({});
+	frameStatistics.WriteJson(stream);
+	const auto json = stream.str();
+	CHECK(json.find("\"all\": { \"frames\": 2000, \"overBudget\": 0") != std::string::npos);
+	CHECK(json.find("\"histogram\": [\n") != std::string::npos);
+}
+
+TEST(FrameStatisticsConcurrentReads) {
+	DX::FrameStatistics frameStatistics;
+
+	// Every frame takes the same time, so any torn snapshot shows as a different average or maximum.
+	std::atomic<bool> isDone{};
+	std::atomic<uint64_t> snapshotCount{};
+	uint64_t tornSnapshotCount = 0;
+	std::thread reader([&] {
+		while (!isDone) {
+			const auto summary = frameStatistics.GetSummary();
+			if (summary.frameCount && !(summary.minSeconds == 0.01 && summary.averageSeconds == 0.01 && summary.maxSeconds == 0.01)) tornSnapshotCount++;
+			snapshotCount++;
+		}
+	});
+
+	// Readers retry while a frame is being added, so frames are added in bursts with the writer yielding in between.
+	while (snapshotCount < 1000) {
+		for (auto i = 0; i < 100; i++) frameStatistics.AddFrame(TicksPerSecond / 100);
+		std::this_thread::yield();
+	}
+
+	isDone = true;
+	reader.join();
+
+	CHECK(!tornSnapshotCount);
+}
+
+// The time StepTimer::Tick spends feeding the statistics, which should stay under 50 ns per frame.
+BENCHMARK(FrameStatisticsOverhead) {
+	constexpr auto FrameCount = 10000000;
+
+	const auto Measure = [](DX::FrameStatistics* pFrameStatistics) {
+		DX::BasicStepTimer<DX::VirtualClock> timer;
+		timer.SetFrameStatistics(pFrameStatistics);
+
+		uint64_t updateCount = 0;
+		const auto start = std::chrono::steady_clock::now();
+		for (auto i = 0; i < FrameCount; i++) {
+			timer.GetClock().Advance(TicksPerSecond / 60 + i % 1000);
+			timer.Tick([&] { updateCount++; });
+		}
+		const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+
+		CHECK(updateCount == FrameCount);
+		return elapsed.count() / FrameCount;
+	};
+
+	DX::FrameStatistics frameStatistics;
+	const auto baseline = Measure(nullptr), withStatistics = Measure(&frameStatistics);
+
+	std::cout << "Tick: " << baseline << " ns, with statistics: " << withStatistics << " ns, overhead: " << withStatistics - baseline << " ns per frame\n";
+
+	CHECK(frameStatistics.GetSummary().frameCount == FrameCount);
+	CHECK(withStatistics - baseline < 50);
+}
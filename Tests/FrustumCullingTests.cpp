@@ -0,0 +1,125 @@
+#include "Test.h"
+
+#include "FrustumCullingBenchmark.h"
+
+#include <bit>
+#include <iostream>
+#include <random>
+
+using namespace DirectX;
+using Hydr10n::Benchmarks::FrustumCullingBenchmark;
+
+namespace {
+	// The planes of one view of a multi-view frustum, for the single-view kernels.
+	DX::FrustumPlanes GetViewPlanes(const DX::MultiViewFrustum& frustum, size_t view) {
+		DX::FrustumPlanes planes;
+		for (size_t i = 0; i < 6; i++) {
+			planes.x[i] = frustum.x[i][view];
+			planes.y[i] = frustum.y[i][view];
+			planes.z[i] = frustum.z[i][view];
+			planes.w[i] = frustum.w[i][view];
+		}
+		return planes;
+	}
+}
+
+TEST(FrustumCullingMatchesScalar) {
+	// Counts that leave a tail of every length after the SIMD groups.
+	FrustumCullingBenchmark::Options options;
+	options.ObjectCounts = { 0, 1, 7, 9, 1000, 1003 };
+	options.MinSeconds = 0;
+
+	for (const auto& result : FrustumCullingBenchmark::Run(options)) {
+		CHECK(result.MismatchCount <= result.ObjectCount / 1000);
+		if (result.ObjectCount >= 1000) CHECK(result.VisibleCount > 0 && result.VisibleCount < result.ObjectCount / 2);
+	}
+}
+
+TEST(MultiViewCullingMatchesSingleViews) {
+	std::mt19937 random(5);
+	std::uniform_real_distribution<float> positions(-20, 20), sizes(0.1f, 2), angles(-XM_PI, XM_PI);
+
+	// Counts that leave a tail of every length after the SIMD groups, and a partly filled last visibility word.
+	for (const size_t count : { 0, 1, 7, 9, 70, 1003 }) {
+		std::vector<BoundingSphere> spheres(count);
+		std::vector<BoundingBox> boxes(count);
+		for (size_t i = 0; i < count; i++) {
+			spheres[i] = { { positions(random), positions(random), positions(random) }, sizes(random) };
+			boxes[i] = { { positions(random), positions(random), positions(random) }, { sizes(random), sizes(random), sizes(random) } };
+		}
+
+		// View counts that fill one SIMD group of views, leave padding in it, or spill into the next.
+		for (const auto viewCount : std::initializer_list<size_t>{ 2, 3, 5, DX::MultiViewFrustum::c_MaxViews }) {
+			std::vector<XMMATRIX> viewProjections;
+			for (size_t v = 0; v < viewCount; v++) {
+				const auto eye = XMVectorSet(positions(random) / 4, positions(random) / 4, positions(random) / 4, 1);
+				const auto direction = XMVectorSet(std::cos(angles(random)), angles(random) / 8, std::sin(angles(random)), 0);
+				const auto view = XMMatrixLookAtRH(eye, XMVectorAdd(eye, direction), XMVectorSet(0, 1, 0, 0));
+				viewProjections.push_back(XMMatrixMultiply(view, XMMatrixPerspectiveFovRH(XM_PIDIV4, 1 + v * 0.25f, 0.1f, 30)));
+			}
+
+			const auto frustum = DX::MultiViewFrustum::CreateFromMatrices(viewProjections.data(), viewCount);
+			CHECK(frustum.viewCount == viewCount);
+
+			// Rows for every view there could be: those past the view count must be left alone.
+			const auto wordCount = (count + 31) / 32;
+			constexpr uint32_t Untouched = 0xdeadbeef;
+			std::vector<uint32_t> sphereVisibility[DX::MultiViewFrustum::c_MaxViews], boxVisibility[DX::MultiViewFrustum::c_MaxViews];
+			uint32_t* sphereRows[DX::MultiViewFrustum::c_MaxViews];
+			uint32_t* boxRows[DX::MultiViewFrustum::c_MaxViews];
+			for (size_t v = 0; v < DX::MultiViewFrustum::c_MaxViews; v++) {
+				sphereVisibility[v].assign(wordCount + 1, Untouched);
+				boxVisibility[v].assign(wordCount + 1, Untouched);
+				sphereRows[v] = sphereVisibility[v].data();
+				boxRows[v] = boxVisibility[v].data();
+			}
+
+			DX::CullSpheres(frustum, spheres.data(), count, sphereRows);
+			DX::CullBoxes(frustum, boxes.data(), count, boxRows);
+
+			for (size_t v = 0; v < DX::MultiViewFrustum::c_MaxViews; v++) {
+				if (v >= viewCount) {
+					CHECK(std::all_of(sphereVisibility[v].cbegin(), sphereVisibility[v].cend(), [](uint32_t word) { return word == Untouched; }));
+					CHECK(std::all_of(boxVisibility[v].cbegin(), boxVisibility[v].cend(), [](uint32_t word) { return word == Untouched; }));
+					continue;
+				}
+
+				// The same planes through the single-view kernels set exactly the same bits, and nothing past the count.
+				const auto planes = GetViewPlanes(frustum, v);
+				std::vector<uint32_t> expected(wordCount + 1, Untouched);
+				DX::CullSpheres(planes, spheres.data(), count, expected.data());
+				CHECK(sphereVisibility[v] == expected);
+				DX::CullBoxes(planes, boxes.data(), count, expected.data());
+				CHECK(boxVisibility[v] == expected);
+				if (count == 1003) {
+					size_t visibleCount = 0;
+					for (size_t i = 0; i < wordCount; i++) visibleCount += std::popcount(sphereVisibility[v][i]) + std::popcount(boxVisibility[v][i]);
+					CHECK(visibleCount > 0 && visibleCount < count);
+				}
+				if (count % 32) CHECK((sphereVisibility[v][wordCount - 1] | boxVisibility[v][wordCount - 1]) >> (count % 32) == 0);
+
+				// And they are the planes each view would have on its own, up to rounding in the normalization.
+				const auto ownPlanes = DX::FrustumPlanes::CreateFromMatrix(viewProjections[v]);
+				for (size_t i = 0; i < 6; i++) {
+					CHECK_NEAR(planes.x[i], ownPlanes.x[i], 1e-5f);
+					CHECK_NEAR(planes.y[i], ownPlanes.y[i], 1e-5f);
+					CHECK_NEAR(planes.z[i], ownPlanes.z[i], 1e-5f);
+					CHECK_NEAR(planes.w[i], ownPlanes.w[i], 1e-4f);
+				}
+			}
+		}
+	}
+
+	const std::vector<XMMATRIX> tooMany(DX::MultiViewFrustum::c_MaxViews + 1, XMMatrixIdentity());
+	CHECK_THROWS(std::out_of_range, DX::MultiViewFrustum::CreateFromMatrices(tooMany.data(), tooMany.size()));
+}
+
+BENCHMARK(FrustumCullingThroughput) {
+	for (const auto& result : FrustumCullingBenchmark::Run()) {
+		std::cout << result.ObjectCount << ' ' << FrustumCullingBenchmark::VolumeNames[static_cast<size_t>(result.Volume)] << ": "
+			<< result.ScalarNanosecondsPerObject << " ns scalar, " << result.BatchNanosecondsPerObject << " ns batch per object ("
+			<< result.GetSpeedup() << "x), " << result.VisibleCount << " visible, " << result.MismatchCount << " mismatched\n";
+
+		CHECK(result.MismatchCount <= result.ObjectCount / 1000);
+	}
+}
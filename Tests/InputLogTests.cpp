@@ -0,0 +1,137 @@
+#include "Test.h"
+
+#include "InputLog.h"
+
+#include <cstddef>
+#include <iterator>
+#include <random>
+#include <span>
+#include <string>
+
+using namespace DirectX;
+using namespace Hydr10n::Inputs;
+
+namespace {
+	// Frames as InputFrame::Capture leaves them, with input that changes only now and then, as it does at a fixed timestep.
+	std::vector<InputFrame> CreateFrames(size_t count) {
+		std::mt19937 random(7);
+		std::uniform_real_distribution<float> axes(-1, 1);
+		std::uniform_int_distribution<int> keys(0, 255), positions(0, 1000), changes(0, 3);
+
+		std::vector<InputFrame> frames(count);
+		InputFrame frame;
+		std::memset(&frame, 0, sizeof(frame));
+		frame.ElapsedTicks = 166666;
+		for (auto& recordedFrame : frames) {
+			if (!changes(random)) frame.ElapsedTicks = 166666 + positions(random);
+
+			if (!changes(random)) {
+				auto& gamepad = frame.GamePads[1];
+				gamepad.connected = true;
+				gamepad.packet++;
+				gamepad.buttons.a = !gamepad.buttons.a;
+				gamepad.dpad.left = positions(random) % 2;
+				gamepad.thumbSticks = { axes(random), axes(random), axes(random), axes(random) };
+				gamepad.triggers = { axes(random), axes(random) };
+			}
+
+			// Keyboard states are one bit per virtual key.
+			if (!changes(random)) reinterpret_cast<uint8_t*>(&frame.Keyboard)[keys(random) / 8] ^= static_cast<uint8_t>(1 << keys(random) % 8);
+
+			if (!changes(random)) {
+				frame.Mouse.leftButton = !frame.Mouse.leftButton;
+				frame.Mouse.x = positions(random);
+				frame.Mouse.y = positions(random);
+				frame.Mouse.scrollWheelValue += 120;
+			}
+
+			std::memcpy(&recordedFrame, &frame, sizeof(frame));
+		}
+		return frames;
+	}
+
+	void Record(const std::filesystem::path& path, std::span<const InputFrame> frames) {
+		InputRecorder recorder(path);
+		for (const auto& frame : frames) recorder.Write(frame);
+	}
+
+	std::string GetReplayError(const std::filesystem::path& path) {
+		try {
+			InputReplayer replayer(path);
+			for (InputFrame frame; replayer.Read(frame);) {}
+		}
+		catch (const std::runtime_error& e) { return e.what(); }
+		return {};
+	}
+
+	// Overwrites bytes of a log in place.
+	void Patch(const std::filesystem::path& path, std::streamoff offset, const void* data, size_t size) {
+		std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+		file.seekp(offset);
+		file.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+	}
+}
+
+TEST(InputLogReplaysFramesExactly) {
+	const auto directory = Hydr10n::Tests::CreateTemporaryDirectory("InputLog");
+	const auto frames = CreateFrames(200);
+
+	const auto path = directory / "input.log";
+	Record(path, frames);
+
+	// Every frame comes back byte for byte, padding included, and then the log ends.
+	InputReplayer replayer(path);
+	InputFrame frame;
+	for (const auto& recordedFrame : frames) {
+		CHECK(replayer.Read(frame));
+		CHECK(frame.ElapsedTicks == recordedFrame.ElapsedTicks);
+		CHECK(!std::memcmp(&frame, &recordedFrame, sizeof(frame)));
+	}
+	CHECK(!replayer.Read(frame));
+
+	// Updates with unchanged input cost only their change mask.
+	auto idleFrames = frames;
+	idleFrames.insert(idleFrames.cend(), 10, frames.back());
+	const auto idlePath = directory / "idle.log";
+	Record(idlePath, idleFrames);
+	CHECK(std::filesystem::file_size(idlePath) == std::filesystem::file_size(path) + 10 * sizeof(uint16_t));
+
+	// Recording what was replayed reproduces the log.
+	const auto replayedPath = directory / "replayed.log";
+	{
+		InputReplayer logReplayer(path);
+		InputRecorder recorder(replayedPath);
+		for (InputFrame replayedFrame; logReplayer.Read(replayedFrame);) recorder.Write(replayedFrame);
+	}
+	std::ifstream log(path, std::ios::binary), replayedLog(replayedPath, std::ios::binary);
+	CHECK(std::vector<char>(std::istreambuf_iterator(log), {}) == std::vector<char>(std::istreambuf_iterator(replayedLog), {}));
+}
+
+TEST(InputLogRejectsOtherFiles) {
+	const auto directory = Hydr10n::Tests::CreateTemporaryDirectory("InputLog");
+	const auto frames = CreateFrames(20);
+
+	const auto path = directory / "input.log";
+	Record(path, frames);
+	CHECK(GetReplayError(path).empty());
+
+	Patch(path, offsetof(InputLog::Header, Magic), "MESH", 4);
+	CHECK(GetReplayError(path) == "Not an input log");
+
+	Record(path, frames);
+	constexpr uint16_t NextVersion = InputLog::Version + 1;
+	Patch(path, offsetof(InputLog::Header, Version), &NextVersion, sizeof(NextVersion));
+	CHECK(GetReplayError(path) == "Unsupported input log version");
+
+	// Cut inside the header, inside the first change mask and inside the last update.
+	for (const auto size : { sizeof(InputLog::Header) - 1, sizeof(InputLog::Header) + 1 }) {
+		Record(path, frames);
+		std::filesystem::resize_file(path, size);
+		CHECK(GetReplayError(path) == "Input log is truncated");
+	}
+	Record(path, frames);
+	std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+	CHECK(GetReplayError(path) == "Input log is truncated");
+
+	CHECK_THROWS(std::runtime_error, InputReplayer(directory / "missing.log"));
+}
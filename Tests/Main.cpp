@@ -0,0 +1,54 @@
+#include "Test.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <string_view>
+
+// Usage: Tests [-benchmark] [-filter <substring>] [-<option> <value>]...
+int main(int argc, char* argv[]) {
+	using namespace Hydr10n::Tests;
+
+	auto isRunningBenchmarks = false;
+	for (int i = 1; i < argc; i++) {
+		const std::string_view option = argv[i];
+		if (option == "-benchmark") isRunningBenchmarks = true;
+		else if (i + 1 < argc && option.size() > 1 && option[0] == '-') GetOptions()[std::string(option.substr(1))] = argv[++i];
+		else {
+			std::cerr << "Usage: [-benchmark] [-filter <substring>] [-<option> <value>]...\n";
+			return EXIT_FAILURE;
+		}
+	}
+
+	const auto filter = GetOption("filter");
+
+	size_t runCount = 0, failureCount = 0;
+	for (const auto& testCase : GetTestCases()) {
+		if (testCase.IsBenchmark != isRunningBenchmarks || std::string_view(testCase.Name).find(filter) == std::string_view::npos) continue;
+
+		runCount++;
+
+		std::cout << "[ RUN    ] " << testCase.Name << std::endl;
+
+		const auto start = std::chrono::steady_clock::now();
+
+		std::string failure;
+		try { testCase.Function(); }
+		catch (const std::exception& exception) { failure = exception.what(); }
+		catch (...) { failure = "Unknown exception"; }
+
+		const auto milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+		if (failure.empty()) std::cout << "[     OK ] " << testCase.Name << " (" << milliseconds << " ms)" << std::endl;
+		else {
+			failureCount++;
+
+			std::cout << failure << '\n' << "[ FAILED ] " << testCase.Name << " (" << milliseconds << " ms)" << std::endl;
+		}
+	}
+
+	std::cout << runCount - failureCount << " of " << runCount << (isRunningBenchmarks ? " benchmarks" : " tests") << " passed" << std::endl;
+
+	return failureCount ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,170 @@
+#include "Test.h"
+
+#include "MeshCodec.h"
+
+#include <chrono>
+#include <iostream>
+#include <random>
+
+using namespace DirectX;
+using namespace Hydr10n::Meshes;
+
+namespace {
+	// The demo sphere, as a triangle list.
+	void CreateSphere(MeshGenerator::VertexCollection& vertices, MeshGenerator::IndexCollection& indices, uint32_t semiCircleSliceCount = 200) {
+		std::vector<XMFLOAT2> points;
+		for (uint32_t i = 0; i <= semiCircleSliceCount; i++) {
+			const auto radians = -XM_PIDIV2 + XM_PI * static_cast<float>(i) / static_cast<float>(semiCircleSliceCount);
+			points.push_back({ std::cos(radians), std::sin(radians) });
+		}
+
+		MeshGenerator::CreateMeshAroundYAxis(vertices, indices, points.data(), points.size(), 1, semiCircleSliceCount * 2);
+	}
+
+	template <class T>
+	void Write(std::vector<std::byte>& data, size_t offset, const T& value) { std::memcpy(data.data() + offset, &value, sizeof(value)); }
+}
+
+TEST(MeshCodecIndexRoundTrip) {
+	MeshGenerator::VertexCollection vertices;
+	MeshGenerator::IndexCollection indices;
+	CreateSphere(vertices, indices, 24);
+
+	std::mt19937 random(1);
+	MeshGenerator::IndexCollection randomIndices(1000);
+	for (auto& index : randomIndices) index = random() >> (random() % 32);
+
+	// Every length up to a few groups, for the scalar prologue and tail around the SIMD loop.
+	for (const auto& source : { indices, randomIndices }) {
+		for (const auto deltaDistance : { 1u, 3u, 4u, 6u, 7u, 8u, 13u }) {
+			for (size_t count = 0; count <= source.size(); count += count < 40 ? 1 : 97) {
+				const std::span<const uint32_t> expected(source.data(), count);
+
+				MeshGenerator::IndexCollection decoded{ 42 };
+				MeshCodec::DecodeIndices(MeshCodec::EncodeIndices(expected, deltaDistance), decoded);
+				CHECK(std::equal(decoded.cbegin(), decoded.cend(), expected.begin(), expected.end()));
+			}
+		}
+	}
+
+	CHECK(MeshCodec::EncodeIndices(indices).size() * 3 < sizeof(indices[0]) * indices.size());
+
+	CHECK_THROWS(std::invalid_argument, MeshCodec::EncodeIndices(indices, 0));
+}
+
+TEST(MeshCodecVertexRoundTrip) {
+	MeshGenerator::VertexCollection vertices;
+	MeshGenerator::IndexCollection indices;
+	CreateSphere(vertices, indices, 24);
+
+	for (auto count = vertices.size(); ; count = count * 2 / 3) {
+		const MeshGenerator::VertexCollection expected(vertices.cbegin(), vertices.cbegin() + static_cast<ptrdiff_t>(count));
+
+		MeshGenerator::VertexCollection decoded;
+		MeshCodec::DecodeVertices(MeshCodec::EncodeVertices(expected), decoded);
+		CHECK(decoded.size() == expected.size());
+		CHECK(!std::memcmp(decoded.data(), expected.data(), sizeof(expected[0]) * expected.size()));
+
+		if (!count) break;
+	}
+
+	std::mt19937 random(2);
+	std::vector<std::byte> bytes(12 * 37);
+	for (auto& byte : bytes) byte = static_cast<std::byte>(random() % 4 ? 0 : random());
+
+	std::vector<std::byte> decoded;
+	CHECK(MeshCodec::DecodeVertices(MeshCodec::EncodeVertices(bytes, 12), decoded) == 12);
+	CHECK(decoded == bytes);
+
+	CHECK_THROWS(std::invalid_argument, MeshCodec::EncodeVertices(bytes, 6));
+	CHECK_THROWS(std::invalid_argument, MeshCodec::EncodeVertices(std::span(bytes).first(10), 4));
+}
+
+TEST(MeshCodecRejectsCorruptStreams) {
+	MeshGenerator::VertexCollection vertices;
+	MeshGenerator::IndexCollection indices;
+	CreateSphere(vertices, indices, 24);
+
+	MeshGenerator::IndexCollection decodedIndices;
+	MeshGenerator::VertexCollection decodedVertices;
+	std::vector<std::byte> decodedBytes;
+
+	auto encodedIndices = MeshCodec::EncodeIndices(indices);
+	for (const auto size : { size_t(0), size_t(7), size_t(8), encodedIndices.size() - 1 }) {
+		CHECK_THROWS(std::runtime_error, MeshCodec::DecodeIndices(std::span(encodedIndices).first(size), decodedIndices));
+	}
+
+	Write(encodedIndices, 4, 0u);
+	CHECK_THROWS(std::runtime_error, MeshCodec::DecodeIndices(encodedIndices, decodedIndices));
+
+	auto encodedVertices = MeshCodec::EncodeVertices(vertices);
+	for (const auto size : { size_t(0), size_t(7), size_t(8), encodedVertices.size() - 1 }) {
+		CHECK_THROWS(std::runtime_error, MeshCodec::DecodeVertices(std::span(encodedVertices).first(size), decodedVertices));
+	}
+
+	// Headers claiming more data than may be decoded are rejected before anything is allocated.
+	Write(encodedVertices, 0, 0xFFFFFFFFu);
+	Write(encodedVertices, 4, MeshCodec::MaxVertexStride);
+	CHECK_THROWS(std::runtime_error, MeshCodec::DecodeVertices(encodedVertices, decodedBytes));
+
+	Write(encodedVertices, 4, MeshCodec::MaxVertexStride + 4);
+	CHECK_THROWS(std::runtime_error, MeshCodec::DecodeVertices(encodedVertices, decodedBytes));
+
+	Write(encodedVertices, 4, 6u);
+	CHECK_THROWS(std::runtime_error, MeshCodec::DecodeVertices(encodedVertices, decodedBytes));
+
+	encodedVertices = MeshCodec::EncodeVertices(vertices);
+	Write(encodedVertices, 4, 12u);
+	CHECK_THROWS(std::runtime_error, MeshCodec::DecodeVertices(encodedVertices, decodedVertices));
+}
+
+TEST(MeshCodecFileRoundTrip) {
+	MeshGenerator::VertexCollection vertices;
+	MeshGenerator::IndexCollection indices;
+	CreateSphere(vertices, indices, 24);
+
+	const auto path = Hydr10n::Tests::CreateTemporaryDirectory("MeshCodec") / "mesh.bin";
+	MeshCodec::WriteEncoded(path, vertices, indices);
+
+	const MappedMeshFile file(path, true);
+	CHECK(file.GetVertices().empty() && file.GetIndices().empty());
+
+	MeshGenerator::VertexCollection loadedVertices;
+	MeshGenerator::IndexCollection loadedIndices;
+	MeshCodec::Load(file, loadedVertices, loadedIndices);
+	CHECK(loadedVertices.size() == vertices.size());
+	CHECK(!std::memcmp(loadedVertices.data(), vertices.data(), sizeof(vertices[0]) * vertices.size()));
+	CHECK(loadedIndices == indices);
+}
+
+BENCHMARK(MeshCodecDecodeThroughput) {
+	MeshGenerator::VertexCollection vertices;
+	MeshGenerator::IndexCollection indices;
+	CreateSphere(vertices, indices);
+
+	const auto encodedIndices = MeshCodec::EncodeIndices(indices), encodedVertices = MeshCodec::EncodeVertices(vertices);
+
+	const auto Measure = [](const char* name, size_t encodedSize, size_t decodedSize, const auto& decode) {
+		constexpr auto MinSeconds = 0.5;
+
+		uint64_t iterationCount = 0;
+		const auto start = std::chrono::steady_clock::now();
+		std::chrono::duration<double> elapsed;
+		do {
+			decode();
+			iterationCount++;
+		} while ((elapsed = std::chrono::steady_clock::now() - start).count() < MinSeconds);
+
+		std::cout << name << ": " << encodedSize << " -> " << decodedSize << " bytes ("
+			<< static_cast<double>(encodedSize) / static_cast<double>(decodedSize) * 100 << "%), "
+			<< static_cast<double>(decodedSize) * static_cast<double>(iterationCount) / elapsed.count() / 1e9 << " GB/s decoded\n";
+	};
+
+	MeshGenerator::IndexCollection decodedIndices;
+	Measure("Indices", encodedIndices.size(), sizeof(indices[0]) * indices.size(), [&] { MeshCodec::DecodeIndices(encodedIndices, decodedIndices); });
+	CHECK(decodedIndices == indices);
+
+	std::vector<std::byte> decodedVertices;
+	Measure("Vertices", encodedVertices.size(), sizeof(vertices[0]) * vertices.size(), [&] { MeshCodec::DecodeVertices(encodedVertices, decodedVertices); });
+	CHECK(!std::memcmp(decodedVertices.data(), vertices.data(), decodedVertices.size()));
+}
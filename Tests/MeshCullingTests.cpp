@@ -0,0 +1,148 @@
+#include "Test.h"
+
+#include "MeshCulling.h"
+#include "MeshScene.h"
+
+#include <random>
+
+using namespace DirectX;
+using namespace Hydr10n::Meshes;
+using namespace Hydr10n::Rendering;
+
+namespace {
+	void CreateChunks(MeshGenerator::ChunkCollection& chunks) {
+		constexpr uint32_t SemiCircleSliceCount = 24;
+
+		std::vector<XMFLOAT2> points;
+		for (uint32_t i = 0; i <= SemiCircleSliceCount; i++) {
+			const auto radians = -XM_PIDIV2 + XM_PI * static_cast<float>(i) / static_cast<float>(SemiCircleSliceCount);
+			points.push_back({ std::cos(radians), std::sin(radians) });
+		}
+
+		MeshGenerator::VertexCollection vertices;
+		MeshGenerator::IndexCollection indices, lineIndices;
+		MeshGenerator::CreateMeshAroundYAxis(vertices, indices, points.data(), points.size(), 1, SemiCircleSliceCount * 2, 0, &lineIndices, MeshGenerator::IndexTopology::TriangleList, &chunks, 16);
+	}
+
+	// The chunks whose index ranges were appended, by their start indices.
+	std::vector<bool> GetCulledChunks(const MeshGenerator::ChunkCollection& chunks, const std::vector<IndexRange>& ranges) {
+		std::vector<bool> isVisible(chunks.size());
+		for (size_t i = 0; i < chunks.size(); i++) {
+			for (const auto& range : ranges) {
+				if (chunks[i].IndexCount && chunks[i].StartIndex >= range.StartIndex && chunks[i].StartIndex < range.StartIndex + range.IndexCount) isVisible[i] = true;
+			}
+		}
+		return isVisible;
+	}
+}
+
+TEST(MeshCullingMatchesBatchViews) {
+	MeshGenerator::ChunkCollection chunks;
+	CreateChunks(chunks);
+
+	std::vector<BoundingBox> bounds;
+	for (const auto& chunk : chunks) bounds.push_back(chunk.Bounds);
+
+	std::mt19937 random(3);
+	std::uniform_real_distribution<float> angles(-XM_PI, XM_PI), distances(0.5f, 6);
+
+	for (auto i = 0; i < 200; i++) {
+		const auto world = XMMatrixMultiply(XMMatrixRotationY(angles(random)), XMMatrixTranslation(0, distances(random) - 3, 0));
+		const auto eye = XMVectorScale(XMVector3Normalize(XMVectorSet(angles(random), angles(random), angles(random), 0)), distances(random));
+		const auto view = XMMatrixLookAtRH(eye, XMVectorSet(angles(random) / 4, angles(random) / 4, 0, 1), XMVectorSet(0, 1, 0, 0));
+		const auto projection = i % 2 ? XMMatrixPerspectiveFovRH(XM_PIDIV4, 1.5f, 0.1f, 10) : XMMatrixPerspectiveFovLH(XM_PIDIV4, 1.5f, 0.1f, 10);
+
+		for (const auto cullBackFacing : { false, true }) {
+			std::vector<IndexRange> ranges, lineRanges;
+			ChunkCuller::Cull(chunks, world, view, projection, cullBackFacing, ranges, &lineRanges);
+
+			// What the scene does for several views at once.
+			const auto worldView = XMMatrixMultiply(world, view), worldViewProjection = XMMatrixMultiply(worldView, projection);
+			std::vector<uint32_t> visibility((chunks.size() + 31) / 32);
+			auto pVisibility = visibility.data();
+			DX::CullBoxes(DX::MultiViewFrustum::CreateFromMatrices(&worldViewProjection, 1), bounds.data(), bounds.size(), &pVisibility);
+
+			std::vector<IndexRange> expectedRanges;
+			ChunkCuller::Cull(chunks, visibility.data(), XMMatrixInverse(nullptr, worldView).r[3], cullBackFacing, expectedRanges);
+			CHECK(GetCulledChunks(chunks, ranges) == GetCulledChunks(chunks, expectedRanges));
+
+			// No chunk outside the frustum is drawn.
+			const auto planes = DX::FrustumPlanes::CreateFromMatrix(worldViewProjection);
+			const auto isVisible = GetCulledChunks(chunks, ranges);
+			for (size_t j = 0; j < chunks.size(); j++) {
+				if (!isVisible[j]) continue;
+
+				const auto& box = chunks[j].Bounds;
+				for (size_t k = 0; k < 6; k++) {
+					CHECK(planes.x[k] * box.Center.x + planes.y[k] * box.Center.y + planes.z[k] * box.Center.z + planes.w[k]
+						+ std::abs(planes.x[k]) * box.Extents.x + std::abs(planes.y[k]) * box.Extents.y + std::abs(planes.z[k]) * box.Extents.z >= -1e-5f);
+				}
+			}
+		}
+	}
+}
+
+TEST(MeshCullingMergesAdjacentChunks) {
+	MeshGenerator::ChunkCollection chunks;
+	CreateChunks(chunks);
+
+	const auto view = XMMatrixLookAtRH(XMVectorSet(0, 0, 5, 1), g_XMZero, XMVectorSet(0, 1, 0, 0));
+
+	// The whole sphere in view: one range for all the index data.
+	std::vector<IndexRange> ranges, lineRanges;
+	ChunkCuller::Cull(chunks, XMMatrixIdentity(), view, XMMatrixPerspectiveFovRH(XM_PIDIV2, 1, 0.1f, 10), false, ranges, &lineRanges);
+	CHECK(ranges.size() == 1 && lineRanges.size() == 1);
+	CHECK(ranges[0].StartIndex == 0 && ranges[0].IndexCount == chunks.back().StartIndex + chunks.back().IndexCount);
+
+	// Facing away from the sphere, nothing is left.
+	ranges.clear();
+	ChunkCuller::Cull(chunks, XMMatrixTranslation(0, 0, 10), view, XMMatrixPerspectiveFovRH(XM_PIDIV2, 1, 0.1f, 10), false, ranges);
+	CHECK(ranges.empty());
+
+	// The back of the sphere is dropped with back-face culling.
+	ranges.clear();
+	ChunkCuller::Cull(chunks, XMMatrixIdentity(), view, XMMatrixPerspectiveFovRH(XM_PIDIV2, 1, 0.1f, 10), true, ranges);
+	const auto isVisible = GetCulledChunks(chunks, ranges);
+	CHECK(std::find(isVisible.cbegin(), isVisible.cend(), false) != isVisible.cend());
+	CHECK(std::find(isVisible.cbegin(), isVisible.cend(), true) != isVisible.cend());
+}
+
+TEST(SplitScreenCoversOutput) {
+	// Columns and rows for one to four views: as many columns as rows, or one more.
+	constexpr std::pair<int32_t, int32_t> Grids[]{ { 1, 1 }, { 2, 1 }, { 2, 2 }, { 2, 2 } };
+
+	const OutputSize outputSize{ 1001, 601 };
+	for (size_t viewCount = 1; viewCount <= std::size(Grids); viewCount++) {
+		Viewport viewports[4];
+		ScissorRect scissorRects[4];
+		LayOutSplitScreen(outputSize, std::span(viewports, viewCount), std::span(scissorRects, viewCount));
+
+		// Every pixel belongs to at most one view, and the rows above the last are full.
+		std::vector<int> owners(static_cast<size_t>(outputSize.Width) * outputSize.Height);
+		const auto [columnCount, rowCount] = Grids[viewCount - 1];
+		for (size_t i = 0; i < viewCount; i++) {
+			const auto& scissorRect = scissorRects[i];
+			const auto column = static_cast<int32_t>(i) % columnCount, row = static_cast<int32_t>(i) / columnCount;
+			CHECK(scissorRect.Left == static_cast<int32_t>(outputSize.Width) * column / columnCount);
+			CHECK(scissorRect.Top == static_cast<int32_t>(outputSize.Height) * row / rowCount);
+
+			const auto& viewport = viewports[i];
+			CHECK(viewport.X == scissorRect.Left && viewport.Y == scissorRect.Top);
+			CHECK(viewport.Width == scissorRect.Right - scissorRect.Left && viewport.Height == scissorRect.Bottom - scissorRect.Top);
+			CHECK(viewport.MinDepth == 0 && viewport.MaxDepth == 1);
+
+			for (auto y = scissorRect.Top; y < scissorRect.Bottom; y++) {
+				for (auto x = scissorRect.Left; x < scissorRect.Right; x++) owners[static_cast<size_t>(y) * outputSize.Width + x]++;
+			}
+		}
+		CHECK(std::all_of(owners.cbegin(), owners.cend(), [](int owner) { return owner <= 1; }));
+
+		const auto coveredCount = static_cast<size_t>(std::count(owners.cbegin(), owners.cend(), 1));
+		const auto missingCount = viewCount == 3 ? static_cast<size_t>(outputSize.Width - outputSize.Width / 2) * (outputSize.Height - outputSize.Height / 2) : 0;
+		CHECK(coveredCount == owners.size() - missingCount);
+	}
+
+	Viewport viewports[2];
+	ScissorRect scissorRects[1];
+	CHECK_THROWS(std::invalid_argument, LayOutSplitScreen(outputSize, viewports, scissorRects));
+}
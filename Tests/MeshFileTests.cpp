@@ -0,0 +1,101 @@
+#include "Test.h"
+
+#include "MeshFile.h"
+
+#include <cstring>
+#include <fstream>
+
+using namespace DirectX;
+using namespace Hydr10n::Meshes;
+
+namespace {
+	void CreateMesh(MeshGenerator::VertexCollection& vertices, MeshGenerator::IndexCollection& indices) {
+		const XMFLOAT2 points[]{ { 0, 0 }, { 1, 0 }, { 1, 2 }, { 0.5f, 3 }, { 0, 3 } };
+		MeshGenerator::CreateMeshAroundYAxis(vertices, indices, points, std::size(points), 4, 16);
+	}
+
+	std::vector<char> ReadFile(const std::filesystem::path& path) {
+		std::ifstream file(path, std::ios::binary);
+		return { std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+	}
+
+	void WriteFile(const std::filesystem::path& path, const std::vector<char>& data) {
+		std::ofstream file(path, std::ios::binary | std::ios::trunc);
+		file.write(data.data(), static_cast<std::streamsize>(data.size()));
+	}
+}
+
+TEST(MeshFileRoundTrip) {
+	MeshGenerator::VertexCollection vertices;
+	MeshGenerator::IndexCollection indices;
+	CreateMesh(vertices, indices);
+
+	const auto path = Hydr10n::Tests::CreateTemporaryDirectory("MeshFile") / "mesh.bin";
+	MeshFile::Write(path, vertices, indices);
+
+	const MappedMeshFile file(path, true);
+
+	const auto mappedVertices = file.GetVertices();
+	CHECK(mappedVertices.size() == vertices.size());
+	CHECK(!std::memcmp(mappedVertices.data(), vertices.data(), sizeof(vertices[0]) * vertices.size()));
+
+	const auto mappedIndices = file.GetIndices();
+	CHECK(std::equal(mappedIndices.begin(), mappedIndices.end(), indices.cbegin(), indices.cend()));
+
+	for (const auto& entry : file.GetSectionEntries()) CHECK(entry.Offset % MeshFile::SectionAlignment == 0);
+
+	CHECK(file.GetSection(MeshFile::SectionType::Meshlets).empty());
+
+	const auto& bounds = file.GetBounds();
+	CHECK_NEAR(bounds.Extents.x, 1.0f, 1e-5f);
+	CHECK_NEAR(bounds.Extents.y, 1.5f, 1e-5f);
+	CHECK_NEAR(bounds.Center.y, 1.5f, 1e-5f);
+}
+
+TEST(MeshFileRejectsCorruption) {
+	MeshGenerator::VertexCollection vertices;
+	MeshGenerator::IndexCollection indices;
+	CreateMesh(vertices, indices);
+
+	const auto directory = Hydr10n::Tests::CreateTemporaryDirectory("MeshFileCorruption"), path = directory / "mesh.bin";
+	MeshFile::Write(path, vertices, indices);
+
+	const auto data = ReadFile(path);
+
+	// A flipped payload byte passes the structural checks and is only caught by the checksum.
+	auto corrupted = data;
+	corrupted.back() ^= 1;
+	WriteFile(path, corrupted);
+	CHECK_THROWS(std::runtime_error, MappedMeshFile{ path, true });
+	{ const MappedMeshFile file(path); }
+
+	corrupted = data;
+	corrupted.resize(corrupted.size() - 1);
+	WriteFile(path, corrupted);
+	CHECK_THROWS(std::runtime_error, MappedMeshFile{ path });
+
+	corrupted = data;
+	corrupted[0] ^= 1;
+	WriteFile(path, corrupted);
+	CHECK_THROWS(std::runtime_error, MappedMeshFile{ path });
+
+	// First section offset, moved off its alignment.
+	corrupted = data;
+	corrupted[sizeof(MeshFile::Header) + offsetof(MeshFile::SectionEntry, Offset)] ^= 1;
+	WriteFile(path, corrupted);
+	CHECK_THROWS(std::runtime_error, MappedMeshFile{ path });
+
+	CHECK_THROWS(std::system_error, MappedMeshFile{ directory / "missing.bin" });
+}
+
+TEST(MeshFileChecksSectionStride) {
+	const uint32_t values[]{ 1, 2, 3, 4 };
+	const MeshFile::SectionData sections[]{ { MeshFile::SectionType::Indices, sizeof(uint16_t), std::as_bytes(std::span(values)) } };
+
+	const auto path = Hydr10n::Tests::CreateTemporaryDirectory("MeshFileStride") / "mesh.bin";
+	MeshFile::Write(path, sections, {}, false);
+
+	const MappedMeshFile file(path, true);
+	CHECK(file.GetSection<uint16_t>(MeshFile::SectionType::Indices).size() == 8);
+	CHECK_THROWS(std::runtime_error, file.GetIndices());
+}
@@ -0,0 +1,332 @@
+#include "Test.h"
+
+#include "MeshGeneratorBenchmark.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <set>
+#include <utility>
+
+using namespace DirectX;
+using namespace Hydr10n::Benchmarks;
+using namespace Hydr10n::Meshes;
+
+namespace {
+	using Position = std::array<int64_t, 3>;
+	using Edge = std::pair<Position, Position>;
+
+	// Positions are compared on a grid fine enough to tell vertices apart and coarse enough to merge seam duplicates.
+	Position Quantize(const XMFLOAT3& position) {
+		return { std::llround(position.x * 1e4f), std::llround(position.y * 1e4f), std::llround(position.z * 1e4f) };
+	}
+
+	Edge MakeEdge(const MeshGenerator::VertexCollection& vertices, uint32_t a, uint32_t b) {
+		const auto positionA = Quantize(vertices[a].position), positionB = Quantize(vertices[b].position);
+		return positionA < positionB ? Edge(positionA, positionB) : Edge(positionB, positionA);
+	}
+
+	std::multiset<Edge> GetLineEdges(const MeshGenerator::VertexCollection& vertices, const MeshGenerator::IndexCollection& lineIndices) {
+		std::multiset<Edge> edges;
+		for (size_t i = 0; i + 1 < lineIndices.size(); i += 2) edges.insert(MakeEdge(vertices, lineIndices[i], lineIndices[i + 1]));
+		return edges;
+	}
+
+	std::set<Edge> GetTriangleEdges(const MeshGenerator::VertexCollection& vertices, const MeshGenerator::IndexCollection& indices) {
+		std::set<Edge> edges;
+		for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+			for (size_t j = 0; j < 3; j++) edges.insert(MakeEdge(vertices, indices[i + j], indices[i + (j + 1) % 3]));
+		}
+		return edges;
+	}
+
+	// Winding kept, rotated to start at the smallest index; triangles with a repeated index are dropped.
+	using Triangle = std::array<uint32_t, 3>;
+
+	void AddTriangle(std::multiset<Triangle>& triangles, uint32_t a, uint32_t b, uint32_t c) {
+		if (a == b || b == c || c == a) return;
+
+		const auto first = std::min({ a, b, c });
+		triangles.insert(first == a ? Triangle{ a, b, c } : first == b ? Triangle{ b, c, a } : Triangle{ c, a, b });
+	}
+
+	std::multiset<Triangle> GetListTriangles(const MeshGenerator::IndexCollection& indices) {
+		std::multiset<Triangle> triangles;
+		for (size_t i = 0; i + 2 < indices.size(); i += 3) AddTriangle(triangles, indices[i], indices[i + 1], indices[i + 2]);
+		return triangles;
+	}
+
+	// Every other triangle of a strip has its first two vertices swapped to keep the winding.
+	std::multiset<Triangle> GetStripTriangles(const MeshGenerator::IndexCollection& indices) {
+		std::multiset<Triangle> triangles;
+		size_t stripStart = 0;
+		for (size_t i = 0; i < indices.size(); i++) {
+			if (indices[i] == MeshGenerator::StripCutIndex) {
+				stripStart = i + 1;
+				continue;
+			}
+
+			if (i - stripStart < 2) continue;
+
+			const auto a = indices[i - 2], b = indices[i - 1], c = indices[i];
+			if ((i - stripStart) % 2) AddTriangle(triangles, b, a, c);
+			else AddTriangle(triangles, a, b, c);
+		}
+		return triangles;
+	}
+
+	std::vector<XMFLOAT2> CreateSemiCircle(uint32_t sliceCount) {
+		std::vector<XMFLOAT2> points;
+		for (uint32_t i = 0; i <= sliceCount; i++) {
+			const auto radians = -XM_PIDIV2 + XM_PI * static_cast<float>(i) / static_cast<float>(sliceCount);
+			points.push_back({ std::cos(radians), std::sin(radians) });
+		}
+		return points;
+	}
+}
+
+TEST(MeshGeneratorLineListHasEachGridEdgeOnce) {
+	// A single band: rowCount * sliceCount vertical and diagonal edges, and (rowCount + 1) * sliceCount around.
+	constexpr uint32_t RowCount = 3, SliceCount = 8;
+	const XMFLOAT2 points[]{ { 1, 0 }, { 0.5f, 1 } };
+
+	for (const auto offsetX : { 0.0f, 0.5f }) {
+		MeshGenerator::VertexCollection vertices;
+		MeshGenerator::IndexCollection indices, lineIndices;
+		MeshGenerator::CreateMeshAroundYAxis(vertices, indices, points, std::size(points), RowCount, SliceCount, offsetX, &lineIndices);
+
+		CHECK(lineIndices.size() == 2 * (3 * RowCount * SliceCount + SliceCount));
+
+		const auto lineEdges = GetLineEdges(vertices, lineIndices);
+		CHECK(std::set(lineEdges.cbegin(), lineEdges.cend()).size() == lineEdges.size());
+		CHECK(std::set(lineEdges.cbegin(), lineEdges.cend()) == GetTriangleEdges(vertices, indices));
+	}
+}
+
+TEST(MeshGeneratorLineListCoversTriangleEdges) {
+	// Repeated points in the degenerate profile make zero-width rings, whose edges all coincide.
+	const std::pair<std::vector<XMFLOAT2>, bool> profiles[]{
+		{ CreateSemiCircle(12), true },
+		{ MeshGeneratorBenchmark::GetProfilePoints(MeshGeneratorBenchmark::ProfileType::Arbitrary), true },
+		{ MeshGeneratorBenchmark::GetProfilePoints(MeshGeneratorBenchmark::ProfileType::Degenerate), false },
+		// Caps: a disk at the bottom and an annulus at the top.
+		{ { { 0, 0 }, { 1, 0 }, { 1, 1 }, { 0.5f, 1 }, { 0.5f, 2 } }, true }
+	};
+
+	for (const auto& [points, isCheckingMultiplicity] : profiles) {
+		for (const auto verticalTessellation : { 1u, 3u }) {
+			MeshGenerator::VertexCollection vertices;
+			MeshGenerator::IndexCollection indices, lineIndices;
+			MeshGenerator::CreateMeshAroundYAxis(vertices, indices, points.data(), points.size(), verticalTessellation, 10, 0, &lineIndices);
+
+			const auto lineEdges = GetLineEdges(vertices, lineIndices);
+			CHECK(std::set(lineEdges.cbegin(), lineEdges.cend()) == GetTriangleEdges(vertices, indices));
+
+			// Edges are only listed twice along rings shared by two profile segments, and more often only next to rows collapsed onto the axis.
+			const auto IsOnAxis = [](const Position& position) { return !position[0] && !position[2]; };
+			for (const auto& edge : lineEdges) {
+				if (!isCheckingMultiplicity || IsOnAxis(edge.first) || IsOnAxis(edge.second)) continue;
+
+				const auto count = lineEdges.count(edge);
+				CHECK(count == 1 || (count == 2 && edge.first[1] == edge.second[1]));
+			}
+
+			// Chunks split the same line list into ranges.
+			MeshGenerator::VertexCollection chunkedVertices;
+			MeshGenerator::IndexCollection chunkedIndices, chunkedLineIndices;
+			MeshGenerator::ChunkCollection chunks;
+			MeshGenerator::CreateMeshAroundYAxis(chunkedVertices, chunkedIndices, points.data(), points.size(), verticalTessellation, 10, 0, &chunkedLineIndices, MeshGenerator::IndexTopology::TriangleList, &chunks, 3);
+			CHECK(GetLineEdges(chunkedVertices, chunkedLineIndices) == lineEdges);
+		}
+	}
+}
+
+TEST(MeshGeneratorStripsMatchLists) {
+	const std::vector<XMFLOAT2> profiles[]{
+		CreateSemiCircle(12),
+		MeshGeneratorBenchmark::GetProfilePoints(MeshGeneratorBenchmark::ProfileType::Arbitrary),
+		MeshGeneratorBenchmark::GetProfilePoints(MeshGeneratorBenchmark::ProfileType::Degenerate),
+		// Caps of both windings: a disk at the bottom, an annulus in between and a disk at the top.
+		{ { 0, 0 }, { 1, 0 }, { 1, 1 }, { 0.5f, 1 }, { 0.5f, 2 }, { 0, 2 } }
+	};
+
+	for (const auto& points : profiles) {
+		for (const auto verticalTessellation : { 1u, 4u }) {
+			for (const auto chunkSectorCount : { 0u, 1u, 3u }) {
+				MeshGenerator::VertexCollection listVertices, stripVertices;
+				MeshGenerator::IndexCollection listIndices, stripIndices;
+				MeshGenerator::ChunkCollection listChunks, stripChunks;
+				MeshGenerator::CreateMeshAroundYAxis(listVertices, listIndices, points.data(), points.size(), verticalTessellation, 9, 0.25f, nullptr, MeshGenerator::IndexTopology::TriangleList, chunkSectorCount ? &listChunks : nullptr, std::max(chunkSectorCount, 1u));
+				MeshGenerator::CreateMeshAroundYAxis(stripVertices, stripIndices, points.data(), points.size(), verticalTessellation, 9, 0.25f, nullptr, MeshGenerator::IndexTopology::TriangleStrip, chunkSectorCount ? &stripChunks : nullptr, std::max(chunkSectorCount, 1u));
+
+				CHECK(!std::memcmp(listVertices.data(), stripVertices.data(), sizeof(listVertices[0]) * listVertices.size()) && listVertices.size() == stripVertices.size());
+				CHECK(GetStripTriangles(stripIndices) == GetListTriangles(listIndices));
+
+				// Chunk by chunk too, since each chunk is drawn on its own.
+				CHECK(listChunks.size() == stripChunks.size());
+				for (size_t i = 0; i < listChunks.size(); i++) {
+					const auto& listChunk = listChunks[i], & stripChunk = stripChunks[i];
+					CHECK(stripChunk.IndexCount && stripIndices[stripChunk.StartIndex + stripChunk.IndexCount - 1] == MeshGenerator::StripCutIndex);
+					CHECK(GetStripTriangles({ stripIndices.cbegin() + stripChunk.StartIndex, stripIndices.cbegin() + stripChunk.StartIndex + stripChunk.IndexCount })
+						== GetListTriangles({ listIndices.cbegin() + listChunk.StartIndex, listIndices.cbegin() + listChunk.StartIndex + listChunk.IndexCount }));
+				}
+			}
+		}
+	}
+}
+
+TEST(MeshGeneratorSectorExpandsToFullMesh) {
+	constexpr uint32_t SliceCount = 24;
+	constexpr auto Tolerance = 1e-5f;
+
+	const std::vector<XMFLOAT2> profiles[]{
+		CreateSemiCircle(12),
+		MeshGeneratorBenchmark::GetProfilePoints(MeshGeneratorBenchmark::ProfileType::Arbitrary),
+		{ { 0, 0 }, { 1, 0 }, { 1, 1 }, { 0.5f, 1 }, { 0.5f, 2 }, { 0, 2 } }
+	};
+
+	const auto AreNear = [&](const XMFLOAT3& a, const XMFLOAT3& b) { return std::abs(a.x - b.x) <= Tolerance && std::abs(a.y - b.y) <= Tolerance && std::abs(a.z - b.z) <= Tolerance; };
+
+	for (const auto& points : profiles) {
+		for (const auto topology : { MeshGenerator::IndexTopology::TriangleList, MeshGenerator::IndexTopology::TriangleStrip }) {
+			const auto GetTriangles = [&](const MeshGenerator::IndexCollection& indices) {
+				return topology == MeshGenerator::IndexTopology::TriangleList ? GetListTriangles(indices) : GetStripTriangles(indices);
+			};
+
+			MeshGenerator::VertexCollection vertices;
+			MeshGenerator::IndexCollection indices;
+			MeshGenerator::CreateMeshAroundYAxis(vertices, indices, points.data(), points.size(), 2, SliceCount, 0.25f, nullptr, topology);
+
+			// Triangles of the full mesh by the grid cell of their first vertex, each matched at most once.
+			const auto triangles = GetTriangles(indices);
+			std::map<Position, std::vector<std::pair<Triangle, bool>>> cells;
+			const auto GetCell = [](const XMFLOAT3& position) { return Position{ std::llround(position.x * 100), std::llround(position.y * 100), std::llround(position.z * 100) }; };
+			for (const auto& triangle : triangles) cells[GetCell(vertices[triangle[0]].position)].push_back({ triangle, false });
+
+			for (const auto sectorSliceCount : { 1u, 4u, 6u, SliceCount }) {
+				MeshGenerator::VertexCollection sectorVertices, expandedVertices;
+				MeshGenerator::IndexCollection sectorIndices, expandedIndices;
+				std::vector<XMFLOAT3X4> instanceTransforms;
+				MeshGenerator::CreateSectorAroundYAxis(sectorVertices, sectorIndices, instanceTransforms, points.data(), points.size(), 2, SliceCount, sectorSliceCount, 0.25f, nullptr, topology);
+				CHECK(instanceTransforms.size() == SliceCount / sectorSliceCount);
+
+				MeshGenerator::ExpandSectorInstances(expandedVertices, expandedIndices, sectorVertices, sectorIndices, instanceTransforms);
+
+				for (auto& cell : cells) for (auto& [triangle, isMatched] : cell.second) isMatched = false;
+
+				const auto expandedTriangles = GetTriangles(expandedIndices);
+				CHECK(expandedTriangles.size() == triangles.size());
+
+				for (const auto& expandedTriangle : expandedTriangles) {
+					const auto cell = GetCell(expandedVertices[expandedTriangle[0]].position);
+
+					auto isFound = false;
+					for (auto dx = -1; dx <= 1 && !isFound; dx++) for (auto dy = -1; dy <= 1 && !isFound; dy++) for (auto dz = -1; dz <= 1 && !isFound; dz++) {
+						const auto candidates = cells.find({ cell[0] + dx, cell[1] + dy, cell[2] + dz });
+						if (candidates == cells.end()) continue;
+
+						for (auto& [triangle, isMatched] : candidates->second) {
+							if (isMatched) continue;
+
+							// The same corners in the same order, so the winding agrees too.
+							auto isEqual = true;
+							for (size_t i = 0; i < 3 && isEqual; i++) {
+								const auto& vertex = vertices[triangle[i]], & expandedVertex = expandedVertices[expandedTriangle[i]];
+								isEqual = AreNear(vertex.position, expandedVertex.position) && AreNear(vertex.normal, expandedVertex.normal);
+							}
+
+							if (isEqual) {
+								isMatched = isFound = true;
+								break;
+							}
+						}
+					}
+					CHECK(isFound);
+				}
+			}
+		}
+	}
+}
+
+// The memory an instanced sector saves on the demo sphere.
+BENCHMARK(MeshGeneratorSectorMemory) {
+	constexpr uint32_t SliceCount = 400;
+
+	const auto points = CreateSemiCircle(SliceCount / 2);
+
+	MeshGenerator::VertexCollection vertices;
+	MeshGenerator::IndexCollection indices;
+	MeshGenerator::CreateMeshAroundYAxis(vertices, indices, points.data(), points.size(), 1, SliceCount);
+
+	const auto fullSize = sizeof(vertices[0]) * vertices.size() + sizeof(indices[0]) * indices.size();
+	std::cout << "Full mesh: " << vertices.size() << " vertices, " << indices.size() << " indices, " << fullSize << " bytes\n";
+
+	for (const auto sectorSliceCount : { 1u, 4u, 20u, 100u }) {
+		MeshGenerator::VertexCollection sectorVertices;
+		MeshGenerator::IndexCollection sectorIndices;
+		std::vector<XMFLOAT3X4> instanceTransforms;
+		MeshGenerator::CreateSectorAroundYAxis(sectorVertices, sectorIndices, instanceTransforms, points.data(), points.size(), 1, SliceCount, sectorSliceCount);
+
+		const auto sectorSize = sizeof(sectorVertices[0]) * sectorVertices.size() + sizeof(sectorIndices[0]) * sectorIndices.size() + sizeof(instanceTransforms[0]) * instanceTransforms.size();
+		std::cout << sectorSliceCount << "-slice sector: " << sectorVertices.size() << " vertices, " << sectorIndices.size() << " indices, "
+			<< instanceTransforms.size() << " instances, " << sectorSize << " bytes (" << static_cast<double>(sectorSize) / static_cast<double>(fullSize) * 100 << "%)\n";
+
+		// A sector of K slices has K + 1 columns of vertices where the full mesh has H + 1.
+		CHECK(sectorVertices.size() * (SliceCount + 1) == vertices.size() * (sectorSliceCount + 1));
+	}
+}
+
+TEST(MeshGeneratorBenchmarkBaseline) {
+	MeshGeneratorBenchmark::Options options;
+	options.Tessellations = { 3, 64 };
+	options.OffsetXs = { 0, 0.25f };
+	options.MinSecondsPerCase = 0;
+	options.MinRepetitionCount = 1;
+	options.MinComparedNanoseconds = 0;
+
+	const auto results = MeshGeneratorBenchmark::Run(options);
+	CHECK(results.size() == static_cast<size_t>(MeshGeneratorBenchmark::ProfileType::Count) * options.Tessellations.size() * options.OffsetXs.size() * static_cast<size_t>(MeshGeneratorBenchmark::StageType::Count));
+
+	for (const auto& result : results) {
+		CHECK(result.Bytes);
+		if (AllocationCounter::IsAvailable) CHECK(result.Allocations.AllocationCount && result.Allocations.AllocatedBytes);
+	}
+
+	const auto path = Hydr10n::Tests::CreateTemporaryDirectory("MeshGeneratorBenchmark") / "baseline.json";
+	MeshGeneratorBenchmark::WriteJson(path, results);
+
+	const auto baseline = MeshGeneratorBenchmark::ReadJson(path);
+	CHECK(baseline.size() == results.size());
+	for (size_t i = 0; i < results.size(); i++) {
+		CHECK(baseline[i].Profile == results[i].Profile && baseline[i].Tessellation == results[i].Tessellation && baseline[i].OffsetX == results[i].OffsetX && baseline[i].Stage == results[i].Stage);
+		CHECK(baseline[i].Bytes == results[i].Bytes && baseline[i].Allocations.AllocationCount == results[i].Allocations.AllocationCount);
+	}
+
+	CHECK(MeshGeneratorBenchmark::Compare(results, results, options).empty());
+
+	// Twice the time for the same bytes halves the throughput.
+	auto regressed = results;
+	regressed[3].Nanoseconds *= 2;
+	regressed[5].Nanoseconds *= 1.05;
+	const auto regressions = MeshGeneratorBenchmark::Compare(regressed, results, options);
+	CHECK(regressions.size() == 1 && regressions[0].starts_with("Sphere/3/0/Chunks"));
+}
+
+// Options: -MeshGeneratorJson <results>, -MeshGeneratorBaseline <baseline> and -MeshGeneratorThreshold <fraction>.
+BENCHMARK(MeshGeneratorStages) {
+	MeshGeneratorBenchmark::Options options;
+	if (const auto threshold = Hydr10n::Tests::GetOption("MeshGeneratorThreshold"); !threshold.empty()) options.RegressionThreshold = std::stod(threshold);
+
+	const auto results = MeshGeneratorBenchmark::Run(options);
+
+	if (const auto path = Hydr10n::Tests::GetOption("MeshGeneratorJson"); !path.empty()) MeshGeneratorBenchmark::WriteJson(path, results);
+	else MeshGeneratorBenchmark::WriteJson(std::cout, results);
+
+	if (const auto path = Hydr10n::Tests::GetOption("MeshGeneratorBaseline"); !path.empty()) {
+		const auto regressions = MeshGeneratorBenchmark::Compare(results, MeshGeneratorBenchmark::ReadJson(path), options);
+		for (const auto& regression : regressions) std::cout << regression << '\n';
+		CHECK(regressions.empty());
+	}
+}
@@ -0,0 +1,174 @@
+#include "Test.h"
+
+#include "OcclusionBenchmark.h"
+
+#include <iostream>
+#include <random>
+#include <sstream>
+
+using namespace DirectX;
+using namespace Hydr10n::Benchmarks;
+using namespace Hydr10n::Rendering;
+
+namespace {
+	constexpr uint32_t Width = 256, Height = 128;
+
+	// A screen-aligned rectangle of pixels at a constant depth, as two triangles in clip space.
+	struct Quad {
+		float Left, Top, Right, Bottom, Depth;
+
+		std::vector<XMFLOAT3> GetVertices() const {
+			const auto ToClipX = [](float x) { return x / Width * 2 - 1; };
+			const auto ToClipY = [](float y) { return 1 - y / Height * 2; };
+			return { { ToClipX(Left), ToClipY(Top), Depth }, { ToClipX(Right), ToClipY(Top), Depth }, { ToClipX(Right), ToClipY(Bottom), Depth }, { ToClipX(Left), ToClipY(Bottom), Depth } };
+		}
+	};
+
+	constexpr uint32_t QuadIndices[]{ 0, 1, 2, 0, 2, 3 };
+
+	// Quads whose edges never pass through pixel centers, so that which pixels they cover is unambiguous.
+	std::vector<Quad> CreateQuads(std::mt19937& random, size_t count) {
+		std::uniform_int_distribution<int> xs(-20, Width + 20), ys(-10, Height + 10), sizes(4, 96);
+		std::uniform_real_distribution<float> depths(0.05f, 0.95f);
+
+		std::vector<Quad> quads(count);
+		for (auto& quad : quads) {
+			const auto x = xs(random), y = ys(random);
+			quad = { x + 0.25f, y + 0.25f, x + sizes(random) + 0.25f, y + sizes(random) / 2 + 0.25f, depths(random) };
+		}
+		return quads;
+	}
+
+	void AddOccluders(MaskedOcclusionCuller& culler, std::span<const Quad> quads, std::vector<std::vector<XMFLOAT3>>& vertices) {
+		vertices.clear();
+		for (const auto& quad : quads) culler.AddOccluder(vertices.emplace_back(quad.GetVertices()), QuadIndices, XMMatrixIdentity());
+		culler.Flush();
+	}
+}
+
+TEST(MaskedOcclusionCullsBehindOccluder) {
+	MaskedOcclusionCuller culler(Width, Height);
+
+	std::vector<std::vector<XMFLOAT3>> vertices;
+	const Quad quads[]{ { 0.25f, 0.25f, Width / 2 + 0.25f, Height + 0.25f, 0.5f } };
+	AddOccluders(culler, quads, vertices);
+
+	CHECK(culler.TestRect(10, 10, 100, 100, 0.6f) == OcclusionResult::Occluded);
+	CHECK(culler.TestRect(10, 10, 100, 100, 0.4f) == OcclusionResult::Visible);
+	CHECK(culler.TestRect(100, 10, 200, 100, 0.6f) == OcclusionResult::Visible);
+	CHECK(culler.TestRect(Width + 10.0f, 10, Width + 20.0f, 20, 0.6f) == OcclusionResult::ViewCulled);
+
+	// Boxes in clip space, with the identity as their view-projection.
+	CHECK(culler.TestBox({ { -0.5f, 0, 0.8f }, { 0.2f, 0.2f, 0.1f } }, XMMatrixIdentity()) == OcclusionResult::Occluded);
+	CHECK(culler.TestBox({ { -0.5f, 0, 0.3f }, { 0.2f, 0.2f, 0.1f } }, XMMatrixIdentity()) == OcclusionResult::Visible);
+	CHECK(culler.TestBox({ { -0.5f, 0, 0.1f }, { 0.2f, 0.2f, 0.2f } }, XMMatrixIdentity()) == OcclusionResult::Visible);
+
+	culler.Clear();
+	CHECK(culler.TestRect(10, 10, 100, 100, 0.6f) == OcclusionResult::Visible);
+}
+
+TEST(MaskedOcclusionIsConservative) {
+	std::mt19937 random(6);
+
+	WorkerPool workerPool(4);
+	MaskedOcclusionCuller cullers[]{ { Width, Height }, { Width, Height }, { Width, Height, &workerPool } };
+	cullers[0].SetAVX2Enabled(false);
+
+	for (auto scene = 0; scene < 20; scene++) {
+		const auto quads = CreateQuads(random, 40);
+
+		// The exact depth of every pixel center.
+		std::vector<float> depths(static_cast<size_t>(Width) * Height, 1);
+		for (const auto& quad : quads) {
+			for (uint32_t y = 0; y < Height; y++) {
+				for (uint32_t x = 0; x < Width; x++) {
+					if (x + 0.5f > quad.Left && x + 0.5f < quad.Right && y + 0.5f > quad.Top && y + 0.5f < quad.Bottom) depths[y * Width + x] = std::min(depths[y * Width + x], quad.Depth);
+				}
+			}
+		}
+
+		std::vector<std::vector<XMFLOAT3>> vertices[std::size(cullers)];
+		for (size_t i = 0; i < std::size(cullers); i++) {
+			cullers[i].Clear();
+			AddOccluders(cullers[i], quads, vertices[i]);
+		}
+
+		// Scalar, AVX2 and binned rasterization agree exactly, and no pixel is occluded beyond what the occluders cover.
+		for (uint32_t y = 0; y < Height; y++) {
+			for (uint32_t x = 0; x < Width; x++) {
+				const auto referenceDepth = cullers[0].GetReferenceDepth(x, y);
+				CHECK(referenceDepth >= depths[y * Width + x]);
+				for (const auto& culler : cullers) CHECK(culler.GetReferenceDepth(x, y) == referenceDepth);
+			}
+		}
+
+		uint32_t occludedCount = 0;
+		for (const auto& rect : CreateQuads(random, 200)) {
+			const auto result = cullers[0].TestRect(rect.Left, rect.Top, rect.Right, rect.Bottom, rect.Depth);
+			for (const auto& culler : cullers) CHECK(culler.TestRect(rect.Left, rect.Top, rect.Right, rect.Bottom, rect.Depth) == result);
+
+			if (result != OcclusionResult::Occluded) continue;
+
+			occludedCount++;
+			for (auto y = std::max(0, static_cast<int>(rect.Top)); y < std::min(static_cast<int>(Height), static_cast<int>(std::ceil(rect.Bottom))); y++) {
+				for (auto x = std::max(0, static_cast<int>(rect.Left)); x < std::min(static_cast<int>(Width), static_cast<int>(std::ceil(rect.Right))); x++) {
+					CHECK(depths[y * Width + x] <= rect.Depth);
+				}
+			}
+		}
+		CHECK(occludedCount > 0);
+	}
+}
+
+namespace {
+	// Turning at eye level inside the grid, where nearer parts hide most of the ones behind.
+	DX::CameraPath CreateCameraPath(double duration) {
+		std::ostringstream path;
+		path << "0 0 1 0 0 0 0 1 20\n" << duration << " 0 1 0 0 0.3826834 0 0.9238795 20\n";
+
+		std::istringstream stream(path.str());
+		return DX::CameraPath::CreateFromStream(stream);
+	}
+}
+
+TEST(OcclusionBenchmarkCullsParts) {
+	const auto cameraPath = CreateCameraPath(1);
+
+	OcclusionBenchmark::Options options;
+	options.GridSize = 16;
+	options.FrameRate = 10;
+
+	std::vector<OcclusionBenchmark::FrameResult> frameResults[2];
+	for (const auto threadCount : { 1u, 4u }) {
+		options.ThreadCount = threadCount;
+		OcclusionBenchmark benchmark(cameraPath, options);
+		benchmark.Run();
+
+		const auto& results = benchmark.GetFrameResults();
+		CHECK(results.size() == 10);
+		CHECK(benchmark.GetCulledFraction() > 0 && benchmark.GetCulledFraction() < 1);
+
+		frameResults[threadCount > 1] = results;
+	}
+
+	// Binning on several threads culls the same parts.
+	for (size_t i = 0; i < frameResults[0].size(); i++) {
+		CHECK(frameResults[0][i].VisiblePartCount == frameResults[1][i].VisiblePartCount);
+		CHECK(frameResults[0][i].OccludedPartCount == frameResults[1][i].OccludedPartCount);
+	}
+
+	CHECK_THROWS(std::invalid_argument, OcclusionBenchmark(cameraPath, OcclusionBenchmark::Options{ .GridSize = 0 }));
+}
+
+BENCHMARK(OcclusionCulling) {
+	for (const auto threadCount : { 1u, 0u }) {
+		OcclusionBenchmark::Options options;
+		options.ThreadCount = threadCount ? threadCount : std::max(1u, std::thread::hardware_concurrency());
+
+		OcclusionBenchmark benchmark(CreateCameraPath(10), options);
+		benchmark.Run();
+
+		std::cout << options.ThreadCount << " thread(s): " << benchmark.GetPartCount() << " parts, " << benchmark.GetCulledFraction() * 100 << "% of those in the frustum occluded, "
+			<< benchmark.GetMeanFrameMilliseconds() << " ms per frame\n";
+	}
+}
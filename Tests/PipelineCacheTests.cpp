@@ -0,0 +1,133 @@
+#include "Test.h"
+
+#include "PipelineCache.h"
+
+#include <chrono>
+#include <map>
+#include <thread>
+
+namespace {
+	// Stands in for ID3D12PipelineLibrary: a pipeline is its description, stored under its hash, and serialized as the hash
+	// followed by the description's byte. Negative descriptions fail to compile.
+	struct FakeLibrary {
+		using Description = int;
+		using Pipeline = std::shared_ptr<int>;
+
+		std::mutex Mutex;
+		std::map<uint64_t, int> Stored;
+		std::atomic<int> CreateCount{};
+
+		explicit FakeLibrary(std::vector<uint8_t> data) {
+			for (size_t i = 0; i + 9 <= data.size(); i += 9) {
+				uint64_t hash;
+				std::memcpy(&hash, &data[i], sizeof(hash));
+				Stored[hash] = data[i + 8];
+			}
+		}
+
+		Pipeline Load(uint64_t hash, const Description& description) {
+			std::lock_guard lock(Mutex);
+			const auto pipeline = Stored.find(hash);
+			return pipeline == Stored.cend() || pipeline->second != description ? nullptr : std::make_shared<int>(description);
+		}
+
+		// Slow enough for the other threads to ask for the same pipeline meanwhile.
+		Pipeline Create(const Description& description) {
+			CreateCount++;
+			std::this_thread::sleep_for(std::chrono::milliseconds(20));
+			if (description < 0) throw std::runtime_error("Failed to compile pipeline");
+			return std::make_shared<int>(description);
+		}
+
+		void Store(uint64_t hash, const Pipeline& pipeline) {
+			std::lock_guard lock(Mutex);
+			Stored.emplace(hash, *pipeline);
+		}
+
+		std::vector<uint8_t> Serialize() {
+			std::lock_guard lock(Mutex);
+			std::vector<uint8_t> data;
+			for (const auto& [hash, description] : Stored) {
+				data.resize(data.size() + 9);
+				std::memcpy(&data[data.size() - 9], &hash, sizeof(hash));
+				data.back() = static_cast<uint8_t>(description);
+			}
+			return data;
+		}
+	};
+
+	uint64_t GetHash(int description) { return DX::HashBuilder().Add(description).GetHash(); }
+}
+
+TEST(PipelineCacheCreatesEachPipelineOnce) {
+	const auto path = Hydr10n::Tests::CreateTemporaryDirectory("PipelineCache") / "PipelineCache.bin";
+	CHECK(DX::PipelineCacheFile::Read(path, 1).empty());
+
+	DX::PipelineCache<FakeLibrary> cache(DX::PipelineCacheFile::Read(path, 1));
+
+	// Eight threads ask for two pipelines at once; the ones that come second wait for the first instead of compiling again.
+	std::shared_ptr<int> pipelines[8];
+	{
+		std::vector<std::jthread> threads;
+		for (int i = 0; i < 8; i++) threads.emplace_back([&, i] { pipelines[i] = cache.GetOrCreate(GetHash(i % 2), i % 2 + 5); });
+	}
+	CHECK(cache.GetLibrary().CreateCount == 2);
+	CHECK(cache.GetCreateCount() == 2 && cache.GetHitCount() == 6 && cache.GetLoadCount() == 0);
+	CHECK(pipelines[0] == pipelines[2] && pipelines[1] == pipelines[3] && pipelines[0] != pipelines[1]);
+	CHECK(*pipelines[0] == 5 && *pipelines[1] == 6);
+
+	// A failure is not remembered: the next request compiles again.
+	CHECK_THROWS(std::runtime_error, cache.GetOrCreate(GetHash(-1), -1));
+	CHECK_THROWS(std::runtime_error, cache.GetOrCreate(GetHash(-1), -1));
+	CHECK(cache.GetLibrary().CreateCount == 4);
+
+	// Only new pipelines are worth writing.
+	CHECK(cache.IsDirty());
+	CHECK(cache.Save(path, 1));
+	CHECK(!cache.IsDirty() && !cache.Save(path, 1));
+}
+
+TEST(PipelineCacheLoadsWhatItSaved) {
+	const auto path = Hydr10n::Tests::CreateTemporaryDirectory("PipelineCache") / "PipelineCache.bin";
+	{
+		DX::PipelineCache<FakeLibrary> cache(std::vector<uint8_t>{});
+		cache.GetOrCreate(GetHash(0), 5);
+		cache.GetOrCreate(GetHash(1), 6);
+		CHECK(cache.Save(path, 1));
+	}
+
+	// Files from another adapter or driver are ignored.
+	CHECK(DX::PipelineCacheFile::Read(path, 2).empty());
+
+	const auto data = DX::PipelineCacheFile::Read(path, 1);
+	CHECK(data.size() == 18);
+	{
+		DX::PipelineCache<FakeLibrary> cache(data);
+		CHECK(*cache.GetOrCreate(GetHash(0), 5) == 5);
+		CHECK(*cache.GetOrCreate(GetHash(1), 6) == 6);
+		CHECK(cache.GetLoadCount() == 2 && cache.GetCreateCount() == 0 && !cache.IsDirty());
+	}
+	{
+		// The library rejects a stored pipeline whose description no longer matches, and it is created anew.
+		DX::PipelineCache<FakeLibrary> cache(data);
+		CHECK(*cache.GetOrCreate(GetHash(0), 9) == 9);
+		CHECK(cache.GetLoadCount() == 0 && cache.GetCreateCount() == 1);
+	}
+
+	// Corrupt and truncated files read as empty.
+	{
+		std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+		file.seekp(-1, std::ios::end);
+		file.put(42);
+	}
+	CHECK(DX::PipelineCacheFile::Read(path, 1).empty());
+
+	std::filesystem::resize_file(path, 20);
+	CHECK(DX::PipelineCacheFile::Read(path, 1).empty());
+}
+
+TEST(HashBuilderSeparatesStrings) {
+	CHECK(DX::HashBuilder().AddString("ab").AddString("c").GetHash() != DX::HashBuilder().AddString("a").AddString("bc").GetHash());
+	CHECK(DX::HashBuilder().Add(1).GetHash() == DX::HashBuilder().Add(1).GetHash());
+	CHECK(DX::HashBuilder().Add(1).GetHash() != DX::HashBuilder().Add(2).GetHash());
+}
@@ -0,0 +1,139 @@
+#include "Test.h"
+
+// What the Mesh Demo's precompiled header provides.
+#include "ErrorHelpers.h"
+#include "d3dx12.h"
+
+namespace DX { using namespace ErrorHelpers; }
+
+#include "PipelineStateCache.h"
+
+#include <climits>
+#include <iterator>
+#include <string>
+
+using DX::PipelineStateHasher;
+
+namespace {
+	// Not real shaders: the hasher only reads their bytes.
+	constexpr uint8_t VertexShader[]{ 0x44, 0x58, 0x42, 0x43, 1, 2, 3, 4, 5, 6, 7, 8 };
+	constexpr uint8_t PixelShader[]{ 0x44, 0x58, 0x42, 0x43, 8, 7, 6, 5, 4, 3, 2, 1 };
+
+	constexpr D3D12_INPUT_ELEMENT_DESC InputElementDescs[]{
+		{ "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
+		{ "NORMAL", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 12, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 }
+	};
+
+	// The same description wherever the shaders and input elements live.
+	struct Pipeline {
+		std::vector<uint8_t> VS, PS;
+		std::vector<std::string> SemanticNames;
+		std::vector<D3D12_INPUT_ELEMENT_DESC> InputElements;
+		D3D12_GRAPHICS_PIPELINE_STATE_DESC Desc{};
+
+		Pipeline() : VS(std::cbegin(VertexShader), std::cend(VertexShader)), PS(std::cbegin(PixelShader), std::cend(PixelShader)),
+			InputElements(std::cbegin(InputElementDescs), std::cend(InputElementDescs)) {
+			for (const auto& element : InputElements) SemanticNames.emplace_back(element.SemanticName);
+			for (size_t i = 0; i < InputElements.size(); i++) InputElements[i].SemanticName = SemanticNames[i].c_str();
+
+			Desc.VS = { VS.data(), VS.size() };
+			Desc.PS = { PS.data(), PS.size() };
+			Desc.BlendState = CD3DX12_BLEND_DESC(D3D12_DEFAULT);
+			Desc.SampleMask = UINT_MAX;
+			Desc.RasterizerState = CD3DX12_RASTERIZER_DESC(D3D12_DEFAULT);
+			Desc.DepthStencilState = CD3DX12_DEPTH_STENCIL_DESC(D3D12_DEFAULT);
+			Desc.InputLayout = { InputElements.data(), static_cast<UINT>(InputElements.size()) };
+			Desc.PrimitiveTopologyType = D3D12_PRIMITIVE_TOPOLOGY_TYPE_TRIANGLE;
+			Desc.NumRenderTargets = 1;
+			Desc.RTVFormats[0] = DXGI_FORMAT_B8G8R8A8_UNORM;
+			Desc.DSVFormat = DXGI_FORMAT_D32_FLOAT;
+			Desc.SampleDesc = { 1, 0 };
+		}
+
+		Pipeline(const Pipeline&) = delete;
+		Pipeline& operator=(const Pipeline&) = delete;
+	};
+
+	// Every subobject the graphics description sets, in an order of its own.
+	struct GraphicsStream {
+		CD3DX12_PIPELINE_STATE_STREAM_SAMPLE_MASK SampleMask;
+		CD3DX12_PIPELINE_STATE_STREAM_PS PS;
+		CD3DX12_PIPELINE_STATE_STREAM_RENDER_TARGET_FORMATS RTVFormats;
+		CD3DX12_PIPELINE_STATE_STREAM_INPUT_LAYOUT InputLayout;
+		CD3DX12_PIPELINE_STATE_STREAM_VS VS;
+		CD3DX12_PIPELINE_STATE_STREAM_DEPTH_STENCIL_FORMAT DSVFormat;
+		CD3DX12_PIPELINE_STATE_STREAM_DEPTH_STENCIL DepthStencilState;
+		CD3DX12_PIPELINE_STATE_STREAM_PRIMITIVE_TOPOLOGY PrimitiveTopologyType;
+		CD3DX12_PIPELINE_STATE_STREAM_RASTERIZER RasterizerState;
+		CD3DX12_PIPELINE_STATE_STREAM_BLEND_DESC BlendState;
+		CD3DX12_PIPELINE_STATE_STREAM_SAMPLE_DESC SampleDesc;
+
+		explicit GraphicsStream(const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc) :
+			SampleMask(desc.SampleMask), PS(desc.PS), RTVFormats(CD3DX12_RT_FORMAT_ARRAY(desc.RTVFormats, desc.NumRenderTargets)),
+			InputLayout(desc.InputLayout), VS(desc.VS), DSVFormat(desc.DSVFormat), DepthStencilState(CD3DX12_DEPTH_STENCIL_DESC(desc.DepthStencilState)),
+			PrimitiveTopologyType(desc.PrimitiveTopologyType), RasterizerState(CD3DX12_RASTERIZER_DESC(desc.RasterizerState)),
+			BlendState(CD3DX12_BLEND_DESC(desc.BlendState)), SampleDesc(desc.SampleDesc) {}
+	};
+
+	template <class Stream>
+	uint64_t HashStream(Stream& stream, uint64_t rootSignatureKey) { return PipelineStateHasher::Hash(D3D12_PIPELINE_STATE_STREAM_DESC{ sizeof(stream), &stream }, rootSignatureKey); }
+}
+
+TEST(PipelineStateHasherHashesContents) {
+	const Pipeline pipeline, copy;
+	CHECK(pipeline.Desc.VS.pShaderBytecode != copy.Desc.VS.pShaderBytecode && pipeline.Desc.InputLayout.pInputElementDescs != copy.Desc.InputLayout.pInputElementDescs);
+	CHECK(pipeline.Desc.InputLayout.pInputElementDescs[0].SemanticName != copy.Desc.InputLayout.pInputElementDescs[0].SemanticName);
+
+	// What the pointers point to counts, not where it is; so does the root signature key.
+	const auto hash = PipelineStateHasher::Hash(pipeline.Desc, 1);
+	CHECK(PipelineStateHasher::Hash(copy.Desc, 1) == hash);
+	CHECK(PipelineStateHasher::Hash(pipeline.Desc, 2) != hash);
+
+	// A single byte of bytecode, or any one field, makes another pipeline.
+	Pipeline changed;
+	changed.PS.back() ^= 1;
+	CHECK(PipelineStateHasher::Hash(changed.Desc, 1) != hash);
+	changed.PS.back() ^= 1;
+	CHECK(PipelineStateHasher::Hash(changed.Desc, 1) == hash);
+
+	changed.Desc.IBStripCutValue = D3D12_INDEX_BUFFER_STRIP_CUT_VALUE_0xFFFF;
+	const auto stripCutHash = PipelineStateHasher::Hash(changed.Desc, 1);
+	CHECK(stripCutHash != hash);
+	changed.Desc.IBStripCutValue = D3D12_INDEX_BUFFER_STRIP_CUT_VALUE_0xFFFFFFFF;
+	CHECK(PipelineStateHasher::Hash(changed.Desc, 1) != hash && PipelineStateHasher::Hash(changed.Desc, 1) != stripCutHash);
+	changed.Desc.IBStripCutValue = D3D12_INDEX_BUFFER_STRIP_CUT_VALUE_DISABLED;
+
+	changed.SemanticNames[1] = "TEXCOORD";
+	changed.InputElements[1].SemanticName = changed.SemanticNames[1].c_str();
+	CHECK(PipelineStateHasher::Hash(changed.Desc, 1) != hash);
+
+	// Render target formats past the count are not used.
+	Pipeline unusedFormats;
+	unusedFormats.Desc.RTVFormats[3] = DXGI_FORMAT_R16G16B16A16_FLOAT;
+	CHECK(PipelineStateHasher::Hash(unusedFormats.Desc, 1) == hash);
+	unusedFormats.Desc.NumRenderTargets = 4;
+	CHECK(PipelineStateHasher::Hash(unusedFormats.Desc, 1) != hash);
+}
+
+TEST(PipelineStateHasherNormalizesStreams) {
+	const Pipeline pipeline;
+
+	// A stream with the subobjects in another order, leaving out those with default values, is the same pipeline.
+	GraphicsStream stream(pipeline.Desc);
+	CHECK(HashStream(stream, 1) == PipelineStateHasher::Hash(pipeline.Desc, 1));
+
+	stream.SampleMask = 1;
+	CHECK(HashStream(stream, 1) != PipelineStateHasher::Hash(pipeline.Desc, 1));
+
+	// A compute pipeline is another pipeline, even with the same shader.
+	D3D12_COMPUTE_PIPELINE_STATE_DESC computeDesc{};
+	computeDesc.CS = pipeline.Desc.VS;
+	CHECK(PipelineStateHasher::Hash(computeDesc, 1) != PipelineStateHasher::Hash(pipeline.Desc, 1));
+
+	// A subobject given twice makes the stream invalid.
+	struct {
+		CD3DX12_PIPELINE_STATE_STREAM_VS VS;
+		CD3DX12_PIPELINE_STATE_STREAM_VS OtherVS;
+	} duplicateStream{ pipeline.Desc.VS, pipeline.Desc.VS };
+	CHECK_THROWS(std::invalid_argument, HashStream(duplicateStream, 1));
+}
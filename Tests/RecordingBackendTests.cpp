@@ -0,0 +1,148 @@
+#include "Test.h"
+
+#include "HeadlessApp.h"
+#include "RecordingBackend.h"
+
+#include <chrono>
+#include <sstream>
+#include <thread>
+
+using namespace Hydr10n::Benchmarks;
+using namespace Hydr10n::Rendering;
+
+namespace {
+	// Half a turn around the sphere while closing in, over two seconds.
+	DX::CameraPath CreateCameraPath() {
+		std::istringstream stream(
+			"0 0 0 0 0 0 0 1 4\n"
+			"2 0 0 0 0 0.7071068 0 0.7071068 2.5\n"
+		);
+		return DX::CameraPath::CreateFromStream(stream);
+	}
+}
+
+TEST(RecordingQueueSimulatesLatency) {
+	RecordingCommandQueue commandQueue;
+	commandQueue.SetLatency(2);
+
+	std::vector<const RecordingCommandList*> executed;
+	commandQueue.SetExecutor([&](const RecordingCommandList& commandList) { executed.push_back(&commandList); });
+
+	RecordingCommandList commandLists[3];
+	for (auto& commandList : commandLists) {
+		commandQueue.Submit(commandList);
+		commandQueue.Signal();
+	}
+
+	// Three values signaled, the first one complete.
+	CHECK(commandQueue.GetCompletedValue() == 1);
+	CHECK(executed == std::vector<const RecordingCommandList*>{ &commandLists[0] });
+
+	commandQueue.WaitForValue(1);
+	CHECK(commandQueue.GetStallCount() == 0);
+
+	// Waiting ahead of the GPU completes everything up to the value at once.
+	commandQueue.WaitForValue(3);
+	CHECK(commandQueue.GetStallCount() == 1);
+	CHECK(commandQueue.GetCompletedValue() == 3);
+	CHECK((executed == std::vector<const RecordingCommandList*>{ &commandLists[0], &commandLists[1], &commandLists[2] }));
+
+	CHECK_THROWS(std::invalid_argument, commandQueue.WaitForValue(4));
+}
+
+TEST(RecordingDeviceCyclesBackBuffers) {
+	for (const auto latency : { 1u, 2u }) {
+		RecordingDevice device({ 64, 32 }, 2);
+		device.GetCommandQueue().SetLatency(latency);
+
+		const uint32_t data[]{ 1, 2, 3 };
+		const auto buffer = device.CreateBuffer(BufferType::Index, data, sizeof(data));
+		CHECK(device.GetBuffer(buffer).Type == BufferType::Index);
+		CHECK(!std::memcmp(device.GetBuffer(buffer).Data.data(), data, sizeof(data)));
+
+		for (uint32_t frame = 0; frame < 10; frame++) {
+			auto& commandList = static_cast<RecordingCommandList&>(device.BeginFrame());
+			CHECK(commandList.GetCommands().empty());
+
+			commandList.DrawIndexed(frame + 1, 0);
+			device.Present();
+
+			CHECK(device.GetLastCommandList() == &commandList);
+		}
+		CHECK(device.GetPresentCount() == 10);
+
+		// With two back buffers, a GPU one frame behind never makes the CPU wait, and one two frames behind does every frame.
+		CHECK(device.GetCommandQueue().GetStallCount() == (latency == 1 ? 0 : 8));
+
+		// Idling signals one more value after the last frame's.
+		device.WaitForIdle();
+		CHECK(device.GetCommandQueue().GetCompletedValue() == 11);
+	}
+}
+
+TEST(HeadlessAppRunsCameraPath) {
+	for (const auto isWireframe : { false, true }) {
+		RecordingDevice device({ 320, 180 });
+		device.GetCommandQueue().SetLatency(1);
+
+		uint64_t frameCount = 0;
+		device.GetCommandQueue().SetExecutor([&](const RecordingCommandList& commandList) {
+			const auto& commands = commandList.GetCommands();
+			CHECK(!commands.empty() && std::holds_alternative<RecordedCommands::Clear>(commands.front()));
+
+			const auto topology = std::find_if(commands.cbegin(), commands.cend(), [](const RecordedCommand& command) { return std::holds_alternative<RecordedCommands::SetPrimitiveTopology>(command); });
+			CHECK(topology != commands.cend());
+			CHECK(std::get<RecordedCommands::SetPrimitiveTopology>(*topology).Topology == (isWireframe ? PrimitiveTopology::LineList : PrimitiveTopology::TriangleStrip));
+
+			// The sphere fills the view; in solid mode the chunks facing away are culled.
+			CHECK(commandList.GetDrawCount() > 0);
+			CHECK(commandList.GetIndexCount() > 0);
+
+			frameCount++;
+		});
+
+		HeadlessApp::Options options;
+		options.FrameRate = 60;
+		options.UpdateRate = 30;
+		options.IsWireframe = isWireframe;
+		HeadlessApp app(device, CreateCameraPath(), options);
+
+		while (!app.IsFinished()) app.Tick();
+
+		// The GPU a frame behind never stalls the frame loop; idling at the end does once.
+		CHECK(device.GetCommandQueue().GetStallCount() == 0);
+		device.WaitForIdle();
+
+		// Updates run until the path ends, two frames each; the first frame comes before any update and renders nothing.
+		const auto updateCount = app.GetStepTimer().GetFrameCount();
+		CHECK(app.GetStepTimer().GetTotalSeconds() >= 2 && updateCount <= 61);
+		CHECK(device.GetPresentCount() == updateCount * 2 - 1);
+		CHECK(device.GetPresentCount() == app.GetBenchmarkRun().GetFrameTimings().size());
+		CHECK(frameCount == device.GetPresentCount());
+	}
+}
+
+TEST(MeshSceneUploadsAfterGeneratingMesh) {
+	for (auto run = 0; run < 10; run++) {
+		RecordingDevice device({ 64, 32 });
+		std::unique_ptr<MeshScene> scene;
+
+		// As at startup, with other work competing for the threads.
+		TaskGraph taskGraph;
+		taskGraph.Add("Effect", [] { std::this_thread::sleep_for(std::chrono::milliseconds(1)); });
+		const auto upload = MeshScene::AddCreationTasks(taskGraph, device, scene);
+		taskGraph.Start(3);
+		taskGraph.Join();
+
+		const auto timings = taskGraph.GetTimings();
+		const auto mesh = std::find_if(timings.begin(), timings.end(), [](const TaskGraph::TaskTiming& timing) { return timing.Name == "Mesh"; });
+		CHECK(mesh != timings.end() && timings[upload].Name == "Upload");
+		CHECK(mesh->IsCompleted && timings[upload].IsCompleted);
+		CHECK(timings[upload].StartSeconds >= mesh->EndSeconds);
+
+		// The buffers were created from the generated geometry.
+		CHECK(scene != nullptr && !scene->GetChunks().empty());
+		CHECK(device.GetBuffer(0).Type == BufferType::Vertex && !device.GetBuffer(0).Data.empty());
+		CHECK(device.GetBuffer(1).Type == BufferType::Index && device.GetBuffer(2).Type == BufferType::Index);
+	}
+}
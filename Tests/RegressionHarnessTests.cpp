@@ -0,0 +1,200 @@
+#include "Test.h"
+
+#include "RegressionHarness.h"
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+using namespace Hydr10n::Benchmarks;
+
+namespace {
+	// An eighth of a turn around the sphere while closing in, over half a second.
+	DX::CameraPath CreateCameraPath(float radius = 4) {
+		std::ostringstream path;
+		path << "0 0 0 0 0 0 0 1 " << radius << "\n0.5 0 0 0 0.3826834 0 0 0.9238795 " << radius - 1 << '\n';
+
+		std::istringstream stream(path.str());
+		return DX::CameraPath::CreateFromStream(stream);
+	}
+
+	RegressionHarness::Options CreateOptions(const std::filesystem::path& directory) {
+		RegressionHarness::Options options;
+		options.OutputSize = { 160, 120 };
+		options.FrameCount = 12;
+		options.CaptureFrames = { 0, 5, 11 };
+		options.GoldenDirectory = directory / "Golden";
+		options.BaselinePath = directory / "Baseline.csv";
+		options.OutputDirectory = directory / "Output";
+
+		// Timings on a shared machine are too noisy to compare here; the timing checks have tests of their own.
+		options.TimingRegressionThreshold = 1000;
+		return options;
+	}
+
+	bool HasFailure(const RegressionHarness::Result& result, std::string_view text) {
+		return std::any_of(result.Failures.cbegin(), result.Failures.cend(), [&](const std::string& failure) { return failure.find(text) != std::string::npos; });
+	}
+
+	Image CreateImage(uint32_t width, uint32_t height, uint8_t value) { return { width, height, std::vector<uint8_t>(static_cast<size_t>(width) * height * 3, value) }; }
+
+	void SetPixel(Image& image, uint32_t x, uint32_t y, uint8_t value) {
+		const auto pixel = const_cast<uint8_t*>(image.GetPixel(x, y));
+		pixel[0] = pixel[1] = pixel[2] = value;
+	}
+}
+
+TEST(CompareImagesToleratesEdgeShifts) {
+	// A vertical edge, and the same edge one pixel to the right.
+	auto golden = CreateImage(16, 8, 0), image = golden;
+	for (uint32_t y = 0; y < 8; y++) {
+		for (uint32_t x = 8; x < 16; x++) SetPixel(golden, x, y, 255);
+		for (uint32_t x = 9; x < 16; x++) SetPixel(image, x, y, 255);
+	}
+
+	auto diff = CompareImages(image, golden, {});
+	CHECK(diff.AreSizesEqual && diff.IsEqual);
+	CHECK(diff.MismatchCount == 0 && diff.EdgeShiftCount == 8);
+	CHECK(diff.MaxChannelDifference == 255);
+
+	diff = CompareImages(image, golden, { .IsEdgeShiftTolerated = false });
+	CHECK(!diff.IsEqual && diff.MismatchCount == 8);
+
+	// A lone pixel has no equal neighbor in the golden image; differences within the tolerance are not counted.
+	image = golden;
+	SetPixel(image, 2, 2, 255);
+	SetPixel(image, 4, 4, 8);
+	diff = CompareImages(image, golden, {});
+	CHECK(!diff.IsEqual && diff.MismatchCount == 1 && diff.EdgeShiftCount == 0);
+	CHECK(CompareImages(image, golden, { .MaxMismatchFraction = 0.01 }).IsEqual);
+
+	diff = CompareImages(CreateImage(8, 8, 0), golden, {});
+	CHECK(!diff.AreSizesEqual && !diff.IsEqual);
+}
+
+TEST(ImageRoundTripsThroughPPM) {
+	auto image = CreateImage(3, 2, 10);
+	SetPixel(image, 2, 1, 200);
+
+	const auto path = Hydr10n::Tests::CreateTemporaryDirectory("Image") / "image.ppm";
+	image.WritePPM(path);
+
+	const auto read = Image::ReadPPM(path);
+	CHECK(read.Width == 3 && read.Height == 2);
+	CHECK(read.Pixels == image.Pixels);
+}
+
+TEST(RegressionHarnessPassesAgainstItsReferences) {
+	const auto directory = Hydr10n::Tests::CreateTemporaryDirectory("RegressionHarness");
+
+	auto options = CreateOptions(directory);
+	options.IsUpdatingReferences = true;
+	auto result = RegressionHarness(CreateCameraPath(), options).Run();
+	CHECK(result.IsPassed());
+	CHECK(result.FrameComparisons.size() == 3);
+	for (const auto frame : options.CaptureFrames) {
+		CHECK(std::filesystem::exists(options.GoldenDirectory / ("frame" + std::to_string(frame) + ".ppm")));
+	}
+	CHECK(std::filesystem::exists(options.BaselinePath));
+
+	// Rendering is deterministic, so the same run reproduces every golden exactly, even on more threads.
+	options.IsUpdatingReferences = false;
+	options.RasterizerThreadCount = 4;
+	result = RegressionHarness(CreateCameraPath(), options).Run();
+	CHECK(result.IsPassed());
+	for (const auto& comparison : result.FrameComparisons) {
+		CHECK(!comparison.IsGoldenMissing && comparison.Diff.IsEqual);
+		CHECK(comparison.Diff.MismatchCount == 0 && comparison.Diff.EdgeShiftCount == 0);
+	}
+
+	// Every stage is timed and compared with the baseline.
+	CHECK(result.StageTimings.size() == static_cast<size_t>(FrameStage::Count) + 1);
+	CHECK(result.StageTimings.front().Stage == RegressionHarness::SetupStageName);
+	CHECK(std::filesystem::exists(options.OutputDirectory / "timings.csv"));
+}
+
+TEST(RegressionHarnessCatchesImageChanges) {
+	const auto directory = Hydr10n::Tests::CreateTemporaryDirectory("RegressionHarness");
+
+	auto options = CreateOptions(directory);
+	options.IsUpdatingReferences = true;
+	RegressionHarness(CreateCameraPath(), options).Run();
+
+	// The camera further away than in the goldens.
+	options.IsUpdatingReferences = false;
+	auto result = RegressionHarness(CreateCameraPath(5), options).Run();
+	CHECK(!result.IsPassed());
+	CHECK(HasFailure(result, "Frame 5 differs from its golden image"));
+	CHECK(std::filesystem::exists(options.OutputDirectory / "frame5_diff.ppm"));
+
+	// A different size.
+	options.OutputSize = { 80, 60 };
+	result = RegressionHarness(CreateCameraPath(), options).Run();
+	CHECK(HasFailure(result, "differs in size"));
+
+	// Missing references, and frames past the end of the run.
+	options.OutputSize = { 160, 120 };
+	options.CaptureFrames.push_back(100);
+	std::filesystem::remove(options.GoldenDirectory / "frame0.ppm");
+	std::filesystem::remove(options.BaselinePath);
+	result = RegressionHarness(CreateCameraPath(), options).Run();
+	CHECK(HasFailure(result, "Frame 0 has no golden image"));
+	CHECK(HasFailure(result, "Frame 100 was not rendered"));
+	CHECK(HasFailure(result, "No timing baseline"));
+	CHECK(result.Failures.size() == 3);
+
+	options.OutputSize = { 0, 120 };
+	CHECK_THROWS(std::invalid_argument, RegressionHarness(CreateCameraPath(), options));
+}
+
+TEST(RegressionHarnessCatchesSlowerStages) {
+	const auto directory = Hydr10n::Tests::CreateTemporaryDirectory("RegressionHarness");
+
+	auto options = CreateOptions(directory);
+	options.CaptureFrames.clear();
+	options.TimingRegressionThreshold = 0.2;
+	options.MinTimingRegressionMilliseconds = 0;
+
+	// Setup cannot have taken no time at all; stages missing from the baseline are not compared.
+	std::ofstream(options.BaselinePath) << "Stage,Milliseconds\n" << RegressionHarness::SetupStageName << ",0\n";
+
+	auto result = RegressionHarness(CreateCameraPath(), options).Run();
+	CHECK(result.Failures.size() == 1);
+	CHECK(result.Failures.front().starts_with(std::string(RegressionHarness::SetupStageName) + " took "));
+	CHECK(result.StageTimings.front().IsRegressed);
+
+	// A baseline far slower than any machine leaves nothing regressed.
+	std::ofstream(options.BaselinePath) << "Stage,Milliseconds\n" << RegressionHarness::SetupStageName << ",1000000\n";
+	result = RegressionHarness(CreateCameraPath(), options).Run();
+	CHECK(result.IsPassed());
+	CHECK(result.StageTimings.front().BaselineMilliseconds == 1000000);
+
+	std::ofstream(options.BaselinePath) << "Stage,Milliseconds\n" << RegressionHarness::SetupStageName << ",slow\n";
+	CHECK_THROWS(std::runtime_error, RegressionHarness(CreateCameraPath(), options).Run());
+}
+
+// Runs the whole demo camera path against references kept outside the tests, e.g. in CI:
+// Tests -benchmark -filter RegressionHarnessReferences -RegressionReferences <directory> [-RegressionUpdate 1]
+BENCHMARK(RegressionHarnessReferences) {
+	const auto references = Hydr10n::Tests::GetOption("RegressionReferences");
+	if (references.empty()) {
+		std::cout << "Skipped: pass -RegressionReferences <directory> to compare against goldens and a timing baseline there\n";
+		return;
+	}
+
+	RegressionHarness::Options options;
+	options.CaptureFrames = { 0, 30, 60, 90, 119 };
+	options.GoldenDirectory = std::filesystem::path(references);
+	options.BaselinePath = options.GoldenDirectory / "Baseline.csv";
+	options.OutputDirectory = Hydr10n::Tests::CreateTemporaryDirectory("RegressionHarnessOutput");
+	options.IsUpdatingReferences = Hydr10n::Tests::GetOption("RegressionUpdate", "0") != "0";
+
+	std::istringstream stream("0 0 0 0 0 0 0 1 4\n2 0 0 0 0.3826834 0 0 0.9238795 3\n");
+	const auto result = RegressionHarness(DX::CameraPath::CreateFromStream(stream), options).Run();
+
+	for (const auto& timing : result.StageTimings) std::cout << timing.Stage << ": " << timing.Milliseconds << " ms (baseline " << timing.BaselineMilliseconds << " ms)\n";
+	for (const auto& failure : result.Failures) std::cout << failure << '\n';
+	std::cout << "Output in " << options.OutputDirectory.string() << '\n';
+
+	CHECK(result.IsPassed());
+}
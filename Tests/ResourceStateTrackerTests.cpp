@@ -0,0 +1,247 @@
+#include "Test.h"
+
+#include "ResourceStateTracker.h"
+
+namespace {
+	// The D3D12 resource states the tests use, with the same values.
+	enum State : uint32_t {
+		Common = 0,
+		VertexBuffer = 0x1,
+		IndexBuffer = 0x2,
+		RenderTarget = 0x4,
+		UnorderedAccess = 0x8,
+		DepthWrite = 0x10,
+		DepthRead = 0x20,
+		NonPixelShaderResource = 0x40,
+		PixelShaderResource = 0x80,
+		CopyDest = 0x400,
+		CopySource = 0x800,
+		GenericRead = 0xac3
+	};
+
+	using Tracker = DX::ResourceStateTracker<const int*, State, State(GenericRead | DepthRead), State(NonPixelShaderResource | PixelShaderResource | CopyDest | CopySource)>;
+	using Barrier = Tracker::Barrier;
+	using Split = Tracker::Split;
+
+	constexpr int Resources[5]{};
+	constexpr auto A = &Resources[0], B = &Resources[1], C = &Resources[2], D = &Resources[3], Unknown = &Resources[4];
+
+	// The barriers of each call to submit.
+	struct Submissions {
+		std::vector<std::vector<Barrier>> Calls;
+
+		auto GetSubmit() {
+			return [this](std::span<const Barrier> barriers) { Calls.emplace_back(barriers.begin(), barriers.end()); };
+		}
+
+		std::vector<Barrier> Flush(Tracker& tracker) {
+			const auto callCount = Calls.size();
+			tracker.Flush(GetSubmit());
+			return Calls.size() == callCount ? std::vector<Barrier>() : Calls.back();
+		}
+
+		std::vector<Barrier> Resolve(Tracker& tracker, Tracker::GlobalStates& globalStates) {
+			const auto callCount = Calls.size();
+			tracker.Resolve(globalStates, GetSubmit());
+			return Calls.size() == callCount ? std::vector<Barrier>() : Calls.back();
+		}
+	};
+}
+
+TEST(ResourceStateTrackerMergesTransitions) {
+	Tracker tracker;
+	tracker.SetState(A, Common);
+	tracker.SetState(B, GenericRead);
+	tracker.SetState(C, CopyDest);
+	tracker.SetState(D, RenderTarget);
+
+	// B is already readable as a vertex buffer, C goes straight to where it ends, and D comes back to where it started.
+	tracker.Transition(A, RenderTarget);
+	tracker.Transition(B, VertexBuffer);
+	tracker.Transition(C, VertexBuffer);
+	tracker.Transition(C, IndexBuffer);
+	tracker.Transition(D, PixelShaderResource);
+	tracker.Transition(D, RenderTarget);
+	CHECK(tracker.GetState(C) == IndexBuffer);
+
+	Submissions submissions;
+	CHECK((submissions.Flush(tracker) == std::vector<Barrier>{ { A, Common, RenderTarget, Split::None }, { C, CopyDest, IndexBuffer, Split::None } }));
+	CHECK(submissions.Calls.size() == 1);
+
+	// Nothing pending submits nothing at all.
+	CHECK(!tracker.HasPendingBarriers());
+	CHECK(submissions.Flush(tracker).empty());
+	CHECK(submissions.Calls.size() == 1);
+
+	// Read-only states combine; leaving them takes a barrier from all of them.
+	tracker.SetState(B, State(VertexBuffer | IndexBuffer));
+	tracker.Transition(B, IndexBuffer);
+	CHECK(submissions.Flush(tracker).empty());
+	tracker.Transition(B, CopyDest);
+	CHECK((submissions.Flush(tracker) == std::vector<Barrier>{ { B, State(VertexBuffer | IndexBuffer), CopyDest, Split::None } }));
+
+	// Forgotten resources drop their barriers.
+	tracker.Transition(A, PixelShaderResource);
+	tracker.Forget(A);
+	CHECK(submissions.Flush(tracker).empty());
+	CHECK_THROWS(std::out_of_range, tracker.GetState(A));
+}
+
+TEST(ResourceStateTrackerSplitsBarriers) {
+	Tracker tracker;
+	tracker.SetState(A, RenderTarget);
+	tracker.SetState(B, CopyDest);
+
+	Submissions submissions;
+
+	// The split begins with one flush and ends with the next transition to its state, after unrelated work.
+	tracker.BeginTransition(A, PixelShaderResource);
+	CHECK((submissions.Flush(tracker) == std::vector<Barrier>{ { A, RenderTarget, PixelShaderResource, Split::Begin } }));
+	tracker.Transition(B, CopySource);
+	CHECK((submissions.Flush(tracker) == std::vector<Barrier>{ { B, CopyDest, CopySource, Split::None } }));
+	tracker.Transition(A, PixelShaderResource);
+	CHECK((submissions.Flush(tracker) == std::vector<Barrier>{ { A, RenderTarget, PixelShaderResource, Split::End } }));
+
+	// Going elsewhere ends the split first.
+	tracker.BeginTransition(A, RenderTarget);
+	submissions.Flush(tracker);
+	tracker.Transition(A, UnorderedAccess);
+	CHECK((submissions.Flush(tracker) == std::vector<Barrier>{ { A, PixelShaderResource, RenderTarget, Split::End }, { A, RenderTarget, UnorderedAccess, Split::None } }));
+
+	// With nothing flushed in between, a single barrier does.
+	tracker.BeginTransition(A, CopySource);
+	tracker.Transition(A, CopySource);
+	CHECK((submissions.Flush(tracker) == std::vector<Barrier>{ { A, UnorderedAccess, CopySource, Split::None } }));
+}
+
+TEST(ResourceStateTrackerPromotesAndDecays) {
+	Tracker tracker;
+	Tracker::GlobalStates globalStates;
+
+	// A buffer, and textures that are promoted to reading, promoted to copying into, and transitioned to render to.
+	tracker.SetState(A, Common, DX::ResourcePromotion::Any);
+	tracker.SetState(B, Common);
+	tracker.SetState(C, Common);
+	tracker.SetState(D, Common);
+
+	Submissions submissions;
+
+	// Buffers are promoted to any state, and read-only promotions accumulate.
+	tracker.Transition(A, VertexBuffer);
+	tracker.Transition(A, IndexBuffer);
+	CHECK(tracker.GetState(A) == State(VertexBuffer | IndexBuffer));
+	CHECK(submissions.Flush(tracker).empty());
+
+	// Textures only to shader resource and copy states; a write ends promotion.
+	tracker.Transition(B, PixelShaderResource);
+	tracker.Transition(B, NonPixelShaderResource);
+	tracker.Transition(C, CopyDest);
+	tracker.Transition(C, CopySource);
+	tracker.Transition(D, RenderTarget);
+	CHECK((submissions.Flush(tracker) == std::vector<Barrier>{ { C, CopyDest, CopySource, Split::None }, { D, Common, RenderTarget, Split::None } }));
+
+	// A split to a promotable state is left to promotion.
+	tracker.SetState(B, Common);
+	tracker.BeginTransition(B, PixelShaderResource);
+	CHECK(submissions.Flush(tracker).empty());
+	tracker.Transition(B, PixelShaderResource);
+	CHECK(submissions.Flush(tracker).empty());
+
+	// Once executed, buffers and textures promoted to reading only decay to common; the others keep their state.
+	CHECK(submissions.Resolve(tracker, globalStates).empty());
+	CHECK(globalStates.GetState(A) == Common);
+	CHECK(globalStates.GetState(B) == Common);
+	CHECK(globalStates.GetState(C) == CopySource);
+	CHECK(globalStates.GetState(D) == RenderTarget);
+
+	// Buffers decay even after explicit barriers; textures that took one do not.
+	tracker.Transition(A, CopyDest);
+	tracker.Transition(B, PixelShaderResource);
+	submissions.Flush(tracker);
+	tracker.Transition(A, VertexBuffer);
+	tracker.Transition(B, RenderTarget);
+	CHECK((submissions.Flush(tracker) == std::vector<Barrier>{ { A, CopyDest, VertexBuffer, Split::None }, { B, PixelShaderResource, RenderTarget, Split::None } }));
+	CHECK(submissions.Resolve(tracker, globalStates).empty());
+	CHECK(globalStates.GetState(A) == Common);
+	CHECK(globalStates.GetState(B) == RenderTarget);
+}
+
+TEST(ResourceStateTrackerResolvesAcrossCommandLists) {
+	Tracker::GlobalStates globalStates;
+	globalStates.SetState(A, RenderTarget);
+	globalStates.SetState(B, Common, DX::ResourcePromotion::Any);
+	globalStates.SetState(C, DepthWrite);
+
+	Submissions submissions;
+
+	// Two command lists recorded at once, neither knowing what the other does to A.
+	Tracker first, second;
+
+	first.Transition(A, PixelShaderResource);
+	first.Transition(C, DepthWrite);
+	first.Transition(B, IndexBuffer);
+	CHECK(first.IsPendingFirstUse(A) && first.GetState(A) == PixelShaderResource);
+	CHECK(submissions.Flush(first).empty());
+
+	second.BeginTransition(A, RenderTarget);
+	second.Transition(A, RenderTarget);
+	second.Transition(A, CopySource);
+	second.Transition(B, VertexBuffer);
+	CHECK((submissions.Flush(second) == std::vector<Barrier>{ { A, RenderTarget, CopySource, Split::None } }));
+
+	// Submitted in order: the first needs A brought from where earlier frames left it; C already is where it is needed,
+	// and B is promoted.
+	CHECK((submissions.Resolve(first, globalStates) == std::vector<Barrier>{ { A, RenderTarget, PixelShaderResource, Split::None } }));
+	CHECK(globalStates.GetState(A) == PixelShaderResource);
+	CHECK(globalStates.GetState(B) == Common);
+	CHECK(!first.IsPendingFirstUse(A));
+
+	// The second assumed A was a render target, which it no longer is once the first has executed.
+	CHECK((submissions.Resolve(second, globalStates) == std::vector<Barrier>{ { A, PixelShaderResource, RenderTarget, Split::None } }));
+	CHECK(globalStates.GetState(A) == CopySource);
+	CHECK(globalStates.GetState(C) == DepthWrite);
+
+	// Resources a command list does not touch keep their state; those it sets its own state for take the state it leaves.
+	Tracker third;
+	third.SetState(D, Common);
+	third.Transition(D, RenderTarget);
+	submissions.Flush(third);
+	CHECK(submissions.Resolve(third, globalStates).empty());
+	CHECK(globalStates.GetState(D) == RenderTarget);
+	CHECK(globalStates.GetState(A) == CopySource);
+
+	// Barriers must be flushed and resources known.
+	third.SetState(D, RenderTarget);
+	third.Transition(D, CopyDest);
+	CHECK_THROWS(std::logic_error, third.Resolve(globalStates, submissions.GetSubmit()));
+	third.Reset();
+
+	third.Transition(Unknown, CopyDest);
+	CHECK_THROWS(std::out_of_range, third.Resolve(globalStates, submissions.GetSubmit()));
+}
+
+TEST(ResourceStateTrackerResolvesCombinedReadStates) {
+	Tracker::GlobalStates globalStates;
+	globalStates.SetState(A, State(NonPixelShaderResource | PixelShaderResource));
+	globalStates.SetState(B, State(NonPixelShaderResource | PixelShaderResource));
+	globalStates.SetState(C, PixelShaderResource);
+
+	Submissions submissions;
+	Tracker tracker;
+
+	// A is read, then rendered to; B and C are only read.
+	tracker.Transition(A, PixelShaderResource);
+	tracker.Transition(A, RenderTarget);
+	tracker.Transition(B, PixelShaderResource);
+	tracker.Transition(C, PixelShaderResource);
+	CHECK((submissions.Flush(tracker) == std::vector<Barrier>{ { A, PixelShaderResource, RenderTarget, Split::None } }));
+
+	// Although both shader resource states include it, A and B are narrowed to the state the command list started from,
+	// so that its own barriers and the state it leaves behind hold.
+	CHECK((submissions.Resolve(tracker, globalStates) == std::vector<Barrier>{
+		{ A, State(NonPixelShaderResource | PixelShaderResource), PixelShaderResource, Split::None },
+		{ B, State(NonPixelShaderResource | PixelShaderResource), PixelShaderResource, Split::None } }));
+	CHECK(globalStates.GetState(A) == RenderTarget);
+	CHECK(globalStates.GetState(B) == PixelShaderResource);
+	CHECK(globalStates.GetState(C) == PixelShaderResource);
+}
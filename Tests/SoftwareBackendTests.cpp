@@ -0,0 +1,155 @@
+#include "Test.h"
+
+#include "HeadlessApp.h"
+#include "SoftwareBackend.h"
+
+#include <atomic>
+#include <fstream>
+#include <sstream>
+
+using namespace DirectX;
+using namespace Hydr10n::Benchmarks;
+using namespace Hydr10n::Rendering;
+
+namespace {
+	struct Vertex { XMFLOAT3 Position, Normal; };
+
+	constexpr OutputSize Size{ 150, 100 };
+
+	// A quad facing the viewer across the whole clip space at depth z, as two triangles sharing a diagonal.
+	void DrawQuad(SoftwareDevice& device, ICommandList& commandList, float z, const XMFLOAT4& color) {
+		const Vertex vertices[]{
+			{ { -1, -1, z }, { 0, 0, 1 } }, { { -1, 1, z }, { 0, 0, 1 } }, { { 1, 1, z }, { 0, 0, 1 } }, { { 1, -1, z }, { 0, 0, 1 } }
+		};
+		const uint32_t indices[]{ 0, 1, 2, 0, 2, 3 };
+
+		commandList.SetViewport({ 0, 0, static_cast<float>(Size.Width), static_cast<float>(Size.Height), 0, 1 }, { 0, 0, static_cast<int32_t>(Size.Width), static_cast<int32_t>(Size.Height) });
+		commandList.SetVertexBuffer(device.CreateBuffer(BufferType::Vertex, vertices, sizeof(vertices)), sizeof(Vertex));
+		commandList.SetIndexBuffer(device.CreateBuffer(BufferType::Index, indices, sizeof(indices)));
+		commandList.SetPrimitiveTopology(PrimitiveTopology::TriangleList);
+
+		EffectConstants effectConstants;
+		XMStoreFloat4x4(&effectConstants.World, XMMatrixIdentity());
+		effectConstants.View = effectConstants.Projection = effectConstants.World;
+		effectConstants.DiffuseColor = color;
+		commandList.SetEffect(effectConstants);
+
+		commandList.DrawIndexed(static_cast<uint32_t>(std::size(indices)), 0);
+	}
+
+	std::vector<uint32_t> GetPixels(const SoftwareRasterizer& rasterizer) {
+		std::vector<uint32_t> pixels;
+		for (uint32_t y = 0; y < rasterizer.GetHeight(); y++) {
+			for (uint32_t x = 0; x < rasterizer.GetWidth(); x++) pixels.push_back(rasterizer.GetPixel(x, y));
+		}
+		return pixels;
+	}
+
+	// The headless app's last frame on the demo sphere.
+	std::vector<uint32_t> RenderSphere(uint32_t threadCount, bool isWireframe) {
+		std::istringstream stream("0 0 0 0 0 0 0 1 3\n0.1 0 0 0 0.0784591 0 0 0.9969173 3\n");
+
+		SoftwareDevice device({ 320, 180 }, threadCount);
+		HeadlessApp::Options options;
+		options.IsWireframe = isWireframe;
+		HeadlessApp app(device, DX::CameraPath::CreateFromStream(stream), options);
+		while (!app.IsFinished()) app.Tick();
+		device.WaitForIdle();
+
+		return GetPixels(device.GetRasterizer());
+	}
+}
+
+TEST(WorkerPoolRunsEveryItemOnce) {
+	for (const auto threadCount : { 1u, 4u }) {
+		WorkerPool workerPool(threadCount);
+		CHECK(workerPool.GetThreadCount() == threadCount);
+
+		for (uint32_t itemCount = 0; itemCount <= 200; itemCount += itemCount < 10 ? 1 : 47) {
+			std::vector<std::atomic<uint32_t>> counts(itemCount);
+			workerPool.Run(itemCount, [&](uint32_t item) { counts[item]++; });
+			CHECK(std::all_of(counts.cbegin(), counts.cend(), [](const std::atomic<uint32_t>& count) { return count == 1; }));
+		}
+	}
+}
+
+TEST(SoftwareRasterizerCoversSharedEdges) {
+	SoftwareDevice device(Size, 2);
+
+	XMFLOAT4 clearColor{ 0, 0, 0, 1 };
+	auto& commandList = device.BeginFrame();
+	commandList.Clear(clearColor, 1);
+	DrawQuad(device, commandList, 0.5f, { 1, 0.5f, 0.25f, 1 });
+	device.Present();
+	device.WaitForIdle();
+
+	// The two triangles leave no pixel uncovered along their diagonal, and a constant normal lights every pixel the same.
+	const auto pixels = GetPixels(device.GetRasterizer());
+	CHECK(pixels.size() == static_cast<size_t>(Size.Width) * Size.Height);
+	CHECK(pixels[0] != 0xff000000);
+	CHECK(std::all_of(pixels.cbegin(), pixels.cend(), [&](uint32_t pixel) { return pixel == pixels[0]; }));
+
+	const auto depths = device.GetRasterizer().GetDepthBuffer();
+	CHECK_NEAR(depths[0], 0.5f, 1e-6f);
+}
+
+TEST(SoftwareRasterizerTestsDepth) {
+	std::vector<uint32_t> images[2];
+
+	// The nearer quad wins whichever is drawn first.
+	for (auto i = 0; i < 2; i++) {
+		SoftwareDevice device(Size, 2);
+		auto& commandList = device.BeginFrame();
+		commandList.Clear({ 0, 0, 0, 1 }, 1);
+		DrawQuad(device, commandList, i ? 0.25f : 0.75f, { i ? 1.0f : 0.0f, 0, i ? 0.0f : 1.0f, 1 });
+		DrawQuad(device, commandList, i ? 0.75f : 0.25f, { i ? 0.0f : 1.0f, 0, i ? 1.0f : 0.0f, 1 });
+		device.Present();
+		device.WaitForIdle();
+
+		images[i] = GetPixels(device.GetRasterizer());
+		CHECK_NEAR(device.GetRasterizer().GetDepthBuffer()[0], 0.25f, 1e-6f);
+	}
+
+	CHECK(images[0] == images[1]);
+	CHECK((images[0][0] & 0xff) > 0 && !(images[0][0] & 0xff0000));
+}
+
+TEST(SoftwareRasterizerIsDeterministic) {
+	for (const auto isWireframe : { false, true }) {
+		const auto image = RenderSphere(1, isWireframe);
+
+		// Binning by worker keeps submission order, so the image does not depend on the thread count.
+		CHECK(image == RenderSphere(4, isWireframe));
+
+		// The sphere is in the middle, the clear color in the corners.
+		XMFLOAT4 clearColor;
+		XMStoreFloat4(&clearColor, Colors::LightSteelBlue);
+		const auto clearPixel = image[0];
+		CHECK(static_cast<int>(clearPixel & 0xff) == static_cast<int>(std::lround(clearColor.x * 255)));
+		if (!isWireframe) CHECK(image[image.size() / 2 + 160] != clearPixel);
+		CHECK(std::count(image.cbegin(), image.cend(), clearPixel) < static_cast<ptrdiff_t>(image.size()));
+	}
+}
+
+TEST(SoftwareRasterizerWritesPPM) {
+	SoftwareDevice device(Size, 1);
+	auto& commandList = device.BeginFrame();
+	commandList.Clear({ 1, 0, 0, 1 }, 1);
+	device.Present();
+	device.WaitForIdle();
+
+	const auto path = Hydr10n::Tests::CreateTemporaryDirectory("SoftwareRasterizer") / "frame.ppm";
+	device.GetRasterizer().WritePPM(path);
+
+	std::ifstream file(path, std::ios::binary);
+	std::string format;
+	uint32_t width, height, maxValue;
+	file >> format >> width >> height >> maxValue;
+	file.get();
+	CHECK(format == "P6" && width == Size.Width && height == Size.Height && maxValue == 255);
+
+	std::vector<char> data(static_cast<size_t>(width) * height * 3 + 1);
+	file.read(data.data(), static_cast<std::streamsize>(data.size()));
+	CHECK(file.gcount() == static_cast<std::streamsize>(data.size() - 1));
+	CHECK(static_cast<unsigned char>(data[0]) == 255 && !data[1] && !data[2]);
+}
@@ -0,0 +1,192 @@
+#include "Test.h"
+
+#include "StepTimer.h"
+
+#include "OrbitCameraState.h"
+
+#include <cstring>
+#include <utility>
+
+namespace {
+	using VirtualStepTimer = DX::BasicStepTimer<DX::VirtualClock>;
+
+	constexpr auto TicksPerSecond = VirtualStepTimer::TicksPerSecond;
+
+	// A camera moving, turning about Y and backing away at constant rates.
+	DX::OrbitCameraState GetCameraState(double seconds) {
+		using namespace DirectX;
+
+		DX::OrbitCameraState state{ { static_cast<float>(seconds * 2), 0, 0 }, {}, static_cast<float>(3 + seconds) };
+		XMStoreFloat4(&state.rotation, XMQuaternionRotationRollPitchYaw(0, static_cast<float>(seconds * 0.5), 0));
+		return state;
+	}
+
+	// Advances the clock, ticks once and returns how many updates ran.
+	uint32_t Tick(VirtualStepTimer& timer, uint64_t counts) {
+		timer.GetClock().Advance(counts);
+
+		uint32_t updateCount = 0;
+		timer.Tick([&] { updateCount++; });
+		return updateCount;
+	}
+}
+
+TEST(StepTimerVariableStep) {
+	VirtualStepTimer timer;
+
+	CHECK(Tick(timer, TicksPerSecond / 100) == 1);
+	CHECK(timer.GetElapsedTicks() == TicksPerSecond / 100);
+
+	// Even without time passing, every Tick updates once.
+	CHECK(Tick(timer, 0) == 1);
+	CHECK(timer.GetElapsedTicks() == 0);
+
+	CHECK(Tick(timer, TicksPerSecond / 50) == 1);
+	CHECK(timer.GetTotalTicks() == TicksPerSecond * 3 / 100);
+	CHECK(timer.GetFrameCount() == 3);
+}
+
+TEST(StepTimerFixedStepCatchUp) {
+	VirtualStepTimer timer;
+	timer.SetFixedTimeStep(true);
+	timer.SetTargetElapsedSeconds(1. / 60);
+
+	const auto step = TicksPerSecond / 60;
+
+	CHECK(Tick(timer, step) == 1);
+	CHECK(timer.GetElapsedTicks() == step);
+
+	// Shorter frames accumulate until a whole step has passed.
+	CHECK(Tick(timer, step / 2) == 0);
+	CHECK(Tick(timer, step / 2 + 1) == 1);
+
+	// A long frame runs every update it missed, each with the fixed elapsed time.
+	uint32_t updateCount = 0;
+	timer.GetClock().Advance(step * 5);
+	timer.Tick([&] {
+		CHECK(timer.GetElapsedTicks() == step);
+		updateCount++;
+	});
+	CHECK(updateCount == 5);
+	CHECK(timer.GetFrameCount() == 7);
+	CHECK(timer.GetTotalTicks() == step * 7);
+
+	// Deltas within a quarter of a millisecond of the step are snapped to it instead of drifting.
+	const auto leftOverTicks = timer.GetInterpolationFactor() * static_cast<double>(step);
+	for (auto i = 0; i < 100; i++) CHECK(Tick(timer, step + TicksPerSecond / 5000) == 1);
+	CHECK(timer.GetInterpolationFactor() * static_cast<double>(step) == leftOverTicks);
+}
+
+TEST(StepTimerClampsLongFrames) {
+	VirtualStepTimer timer;
+
+	DX::FrameStatistics frameStatistics;
+	timer.SetFrameStatistics(&frameStatistics);
+
+	// A frame after e.g. a breakpoint counts as a tenth of a second.
+	CHECK(Tick(timer, TicksPerSecond * 10) == 1);
+	CHECK(timer.GetElapsedTicks() == TicksPerSecond / 10);
+
+	// The statistics see the frame as it was.
+	CHECK(frameStatistics.GetSummary().maxSeconds == 10);
+
+	timer.SetFixedTimeStep(true);
+	timer.SetTargetElapsedSeconds(1. / 60);
+
+	CHECK(Tick(timer, TicksPerSecond * 10) == 6);
+	CHECK(Tick(timer, TicksPerSecond * 3600) == 6);
+
+	// Discontinuities reported up front run no catch-up at all.
+	timer.GetClock().AdvanceSeconds(10);
+	timer.ResetElapsedTime();
+	CHECK(Tick(timer, 0) == 0);
+	CHECK(timer.GetInterpolationFactor() == 0);
+}
+
+TEST(StepTimerConvertsClockUnits) {
+	// A microsecond clock: an update of a thirtieth of a second, and a clamp at a tenth of a second worth of counts.
+	VirtualStepTimer timer(DX::VirtualClock(1000000));
+
+	CHECK(Tick(timer, 33333) == 1);
+	CHECK(timer.GetElapsedTicks() == 333330);
+
+	CHECK(Tick(timer, 1000000) == 1);
+	CHECK(timer.GetElapsedTicks() == TicksPerSecond / 10);
+
+	// The frame rate is counted over every second of clock time.
+	timer.SetFixedTimeStep(true);
+	timer.SetTargetElapsedSeconds(1. / 10);
+	for (auto i = 0; i < 20; i++) Tick(timer, 100000);
+	CHECK(timer.GetFramesPerSecond() == 10);
+}
+
+TEST(StepTimerSteadyClock) {
+	const DX::SteadyClock clock;
+	CHECK(clock.GetFrequency() == 1000000000);
+
+	auto count = clock.GetCount();
+	for (auto i = 0; i < 1000; i++) {
+		const auto nextCount = clock.GetCount();
+		CHECK(nextCount >= count);
+		count = nextCount;
+	}
+
+	DX::BasicStepTimer<DX::SteadyClock> timer;
+	timer.Tick([] {});
+	CHECK(timer.GetFrameCount() == 1);
+	CHECK(timer.GetElapsedTicks() < TicksPerSecond / 10);
+}
+
+TEST(StepTimerInterpolatesBetweenUpdates) {
+	// 30 Hz updates rendered at 144 Hz, the way D3DApp keeps the camera states of the last two updates.
+	VirtualStepTimer timer;
+	timer.SetFixedTimeStep(true);
+	timer.SetTargetElapsedSeconds(1. / 30);
+
+	const auto step = VirtualStepTimer::TicksToSeconds(TicksPerSecond / 30);
+
+	auto previousState = GetCameraState(0), state = previousState;
+	auto lastFocusX = -1.0f;
+
+	for (auto frame = 0; frame < 288; frame++) {
+		timer.GetClock().AdvanceSeconds(1. / 144);
+		timer.Tick([&] {
+			previousState = state;
+			state = GetCameraState(timer.GetTotalSeconds());
+		});
+
+		const auto interpolationFactor = timer.GetInterpolationFactor();
+		CHECK(interpolationFactor >= 0 && interpolationFactor < 1);
+
+		if (!timer.GetFrameCount()) continue;
+
+		// Rendering runs exactly one update behind the clock, so motion stays continuous between updates.
+		const auto rendered = DX::OrbitCameraState::Lerp(previousState, state, static_cast<float>(interpolationFactor)),
+			expected = GetCameraState(timer.GetTotalSeconds() + (interpolationFactor - 1) * step);
+		CHECK_NEAR(rendered.focus.x, expected.focus.x, 1e-5f);
+		CHECK_NEAR(rendered.radius, expected.radius, 1e-5f);
+		CHECK_NEAR(rendered.rotation.y, expected.rotation.y, 1e-5f);
+		CHECK_NEAR(rendered.rotation.w, expected.rotation.w, 1e-5f);
+
+		CHECK(rendered.focus.x > lastFocusX);
+		lastFocusX = rendered.focus.x;
+	}
+
+	// 288 frames of a whole number of clock counts each fall just short of 2 seconds.
+	CHECK(timer.GetFrameCount() == 59);
+}
+
+TEST(StepTimerInterpolationEnds) {
+	const auto from = GetCameraState(1), to = GetCameraState(2);
+
+	// An update is reproduced exactly at either end.
+	for (const auto& [t, expected] : { std::pair{ 0.0f, &from }, std::pair{ 1.0f, &to } }) {
+		const auto state = DX::OrbitCameraState::Lerp(from, to, t);
+		CHECK(!std::memcmp(&state, expected, sizeof(state)));
+	}
+
+	// Variable timestep renders the last update as is.
+	VirtualStepTimer timer;
+	Tick(timer, TicksPerSecond / 144);
+	CHECK(timer.GetInterpolationFactor() == 1);
+}
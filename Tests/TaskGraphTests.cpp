@@ -0,0 +1,115 @@
+#include "Test.h"
+
+#include "TaskGraph.h"
+
+#include <atomic>
+
+using namespace Hydr10n::Rendering;
+using namespace std::chrono_literals;
+
+TEST(TaskGraphRunsDependenciesFirst) {
+	// A diamond: B and C after A, D after both; repeated since the order in which ready tasks run varies.
+	for (int i = 0; i < 20; i++) {
+		TaskGraph graph;
+		std::atomic<int> order;
+		int a = -1, b = -1, c = -1, d = -1;
+		const auto A = graph.Add("A", [&] { std::this_thread::sleep_for(1ms); a = order++; });
+		const auto B = graph.Add("B", [&] { b = order++; }, { A });
+		const auto C = graph.Add("C", [&] { c = order++; }, { A });
+		const auto D = graph.Add("D", [&] { d = order++; }, { B, C });
+		CHECK(graph.GetTaskCount() == 4 && !graph.IsStarted());
+
+		graph.Start(3);
+		CHECK(graph.IsStarted());
+		graph.Join();
+		CHECK(graph.IsFinished());
+
+		CHECK(a == 0 && b > a && c > a && d == 3);
+
+		const auto timings = graph.GetTimings();
+		CHECK(timings.size() == 4 && timings[D].Name == "D");
+		for (const auto& timing : timings) CHECK(timing.IsCompleted && timing.Thread >= 1 && timing.Thread <= 3 && timing.StartSeconds <= timing.EndSeconds);
+		CHECK(timings[B].StartSeconds >= timings[A].EndSeconds && timings[C].StartSeconds >= timings[A].EndSeconds);
+		CHECK(timings[D].StartSeconds >= std::max(timings[B].EndSeconds, timings[C].EndSeconds));
+	}
+
+	// Nothing to run is finished at once.
+	TaskGraph graph;
+	graph.Start();
+	CHECK(graph.WaitFor(1s));
+	graph.Join();
+}
+
+TEST(TaskGraphStopsAtFirstException) {
+	TaskGraph graph;
+	std::atomic<bool> hasThrown, hasDependentStarted;
+
+	// The second task throws only once the first has, and neither's dependents start.
+	const auto first = graph.Add("First", [&] {
+		hasThrown = true;
+		throw std::runtime_error("First");
+	});
+	const auto second = graph.Add("Second", [&] {
+		while (!hasThrown) std::this_thread::yield();
+		std::this_thread::sleep_for(10ms);
+		throw std::runtime_error("Second");
+	});
+	graph.Add("AfterFirst", [&] { hasDependentStarted = true; }, { first });
+	graph.Add("AfterBoth", [&] { hasDependentStarted = true; }, { first, second });
+	graph.Start(2);
+
+	std::string message;
+	try { graph.Join(); }
+	catch (const std::runtime_error& e) { message = e.what(); }
+	CHECK(message == "First");
+	CHECK(graph.IsFinished() && !hasDependentStarted);
+
+	// Joining again rethrows the same exception.
+	CHECK_THROWS(std::runtime_error, graph.Join());
+
+	const auto timings = graph.GetTimings();
+	CHECK(!timings[first].IsCompleted && !timings[2].IsCompleted && !timings[3].IsCompleted);
+	CHECK(timings[2].Thread == 0 && timings[3].Thread == 0);
+}
+
+TEST(TaskGraphDropsTasksNotStarted) {
+	std::atomic<bool> hasStarted, hasDependentStarted;
+	{
+		TaskGraph graph;
+		graph.Add("Slow", [&] {
+			hasStarted = true;
+			std::this_thread::sleep_for(50ms);
+		});
+		graph.Add("AfterSlow", [&] { hasDependentStarted = true; }, { 0 });
+		graph.Start(1);
+
+		// Destroyed while the first task runs: it waits for that one but starts no other.
+		while (!hasStarted) std::this_thread::yield();
+	}
+	CHECK(!hasDependentStarted);
+
+	// Nor does a graph that never started run anything.
+	{
+		TaskGraph graph;
+		graph.Add("Never", [&] { hasDependentStarted = true; });
+	}
+	CHECK(!hasDependentStarted);
+}
+
+TEST(TaskGraphRejectsInvalidUse) {
+	TaskGraph graph;
+
+	// Dependencies on the task itself or on tasks not added yet would allow cycles.
+	CHECK_THROWS(std::out_of_range, graph.Add("First", [] {}, { 0 }));
+	const auto first = graph.Add("First", [] {});
+	CHECK_THROWS(std::out_of_range, graph.Add("Second", [] {}, { first, 2 }));
+	CHECK(graph.GetTaskCount() == 1);
+
+	CHECK_THROWS(std::logic_error, graph.Join());
+
+	graph.Start(1);
+	CHECK_THROWS(std::logic_error, graph.Add("Late", [] {}, { first }));
+	CHECK_THROWS(std::logic_error, graph.Start(1));
+	graph.Join();
+	CHECK(graph.GetTaskCount() == 1 && graph.GetTimings()[first].IsCompleted);
+}
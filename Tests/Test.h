@@ -0,0 +1,88 @@
+/*
+ * Header File: Test.h
+ * Last Update: 2026/10/18
+ *
+ * Copyright (C) Hydr10n@GitHub. All Rights Reserved.
+ */
+
+#pragma once
+
+#include <cmath>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Hydr10n::Tests {
+	class TestFailure : public std::runtime_error {
+	public:
+		using runtime_error::runtime_error;
+	};
+
+	struct TestCase {
+		const char* Name;
+		void (*Function)();
+		bool IsBenchmark;
+	};
+
+	inline std::vector<TestCase>& GetTestCases() {
+		static std::vector<TestCase> s_testCases;
+		return s_testCases;
+	}
+
+	struct TestRegistration {
+		TestRegistration(const char* name, void (*function)(), bool isBenchmark) { GetTestCases().push_back({ name, function, isBenchmark }); }
+	};
+
+	// Options passed to the runner as "-name value".
+	inline std::map<std::string, std::string, std::less<>>& GetOptions() {
+		static std::map<std::string, std::string, std::less<>> s_options;
+		return s_options;
+	}
+
+	inline std::string GetOption(std::string_view name, std::string_view defaultValue = {}) {
+		const auto& options = GetOptions();
+		const auto option = options.find(name);
+		return option == options.cend() ? std::string(defaultValue) : option->second;
+	}
+
+	// A directory of its own under the system temporary directory, emptied first.
+	inline std::filesystem::path CreateTemporaryDirectory(std::string_view name) {
+		const auto path = std::filesystem::temp_directory_path() / "Mesh Demo Tests" / name;
+		std::filesystem::remove_all(path);
+		std::filesystem::create_directories(path);
+		return path;
+	}
+
+	inline void Check(bool condition, const char* expression, const char* file, int line) {
+		if (!condition) throw TestFailure(std::string(file) + '(' + std::to_string(line) + "): " + expression);
+	}
+
+	template <class Exception>
+	void CheckThrows(const std::function<void()>& function, const char* expression, const char* file, int line) {
+		try { function(); }
+		catch (const Exception&) { return; }
+		catch (...) {}
+		throw TestFailure(std::string(file) + '(' + std::to_string(line) + "): " + expression + " did not throw the expected exception");
+	}
+}
+
+#define HYDR10N_TEST_CASE(name, isBenchmark) \
+	static void name(); \
+	static const Hydr10n::Tests::TestRegistration name##Registration(#name, name, isBenchmark); \
+	static void name()
+
+// Run by default.
+#define TEST(name) HYDR10N_TEST_CASE(name, false)
+
+// Run with -benchmark only, which is meant for release builds.
+#define BENCHMARK(name) HYDR10N_TEST_CASE(name, true)
+
+#define CHECK(expression) Hydr10n::Tests::Check(static_cast<bool>(expression), #expression, __FILE__, __LINE__)
+
+#define CHECK_NEAR(a, b, tolerance) Hydr10n::Tests::Check(std::abs((a) - (b)) <= (tolerance), #a " is near " #b, __FILE__, __LINE__)
+
+#define CHECK_THROWS(exception, ...) Hydr10n::Tests::CheckThrows<exception>([&] { __VA_ARGS__; }, #__VA_ARGS__, __FILE__, __LINE__)
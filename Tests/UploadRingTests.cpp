@@ -0,0 +1,96 @@
+#include "Test.h"
+
+#include "UploadRing.h"
+
+#include <algorithm>
+#include <random>
+#include <thread>
+
+namespace {
+	constexpr auto InvalidOffset = DX::UploadRing::c_InvalidOffset;
+}
+
+TEST(UploadRingAlignsAllocations) {
+	DX::UploadRing ring(1024);
+	CHECK(ring.GetCapacity() == 1024 && ring.GetUsedSize() == 0);
+
+	CHECK(ring.Allocate(3) == 0);
+	CHECK(ring.Allocate(16, 256) == 256);
+	CHECK(ring.Allocate(1, 4) == 272);
+
+	// Padding counts as used.
+	CHECK(ring.GetUsedSize() == 273);
+
+	// Empty and oversized allocations, and alignments that are not powers of two or do not divide the capacity.
+	CHECK(ring.Allocate(0) == InvalidOffset);
+	CHECK(ring.Allocate(1025) == InvalidOffset);
+	CHECK(ring.Allocate(1, 0) == InvalidOffset);
+	CHECK(ring.Allocate(1, 48) == InvalidOffset);
+	CHECK(ring.Allocate(1, 2048) == InvalidOffset);
+	CHECK(DX::UploadRing(768).Allocate(1, 512) == InvalidOffset);
+	CHECK(ring.GetUsedSize() == 273);
+
+	CHECK_THROWS(std::invalid_argument, DX::UploadRing(0));
+}
+
+TEST(UploadRingReclaimsFinishedFrames) {
+	DX::UploadRing ring(1024);
+
+	CHECK(ring.Allocate(600) == 0);
+	ring.EndFrame(1);
+	CHECK(ring.Allocate(300) == 600);
+	ring.EndFrame(2);
+
+	// Nothing fits while both frames are in flight, and a frame allocating nothing closes nothing.
+	CHECK(ring.Allocate(200) == InvalidOffset);
+	ring.EndFrame(3);
+	ring.Reclaim(0);
+	CHECK(ring.Allocate(200) == InvalidOffset);
+	CHECK(ring.GetUsedSize() == 900);
+
+	// Once the first frame completes, the next allocation skips the end of the ring rather than wrapping across it.
+	ring.Reclaim(1);
+	CHECK(ring.GetUsedSize() == 300);
+	CHECK(ring.Allocate(200) == 0);
+	CHECK(ring.GetUsedSize() == 624);
+	CHECK(ring.Allocate(500) == InvalidOffset);
+	ring.EndFrame(4);
+
+	// Completing a later fence value reclaims every frame up to it. The ring is free again, but in one piece only up to its end.
+	ring.Reclaim(4);
+	CHECK(ring.GetUsedSize() == 0);
+	CHECK(ring.Allocate(1024) == InvalidOffset);
+	CHECK(ring.Allocate(824) == 200);
+}
+
+TEST(UploadRingAllocatesConcurrently) {
+	constexpr uint64_t Alignment = 16;
+	constexpr size_t ThreadCount = 8, AllocationCount = 1000;
+
+	DX::UploadRing ring(1 << 20);
+
+	// Each thread keeps its own ranges; they are checked after the threads finish.
+	std::vector<std::pair<uint64_t, uint64_t>> ranges[ThreadCount];
+	{
+		std::vector<std::jthread> threads;
+		for (size_t i = 0; i < ThreadCount; i++) {
+			threads.emplace_back([&, i] {
+				std::mt19937 random(static_cast<unsigned int>(i));
+				std::uniform_int_distribution<uint64_t> sizes(1, 64);
+				for (size_t j = 0; j < AllocationCount; j++) {
+					const auto size = sizes(random);
+					ranges[i].emplace_back(ring.Allocate(size, Alignment), size);
+				}
+			});
+		}
+	}
+
+	std::vector<std::pair<uint64_t, uint64_t>> allRanges;
+	for (const auto& threadRanges : ranges) allRanges.insert(allRanges.cend(), threadRanges.cbegin(), threadRanges.cend());
+	std::ranges::sort(allRanges);
+
+	CHECK(allRanges.size() == ThreadCount * AllocationCount);
+	CHECK(std::ranges::none_of(allRanges, [](const auto& range) { return range.first == InvalidOffset || range.first % Alignment; }));
+	for (size_t i = 1; i < allRanges.size(); i++) CHECK(allRanges[i - 1].first + allRanges[i - 1].second <= allRanges[i].first);
+	CHECK(allRanges.back().first + allRanges.back().second <= ring.GetUsedSize());
+}
@@ -0,0 +1,104 @@
+#include "Test.h"
+
+#include "UploadScheduler.h"
+
+#include <algorithm>
+#include <memory>
+
+namespace {
+	// Stands in for a copy queue: it remembers the batches submitted and completes fence values only when told to.
+	// Staging data is shared so that the tests can watch when the scheduler lets go of it.
+	struct FakeQueue {
+		using Copy = int;
+		using Staging = std::shared_ptr<int>;
+
+		std::vector<std::vector<int>> Batches;
+		uint64_t CompletedValue{};
+
+		uint64_t Submit(std::span<const Copy> copies) {
+			Batches.emplace_back(copies.begin(), copies.end());
+			return Batches.size();
+		}
+
+		uint64_t GetCompletedValue() const { return CompletedValue; }
+	};
+
+	using Scheduler = DX::UploadScheduler<FakeQueue>;
+}
+
+TEST(UploadSchedulerBatchesCopies) {
+	Scheduler scheduler;
+	auto& queue = scheduler.GetQueue();
+
+	// Copies wait in the open batch until Submit, which sends them all at once.
+	std::vector<std::weak_ptr<int>> staging;
+	std::vector<DX::UploadTicket> tickets;
+	for (int i = 0; i < 3; i++) {
+		const auto data = std::make_shared<int>(i);
+		staging.emplace_back(data);
+		tickets.emplace_back(scheduler.Enqueue(i + 10, data));
+	}
+	CHECK((tickets == std::vector<DX::UploadTicket>{ 1, 2, 3 }));
+	CHECK(scheduler.HasOpenBatch() && queue.Batches.empty());
+	CHECK(!scheduler.IsComplete(tickets[0]) && scheduler.IsComplete(0));
+
+	scheduler.Submit();
+	CHECK(!scheduler.HasOpenBatch());
+	CHECK((queue.Batches == std::vector<std::vector<int>>{ { 10, 11, 12 } }));
+	CHECK(scheduler.GetPendingBatchCount() == 1 && scheduler.GetLastFenceValue() == 1);
+	CHECK(!scheduler.IsComplete(tickets[2]));
+
+	auto data = std::make_shared<int>(3);
+	staging.emplace_back(data);
+	tickets.emplace_back(scheduler.Enqueue(13, std::move(data)));
+	scheduler.Submit();
+
+	// Nothing open, nothing submitted.
+	scheduler.Submit();
+	CHECK(queue.Batches.size() == 2 && scheduler.GetLastFenceValue() == 2);
+
+	// A batch is complete as soon as its fence value is, but its staging data stays until Retire sees that.
+	queue.CompletedValue = 1;
+	CHECK(scheduler.IsComplete(tickets[2]) && !scheduler.IsComplete(tickets[3]));
+	CHECK(std::ranges::none_of(staging, &std::weak_ptr<int>::expired));
+
+	scheduler.Retire();
+	CHECK(staging[0].expired() && staging[1].expired() && staging[2].expired() && !staging[3].expired());
+	CHECK(scheduler.GetPendingBatchCount() == 1);
+	CHECK(scheduler.IsComplete(tickets[0]) && !scheduler.IsComplete(tickets[3]));
+
+	// Submit retires as well.
+	queue.CompletedValue = 2;
+	scheduler.Submit();
+	CHECK(staging[3].expired());
+	CHECK(scheduler.GetPendingBatchCount() == 0 && scheduler.GetLastFenceValue() == 0);
+	CHECK(std::ranges::all_of(tickets, [&](DX::UploadTicket ticket) { return scheduler.IsComplete(ticket); }));
+}
+
+TEST(UploadSchedulerHandsOutEachWaitOnce) {
+	Scheduler scheduler;
+	auto& queue = scheduler.GetQueue();
+
+	// Using a copy still in the open batch submits it.
+	const auto first = scheduler.Enqueue(0, nullptr);
+	CHECK(scheduler.AcquireForUse(first) == 1);
+	CHECK(queue.Batches.size() == 1);
+	CHECK(scheduler.AcquireForUse(first) == 0);
+
+	// Once the consumer waits on a fence value, copies in that batch and earlier ones need no further wait.
+	const auto second = scheduler.Enqueue(1, nullptr), third = scheduler.Enqueue(2, nullptr);
+	scheduler.Submit();
+	const auto fourth = scheduler.Enqueue(3, nullptr);
+	scheduler.Submit();
+	CHECK(scheduler.AcquireForUse(fourth) == 3);
+	CHECK(scheduler.AcquireForUse(second) == 0 && scheduler.AcquireForUse(third) == 0);
+
+	// Completed copies need no wait at all, retired or not.
+	const auto fifth = scheduler.Enqueue(4, nullptr);
+	scheduler.Submit();
+	queue.CompletedValue = 4;
+	CHECK(scheduler.AcquireForUse(fifth) == 0);
+	scheduler.Retire();
+	CHECK(scheduler.AcquireForUse(fifth) == 0 && scheduler.AcquireForUse(0) == 0);
+	CHECK(queue.Batches.size() == 4);
+}